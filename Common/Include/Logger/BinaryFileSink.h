@@ -0,0 +1,207 @@
+#pragma once
+
+#include "LogSink.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// バイナリ形式のファイル出力Sink
+/// レコードをテキスト化せずにコンパクトなバイナリで書き込み、表示はオフラインのデコーダ（LogTool）で行う
+///
+/// ファイル構成: ["RSLOGBIN" + バージョン][エントリ]...
+///   エントリの先頭1バイトは上位4ビットが種別、下位4ビットがログレベル
+///   カテゴリ・ファイル名・書式文字列は初出時に辞書エントリとして1度だけ出力し、以降はIDで参照する
+///   さらに（カテゴリ, ファイル名, 行番号, 書式文字列）の組を呼び出し箇所として登録し、レコードはそのIDだけを持つ
+///   タイムスタンプは直前のレコードとの差分（マイクロ秒、zigzag + varint）
+///   LOG_*Fのレコードは書式文字列IDと引数の生の値のみを書き、std::formatを呼ばない
+///   （型を復元できない引数を含む場合や、書式文字列がネストした置換フィールドを含む場合はテキストで書く）
+///   短い文字列の引数も辞書に登録し、2回目以降はIDで参照する（登録数には上限がある）
+///   追記モードでは開くたびにヘッダを書き、デコーダはそこで辞書と基準時刻をリセットする
+/// </summary>
+class BinaryFileSink : public ILogSink {
+public:
+    /// <summary>
+    /// ファイルパスを指定してBinaryFileSinkを構築
+    /// </summary>
+    /// <param name="filePath">ログファイルのパス</param>
+    /// <param name="append">trueの場合は追記モード、falseの場合は上書きモード</param>
+    explicit BinaryFileSink(const std::filesystem::path& filePath, bool append = true);
+
+    ~BinaryFileSink() override;
+
+    // コピー・ムーブ禁止
+    BinaryFileSink(const BinaryFileSink&) = delete;
+    BinaryFileSink& operator=(const BinaryFileSink&) = delete;
+
+    /// <summary>
+    /// ログメッセージをエンコードしてバッファに追記
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    void Write(const LogMessage& message) override;
+
+    /// <summary>
+    /// バッファ内のエントリをファイルに書き出す
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// クラッシュ時にバッファ内のレコードをロックせずに書き出す（バイナリ形式のため、クラッシュレポートは追記させない）
+    /// </summary>
+    /// <returns>常に-1</returns>
+    int EmergencyFlush() noexcept override;
+
+    /// <summary>
+    /// ファイルが正常に開いているかを確認
+    /// </summary>
+    /// <returns>ファイルが開いている場合true</returns>
+    bool IsOpen() const { return m_fd >= 0; }
+
+    /// <summary>
+    /// ログファイルのパスを取得
+    /// </summary>
+    /// <returns>ログファイルのパス</returns>
+    const std::filesystem::path& GetFilePath() const { return m_filePath; }
+
+    /// <summary>
+    /// 前回の書き出しからこの時間が経過したら次の書き込み時に書き出す
+    /// 経過時間はレコードのタイムスタンプで判定する（レコードごとに時計を読まない）
+    /// </summary>
+    /// <param name="interval">書き出し間隔</param>
+    void SetFlushInterval(std::chrono::milliseconds interval) { m_flushInterval = interval; }
+
+    /// <summary>
+    /// 書き出し間隔を取得
+    /// </summary>
+    /// <returns>書き出し間隔</returns>
+    std::chrono::milliseconds GetFlushInterval() const { return m_flushInterval; }
+
+    /// <summary>
+    /// バイナリログファイルをデコードして先頭から順に読み出す
+    /// LOG_*Fのレコードは書式文字列と引数からここで本文を生成する
+    /// </summary>
+    /// <param name="filePath">ログファイルのパス</param>
+    /// <param name="callback">レコードごとに呼ばれる関数（messageは呼び出し中のみ有効）</param>
+    /// <returns>ファイルが有効なバイナリログだった場合true（末尾の途切れたエントリは無視する）</returns>
+    static bool ReadFile(const std::filesystem::path& filePath, const std::function<void(const LogMessage&)>& callback);
+
+    /// <summary>
+    /// 書き込みバッファのサイズ
+    /// </summary>
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+private:
+    // 文字列辞書のキー（静的な文字列の先頭アドレスと長さ、書式文字列の場合は型情報も含む）
+    struct DictionaryKey {
+        const void* data;
+        size_t size;
+        const void* extra;
+
+        bool operator==(const DictionaryKey&) const = default;
+    };
+
+    // 呼び出し箇所のキー（カテゴリ・ファイル・行番号・書式文字列の組）
+    struct SiteKey {
+        const void* category;
+        const void* file;
+        const void* format;
+        const void* kinds;
+        int line;
+
+        bool operator==(const SiteKey&) const = default;
+    };
+
+    // 呼び出し箇所の登録内容
+    struct SiteInfo {
+        uint32_t id;                            // 呼び出し箇所ID
+        bool deferred;                          // 引数のまま書くか（falseの場合は本文をテキストで書く）
+        bool hasStrings;                        // 文字列の引数を含むか
+    };
+
+    struct KeyHash {
+        size_t operator()(const DictionaryKey& key) const;
+        size_t operator()(const SiteKey& key) const;
+    };
+
+    // 文字列引数の辞書のハッシュ（std::string_viewで検索できるようにする）
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+    };
+
+    using Dictionary = std::unordered_map<DictionaryKey, uint32_t, KeyHash>;
+    using StringDictionary = std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>;
+
+    /// <summary>
+    /// 辞書を引き、未登録なら定義エントリを出力してIDを割り当てる
+    /// </summary>
+    uint32_t Intern(Dictionary& dictionary, uint8_t entryType, std::string_view text, const LogArgKind* kinds);
+
+    /// <summary>
+    /// 呼び出し箇所を引き、未登録なら（必要な文字列定義とともに）定義エントリを出力してIDを割り当てる
+    /// 引数のまま書けるかどうかも登録時に一度だけ判定する
+    /// </summary>
+    const SiteInfo& InternSite(const LogMessage& message);
+
+    /// <summary>
+    /// 呼び出し箇所の定義エントリを（必要な文字列定義とともに）出力してIDを割り当てる
+    /// </summary>
+    uint32_t WriteSite(const LogMessage& message, bool deferred);
+
+    /// <summary>
+    /// 文字列引数を辞書から引き、未登録なら定義エントリを出力してIDを割り当てる
+    /// </summary>
+    /// <returns>ID（長すぎる・辞書が満杯で登録しない場合はkNotInterned）</returns>
+    uint32_t InternString(std::string_view text);
+
+    /// <summary>
+    /// シリアライズ済みの引数（LogFormatDetail::Encode形式）を可変長の表現に詰め直す
+    /// </summary>
+    /// <param name="stringIds">文字列引数ごとのInternStringの結果（出現順）</param>
+    uint8_t* WriteArguments(uint8_t* out, const LogArgKind* kinds, const LogBuffer& payload, const uint32_t* stringIds);
+
+    /// <summary>
+    /// バッファに最低size バイトの空きを確保し、書き込み位置を返す
+    /// </summary>
+    uint8_t* Reserve(size_t size);
+
+    /// <summary>
+    /// ファイルヘッダを出力して辞書と基準時刻をリセット
+    /// </summary>
+    void BeginSession();
+
+    void OpenFile(bool truncate);
+    void CloseFile();
+    void FlushBuffer();
+    void WriteToFile(const uint8_t* data, size_t size);
+
+    std::filesystem::path m_filePath;                           // ログファイルのパス
+    int m_fd;                                                   // ファイルディスクリプタ（開いていない場合は-1）
+    std::mutex m_mutex;                                         // スレッドセーフのためのミューテックス
+
+    std::string m_buffer;                                       // 書き込みバッファ
+    size_t m_bufferUsed;                                        // バッファ内の未書き出しバイト数
+    std::chrono::milliseconds m_flushInterval;                  // 書き出し間隔（デフォルト1秒）
+    int64_t m_lastFlushTimestamp;                               // 前回間隔で書き出したレコードのタイムスタンプ（マイクロ秒）
+
+    Dictionary m_categories;                                    // カテゴリ辞書
+    Dictionary m_files;                                         // ファイル名辞書
+    Dictionary m_formats;                                       // 書式文字列辞書
+    StringDictionary m_strings;                                 // 文字列引数の辞書
+    const StringDictionary::value_type* m_lastString;           // 直前に引いた文字列引数（同じ文字列が続く場合はハッシュを計算しない）
+    std::unordered_map<SiteKey, SiteInfo, KeyHash> m_sites;     // 呼び出し箇所辞書
+    SiteKey m_lastSiteKey;                                      // 直前のレコードの呼び出し箇所（連続する同じ呼び出し箇所は辞書を引かない）
+    const SiteInfo* m_lastSite;                                 // 直前のレコードの呼び出し箇所の登録内容（未設定はnullptr）
+    int64_t m_lastTimestamp;                                    // 直前のレコードのタイムスタンプ（マイクロ秒）
+};
+
+} // namespace RenderingSandbox
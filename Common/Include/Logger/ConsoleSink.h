@@ -2,12 +2,15 @@
 
 #include "LogSink.h"
 #include <mutex>
+#include <string>
 
 namespace RenderingSandbox {
 
 /// <summary>
 /// コンソール出力Sink
-/// std::cout/std::cerrへログを出力し、Windows Console APIで色付き表示を実現
+/// Windowsではstd::cout/std::cerrへログを出力し、Windows Console APIで色付き表示を実現
+/// POSIXではiostreamを使わず、色のエスケープシーケンスと1レコード分をまとめて1回のwrite(2)で出力する
+/// （色付けは出力先が端末の場合のみ、Error以上は標準エラー出力）
 /// </summary>
 class ConsoleSink : public ILogSink {
 public:
@@ -25,6 +28,12 @@ class ConsoleSink : public ILogSink {
     /// </summary>
     void Flush() override;
 
+    /// <summary>
+    /// クラッシュ時のレポートの出力先として標準エラー出力を返す
+    /// </summary>
+    /// <returns>標準エラー出力のファイルディスクリプタ</returns>
+    int EmergencyFlush() noexcept override { return 2; }
+
     /// <summary>
     /// 色付き出力の有効/無効を設定
     /// </summary>
@@ -38,8 +47,16 @@ class ConsoleSink : public ILogSink {
     bool IsColorEnabled() const { return m_colorEnabled; }
 
 private:
+    /// <summary>
+    /// POSIX: 1レコード分（色 + 本文 + 改行）を組み立てて1回のwrite(2)で出力
+    /// </summary>
+    void WriteRecord(int fd, bool useColor, LogLevel level, std::string_view text);
+
     void* m_consoleHandle;      // HANDLE型（Windows.hへの依存を隠蔽するためvoid*）
     bool m_colorEnabled;        // 色付き出力が有効かどうか
+    bool m_stdoutColor;         // POSIX: 標準出力が色付けできる端末かどうか
+    bool m_stderrColor;         // POSIX: 標準エラー出力が色付けできる端末かどうか
+    std::string m_lineBuffer;   // POSIX: 1レコード分の出力を組み立てるバッファ（容量を再利用）
     std::mutex m_mutex;         // スレッドセーフのためのミューテックス
 };
 
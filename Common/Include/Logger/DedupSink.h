@@ -0,0 +1,90 @@
+#pragma once
+
+#include "LogSink.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 連続する同一メッセージをまとめる中継Sink
+/// 直前と同じレコード（レベル・カテゴリ・呼び出し箇所・本文が一致）は出力先に渡さずに数えるだけにし、
+/// 別のレコードが来た時・Flush時・集約が一定時間続いた時に "Last message repeated N times" の要約を1件出力する
+/// 毎フレーム同じ警告が出続けるようなログの嵐でも、出力先の負荷を一定に抑えつつ発生したこと自体は残す
+/// </summary>
+class DedupSink : public ILogSink {
+public:
+    /// <summary>
+    /// コンストラクタ
+    /// </summary>
+    /// <param name="inner">実際の出力先</param>
+    /// <param name="summaryInterval">集約が続いている間に要約を出力する間隔</param>
+    explicit DedupSink(std::unique_ptr<ILogSink> inner,
+                       std::chrono::milliseconds summaryInterval = std::chrono::seconds(5));
+    ~DedupSink() override;
+
+    /// <summary>
+    /// ログメッセージを出力（直前と同じ場合は数えるだけ）
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    void Write(const LogMessage& message) override;
+
+    /// <summary>
+    /// 保留中の要約を出力してから出力先をフラッシュ
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// クラッシュ時に内側のSinkのバッファを書き出す（集約中の件数の要約は出力しない）
+    /// </summary>
+    /// <returns>内側のSinkが返すファイルディスクリプタ</returns>
+    int EmergencyFlush() noexcept override { return m_inner ? m_inner->EmergencyFlush() : -1; }
+
+    /// <summary>
+    /// 実際の出力先を取得
+    /// </summary>
+    /// <returns>出力先のSink</returns>
+    ILogSink* GetInner() const { return m_inner.get(); }
+
+    /// <summary>
+    /// これまでに集約（出力を省略）したレコード数を取得
+    /// </summary>
+    /// <returns>省略したレコード数</returns>
+    uint64_t GetSuppressedCount() const;
+
+private:
+    /// <summary>
+    /// 直前のレコードと同じかどうかを判定
+    /// </summary>
+    bool IsRepeat(const LogMessage& message) const;
+
+    /// <summary>
+    /// 保留中の要約を出力先に渡す
+    /// </summary>
+    void WriteSummary();
+
+    std::unique_ptr<ILogSink> m_inner;                          // 実際の出力先
+    std::chrono::milliseconds m_summaryInterval;                // 集約中に要約を出力する間隔
+    mutable std::mutex m_mutex;                                 // スレッドセーフのためのミューテックス
+
+    // 直前に出力したレコード（要約の出力にも使う）
+    bool m_hasLast = false;
+    LogLevel m_lastLevel = LogLevel::Info;
+    std::string m_lastCategory;                                 // カテゴリ（レジストリ外のカテゴリにも備えてコピー）
+    const char* m_lastFile = "";                                // __FILE__リテラルを指す
+    int m_lastLine = 0;
+    std::string m_lastText;                                     // 本文
+    std::string m_lastFields;                                   // 構造化フィールド（エンコード済みのバイト列）
+
+    uint64_t m_repeatCount = 0;                                 // 要約していない繰り返し回数
+    std::chrono::system_clock::time_point m_repeatStart{};      // 集約を始めた（または前回要約した）時刻
+    std::chrono::system_clock::time_point m_repeatLast{};       // 最後に繰り返した時刻
+    std::thread::id m_repeatThread{};                           // 最後に繰り返したスレッド
+    uint64_t m_suppressedTotal = 0;                             // 省略したレコードの累計
+};
+
+} // namespace RenderingSandbox
@@ -1,15 +1,27 @@
 #pragma once
 
 #include "LogSink.h"
-#include <fstream>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 namespace RenderingSandbox {
 
 /// <summary>
 /// ファイル出力Sink
 /// ログをファイルに書き込む（RAII原則に基づいた自動クローズ）
+/// 既定では1レコードごとに書き込むが、バッファリングモードではユーザー空間のバッファに溜めて
+/// 満杯時・一定間隔ごと・Error以上のレコード時にまとめて1回のwriteで書き込む
+/// （一定間隔ごとの書き出しは、新しい書き込みがなくてもバックグラウンドのスレッドが行う）
+/// ローテーションは書き込みスレッドでは現在のファイルの退避（リネーム1回）と新しいファイルのオープンだけを行い、
+/// 世代のリネームと圧縮はバックグラウンドのスレッドで行う
+/// 行末はWindowsではCRLF、それ以外ではLF
 /// </summary>
 class FileSink : public ILogSink {
 public:
@@ -33,6 +45,12 @@ class FileSink : public ILogSink {
     /// </summary>
     void Flush() override;
 
+    /// <summary>
+    /// クラッシュ時にバッファ内のレコードをロックせずに書き出す
+    /// </summary>
+    /// <returns>ログファイルのファイルディスクリプタ（開いていない場合は-1）</returns>
+    int EmergencyFlush() noexcept override;
+
     /// <summary>
     /// ログファイルのパスを取得
     /// </summary>
@@ -69,18 +87,169 @@ class FileSink : public ILogSink {
     /// <returns>最大世代数</returns>
     size_t GetMaxFiles() const { return m_maxFiles; }
 
+    /// <summary>
+    /// バッファリングモードの有効/無効を設定
+    /// 無効にする場合はバッファ内のレコードを書き出してから切り替える
+    /// </summary>
+    /// <param name="enabled">有効にする場合true</param>
+    /// <param name="bufferSize">バッファサイズ（バイト、ページ境界に整列して確保）</param>
+    void SetBuffered(bool enabled, size_t bufferSize = kDefaultBufferSize);
+
+    /// <summary>
+    /// バッファリングモードが有効かどうかを取得
+    /// </summary>
+    /// <returns>有効な場合true</returns>
+    bool IsBuffered() const { return m_buffered; }
+
+    /// <summary>
+    /// バッファリングモードで、前回の書き出しからこの時間が経過したら書き出す
+    /// 書き込みが途絶えてもバックグラウンドのスレッドが書き出すため、バッファに残る時間はおおむねこの間隔以内になる
+    /// </summary>
+    /// <param name="interval">書き出し間隔</param>
+    void SetFlushInterval(std::chrono::milliseconds interval);
+
+    /// <summary>
+    /// 書き出し間隔を取得
+    /// </summary>
+    /// <returns>書き出し間隔</returns>
+    std::chrono::milliseconds GetFlushInterval() const;
+
+    /// <summary>
+    /// 時間によるローテーションの間隔を設定（0で無効、サイズによるローテーションと併用できる）
+    /// </summary>
+    /// <param name="interval">ローテーション間隔（ファイルを開いてからの経過時間）</param>
+    void SetRotationInterval(std::chrono::seconds interval) { m_rotationInterval = interval; }
+
+    /// <summary>
+    /// 時間によるローテーションの間隔を取得
+    /// </summary>
+    /// <returns>ローテーション間隔（0は無効）</returns>
+    std::chrono::seconds GetRotationInterval() const { return m_rotationInterval; }
+
+    /// <summary>
+    /// ローテーションした世代をgzip圧縮するかを設定（.log.1.gz のように保存される）
+    /// </summary>
+    /// <param name="enabled">圧縮する場合true</param>
+    void SetCompressRotated(bool enabled) { m_compressRotated = enabled; }
+
+    /// <summary>
+    /// ローテーションした世代をgzip圧縮するかを取得
+    /// </summary>
+    /// <returns>圧縮する場合true</returns>
+    bool IsCompressRotated() const { return m_compressRotated; }
+
+    /// <summary>
+    /// バックグラウンドのローテーション処理（世代のリネーム・圧縮）がすべて終わるまで待つ
+    /// </summary>
+    void WaitForRotation();
+
+    /// <summary>
+    /// バッファリングモードの既定バッファサイズ
+    /// </summary>
+    static constexpr size_t kDefaultBufferSize = 256 * 1024;
+
+protected:
+    /// <summary>
+    /// 1レコード分の行（改行を除く）を整形する。既定ではこのSinkのパターンで整形する
+    /// 派生クラスで出力形式を変える場合にオーバーライドする（書き込み中のミューテックスを取得した状態で呼ばれる）
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <returns>整形結果（次の呼び出しまで有効）</returns>
+    virtual std::string_view FormatLine(const LogMessage& message) { return FormatRecord(message); }
+
 private:
+    // ページ境界に整列したバッファの解放用
+    struct AlignedDeleter {
+        void operator()(char* buffer) const;
+    };
+
+    // バックグラウンドで行うローテーション処理
+    struct RotationJob {
+        std::filesystem::path pendingPath;  // 退避したファイル
+        size_t maxFiles;                    // 最大世代数
+        bool compress;                      // 圧縮するかどうか
+    };
+
     /// <summary>
-    /// ファイルサイズをチェックし、必要に応じてローテーション
+    /// ファイルサイズと経過時間をチェックし、必要に応じてローテーション
     /// </summary>
     void CheckAndRotate();
 
+    /// <summary>
+    /// バックグラウンドスレッドのメインループ（ローテーション処理と、バッファリングモードの定期書き出し）
+    /// </summary>
+    void BackgroundLoop();
+
+    /// <summary>
+    /// 前回の書き出しから書き出し間隔が経過していればバッファを書き出す
+    /// </summary>
+    /// <returns>次に確認するまでの時間</returns>
+    std::chrono::steady_clock::duration FlushIfDue();
+
+    /// <summary>
+    /// 定期書き出しの設定をバックグラウンドスレッドに反映する（m_mutexを取得した状態で呼ぶ）
+    /// 必要ならバックグラウンドスレッドを起動する
+    /// </summary>
+    void UpdateFlushTimer();
+
+    /// <summary>
+    /// 世代をずらして退避したファイルを .1 にし、必要なら圧縮する
+    /// </summary>
+    void ProcessRotation(const RotationJob& job);
+
+    /// <summary>
+    /// ログファイルを開く
+    /// </summary>
+    /// <param name="truncate">trueの場合は既存の内容を破棄</param>
+    void OpenFile(bool truncate);
+
+    /// <summary>
+    /// ログファイルを閉じる（バッファは書き出さない）
+    /// </summary>
+    void CloseFile();
+
+    /// <summary>
+    /// バッファ内のレコードを1回のwriteで書き出す
+    /// </summary>
+    void FlushBuffer();
+
+    /// <summary>
+    /// ファイルに直接書き込む（部分書き込みの場合は残りを書き込み続ける）
+    /// </summary>
+    void WriteToFile(const char* data, size_t size);
+
+    /// <summary>
+    /// バッファを確保し直す
+    /// </summary>
+    void AllocateBuffer(size_t bufferSize);
+
     std::filesystem::path m_filePath;       // ログファイルのパス
-    std::ofstream m_file;                   // ファイルストリーム
-    size_t m_currentSize;                   // 現在のファイルサイズ
+    int m_fd;                               // ファイルディスクリプタ（開いていない場合は-1）
+    size_t m_currentSize;                   // 現在のファイルサイズ（バッファ内の未書き出し分も含む）
     size_t m_maxFileSize;                   // 最大ファイルサイズ（デフォルト10MB）
     size_t m_maxFiles;                      // 最大世代数（デフォルト5）
-    std::mutex m_mutex;                     // スレッドセーフのためのミューテックス
+    mutable std::mutex m_mutex;             // スレッドセーフのためのミューテックス
+
+    // バッファリング
+    std::unique_ptr<char[], AlignedDeleter> m_buffer;                   // 書き込みバッファ
+    size_t m_bufferCapacity;                                            // バッファサイズ
+    size_t m_bufferUsed;                                                // バッファ内の未書き出しバイト数
+    bool m_buffered;                                                    // バッファリングモードかどうか
+    std::chrono::milliseconds m_flushInterval;                          // 書き出し間隔（デフォルト1秒）
+    std::chrono::steady_clock::time_point m_lastFlushTime;              // 前回書き出した時刻
+
+    // ローテーション
+    std::chrono::seconds m_rotationInterval;                            // 時間によるローテーション間隔（0は無効）
+    std::chrono::steady_clock::time_point m_openedTime;                 // 現在のファイルを開いた時刻
+    bool m_compressRotated;                                             // ローテーションした世代を圧縮するかどうか
+    uint64_t m_rotationSequence;                                        // 退避ファイル名の連番
+    std::thread m_rotationThread;                                       // バックグラウンドスレッド（初回のローテーション時かバッファリングモードの有効化時に起動）
+    std::mutex m_rotationMutex;                                         // ローテーション処理キューと定期書き出しの設定用のミューテックス
+    std::condition_variable m_rotationCondition;                        // ローテーション処理の投入・完了、定期書き出しの設定変更の通知
+    bool m_flushTimerEnabled;                                           // 定期書き出しを行うか（バッファリングモードの間）
+    std::deque<RotationJob> m_rotationJobs;                             // 未処理のローテーション
+    bool m_rotationBusy;                                                // ローテーション処理の実行中かどうか
+    bool m_rotationStop;                                                // ローテーション処理スレッドの停止要求
 };
 
 } // namespace RenderingSandbox
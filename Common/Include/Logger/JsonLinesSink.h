@@ -0,0 +1,48 @@
+#pragma once
+
+#include "FileSink.h"
+#include <string>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// JSON Lines形式のファイル出力Sink（1レコードを1行のJSONオブジェクトとして書き込む）
+/// 構造化フィールドは "fields" オブジェクトに型を保ったまま出力するため、jq等でそのまま集計できる
+/// 時間（LogFieldType::Duration）は単位を明示するため、キーに「_ns」を付けたナノ秒の整数で出力する（例: "frameTime_ns":16667000）
+/// 出力例: {"time":"12:34:56.789","timestamp_us":...,"level":"INFO","category":"DeviceInfo","file":"main.cpp","line":42,"message":"Adapter","fields":{"vendorId":4318}}
+/// ローテーション・バッファリング等の動作はFileSinkと同じ（SetPatternは使用しない）
+/// </summary>
+class JsonLinesSink : public FileSink {
+public:
+    /// <summary>
+    /// ファイルパスを指定してJsonLinesSinkを構築
+    /// </summary>
+    /// <param name="filePath">ログファイルのパス（拡張子は .jsonl を推奨）</param>
+    /// <param name="append">trueの場合は追記モード、falseの場合は上書きモード</param>
+    explicit JsonLinesSink(const std::filesystem::path& filePath, bool append = true)
+        : FileSink(filePath, append) {}
+
+    /// <summary>
+    /// 1レコードをJSONオブジェクト1行（改行なし）に整形（LogToolのJSON出力と共通）
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <param name="out">書き込み先（既存の内容は置き換え）</param>
+    static void FormatJson(const LogMessage& message, std::string& out);
+
+    /// <summary>
+    /// クラッシュ時にバッファ内のレコードを書き出す（テキストのクラッシュレポートはJSON Linesを壊すため追記させない）
+    /// </summary>
+    /// <returns>常に-1</returns>
+    int EmergencyFlush() noexcept override {
+        FileSink::EmergencyFlush();
+        return -1;
+    }
+
+protected:
+    std::string_view FormatLine(const LogMessage& message) override;
+
+private:
+    std::string m_lineBuffer;               // 整形先（FileSinkのミューテックスで保護される）
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// ログレコード用の小さなバイトバッファ
+/// InlineCapacityバイトまではインラインに保持し、収まらない場合のみヒープに確保する
+/// 使用するサイズはLogBuffer・LogFieldBufferの2種類（LogBuffer.cppで明示的にインスタンス化する）
+/// </summary>
+template <size_t InlineCapacity>
+class BasicLogBuffer {
+public:
+    /// <summary>
+    /// インラインに保持できるバイト数
+    /// </summary>
+    static constexpr size_t kInlineCapacity = InlineCapacity;
+
+    BasicLogBuffer() = default;
+    ~BasicLogBuffer() = default;
+
+    BasicLogBuffer(const BasicLogBuffer& other);
+    BasicLogBuffer& operator=(const BasicLogBuffer& other);
+    BasicLogBuffer(BasicLogBuffer&& other) noexcept;
+    BasicLogBuffer& operator=(BasicLogBuffer&& other) noexcept;
+
+    /// <summary>
+    /// 内容を破棄してsizeバイトの領域を確保
+    /// </summary>
+    /// <param name="size">確保するバイト数</param>
+    /// <returns>書き込み先の先頭</returns>
+    std::byte* Resize(size_t size);
+
+    /// <summary>
+    /// 文字列をコピーして保持
+    /// </summary>
+    /// <param name="text">コピーする文字列</param>
+    void Assign(std::string_view text);
+
+    /// <summary>
+    /// 既存の内容を保ったまま末尾に文字列を追加
+    /// </summary>
+    /// <param name="text">追加する文字列</param>
+    void Append(std::string_view text);
+
+    /// <summary>
+    /// 内容を破棄
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 先頭ポインタを取得
+    /// </summary>
+    /// <returns>保持しているバイト列の先頭</returns>
+    const std::byte* GetData() const { return m_heap ? m_heap.get() : m_inline.data(); }
+
+    /// <summary>
+    /// 保持しているバイト数を取得
+    /// </summary>
+    /// <returns>バイト数</returns>
+    size_t GetSize() const { return m_size; }
+
+    /// <summary>
+    /// 保持しているバイト列を文字列として取得
+    /// </summary>
+    /// <returns>文字列ビュー（このバッファが変更されるまで有効）</returns>
+    std::string_view GetView() const { return std::string_view(reinterpret_cast<const char*>(GetData()), m_size); }
+
+private:
+    std::array<std::byte, kInlineCapacity> m_inline{};      // インライン領域
+    std::unique_ptr<std::byte[]> m_heap;                    // インラインに収まらない場合の領域
+    size_t m_size = 0;                                      // 保持しているバイト数
+};
+
+extern template class BasicLogBuffer<192>;
+extern template class BasicLogBuffer<64>;
+
+/// <summary>
+/// メッセージ本文・遅延フォーマットの引数列用のバッファ
+/// </summary>
+using LogBuffer = BasicLogBuffer<192>;
+
+/// <summary>
+/// 構造化フィールド用のバッファ（フィールドを付けないレコードが大半のため、インライン領域を小さくしてレコードサイズを抑える）
+/// </summary>
+using LogFieldBuffer = BasicLogBuffer<64>;
+
+} // namespace RenderingSandbox
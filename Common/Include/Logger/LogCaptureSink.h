@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Logger.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 受け取ったレコードをメモリに保持するSink（テストでの出力確認、ImGuiのログウィンドウ等に使う）
+/// 保持するレコードは本文を確定させたコピーで、上限を超えると古いものから捨てる
+/// </summary>
+class LogCaptureSink : public ILogSink {
+public:
+    /// <summary>
+    /// コンストラクタ
+    /// </summary>
+    /// <param name="maxRecords">保持するレコード数の上限</param>
+    explicit LogCaptureSink(size_t maxRecords = 4096);
+    ~LogCaptureSink() override = default;
+
+    /// <summary>
+    /// レコードを保持
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    void Write(const LogMessage& message) override;
+
+    /// <summary>
+    /// 保持しているレコードのコピーを取得（古い順）
+    /// </summary>
+    /// <returns>レコードの一覧</returns>
+    std::vector<LogMessage> GetMessages() const;
+
+    /// <summary>
+    /// 保持しているレコードを取り出して空にする（古い順）
+    /// </summary>
+    /// <returns>レコードの一覧</returns>
+    std::vector<LogMessage> TakeMessages();
+
+    /// <summary>
+    /// 保持しているレコード数を取得
+    /// </summary>
+    /// <returns>レコード数</returns>
+    size_t GetCount() const;
+
+    /// <summary>
+    /// 上限を超えて捨てたレコード数を取得
+    /// </summary>
+    /// <returns>捨てたレコード数</returns>
+    size_t GetDroppedCount() const;
+
+    /// <summary>
+    /// 保持しているレコードを破棄
+    /// </summary>
+    void Clear();
+
+private:
+    size_t m_maxRecords;                        // 保持するレコード数の上限
+    std::vector<LogMessage> m_records;          // 保持しているレコード（m_headから古い順に並ぶリングバッファ）
+    size_t m_head = 0;                          // 最古のレコードの位置（上限に達した後のみ使う）
+    size_t m_dropped = 0;                       // 捨てたレコード数
+    mutable std::mutex m_mutex;                 // スレッドセーフのためのミューテックス
+};
+
+/// <summary>
+/// スコープの間だけLoggerにキャプチャ用Sinkを取り付ける
+/// ログ出力中のスレッドを止めずに取り付け・取り外しができる（取り外し時は配信済みのレコードまでを保持）
+/// 使用例:
+///   ScopedLogCapture capture;
+///   RunSomething();
+///   auto messages = capture.GetSink().TakeMessages();
+/// </summary>
+class ScopedLogCapture {
+public:
+    /// <summary>
+    /// コンストラクタ（Logger::GetInstance()にSinkを取り付ける）
+    /// </summary>
+    /// <param name="minLevel">キャプチャする最小ログレベル</param>
+    /// <param name="maxRecords">保持するレコード数の上限</param>
+    explicit ScopedLogCapture(LogLevel minLevel = LogLevel::Trace, size_t maxRecords = 4096);
+
+    /// <summary>
+    /// デストラクタ（保留中のレコードを配信してからSinkを取り外す）
+    /// </summary>
+    ~ScopedLogCapture();
+
+    // コピー・ムーブ禁止
+    ScopedLogCapture(const ScopedLogCapture&) = delete;
+    ScopedLogCapture& operator=(const ScopedLogCapture&) = delete;
+
+    /// <summary>
+    /// キャプチャ用Sinkを取得
+    /// 非同期モード・スレッドごとのバッファリングモードでは、Logger::Flush()を呼ぶまで届いていないレコードがある
+    /// </summary>
+    /// <returns>キャプチャ用Sink</returns>
+    LogCaptureSink& GetSink() const { return *m_sink; }
+
+private:
+    std::shared_ptr<LogCaptureSink> m_sink;     // キャプチャ用Sink
+    LogSinkHandle m_handle;                     // 取り外し用のハンドル
+};
+
+} // namespace RenderingSandbox
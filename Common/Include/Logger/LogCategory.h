@@ -0,0 +1,133 @@
+#pragma once
+
+#include "LogLevel.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// カテゴリハンドル（LogCategoryRegistryが払い出すインデックス）
+/// </summary>
+using LogCategoryId = uint16_t;
+
+/// <summary>
+/// カテゴリ名をインターンし、カテゴリごとの実効最小ログレベルを保持するレジストリ
+/// 実効レベルはアトミックな配列で公開するため、フィルタ判定はロックなしの1回のロードで済む
+/// 登録・レベル変更は稀なのでミューテックスで保護する
+/// </summary>
+class LogCategoryRegistry {
+public:
+    /// <summary>
+    /// 登録できるカテゴリの最大数
+    /// </summary>
+    static constexpr size_t kMaxCategories = 1024;
+
+    /// <summary>
+    /// カテゴリ指定なし（空文字列）を表すハンドル
+    /// </summary>
+    static constexpr LogCategoryId kDefaultCategory = 0;
+
+    /// <summary>
+    /// 上限を超えて登録できなかったカテゴリを表すハンドル
+    /// 名前は空、レベルは常にグローバルレベルに追従し、SetLevel/ClearLevelは無視される
+    /// </summary>
+    static constexpr LogCategoryId kInvalidCategory = static_cast<LogCategoryId>(kMaxCategories);
+
+    LogCategoryRegistry();
+    ~LogCategoryRegistry() = default;
+
+    // コピー・ムーブ禁止
+    LogCategoryRegistry(const LogCategoryRegistry&) = delete;
+    LogCategoryRegistry& operator=(const LogCategoryRegistry&) = delete;
+
+    /// <summary>
+    /// カテゴリを登録してハンドルを取得（登録済みの場合は既存のハンドルを返す）
+    /// 上限を超えた場合はkInvalidCategoryを返す
+    /// </summary>
+    /// <param name="name">カテゴリ名</param>
+    /// <returns>カテゴリハンドル</returns>
+    LogCategoryId Register(std::string_view name);
+
+    /// <summary>
+    /// カテゴリ名を取得（レジストリが保持する文字列への参照、ロックなし）
+    /// 未登録のハンドルとkInvalidCategoryには空文字列を返す
+    /// </summary>
+    /// <param name="id">カテゴリハンドル</param>
+    /// <returns>カテゴリ名</returns>
+    const std::string& GetName(LogCategoryId id) const {
+        // 登録数はカテゴリ名を書き込んだ後にreleaseで公開されるため、これ未満のハンドルの名前は読める
+        return id < m_count.load(std::memory_order_acquire) ? m_names[id] : m_names[kInvalidCategory];
+    }
+
+    /// <summary>
+    /// 登録済みのカテゴリ数を取得（有効なハンドルはこれ未満）
+    /// </summary>
+    /// <returns>カテゴリ数（kDefaultCategoryを含む）</returns>
+    size_t GetCount() const;
+
+    /// <summary>
+    /// カテゴリの実効最小ログレベルを取得（ロックなし）
+    /// </summary>
+    /// <param name="id">カテゴリハンドル</param>
+    /// <returns>実効最小ログレベル</returns>
+    LogLevel GetMinLevel(LogCategoryId id) const {
+        return m_minLevels[id].load(std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// カテゴリ名から実効最小ログレベルを検索（未登録の場合はグローバルレベル）
+    /// </summary>
+    /// <param name="name">カテゴリ名</param>
+    /// <returns>実効最小ログレベル</returns>
+    LogLevel FindMinLevel(std::string_view name) const;
+
+    /// <summary>
+    /// グローバル最小ログレベルを設定（個別設定のないカテゴリに反映）
+    /// </summary>
+    /// <param name="level">グローバル最小ログレベル</param>
+    void SetGlobalLevel(LogLevel level);
+
+    /// <summary>
+    /// グローバル最小ログレベルを取得
+    /// </summary>
+    /// <returns>グローバル最小ログレベル</returns>
+    LogLevel GetGlobalLevel() const { return m_globalLevel.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// カテゴリ固有の最小ログレベルを設定（kInvalidCategoryの場合は何もしない）
+    /// </summary>
+    /// <param name="id">カテゴリハンドル</param>
+    /// <param name="level">最小ログレベル</param>
+    void SetLevel(LogCategoryId id, LogLevel level);
+
+    /// <summary>
+    /// カテゴリ固有の最小ログレベルをクリア（グローバルレベルに戻す、kInvalidCategoryの場合は何もしない）
+    /// </summary>
+    /// <param name="id">カテゴリハンドル</param>
+    void ClearLevel(LogCategoryId id);
+
+private:
+    // string_viewで検索するための透過的ハッシュ
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    // 末尾の1要素はkInvalidCategory用（ロックなしで参照できるよう常に有効な値を置く）
+    std::array<std::atomic<LogLevel>, kMaxCategories + 1> m_minLevels;          // カテゴリごとの実効最小レベル
+    std::array<std::string, kMaxCategories + 1> m_names;                        // カテゴリ名（登録後は不変）
+    std::array<bool, kMaxCategories + 1> m_hasOverride;                         // 個別設定があるかどうか
+    std::unordered_map<std::string, LogCategoryId, NameHash, std::equal_to<>> m_ids; // カテゴリ名→ハンドル
+    std::atomic<size_t> m_count;                                                // 登録済みカテゴリ数（名前を書き込んだ後に更新）
+    std::atomic<LogLevel> m_globalLevel;                                        // グローバル最小レベル
+    mutable std::shared_mutex m_mutex;                                          // 登録・設定変更の保護
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "LogLevel.h"
+#include <cstddef>
+#include <string_view>
+
+// ==================================================
+// コンパイル時のログレベルしきい値
+// しきい値より低いレベルのLOG_*マクロはコンパイル時に取り除かれ、引数の評価も含めてコードが生成されない
+//
+// LOG_COMPILE_MIN_LEVEL（プリプロセッサ定義で上書き可能）
+//   0=Trace 1=Debug 2=Info 3=Warning 4=Error 5=Fatal 6=Off
+//   既定はデバッグビルドでTrace、それ以外ではOff（従来どおりリリースビルドではログなし）
+//   例: プロファイル用のリリースビルドで /DLOG_COMPILE_MIN_LEVEL=3 とするとWarning以上のみ残る
+//
+// LOG_COMPILE_CATEGORY_LEVELS（任意）
+//   カテゴリ別のしきい値（グローバルのしきい値を上書き）を { "カテゴリ", レベル } の並びで定義する
+//   例: #define LOG_COMPILE_CATEGORY_LEVELS { "Renderer", ::RenderingSandbox::LogLevel::Warning }, { "D3D12", ::RenderingSandbox::LogLevel::Trace },
+// ==================================================
+
+#ifndef LOG_COMPILE_MIN_LEVEL
+    #ifdef _DEBUG
+        #define LOG_COMPILE_MIN_LEVEL 0
+    #else
+        #define LOG_COMPILE_MIN_LEVEL 6
+    #endif
+#endif
+
+// いずれかのレベル・カテゴリのログが残る可能性があるか
+#if LOG_COMPILE_MIN_LEVEL <= 5 || defined(LOG_COMPILE_CATEGORY_LEVELS)
+    #define LOG_ENABLED 1
+#else
+    #define LOG_ENABLED 0
+#endif
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// コンパイル時に決まるカテゴリ名（LOG_*マクロとLogger::Log等のカテゴリ引数）
+/// カテゴリは一度登録すると解放されず登録数にも上限があるため、実行時に組み立てた文字列は受け付けない
+/// 実行時に決まるカテゴリはLogger::RegisterCategoryで得たハンドルを使う
+/// </summary>
+class LogCategoryName {
+public:
+    template <size_t N>
+    consteval LogCategoryName(const char (&name)[N]) : m_name(name, N - 1) {}
+    consteval LogCategoryName(std::string_view name) : m_name(name) {}
+
+    constexpr std::string_view Get() const { return m_name; }
+    constexpr operator std::string_view() const { return m_name; }
+
+private:
+    std::string_view m_name;        // 静的記憶域の文字列を指す
+};
+
+/// <summary>
+/// カテゴリ別のコンパイル時しきい値
+/// </summary>
+struct LogCompileCategoryLevel {
+    std::string_view category;      // カテゴリ名
+    int minLevel;                   // このカテゴリのしきい値（LOG_COMPILE_MIN_LEVELと同じ数値）
+
+    constexpr LogCompileCategoryLevel(std::string_view name, LogLevel level)
+        : category(name), minLevel(static_cast<int>(level)) {}
+    constexpr LogCompileCategoryLevel(std::string_view name, int level)
+        : category(name), minLevel(level) {}
+};
+
+/// <summary>
+/// カテゴリ別のコンパイル時しきい値の一覧（末尾は番兵）
+/// </summary>
+inline constexpr LogCompileCategoryLevel kLogCompileCategoryLevels[] = {
+#ifdef LOG_COMPILE_CATEGORY_LEVELS
+    LOG_COMPILE_CATEGORY_LEVELS
+#endif
+    { std::string_view(), LOG_COMPILE_MIN_LEVEL }
+};
+
+/// <summary>
+/// カテゴリ別しきい値の一覧からカテゴリのしきい値を検索（最初に一致した要素を使う）
+/// </summary>
+/// <param name="table">カテゴリ別しきい値の一覧（categoryがnullの要素は番兵として読み飛ばす）</param>
+/// <param name="category">カテゴリ名（定数式）</param>
+/// <param name="defaultLevel">一致しない場合のしきい値</param>
+/// <returns>しきい値（LOG_COMPILE_MIN_LEVELと同じ数値）</returns>
+template <size_t N>
+constexpr int FindLogCompileMinLevel(const LogCompileCategoryLevel (&table)[N], std::string_view category, int defaultLevel) {
+    for (const LogCompileCategoryLevel& entry : table) {
+        if (entry.category.data() != nullptr && entry.category == category) {
+            return entry.minLevel;
+        }
+    }
+    return defaultLevel;
+}
+
+/// <summary>
+/// 指定したカテゴリのコンパイル時しきい値を取得
+/// </summary>
+/// <param name="category">カテゴリ名</param>
+/// <returns>しきい値（LOG_COMPILE_MIN_LEVELと同じ数値）</returns>
+constexpr int LogCompileMinLevel(LogCategoryName category) {
+    return FindLogCompileMinLevel(kLogCompileCategoryLevels, category, LOG_COMPILE_MIN_LEVEL);
+}
+
+/// <summary>
+/// 指定したレベル・カテゴリのログがコンパイル時に残るかを判定（LOG_*マクロのif constexprで使う）
+/// </summary>
+/// <param name="level">ログレベル</param>
+/// <param name="category">カテゴリ名</param>
+/// <returns>残る場合true</returns>
+constexpr bool LogIsCompiledIn(LogLevel level, LogCategoryName category) {
+    return static_cast<int>(level) >= LogCompileMinLevel(category);
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// データをgzip形式（deflate、固定ハフマン符号 + LZ77）で圧縮する
+/// 外部ライブラリに依存しない簡易実装で、ローテーション済みログの圧縮に使う
+/// 繰り返しの多いテキストログでは数分の1程度に縮む（zlibの既定レベルよりは劣る）
+/// </summary>
+/// <param name="data">圧縮するデータ</param>
+/// <param name="out">gzipストリームの書き込み先（内容は置き換え）</param>
+void LogGzipCompress(std::string_view data, std::string& out);
+
+/// <summary>
+/// ファイルをgzip形式で圧縮して別のファイルに書き込む
+/// </summary>
+/// <param name="source">圧縮するファイル</param>
+/// <param name="destination">書き込み先（既存の場合は上書き）</param>
+/// <returns>成功した場合true</returns>
+bool LogGzipCompressFile(const std::filesystem::path& source, const std::filesystem::path& destination);
+
+} // namespace RenderingSandbox
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "LogMessage.h"
+#include <cstddef>
+#include <string_view>
+
+namespace RenderingSandbox {
+
+class ILogSink;
+
+/// <summary>
+/// クラッシュ時に配信前のログを書き出すハンドラ
+/// SIGSEGV/SIGABRT/SIGBUS/SIGILL/SIGFPE（Windowsでは未処理の構造化例外とSIGABRT）を捕捉し、
+/// 非同期シグナル安全な処理（ロック・ヒープ確保なし、writeのみ）で次の順に出力してから既定の動作に戻す
+///   1. 各Sinkのバッファ内の未書き出しレコード（ILogSink::EmergencyFlush）
+///   2. クラッシュの理由
+///   3. 非同期キュー・スレッドごとのバッファに残っている配信前のレコード
+///   4. バックトレース
+/// 2〜4はEmergencyFlushがファイルディスクリプタを返したSink（FileSinkのログファイル、ConsoleSinkの標準エラー出力）へ書き込む
+/// 使用例: Sinkを登録した後に LogCrashHandler::Install(); を呼ぶ
+/// </summary>
+class LogCrashHandler {
+public:
+    /// <summary>
+    /// シグナルハンドラを登録（既存のハンドラは保存され、処理後に呼び出される）
+    /// POSIXではスタックオーバーフローでも動作するよう代替スタックを使用する
+    /// 代替スタックはスレッドごとの設定のため、ここでは呼び出したスレッドにのみ設定される
+    /// 他のスレッドにはLogger::SetThreadStartHookに登録したInstallThreadAltStackが、Logger::OnThreadStartの呼び出し時に設定する
+    /// ローカル時刻の時差はここで取得する（以降のサマータイムの切り替えは反映されない）
+    /// </summary>
+    /// <returns>登録できた場合true</returns>
+    static bool Install();
+
+    /// <summary>
+    /// 呼び出しスレッドに代替スタックを設定（POSIXのみ、Windowsでは何もしない）
+    /// ワーカースレッドのスタックオーバーフローもクラッシュレポートに残すため、スレッドの開始時に呼ぶ（通常はLogger::OnThreadStart経由）
+    /// ハンドラが登録されていない場合・既に設定されている場合は何もしない。設定した代替スタックはスレッドの終了時に解除して解放する
+    /// </summary>
+    static void InstallThreadAltStack();
+
+    /// <summary>
+    /// シグナルハンドラの登録を解除し、保存していたハンドラに戻す（Loggerの終了処理の前に呼ぶ）
+    /// 以降に開始するスレッドには代替スタックを設定しない
+    /// </summary>
+    static void Uninstall();
+
+    /// <summary>
+    /// シグナルハンドラが登録されているかどうかを取得
+    /// </summary>
+    /// <returns>登録されている場合true</returns>
+    static bool IsInstalled();
+
+    /// <summary>
+    /// クラッシュレポートを書き出す（シグナルハンドラから呼ばれる。致命的な状態の検出時に直接呼んでもよい）
+    /// </summary>
+    /// <param name="reason">クラッシュの理由（例: "SIGSEGV at 0x0000000000000010"）</param>
+    static void WriteReport(std::string_view reason) noexcept;
+
+    /// <summary>
+    /// 指定したSinkにだけクラッシュレポートを書き出す（Loggerに登録されたSinkには書き込まない）
+    /// 配信前のレコードはLoggerから集める。動作確認など、アプリのログに偽のレポートを残したくない場合に使う
+    /// </summary>
+    /// <param name="reason">クラッシュの理由</param>
+    /// <param name="sinks">書き出し先のSink</param>
+    /// <param name="count">Sinkの数</param>
+    static void WriteReport(std::string_view reason, ILogSink* const* sinks, size_t count) noexcept;
+
+    /// <summary>
+    /// レコードを非同期シグナル安全に1行のテキストへ整形（改行付き、収まらない場合は切り詰める）
+    /// 形式はLogMessage::Formatと同じ。ただし遅延フォーマットのレコードは引数を既定の表記で埋め込み（幅・精度などの書式指定は無視）、
+    /// 構造化フィールドは簡略表記（時間はナノ秒、文字列はエスケープせず引用符で囲む）になる
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <param name="buffer">書き込み先</param>
+    /// <param name="capacity">書き込み先のバイト数</param>
+    /// <returns>書き込んだバイト数</returns>
+    static size_t FormatRecord(const LogMessage& message, char* buffer, size_t capacity) noexcept;
+
+    /// <summary>
+    /// ファイルディスクリプタへすべて書き込む（部分書き込み・割り込みの場合は続きを書き込む、非同期シグナル安全）
+    /// </summary>
+    /// <param name="fd">ファイルディスクリプタ</param>
+    /// <param name="data">書き込むデータ</param>
+    /// <param name="size">バイト数</param>
+    /// <returns>すべて書き込めた場合true</returns>
+    static bool WriteAll(int fd, const void* data, size_t size) noexcept;
+};
+
+} // namespace RenderingSandbox
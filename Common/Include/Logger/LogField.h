@@ -0,0 +1,134 @@
+#pragma once
+
+#include "LogBuffer.h"
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 構造化フィールドの値の種類
+/// </summary>
+enum class LogFieldType : uint8_t {
+    Bool,
+    Int,            // 符号付き整数（int64_t）
+    UInt,           // 符号なし整数（uint64_t）
+    Float,          // 浮動小数点数（double）
+    String,         // 文字列（レコードにコピーされる）
+    Duration        // 時間（ナノ秒のint64_t）
+};
+
+/// <summary>
+/// レコードに付けるキーと型付きの値の組（LOG_*_KVマクロ・Logger::LogFieldsに渡す）
+/// キーと文字列の値は参照するだけで、レコードに積む時（EncodeLogFields）にコピーされる
+/// 使用例: { "vendorId", desc.VendorId }, { "frameTime", std::chrono::microseconds(16667) }
+/// </summary>
+struct LogField {
+    std::string_view key;                   // キー
+    LogFieldType type = LogFieldType::Int;  // 値の種類
+    union {
+        bool boolValue;
+        int64_t intValue;                   // Int・Duration（ナノ秒）
+        uint64_t uintValue;
+        double floatValue;
+    };
+    std::string_view stringValue{};         // String
+
+    LogField(std::string_view name, bool value) : key(name), type(LogFieldType::Bool), boolValue(value) {}
+
+    template <std::signed_integral T>
+    LogField(std::string_view name, T value) : key(name), type(LogFieldType::Int), intValue(value) {}
+
+    template <std::unsigned_integral T>
+        requires (!std::same_as<T, bool>)
+    LogField(std::string_view name, T value) : key(name), type(LogFieldType::UInt), uintValue(value) {}
+
+    template <std::floating_point T>
+    LogField(std::string_view name, T value) : key(name), type(LogFieldType::Float), floatValue(static_cast<double>(value)) {}
+
+    LogField(std::string_view name, std::string_view value) : key(name), type(LogFieldType::String), intValue(0), stringValue(value) {}
+    LogField(std::string_view name, const char* value) : LogField(name, std::string_view(value)) {}
+    LogField(std::string_view name, const std::string& value) : LogField(name, std::string_view(value)) {}
+
+    template <class Rep, class Period>
+    LogField(std::string_view name, std::chrono::duration<Rep, Period> value)
+        : key(name), type(LogFieldType::Duration)
+        , intValue(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count()) {}
+};
+
+/// <summary>
+/// レコードから読み出したフィールド（文字列はレコードのバッファを指す）
+/// </summary>
+struct LogFieldView {
+    std::string_view key;
+    LogFieldType type = LogFieldType::Int;
+    union {
+        bool boolValue;
+        int64_t intValue;
+        uint64_t uintValue;
+        double floatValue;
+    };
+    std::string_view stringValue{};
+
+    LogFieldView() : intValue(0) {}
+};
+
+/// <summary>
+/// フィールドをバッファにシリアライズ（既存の内容は置き換え）
+/// 形式: [種類 1バイト][キー長 1バイト][キー][値: 数値は8バイト、文字列は長さ4バイト + 本体] の繰り返し
+/// 合計サイズを先に求めて一度だけ確保するため、インライン領域に収まる場合はヒープ確保しない
+/// </summary>
+/// <param name="buffer">書き込み先</param>
+/// <param name="fields">フィールドの並び</param>
+/// <param name="count">フィールド数</param>
+void EncodeLogFields(LogFieldBuffer& buffer, const LogField* fields, size_t count);
+
+/// <summary>
+/// EncodeLogFieldsで作ったバッファからフィールドを順に読み出す
+/// 使用例: LogFieldReader reader(message.fields); LogFieldView field; while (reader.Next(field)) { ... }
+/// </summary>
+class LogFieldReader {
+public:
+    explicit LogFieldReader(const LogFieldBuffer& buffer)
+        : m_cursor(buffer.GetData()), m_end(buffer.GetData() + buffer.GetSize()) {}
+
+    /// <summary>
+    /// 次のフィールドを読み出す
+    /// </summary>
+    /// <param name="field">読み出し先</param>
+    /// <returns>読み出せた場合true、末尾に達した（または壊れていた）場合false</returns>
+    bool Next(LogFieldView& field);
+
+private:
+    const std::byte* m_cursor;
+    const std::byte* m_end;
+};
+
+/// <summary>
+/// 時間を単位付きの小数点以下3桁で追記（例: 850ns, 16.667ms, 2.500s）
+/// </summary>
+/// <param name="out">追記先</param>
+/// <param name="nanoseconds">時間（ナノ秒）</param>
+void AppendLogDuration(std::string& out, int64_t nanoseconds);
+
+/// <summary>
+/// フィールドを「key=value」形式で空白区切りにして追記（テキスト出力用）
+/// 空白・'='・'"'を含む文字列や空文字列は二重引用符で囲む。時間は単位付き（例: 16.667ms）
+/// </summary>
+/// <param name="out">追記先</param>
+/// <param name="fields">EncodeLogFieldsで作ったバッファ</param>
+void AppendLogFieldsText(std::string& out, const LogFieldBuffer& fields);
+
+/// <summary>
+/// フィールドをJSONオブジェクトのメンバー（"key":value の並び、波括弧なし）として追記
+/// 時間はキーに「_ns」を付けたナノ秒の整数で出力する（例: "frameTime_ns":16667000）
+/// </summary>
+/// <param name="out">追記先</param>
+/// <param name="fields">EncodeLogFieldsで作ったバッファ</param>
+void AppendLogFieldsJson(std::string& out, const LogFieldBuffer& fields);
+
+} // namespace RenderingSandbox
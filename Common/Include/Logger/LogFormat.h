@@ -0,0 +1,169 @@
+#pragma once
+
+#include "LogBuffer.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 引数バッファをデコードしてメッセージ本文を生成する関数
+/// </summary>
+using LogFormatFunction = void (*)(std::string_view format, const LogBuffer& args, std::string& out);
+
+/// <summary>
+/// シリアライズ済みフォーマット引数の型情報（バイナリ出力でテキスト化せずに保存するため）
+/// </summary>
+enum class LogArgKind : uint8_t {
+    End = 0,        // 終端
+    Bool,
+    Char,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float,
+    Double,
+    String,         // 長さ(uint32) + バイト列
+    Pointer,
+    Opaque          // 上記以外（型を復元できないためテキスト化が必要）
+};
+
+namespace LogFormatDetail {
+
+    // 文字列系の引数は「長さ + バイト列」として、それ以外は値のままコピーする
+    template <class T>
+    inline constexpr bool kIsString = std::is_convertible_v<const T&, std::string_view>;
+
+    template <class T>
+    using Decoded = std::conditional_t<kIsString<T>, std::string_view, T>;
+
+    template <class T>
+    std::string_view ToStringView(const T& value) {
+        if constexpr (std::is_pointer_v<T>) {
+            if (value == nullptr) {
+                return "(null)";
+            }
+        }
+        return std::string_view(value);
+    }
+
+    template <class T>
+    size_t EncodedSize(const T& value) {
+        if constexpr (kIsString<T>) {
+            return sizeof(uint32_t) + ToStringView(value).size();
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>,
+                "LOG_*F: arguments must be strings or trivially copyable values; format other types beforehand");
+            return sizeof(T);
+        }
+    }
+
+    template <class T>
+    std::byte* Encode(std::byte* cursor, const T& value) {
+        if constexpr (kIsString<T>) {
+            std::string_view text = ToStringView(value);
+            uint32_t length = static_cast<uint32_t>(text.size());
+            std::memcpy(cursor, &length, sizeof(length));
+            std::memcpy(cursor + sizeof(length), text.data(), length);
+            return cursor + sizeof(length) + length;
+        } else {
+            std::memcpy(cursor, &value, sizeof(T));
+            return cursor + sizeof(T);
+        }
+    }
+
+    template <class T>
+    Decoded<T> Decode(const std::byte*& cursor) {
+        if constexpr (kIsString<T>) {
+            uint32_t length = 0;
+            std::memcpy(&length, cursor, sizeof(length));
+            std::string_view text(reinterpret_cast<const char*>(cursor + sizeof(length)), length);
+            cursor += sizeof(length) + length;
+            return text;
+        } else {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), cursor, sizeof(T));
+            cursor += sizeof(T);
+            return std::bit_cast<T>(bytes);
+        }
+    }
+
+    template <class T>
+    constexpr LogArgKind KindOf() {
+        if constexpr (kIsString<T>) {
+            return LogArgKind::String;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return LogArgKind::Bool;
+        } else if constexpr (std::is_same_v<T, char>) {
+            return LogArgKind::Char;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= 8) {
+            constexpr LogArgKind kSigned[] = { LogArgKind::Int8, LogArgKind::Int16, LogArgKind::Opaque, LogArgKind::Int32,
+                LogArgKind::Opaque, LogArgKind::Opaque, LogArgKind::Opaque, LogArgKind::Int64 };
+            return kSigned[sizeof(T) - 1];
+        } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) <= 8) {
+            constexpr LogArgKind kUnsigned[] = { LogArgKind::UInt8, LogArgKind::UInt16, LogArgKind::Opaque, LogArgKind::UInt32,
+                LogArgKind::Opaque, LogArgKind::Opaque, LogArgKind::Opaque, LogArgKind::UInt64 };
+            return kUnsigned[sizeof(T) - 1];
+        } else if constexpr (std::is_same_v<T, float>) {
+            return LogArgKind::Float;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return LogArgKind::Double;
+        } else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+            return LogArgKind::Pointer;
+        } else {
+            return LogArgKind::Opaque;
+        }
+    }
+
+} // namespace LogFormatDetail
+
+/// <summary>
+/// 引数列の型情報（End終端の静的配列）
+/// </summary>
+template <class... Args>
+inline constexpr LogArgKind kLogArgKinds[] = { LogFormatDetail::KindOf<Args>()..., LogArgKind::End };
+
+/// <summary>
+/// 引数列をバッファにシリアライズ（1回の確保とmemcpyのみ）
+/// </summary>
+/// <param name="buffer">書き込み先</param>
+/// <param name="args">フォーマット引数</param>
+template <class... Args>
+void EncodeLogArgs(LogBuffer& buffer, const Args&... args) {
+    std::byte* cursor = buffer.Resize((size_t{0} + ... + LogFormatDetail::EncodedSize(args)));
+    ((cursor = LogFormatDetail::Encode(cursor, args)), ...);
+    (void)cursor;
+}
+
+/// <summary>
+/// EncodeLogArgsで作ったバッファを復元してstd::vformatでメッセージ本文を生成
+/// LogFormatFunctionとして呼び出し箇所ごとにインスタンス化される
+/// </summary>
+template <class... Args>
+void FormatLogArgs(std::string_view format, const LogBuffer& args, std::string& out) {
+    const std::byte* cursor = args.GetData();
+    // 波括弧初期化は左から順に評価されるため、エンコード順にデコードされる
+    std::tuple<LogFormatDetail::Decoded<Args>...> values{ LogFormatDetail::Decode<Args>(cursor)... };
+    (void)cursor;
+    // outはスレッドごとに使い回すバッファ（容量を保ったままクリアして書き込む）
+    out.clear();
+    std::apply([&](auto&... value) {
+        std::vformat_to(std::back_inserter(out), format, std::make_format_args(value...));
+    }, values);
+}
+
+} // namespace RenderingSandbox
@@ -52,4 +52,16 @@ constexpr uint16_t LogLevelToConsoleColor(LogLevel level) {
     }
 }
 
+/// <summary>
+/// ログレベルをANSIエスケープシーケンスの前景色コードに変換（POSIX端末用）
+/// LogLevelToConsoleColorの色（青=1、緑=2、赤=4、高輝度=8のビット）をそのままANSIの色番号に対応させる
+/// </summary>
+/// <param name="level">ログレベル</param>
+/// <returns>SGRの前景色コード（30～37、高輝度は90～97）</returns>
+constexpr int LogLevelToAnsiColor(LogLevel level) {
+    const uint16_t color = LogLevelToConsoleColor(level);
+    const int base = (color & 8) ? 90 : 30;
+    return base + ((color & 4) ? 1 : 0) + ((color & 2) ? 2 : 0) + ((color & 1) ? 4 : 0);
+}
+
 } // namespace RenderingSandbox
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "Logger.h"
+#include "LogCompileLevel.h"
+#include "LogRateLimit.h"
+#include "LogScopeTimer.h"
+#include "LogTextWriter.h"
 #include <format>
 
 #define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX    // std::min/std::maxと衝突するmin/maxマクロを定義させない
+#endif
 #include <Windows.h>
 
 namespace RenderingSandbox {
@@ -46,15 +53,107 @@ namespace RenderingSandbox {
     }
 }
 
-// デバッグビルドでのみログを有効化
-#ifdef _DEBUG
-    #define LOG_ENABLED 1
-#else
-    #define LOG_ENABLED 0
-#endif
+// LOG_ENABLEDとコンパイル時しきい値はLogCompileLevel.hで定義
+
+// 呼び出し箇所ごとに一意な変数名を作る（__LINE__を展開してから連結する）
+#define LOG_CONCAT_INNER_(a, b) a##b
+#define LOG_CONCAT_(a, b) LOG_CONCAT_INNER_(a, b)
 
 #if LOG_ENABLED
 
+    // ==================================================
+    // 内部実装用マクロ
+    // ==================================================
+
+    /// <summary>
+    /// カテゴリハンドルを呼び出し箇所ごとのstaticローカル変数で一度だけ解決し、
+    /// レベル判定（ロックなしのアトミックロード1回）を通過した場合のみメッセージを評価して出力
+    /// categoryはLogCategoryName（文字列リテラルなどの定数式）で、実行時に組み立てた文字列はコンパイルエラーになる
+    /// （動的なカテゴリはLogger::RegisterCategoryで得たハンドルをLogger::Logに渡す）
+    /// ファイル名は__FILE__からコンパイル時に抽出する
+    /// コンパイル時しきい値（LogCompileLevel.h）を下回る場合はif constexprで本体ごと取り除かれる
+    /// </summary>
+    #define LOG_IMPL_(level, category, msg) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                static const ::RenderingSandbox::LogCategoryId _log_category = \
+                    ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+                static constexpr const char* _log_file = ::RenderingSandbox::LogBaseName(__FILE__); \
+                auto& _logger = ::RenderingSandbox::Logger::GetInstance(); \
+                if (_logger.IsEnabled(_log_category, level)) { \
+                    _logger.Log(level, _log_category, msg, _log_file, __LINE__); \
+                } \
+            } \
+        } while(0)
+
+    /// <summary>
+    /// LOG_IMPL_の遅延フォーマット版（可変引数の先頭が書式文字列）
+    /// </summary>
+    #define LOG_IMPL_F_(level, category, ...) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                static const ::RenderingSandbox::LogCategoryId _log_category = \
+                    ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+                static constexpr const char* _log_file = ::RenderingSandbox::LogBaseName(__FILE__); \
+                auto& _logger = ::RenderingSandbox::Logger::GetInstance(); \
+                if (_logger.IsEnabled(_log_category, level)) { \
+                    _logger.LogFormat(level, _log_category, _log_file, __LINE__, __VA_ARGS__); \
+                } \
+            } \
+        } while(0)
+
+    /// <summary>
+    /// LOG_IMPL_の構造化フィールド付き版（可変引数は { "key", value } の並び）
+    /// </summary>
+    #define LOG_IMPL_KV_(level, category, msg, ...) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                static const ::RenderingSandbox::LogCategoryId _log_category = \
+                    ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+                static constexpr const char* _log_file = ::RenderingSandbox::LogBaseName(__FILE__); \
+                auto& _logger = ::RenderingSandbox::Logger::GetInstance(); \
+                if (_logger.IsEnabled(_log_category, level)) { \
+                    _logger.LogFields(level, _log_category, msg, { __VA_ARGS__ }, _log_file, __LINE__); \
+                } \
+            } \
+        } while(0)
+
+    /// <summary>
+    /// LOG_IMPL_に呼び出し箇所ごとの間引き判定を加えたもの
+    /// gateはLogRateLimit.hの判定クラスを生成する式で、初回の呼び出し時にstaticローカル変数として一度だけ評価される
+    /// 判定はレベル判定を通過した呼び出しだけを数える
+    /// </summary>
+    #define LOG_IMPL_RATE_(level, category, gate, msg) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                static const ::RenderingSandbox::LogCategoryId _log_category = \
+                    ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+                static constexpr const char* _log_file = ::RenderingSandbox::LogBaseName(__FILE__); \
+                static auto _log_gate = gate; \
+                auto& _logger = ::RenderingSandbox::Logger::GetInstance(); \
+                if (_logger.IsEnabled(_log_category, level) && _log_gate.Check()) { \
+                    _logger.Log(level, _log_category, msg, _log_file, __LINE__); \
+                } \
+            } \
+        } while(0)
+
+    /// <summary>
+    /// LOG_IMPL_RATE_の遅延フォーマット版（可変引数の先頭が書式文字列）
+    /// </summary>
+    #define LOG_IMPL_RATE_F_(level, category, gate, ...) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                static const ::RenderingSandbox::LogCategoryId _log_category = \
+                    ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+                static constexpr const char* _log_file = ::RenderingSandbox::LogBaseName(__FILE__); \
+                static auto _log_gate = gate; \
+                auto& _logger = ::RenderingSandbox::Logger::GetInstance(); \
+                if (_logger.IsEnabled(_log_category, level) && _log_gate.Check()) { \
+                    _logger.LogFormat(level, _log_category, _log_file, __LINE__, __VA_ARGS__); \
+                } \
+            } \
+        } while(0)
+
     // ==================================================
     // ログマクロ（カテゴリ指定必須）
     // ==================================================
@@ -63,48 +162,258 @@ namespace RenderingSandbox {
     /// Traceレベルのログを出力
     /// </summary>
     #define LOG_TRACE(category, msg) \
-        ::RenderingSandbox::Logger::GetInstance().Trace(category, msg, __FILE__, __LINE__)
+        LOG_IMPL_(::RenderingSandbox::LogLevel::Trace, category, msg)
 
     /// <summary>
     /// Debugレベルのログを出力
     /// </summary>
     #define LOG_DEBUG(category, msg) \
-        ::RenderingSandbox::Logger::GetInstance().Debug(category, msg, __FILE__, __LINE__)
+        LOG_IMPL_(::RenderingSandbox::LogLevel::Debug, category, msg)
 
     /// <summary>
     /// Infoレベルのログを出力
     /// </summary>
     #define LOG_INFO(category, msg) \
-        ::RenderingSandbox::Logger::GetInstance().Info(category, msg, __FILE__, __LINE__)
+        LOG_IMPL_(::RenderingSandbox::LogLevel::Info, category, msg)
 
     /// <summary>
     /// Warningレベルのログを出力
     /// </summary>
     #define LOG_WARNING(category, msg) \
-        ::RenderingSandbox::Logger::GetInstance().Warning(category, msg, __FILE__, __LINE__)
+        LOG_IMPL_(::RenderingSandbox::LogLevel::Warning, category, msg)
 
     /// <summary>
     /// Errorレベルのログを出力
     /// </summary>
     #define LOG_ERROR(category, msg) \
-        ::RenderingSandbox::Logger::GetInstance().Error(category, msg, __FILE__, __LINE__)
+        LOG_IMPL_(::RenderingSandbox::LogLevel::Error, category, msg)
 
     /// <summary>
     /// Fatalレベルのログを出力（conditionがfalseの時にログ出力してexit）
     /// デバッガがアタッチされている場合はDebugBreak()で停止
+    /// Fatalがコンパイル時に取り除かれるカテゴリではconditionも評価しない
     /// </summary>
     #define LOG_FATAL(condition, category, msg) \
         do { \
-            if (!(condition)) { \
-                ::RenderingSandbox::Logger::GetInstance().Fatal(category, msg, __FILE__, __LINE__); \
-                ::RenderingSandbox::Logger::GetInstance().Flush(); \
-                if (::IsDebuggerPresent()) { \
-                    ::DebugBreak(); \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Fatal, category)) { \
+                if (!(condition)) { \
+                    LOG_IMPL_(::RenderingSandbox::LogLevel::Fatal, category, msg); \
+                    ::RenderingSandbox::Logger::GetInstance().Flush(); \
+                    if (::IsDebuggerPresent()) { \
+                        ::DebugBreak(); \
+                    } \
+                    std::exit(1); \
                 } \
-                std::exit(1); \
             } \
         } while(0)
 
+    // ==================================================
+    // 遅延フォーマット版ログマクロ
+    // 呼び出し側では引数をコピーするだけで、std::formatはSink側で行う
+    // 使用例: LOG_INFOF("DeviceInfo", "VendorID: {:#x}, DeviceID: {:#x}", desc.VendorId, desc.DeviceId)
+    // ==================================================
+
+    /// <summary>
+    /// Traceレベルのログを書式指定で出力
+    /// </summary>
+    #define LOG_TRACEF(category, ...) \
+        LOG_IMPL_F_(::RenderingSandbox::LogLevel::Trace, category, __VA_ARGS__)
+
+    /// <summary>
+    /// Debugレベルのログを書式指定で出力
+    /// </summary>
+    #define LOG_DEBUGF(category, ...) \
+        LOG_IMPL_F_(::RenderingSandbox::LogLevel::Debug, category, __VA_ARGS__)
+
+    /// <summary>
+    /// Infoレベルのログを書式指定で出力
+    /// </summary>
+    #define LOG_INFOF(category, ...) \
+        LOG_IMPL_F_(::RenderingSandbox::LogLevel::Info, category, __VA_ARGS__)
+
+    /// <summary>
+    /// Warningレベルのログを書式指定で出力
+    /// </summary>
+    #define LOG_WARNINGF(category, ...) \
+        LOG_IMPL_F_(::RenderingSandbox::LogLevel::Warning, category, __VA_ARGS__)
+
+    /// <summary>
+    /// Errorレベルのログを書式指定で出力
+    /// </summary>
+    #define LOG_ERRORF(category, ...) \
+        LOG_IMPL_F_(::RenderingSandbox::LogLevel::Error, category, __VA_ARGS__)
+
+    /// <summary>
+    /// LOG_FATALの書式指定版（conditionがfalseの時にログ出力してexit）
+    /// 書式の引数はconditionがfalseの場合だけ評価する
+    /// </summary>
+    #define LOG_FATALF(condition, category, ...) \
+        do { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Fatal, category)) { \
+                if (!(condition)) { \
+                    LOG_IMPL_F_(::RenderingSandbox::LogLevel::Fatal, category, __VA_ARGS__); \
+                    ::RenderingSandbox::Logger::GetInstance().Flush(); \
+                    if (::IsDebuggerPresent()) { \
+                        ::DebugBreak(); \
+                    } \
+                    std::exit(1); \
+                } \
+            } \
+        } while(0)
+
+    // ==================================================
+    // 構造化フィールド付きログマクロ
+    // 数値や文字列を本文に埋め込まず、型付きのキーと値として残す（JsonLinesSinkで機械処理しやすい）
+    // 使用例: LOG_INFO_KV("DeviceInfo", "Adapter found", { "vendorId", desc.VendorId }, { "deviceId", desc.DeviceId })
+    // ==================================================
+
+    /// <summary>
+    /// 各レベルのログを構造化フィールド付きで出力
+    /// </summary>
+    #define LOG_TRACE_KV(category, msg, ...) \
+        LOG_IMPL_KV_(::RenderingSandbox::LogLevel::Trace, category, msg, __VA_ARGS__)
+    #define LOG_DEBUG_KV(category, msg, ...) \
+        LOG_IMPL_KV_(::RenderingSandbox::LogLevel::Debug, category, msg, __VA_ARGS__)
+    #define LOG_INFO_KV(category, msg, ...) \
+        LOG_IMPL_KV_(::RenderingSandbox::LogLevel::Info, category, msg, __VA_ARGS__)
+    #define LOG_WARNING_KV(category, msg, ...) \
+        LOG_IMPL_KV_(::RenderingSandbox::LogLevel::Warning, category, msg, __VA_ARGS__)
+    #define LOG_ERROR_KV(category, msg, ...) \
+        LOG_IMPL_KV_(::RenderingSandbox::LogLevel::Error, category, msg, __VA_ARGS__)
+
+    // ==================================================
+    // スコープ時間計測マクロ
+    // スコープの先頭に置くと、スコープを抜ける時に所要時間を出力（または集計）する
+    // スコープ名はメッセージ本文になり、所要時間は構造化フィールド「elapsed」として付く
+    // スコープ名は文字列リテラルに限る（ポインタやstd::stringを渡すとコンパイルエラー）
+    // 使用例:
+    //   LOG_SCOPE_TIMER("Loader", "Import mesh");                 // 毎回Debugで出力
+    //   LOG_SCOPE_TIMER_SLOW("Renderer", "Present", 20);          // 20ms以上かかった場合だけWarningで出力
+    //   LOG_SCOPE_TIMER_ACCUM("Renderer", "Record commands");     // 回数・合計・最小・最大・平均を集計し、Logger::Flushで要約表を出力
+    // ==================================================
+
+    /// <summary>
+    /// スコープの所要時間を、しきい値以上の場合にlevelで出力するRAII変数を宣言
+    /// カテゴリハンドルは呼び出し箇所ごとのstaticローカル変数で一度だけ解決する
+    /// スコープ名はLogScopeTimerがスコープを抜けるまで参照するため、「"" name ""」で文字列リテラル以外をコンパイルエラーにする
+    /// </summary>
+    #define LOG_IMPL_SCOPE_TIMER_(level, category, name, threshold) \
+        static const ::RenderingSandbox::LogCategoryId LOG_CONCAT_(_log_scope_category_, __LINE__) = [] { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(level, category)) { \
+                return ::RenderingSandbox::Logger::GetInstance().RegisterCategory(category); \
+            } else { \
+                return ::RenderingSandbox::LogCategoryId{}; \
+            } \
+        }(); \
+        ::RenderingSandbox::LogScopeTimer<::RenderingSandbox::LogIsCompiledIn(level, category)> LOG_CONCAT_(_log_scope_timer_, __LINE__)( \
+            level, LOG_CONCAT_(_log_scope_category_, __LINE__), "" name "", ::RenderingSandbox::LogBaseName(__FILE__), __LINE__, threshold)
+
+    /// <summary>
+    /// スコープの所要時間をDebugで出力
+    /// </summary>
+    #define LOG_SCOPE_TIMER(category, name) \
+        LOG_IMPL_SCOPE_TIMER_(::RenderingSandbox::LogLevel::Debug, category, name, std::chrono::nanoseconds::zero())
+
+    /// <summary>
+    /// スコープの所要時間がthresholdMsミリ秒以上の場合だけWarningで出力
+    /// </summary>
+    #define LOG_SCOPE_TIMER_SLOW(category, name, thresholdMs) \
+        LOG_IMPL_SCOPE_TIMER_(::RenderingSandbox::LogLevel::Warning, category, name, std::chrono::milliseconds(thresholdMs))
+
+    /// <summary>
+    /// スコープの所要時間を呼び出し箇所ごとに集計（出力はLogger::Flush時の要約表のみ）
+    /// スコープ名はLogScopeStatsがプログラム終了まで参照するため、文字列リテラルに限る
+    /// </summary>
+    #define LOG_SCOPE_TIMER_ACCUM(category, name) \
+        static ::RenderingSandbox::LogScopeStats* const LOG_CONCAT_(_log_scope_stats_, __LINE__) = [] { \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Info, category)) { \
+                static ::RenderingSandbox::LogScopeStats stats(category, "" name "", ::RenderingSandbox::LogBaseName(__FILE__), __LINE__); \
+                return &stats; \
+            } else { \
+                return static_cast<::RenderingSandbox::LogScopeStats*>(nullptr); \
+            } \
+        }(); \
+        ::RenderingSandbox::LogScopeAccumulator<::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Info, category)> \
+            LOG_CONCAT_(_log_scope_accumulator_, __LINE__)(LOG_CONCAT_(_log_scope_stats_, __LINE__))
+
+    // ==================================================
+    // 間引き付きログマクロ
+    // 毎フレーム通るコードパスで同じメッセージが大量に出るのを防ぐ（判定状態は呼び出し箇所ごと）
+    // 使用例: LOG_WARNINGF_EVERY_MS("Renderer", 1000, "Resource state mismatch: {}", name)
+    // ==================================================
+
+    /// <summary>
+    /// N回に1回だけ出力（初回は必ず出力、nは初回の呼び出し時の値で固定）
+    /// </summary>
+    #define LOG_TRACE_EVERY_N(category, n, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogEveryN(n), msg)
+    #define LOG_DEBUG_EVERY_N(category, n, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogEveryN(n), msg)
+    #define LOG_INFO_EVERY_N(category, n, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogEveryN(n), msg)
+    #define LOG_WARNING_EVERY_N(category, n, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogEveryN(n), msg)
+    #define LOG_ERROR_EVERY_N(category, n, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogEveryN(n), msg)
+    #define LOG_TRACEF_EVERY_N(category, n, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogEveryN(n), __VA_ARGS__)
+    #define LOG_DEBUGF_EVERY_N(category, n, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogEveryN(n), __VA_ARGS__)
+    #define LOG_INFOF_EVERY_N(category, n, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogEveryN(n), __VA_ARGS__)
+    #define LOG_WARNINGF_EVERY_N(category, n, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogEveryN(n), __VA_ARGS__)
+    #define LOG_ERRORF_EVERY_N(category, n, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogEveryN(n), __VA_ARGS__)
+
+    /// <summary>
+    /// msミリ秒に1回だけ出力（初回は必ず出力、msは初回の呼び出し時の値で固定）
+    /// </summary>
+    #define LOG_TRACE_EVERY_MS(category, ms, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogEveryMs(ms), msg)
+    #define LOG_DEBUG_EVERY_MS(category, ms, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogEveryMs(ms), msg)
+    #define LOG_INFO_EVERY_MS(category, ms, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogEveryMs(ms), msg)
+    #define LOG_WARNING_EVERY_MS(category, ms, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogEveryMs(ms), msg)
+    #define LOG_ERROR_EVERY_MS(category, ms, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogEveryMs(ms), msg)
+    #define LOG_TRACEF_EVERY_MS(category, ms, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogEveryMs(ms), __VA_ARGS__)
+    #define LOG_DEBUGF_EVERY_MS(category, ms, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogEveryMs(ms), __VA_ARGS__)
+    #define LOG_INFOF_EVERY_MS(category, ms, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogEveryMs(ms), __VA_ARGS__)
+    #define LOG_WARNINGF_EVERY_MS(category, ms, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogEveryMs(ms), __VA_ARGS__)
+    #define LOG_ERRORF_EVERY_MS(category, ms, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogEveryMs(ms), __VA_ARGS__)
+
+    /// <summary>
+    /// 最初の1回だけ出力
+    /// </summary>
+    #define LOG_TRACE_ONCE(category, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogOnce(), msg)
+    #define LOG_DEBUG_ONCE(category, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogOnce(), msg)
+    #define LOG_INFO_ONCE(category, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogOnce(), msg)
+    #define LOG_WARNING_ONCE(category, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogOnce(), msg)
+    #define LOG_ERROR_ONCE(category, msg) \
+        LOG_IMPL_RATE_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogOnce(), msg)
+    #define LOG_TRACEF_ONCE(category, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Trace, category, ::RenderingSandbox::LogOnce(), __VA_ARGS__)
+    #define LOG_DEBUGF_ONCE(category, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Debug, category, ::RenderingSandbox::LogOnce(), __VA_ARGS__)
+    #define LOG_INFOF_ONCE(category, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Info, category, ::RenderingSandbox::LogOnce(), __VA_ARGS__)
+    #define LOG_WARNINGF_ONCE(category, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Warning, category, ::RenderingSandbox::LogOnce(), __VA_ARGS__)
+    #define LOG_ERRORF_ONCE(category, ...) \
+        LOG_IMPL_RATE_F_(::RenderingSandbox::LogLevel::Error, category, ::RenderingSandbox::LogOnce(), __VA_ARGS__)
+
     // ==================================================
     // HRESULT用マクロ
     // ==================================================
@@ -112,34 +421,41 @@ namespace RenderingSandbox {
     /// <summary>
     /// HRESULTが失敗していた場合にエラーログを出力
     /// 使用例: LOG_IF_FAILED("D3D12", hr, "Failed to create device")
+    /// Errorがコンパイル時に取り除かれるカテゴリではhrも評価しない
     /// </summary>
     #define LOG_IF_FAILED(category, hr, msg) \
         do { \
-            HRESULT _hr_result = (hr); \
-            if (FAILED(_hr_result)) { \
-                std::string _full_msg = std::string(msg) + " - " + ::RenderingSandbox::GetHResultMessage(_hr_result); \
-                ::RenderingSandbox::Logger::GetInstance().Error(category, _full_msg, __FILE__, __LINE__); \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Error, category)) { \
+                HRESULT _hr_result = (hr); \
+                if (FAILED(_hr_result)) { \
+                    LOG_IMPL_(::RenderingSandbox::LogLevel::Error, category, \
+                        std::string(msg) + " - " + ::RenderingSandbox::GetHResultMessage(_hr_result)); \
+                } \
             } \
         } while(0)
 
     /// <summary>
     /// HRESULTの結果をログに出力（成功時はInfo、失敗時はError）
     /// 使用例: LOG_HRESULT("D3D12", hr, "Device creation result")
+    /// Errorがコンパイル時に取り除かれるカテゴリではhrも評価しない（Infoのみ取り除かれる場合は失敗時だけ出力）
     /// </summary>
     #define LOG_HRESULT(category, hr, msg) \
         do { \
-            HRESULT _hr_result = (hr); \
-            std::string _full_msg = std::string(msg) + " - " + ::RenderingSandbox::GetHResultMessage(_hr_result); \
-            if (FAILED(_hr_result)) { \
-                ::RenderingSandbox::Logger::GetInstance().Error(category, _full_msg, __FILE__, __LINE__); \
-            } else { \
-                ::RenderingSandbox::Logger::GetInstance().Info(category, _full_msg, __FILE__, __LINE__); \
+            if constexpr (::RenderingSandbox::LogIsCompiledIn(::RenderingSandbox::LogLevel::Error, category)) { \
+                HRESULT _hr_result = (hr); \
+                if (FAILED(_hr_result)) { \
+                    LOG_IMPL_(::RenderingSandbox::LogLevel::Error, category, \
+                        std::string(msg) + " - " + ::RenderingSandbox::GetHResultMessage(_hr_result)); \
+                } else { \
+                    LOG_IMPL_(::RenderingSandbox::LogLevel::Info, category, \
+                        std::string(msg) + " - " + ::RenderingSandbox::GetHResultMessage(_hr_result)); \
+                } \
             } \
         } while(0)
 
 #else
     // ==================================================
-    // リリースビルドでは完全に無効化（コンパイラが最適化で削除）
+    // すべてのレベルが取り除かれる場合（既定のリリースビルド）は完全に無効化
     // ==================================================
 
     #define LOG_TRACE(category, msg)              ((void)0)
@@ -147,8 +463,52 @@ namespace RenderingSandbox {
     #define LOG_INFO(category, msg)               ((void)0)
     #define LOG_WARNING(category, msg)            ((void)0)
     #define LOG_ERROR(category, msg)              ((void)0)
+    #define LOG_TRACEF(category, ...)             ((void)0)
+    #define LOG_DEBUGF(category, ...)             ((void)0)
+    #define LOG_INFOF(category, ...)              ((void)0)
+    #define LOG_WARNINGF(category, ...)           ((void)0)
+    #define LOG_ERRORF(category, ...)             ((void)0)
     #define LOG_FATAL(condition, category, msg)   ((void)0)
+    #define LOG_FATALF(condition, category, ...)  ((void)0)
     #define LOG_IF_FAILED(category, hr, msg)      ((void)0)
     #define LOG_HRESULT(category, hr, msg)        ((void)0)
+    #define LOG_SCOPE_TIMER(category, name)               ((void)0)
+    #define LOG_SCOPE_TIMER_SLOW(category, name, thresholdMs) ((void)0)
+    #define LOG_SCOPE_TIMER_ACCUM(category, name)         ((void)0)
+    #define LOG_TRACE_KV(category, msg, ...)              ((void)0)
+    #define LOG_DEBUG_KV(category, msg, ...)              ((void)0)
+    #define LOG_INFO_KV(category, msg, ...)               ((void)0)
+    #define LOG_WARNING_KV(category, msg, ...)            ((void)0)
+    #define LOG_ERROR_KV(category, msg, ...)              ((void)0)
+    #define LOG_TRACE_EVERY_N(category, n, msg)           ((void)0)
+    #define LOG_DEBUG_EVERY_N(category, n, msg)           ((void)0)
+    #define LOG_INFO_EVERY_N(category, n, msg)            ((void)0)
+    #define LOG_WARNING_EVERY_N(category, n, msg)         ((void)0)
+    #define LOG_ERROR_EVERY_N(category, n, msg)           ((void)0)
+    #define LOG_TRACEF_EVERY_N(category, n, ...)          ((void)0)
+    #define LOG_DEBUGF_EVERY_N(category, n, ...)          ((void)0)
+    #define LOG_INFOF_EVERY_N(category, n, ...)           ((void)0)
+    #define LOG_WARNINGF_EVERY_N(category, n, ...)        ((void)0)
+    #define LOG_ERRORF_EVERY_N(category, n, ...)          ((void)0)
+    #define LOG_TRACE_EVERY_MS(category, ms, msg)         ((void)0)
+    #define LOG_DEBUG_EVERY_MS(category, ms, msg)         ((void)0)
+    #define LOG_INFO_EVERY_MS(category, ms, msg)          ((void)0)
+    #define LOG_WARNING_EVERY_MS(category, ms, msg)       ((void)0)
+    #define LOG_ERROR_EVERY_MS(category, ms, msg)         ((void)0)
+    #define LOG_TRACEF_EVERY_MS(category, ms, ...)        ((void)0)
+    #define LOG_DEBUGF_EVERY_MS(category, ms, ...)        ((void)0)
+    #define LOG_INFOF_EVERY_MS(category, ms, ...)         ((void)0)
+    #define LOG_WARNINGF_EVERY_MS(category, ms, ...)      ((void)0)
+    #define LOG_ERRORF_EVERY_MS(category, ms, ...)        ((void)0)
+    #define LOG_TRACE_ONCE(category, msg)                 ((void)0)
+    #define LOG_DEBUG_ONCE(category, msg)                 ((void)0)
+    #define LOG_INFO_ONCE(category, msg)                  ((void)0)
+    #define LOG_WARNING_ONCE(category, msg)               ((void)0)
+    #define LOG_ERROR_ONCE(category, msg)                 ((void)0)
+    #define LOG_TRACEF_ONCE(category, ...)                ((void)0)
+    #define LOG_DEBUGF_ONCE(category, ...)                ((void)0)
+    #define LOG_INFOF_ONCE(category, ...)                 ((void)0)
+    #define LOG_WARNINGF_ONCE(category, ...)              ((void)0)
+    #define LOG_ERRORF_ONCE(category, ...)                ((void)0)
 
 #endif // LOG_ENABLED
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "LogLevel.h"
+#include "LogCategory.h"
+#include "LogFormat.h"
+#include "LogBuffer.h"
+#include "LogField.h"
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 
 namespace RenderingSandbox {
@@ -10,22 +16,87 @@ namespace RenderingSandbox {
 /// <summary>
 /// ログメッセージ構造体
 /// タイムスタンプ、ログレベル、メッセージ本文、カテゴリ、ソースファイル情報を保持
+/// カテゴリとファイル名は静的な文字列（カテゴリレジストリ・__FILE__）を指すだけで所有しない
+/// 本文は短ければインラインに保持するため、通常のログではヒープ確保が発生しない
 /// </summary>
 struct LogMessage {
-    LogLevel level;                                         // ログレベル
-    std::string message;                                    // メッセージ本文
-    std::string category;                                   // カテゴリ（オプション）
-    std::string file;                                       // ソースファイル名
-    int line;                                               // 行番号
-    std::chrono::system_clock::time_point timestamp;        // タイムスタンプ
-    std::thread::id threadId;                               // スレッドID
+    /// <summary>
+    /// 遅延フォーマットの本文が未生成であることを表すtextOffset
+    /// </summary>
+    static constexpr uint32_t kNoText = UINT32_MAX;
+
+    LogLevel level = LogLevel::Info;                        // ログレベル
+    std::string_view category{};                            // カテゴリ（レジストリが保持する文字列を指す）
+    LogCategoryId categoryId = LogCategoryRegistry::kDefaultCategory;   // カテゴリハンドル（Loggerを通さずに作ったレコードでは既定値のまま）
+    const char* file = "";                                  // ソースファイル名（__FILE__リテラルを指す）
+    int line = 0;                                           // 行番号
+    std::chrono::system_clock::time_point timestamp{};      // タイムスタンプ
+    std::thread::id threadId{};                             // スレッドID
+
+    // 遅延フォーマット（LOG_*Fマクロ）用
+    std::string_view formatString{};                        // 書式文字列（文字列リテラルを指す）
+    LogFormatFunction formatter = nullptr;                  // 引数をデコードして本文を生成する関数
+    const LogArgKind* argKinds = nullptr;                   // 引数の型情報（kLogArgKinds、バイナリ出力用）
+    mutable uint32_t textOffset = kNoText;                  // 生成済みの本文のpayload内の開始位置（未生成はkNoText）
+
+    // 本文（formatterが設定されている場合はシリアライズ済みのフォーマット引数、GetTextで生成した本文はその後ろに追記する）
+    mutable LogBuffer payload{};
+
+    // 構造化フィールド（EncodeLogFieldsの形式、LogFieldReaderで読み出す。付けない場合は空）
+    LogFieldBuffer fields{};
+
+    /// <summary>
+    /// メッセージ本文を設定
+    /// </summary>
+    /// <param name="text">メッセージ本文（コピーされる）</param>
+    void SetText(std::string_view text) {
+        formatter = nullptr;
+        argKinds = nullptr;
+        textOffset = kNoText;
+        payload.Assign(text);
+    }
+
+    /// <summary>
+    /// メッセージ本文を取得
+    /// 遅延フォーマットのレコードは初回呼び出し時にここでstd::vformatする（Loggerは配信前に一度呼んでおく）
+    /// 生成した本文は引数列の後ろに保存するため、後続のSinkも引数列（formatter・payload）をそのまま使える
+    /// </summary>
+    /// <returns>メッセージ本文（このレコードが変更されるまで有効）</returns>
+    std::string_view GetText() const;
+
+    /// <summary>
+    /// 構造化フィールドが付いているかどうか
+    /// </summary>
+    /// <returns>付いている場合true</returns>
+    bool HasFields() const { return fields.GetSize() > 0; }
 
     /// <summary>
     /// フォーマット済みログメッセージ文字列を生成
-    /// 形式: [HH:MM:SS.mmm] [LEVEL] [Category] message (file:line) [ThreadID]
+    /// 形式: [HH:MM:SS.mmm] [LEVEL] [Category] message key=value ... (file:line)
     /// </summary>
     /// <returns>フォーマット済み文字列</returns>
     std::string Format() const;
+
+    /// <summary>
+    /// フォーマット済みログメッセージをoutに書き込む（outの内容は置き換え、確保済みの容量は再利用）
+    /// </summary>
+    /// <param name="out">書き込み先</param>
+    void FormatTo(std::string& out) const;
+
+    /// <summary>
+    /// フォーマット済みログメッセージを呼び出し側のバッファに書き込む（終端文字は書かない）
+    /// 収まらない場合は本文を切り詰める
+    /// </summary>
+    /// <param name="buffer">書き込み先</param>
+    /// <param name="capacity">書き込み先のバイト数</param>
+    /// <returns>書き込んだバイト数</returns>
+    size_t FormatTo(char* buffer, size_t capacity) const;
+
+    /// <summary>
+    /// FormatToで書き込まれるバイト数を取得
+    /// </summary>
+    /// <returns>フォーマット済み文字列のバイト数</returns>
+    size_t GetFormattedSize() const;
 };
 
 } // namespace RenderingSandbox
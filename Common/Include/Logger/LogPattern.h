@@ -0,0 +1,121 @@
+#pragma once
+
+#include "LogMessage.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// コンパイル済みの出力パターン
+/// パターン文字列を一度だけ解析して命令列に変換し、レコードごとの整形はその命令列をなぞるだけにする
+///
+/// 書式指定子:
+///   %T  タイムスタンプ（HH:MM:SS.mmm）
+///   %L  ログレベル（5文字）
+///   %c  カテゴリ
+///   %v  メッセージ本文
+///   %k  構造化フィールド（key=value を空白区切り）
+///   %s  ソースファイル名
+///   %#  行番号
+///   %t  スレッドID
+///   %%  '%'そのもの
+///   %[ ... %]  グループ：中の指定子がすべて空でない場合のみ出力（カテゴリやファイル名の省略用）
+/// </summary>
+class LogPattern {
+public:
+    /// <summary>
+    /// 既定のパターン（LogMessage::Format()と同じ出力）
+    /// </summary>
+    static constexpr std::string_view kDefaultPattern = "[%T] [%L] %[[%c] %]%v%[ %k%]%[ (%s:%#)%]";
+
+    /// <summary>
+    /// パターンをコンパイル（同じ文字列は同じインスタンスを共有する）
+    /// </summary>
+    /// <param name="pattern">パターン文字列</param>
+    /// <returns>コンパイル済みパターン</returns>
+    static std::shared_ptr<const LogPattern> Compile(std::string_view pattern);
+
+    /// <summary>
+    /// 既定のパターンを取得
+    /// </summary>
+    /// <returns>既定のコンパイル済みパターン</returns>
+    static const std::shared_ptr<const LogPattern>& GetDefault();
+
+    /// <summary>
+    /// パターン文字列を指定して構築（通常はCompile()を使う）
+    /// </summary>
+    /// <param name="pattern">パターン文字列</param>
+    explicit LogPattern(std::string_view pattern);
+
+    /// <summary>
+    /// レコードを整形してoutに書き込む（outの内容は置き換え、確保済みの容量は再利用）
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <param name="out">書き込み先</param>
+    void FormatTo(const LogMessage& message, std::string& out) const;
+
+    /// <summary>
+    /// パターン文字列を取得
+    /// </summary>
+    /// <returns>パターン文字列</returns>
+    const std::string& GetSource() const { return m_source; }
+
+private:
+    enum class OpType : uint8_t {
+        Literal,        // 固定文字列
+        Time,           // %T
+        Level,          // %L
+        Category,       // %c
+        Text,           // %v
+        Fields,         // %k
+        File,           // %s
+        Line,           // %#
+        Thread,         // %t
+        GroupBegin,     // %[
+        GroupEnd        // %]
+    };
+
+    struct Op {
+        OpType type;
+        uint32_t literalOffset = 0;     // Literal: m_literals内の開始位置
+        uint32_t literalLength = 0;     // Literal: 長さ
+        uint32_t groupEnd = 0;          // GroupBegin: 対応するGroupEndの次の命令位置
+    };
+
+    // グループ内のフィールドがすべて空でないかを判定
+    bool IsGroupPresent(const LogMessage& message, size_t begin, size_t end) const;
+
+    std::string m_source;               // パターン文字列
+    std::string m_literals;             // 固定文字列の連結
+    std::vector<Op> m_ops;              // 命令列
+};
+
+/// <summary>
+/// 1回の配信（全Sinkへの書き込み）の間だけ有効な整形結果キャッシュ
+/// Logger::Dispatchがスタック上に置き、同じパターンを使うSink同士で整形結果を共有する
+/// スコープ外（Sinkを直接呼ぶ場合など）ではキャッシュせずに毎回整形する
+/// </summary>
+class LogFormatCache {
+public:
+    explicit LogFormatCache(const LogMessage& message);
+    ~LogFormatCache();
+
+    // コピー・ムーブ禁止
+    LogFormatCache(const LogFormatCache&) = delete;
+    LogFormatCache& operator=(const LogFormatCache&) = delete;
+
+    /// <summary>
+    /// レコードを整形（配信中かつ同じパターンで整形済みならキャッシュを返す）
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <param name="pattern">パターン</param>
+    /// <param name="fallback">キャッシュを使えない場合の書き込み先</param>
+    /// <returns>整形結果（次の配信またはfallbackの変更まで有効）</returns>
+    static std::string_view Format(const LogMessage& message, const LogPattern& pattern, std::string& fallback);
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "LogMessage.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 非同期ログ用の固定長リングキュー（ロックフリー）
+/// 各スロットにシーケンス番号を持たせる方式（Dmitry Vyukov の bounded queue）で、
+/// 複数スレッドからのPushと、ドレインスレッドからのPopをロックなしで行う
+/// DropOldestポリシーでは生産者側もPopするため、Popも複数スレッドから安全に呼べる
+/// </summary>
+class LogQueue {
+public:
+    /// <summary>
+    /// 容量を指定してキューを構築（2のべき乗に切り上げ）
+    /// </summary>
+    /// <param name="capacity">格納できるレコード数</param>
+    explicit LogQueue(size_t capacity);
+
+    ~LogQueue() = default;
+
+    // コピー・ムーブ禁止
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    /// <summary>
+    /// レコードを追加（満杯の場合は何もせずfalseを返す）
+    /// </summary>
+    /// <param name="message">追加するレコード（成功時のみムーブされる）</param>
+    /// <returns>追加できた場合true</returns>
+    bool TryPush(LogMessage&& message);
+
+    /// <summary>
+    /// 最古のレコードを取り出す（空の場合はfalseを返す）
+    /// </summary>
+    /// <param name="message">取り出したレコードの格納先</param>
+    /// <returns>取り出せた場合true</returns>
+    bool TryPop(LogMessage& message);
+
+    /// <summary>
+    /// キューが空かどうかを取得（他スレッドが操作中の場合は目安）
+    /// </summary>
+    /// <returns>空の場合true</returns>
+    bool IsEmpty() const;
+
+    /// <summary>
+    /// 取り出されていないレコードを古い順に参照する（取り出しはしない）
+    /// ロックとヒープ確保を行わないため、クラッシュ時のシグナルハンドラから呼べる
+    /// 他スレッドが操作中の場合、走査中に取り出された・追加されたレコードは含まれないことがある
+    /// </summary>
+    /// <param name="function">各レコードに対して呼び出す関数（const LogMessage&を受け取る）</param>
+    template <class Function>
+    void ForEachPending(Function&& function) const {
+        const size_t end = m_enqueuePos.load(std::memory_order_acquire);
+        for (size_t pos = m_dequeuePos.load(std::memory_order_acquire); pos != end; ++pos) {
+            const Slot& slot = m_slots[pos & m_mask];
+            // 書き込みが完了していて、まだ取り出されていないスロットだけを読む
+            if (slot.sequence.load(std::memory_order_acquire) == pos + 1) {
+                function(slot.message);
+            }
+        }
+    }
+
+    /// <summary>
+    /// キューの容量を取得
+    /// </summary>
+    /// <returns>容量（レコード数）</returns>
+    size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;       // スロットの世代番号
+        LogMessage message;                 // 格納されたレコード
+    };
+
+    // 生産者と消費者のカーソルが同じキャッシュラインに乗らないようにする
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::unique_ptr<Slot[]> m_slots;                                // スロット配列
+    size_t m_mask;                                                  // インデックスマスク（容量 - 1）
+    alignas(kCacheLineSize) std::atomic<size_t> m_enqueuePos;       // 次に書き込む位置
+    alignas(kCacheLineSize) std::atomic<size_t> m_dequeuePos;       // 次に読み出す位置
+};
+
+} // namespace RenderingSandbox
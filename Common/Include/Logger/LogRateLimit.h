@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace RenderingSandbox {
+
+// ==================================================
+// 呼び出し箇所ごとの出力間引き（LOG_*_EVERY_N / LOG_*_EVERY_MS / LOG_*_ONCEマクロ用）
+// マクロ内のstaticローカル変数として呼び出し箇所ごとに1つずつ置かれ、ロックなしのアトミック操作だけで判定する
+// ==================================================
+
+/// <summary>
+/// N回に1回だけ通す（初回は必ず通す）
+/// </summary>
+class LogEveryN {
+public:
+    explicit LogEveryN(uint32_t n) : m_n(n > 0 ? n : 1) {}
+
+    /// <summary>
+    /// 今回の呼び出しを出力するかを判定
+    /// </summary>
+    /// <returns>出力する場合true</returns>
+    bool Check() {
+        return m_counter.fetch_add(1, std::memory_order_relaxed) % m_n == 0;
+    }
+
+private:
+    const uint32_t m_n;                             // 間隔（回数）
+    std::atomic<uint32_t> m_counter{ 0 };           // 呼び出し回数
+};
+
+/// <summary>
+/// 指定した時間（ミリ秒）に1回だけ通す（初回は必ず通す）
+/// 複数スレッドが同時に期限を迎えた場合も、compare_exchangeに勝った1スレッドだけが通る
+/// </summary>
+class LogEveryMs {
+public:
+    explicit LogEveryMs(int64_t intervalMs) : m_interval(std::chrono::milliseconds(intervalMs)) {}
+
+    /// <summary>
+    /// 今回の呼び出しを出力するかを判定
+    /// </summary>
+    /// <returns>出力する場合true</returns>
+    bool Check() {
+        const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        int64_t next = m_next.load(std::memory_order_relaxed);
+        if (now < next) {
+            return false;
+        }
+        const int64_t interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_interval).count();
+        return m_next.compare_exchange_strong(next, now + interval, std::memory_order_relaxed);
+    }
+
+private:
+    const std::chrono::milliseconds m_interval;     // 間隔
+    std::atomic<int64_t> m_next{ INT64_MIN };       // 次に通す時刻（steady_clockのtick）
+};
+
+/// <summary>
+/// 最初の1回だけ通す
+/// </summary>
+class LogOnce {
+public:
+    /// <summary>
+    /// 今回の呼び出しを出力するかを判定
+    /// </summary>
+    /// <returns>出力する場合true</returns>
+    bool Check() {
+        // 2回目以降はロードだけで済ませる
+        return !m_done.load(std::memory_order_relaxed) && !m_done.exchange(true, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> m_done{ false };              // 出力済みかどうか
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// スコープの所要時間を計測し、スコープを抜ける時に1レコード出力するRAIIヘルパー（LOG_SCOPE_TIMER*マクロから使う）
+/// 所要時間は構造化フィールド「elapsed」として付く（例: "Import mesh elapsed=12.345ms"）
+/// Enabled=falseの場合（コンパイル時に取り除かれるレベル）は何もしない空の型になる
+/// </summary>
+template <bool Enabled>
+class LogScopeTimer {
+public:
+    /// <summary>
+    /// 計測を開始（レベル判定で出力されない場合は時計を読まない）
+    /// </summary>
+    /// <param name="level">ログレベル</param>
+    /// <param name="category">カテゴリハンドル</param>
+    /// <param name="name">スコープ名（メッセージ本文になる。参照するだけなので、このオブジェクトより長く生存する文字列を渡す。マクロは文字列リテラルに限定している）</param>
+    /// <param name="file">ソースファイル名</param>
+    /// <param name="line">行番号</param>
+    /// <param name="threshold">これ未満の所要時間では出力しない（0の場合は常に出力）</param>
+    LogScopeTimer(LogLevel level, LogCategoryId category, std::string_view name, const char* file, int line,
+                  std::chrono::nanoseconds threshold = std::chrono::nanoseconds::zero())
+        : m_name(name)
+        , m_file(file)
+        , m_line(line)
+        , m_threshold(threshold)
+        , m_level(level)
+        , m_category(category)
+        , m_active(Logger::GetInstance().IsEnabled(category, level)) {
+        if (m_active) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~LogScopeTimer() {
+        if (!m_active) {
+            return;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+        if (elapsed >= m_threshold) {
+            Logger::GetInstance().LogFields(m_level, m_category, m_name, { { "elapsed", elapsed } }, m_file, m_line);
+        }
+    }
+
+    // コピー禁止
+    LogScopeTimer(const LogScopeTimer&) = delete;
+    LogScopeTimer& operator=(const LogScopeTimer&) = delete;
+
+private:
+    std::string_view m_name;                            // スコープ名（所有しない）
+    const char* m_file;                                 // ソースファイル名
+    int m_line;                                         // 行番号
+    std::chrono::nanoseconds m_threshold;               // 出力する最小の所要時間
+    std::chrono::steady_clock::time_point m_start{};    // 計測開始時刻
+    LogLevel m_level;                                   // ログレベル
+    LogCategoryId m_category;                           // カテゴリハンドル
+    bool m_active;                                      // 計測中かどうか
+};
+
+template <>
+class LogScopeTimer<false> {
+public:
+    template <class... Args>
+    explicit LogScopeTimer(Args&&...) {}
+};
+
+/// <summary>
+/// 呼び出し箇所ごとの所要時間の集計（LOG_SCOPE_TIMER_ACCUMで呼び出し箇所ごとのstatic変数として置かれる）
+/// 回数・合計・最小・最大をロックなしで加算し、Logger::Flushで要約表として出力してリセットする
+/// </summary>
+class LogScopeStats {
+public:
+    /// <summary>
+    /// 集計値（TakeSnapshotの戻り値）
+    /// </summary>
+    struct Snapshot {
+        uint64_t count = 0;             // 回数
+        uint64_t totalNs = 0;           // 合計（ナノ秒）
+        uint64_t minNs = 0;             // 最小（ナノ秒）
+        uint64_t maxNs = 0;             // 最大（ナノ秒）
+    };
+
+    /// <summary>
+    /// 呼び出し箇所を登録（Loggerの集計一覧に加わる）
+    /// </summary>
+    /// <param name="category">カテゴリ名（静的な文字列）</param>
+    /// <param name="name">スコープ名（静的な文字列。所有せずプログラム終了まで参照する）</param>
+    /// <param name="file">ソースファイル名</param>
+    /// <param name="line">行番号</param>
+    LogScopeStats(std::string_view category, std::string_view name, const char* file, int line);
+
+    /// <summary>
+    /// Loggerの集計一覧から外す
+    /// </summary>
+    ~LogScopeStats();
+
+    // コピー禁止
+    LogScopeStats(const LogScopeStats&) = delete;
+    LogScopeStats& operator=(const LogScopeStats&) = delete;
+
+    /// <summary>
+    /// 1回分の所要時間を加算（複数スレッドから呼べる）
+    /// </summary>
+    /// <param name="elapsed">所要時間</param>
+    void Add(std::chrono::nanoseconds elapsed) {
+        const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t current = m_minNs.load(std::memory_order_relaxed);
+        while (ns < current && !m_minNs.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {}
+        current = m_maxNs.load(std::memory_order_relaxed);
+        while (ns > current && !m_maxNs.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {}
+    }
+
+    /// <summary>
+    /// 集計値を取得してリセット
+    /// 加算中のスレッドがある場合、その1回分は今回と次回のどちらか（値によっては両方に分かれて）数えられる
+    /// </summary>
+    /// <returns>前回のリセット以降の集計値</returns>
+    Snapshot TakeSnapshot();
+
+    LogCategoryId GetCategoryId() const { return m_categoryId; }
+    std::string_view GetCategory() const { return m_category; }
+    std::string_view GetName() const { return m_name; }
+    const char* GetFile() const { return m_file; }
+    int GetLine() const { return m_line; }
+
+private:
+    std::string_view m_category;                        // カテゴリ名
+    LogCategoryId m_categoryId;                         // カテゴリハンドル（レベル判定用）
+    std::string_view m_name;                            // スコープ名（所有しない）
+    const char* m_file;                                 // ソースファイル名
+    int m_line;                                         // 行番号
+    std::atomic<uint64_t> m_count{ 0 };                 // 回数
+    std::atomic<uint64_t> m_totalNs{ 0 };               // 合計（ナノ秒）
+    std::atomic<uint64_t> m_minNs{ UINT64_MAX };        // 最小（ナノ秒）
+    std::atomic<uint64_t> m_maxNs{ 0 };                 // 最大（ナノ秒）
+};
+
+/// <summary>
+/// スコープの所要時間をLogScopeStatsに加算するRAIIヘルパー（LOG_SCOPE_TIMER_ACCUMマクロから使う）
+/// 集計の要約はInfoレベルで出力されるため、カテゴリのレベルがInfoより高い場合は計測しない
+/// </summary>
+template <bool Enabled>
+class LogScopeAccumulator {
+public:
+    /// <summary>
+    /// 計測を開始
+    /// </summary>
+    /// <param name="stats">加算先</param>
+    explicit LogScopeAccumulator(LogScopeStats* stats)
+        : m_stats(Logger::GetInstance().IsEnabled(stats->GetCategoryId(), LogLevel::Info) ? stats : nullptr) {
+        if (m_stats) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~LogScopeAccumulator() {
+        if (m_stats) {
+            m_stats->Add(std::chrono::steady_clock::now() - m_start);
+        }
+    }
+
+    // コピー禁止
+    LogScopeAccumulator(const LogScopeAccumulator&) = delete;
+    LogScopeAccumulator& operator=(const LogScopeAccumulator&) = delete;
+
+private:
+    LogScopeStats* m_stats;                             // 加算先（計測しない場合はnullptr）
+    std::chrono::steady_clock::time_point m_start{};    // 計測開始時刻
+};
+
+template <>
+class LogScopeAccumulator<false> {
+public:
+    template <class... Args>
+    explicit LogScopeAccumulator(Args&&...) {}
+};
+
+} // namespace RenderingSandbox
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "LogMessage.h"
+#include "LogPattern.h"
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace RenderingSandbox {
 
@@ -23,6 +27,13 @@ class ILogSink {
     /// </summary>
     virtual void Flush() {}
 
+    /// <summary>
+    /// クラッシュ時にLogCrashHandlerから（シグナルハンドラ内で）呼ばれる（オプション）
+    /// ロックの取得・ヒープ確保を行わず、未書き出しのバッファがあれば出力先へ書き出す
+    /// </summary>
+    /// <returns>クラッシュレポート（配信前のレコードとバックトレース）をテキストで追記できるファイルディスクリプタ（できない場合は-1）</returns>
+    virtual int EmergencyFlush() noexcept { return -1; }
+
     /// <summary>
     /// このSinkの有効/無効を設定
     /// </summary>
@@ -47,6 +58,19 @@ class ILogSink {
     /// <returns>最小ログレベル</returns>
     LogLevel GetMinLevel() const { return m_minLevel; }
 
+    /// <summary>
+    /// 出力パターンを設定（書式はLogPatternを参照）
+    /// ログ出力中のスレッドがある状態での変更は想定しない（初期化時に呼ぶこと）
+    /// </summary>
+    /// <param name="pattern">パターン文字列</param>
+    void SetPattern(std::string_view pattern) { m_pattern = LogPattern::Compile(pattern); }
+
+    /// <summary>
+    /// 出力パターンを取得
+    /// </summary>
+    /// <returns>コンパイル済みパターン</returns>
+    const LogPattern& GetPattern() const { return *m_pattern; }
+
 protected:
     /// <summary>
     /// このメッセージを出力すべきかどうかを判定
@@ -57,9 +81,21 @@ class ILogSink {
         return m_enabled && message.level >= m_minLevel;
     }
 
+    /// <summary>
+    /// このSinkのパターンでメッセージを整形
+    /// 同じパターンを使う他のSinkが同じ配信中に整形済みであれば、その結果を再利用する
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    /// <returns>整形結果（次の書き込みまで有効）</returns>
+    std::string_view FormatRecord(const LogMessage& message) {
+        return LogFormatCache::Format(message, *m_pattern, m_formatBuffer);
+    }
+
 private:
     bool m_enabled = true;                      // Sinkが有効かどうか
     LogLevel m_minLevel = LogLevel::Trace;      // 最小ログレベル
+    std::shared_ptr<const LogPattern> m_pattern = LogPattern::GetDefault();    // 出力パターン
+    std::string m_formatBuffer;                 // キャッシュを使えない場合の整形先
 };
 
 } // namespace RenderingSandbox
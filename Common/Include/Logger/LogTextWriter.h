@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// タイムスタンプ文字列（HH:MM:SS.mmm）の長さ
+/// </summary>
+inline constexpr size_t kLogTimeLength = 12;
+
+/// <summary>
+/// 符号なし整数を10進数で書き込む（std::to_stringやiostreamを使わない）
+/// </summary>
+/// <param name="out">書き込み先（最大20文字）</param>
+/// <param name="value">値</param>
+/// <returns>書き込んだ末尾の次の位置</returns>
+char* LogWriteUInt(char* out, uint64_t value);
+
+/// <summary>
+/// 符号なし整数を指定桁数で0埋めして書き込む（桁あふれした上位桁は切り捨て）
+/// </summary>
+/// <param name="out">書き込み先（width文字）</param>
+/// <param name="value">値</param>
+/// <param name="width">桁数</param>
+/// <returns>書き込んだ末尾の次の位置</returns>
+char* LogWriteUIntPadded(char* out, uint32_t value, int width);
+
+/// <summary>
+/// タイムスタンプをローカル時刻の HH:MM:SS.mmm 形式で書き込む
+/// 年月日時分秒への分解（localtime）は秒が変わった時だけ行い、スレッドごとにキャッシュする
+/// </summary>
+/// <param name="out">書き込み先（kLogTimeLength文字）</param>
+/// <param name="timestamp">タイムスタンプ</param>
+/// <returns>書き込んだ末尾の次の位置</returns>
+char* LogWriteTime(char* out, std::chrono::system_clock::time_point timestamp);
+
+/// <summary>
+/// 文字列をJSONの文字列リテラルとしてエスケープし、二重引用符で囲んで追記
+/// </summary>
+/// <param name="out">追記先</param>
+/// <param name="text">文字列（UTF-8）</param>
+void LogAppendJsonString(std::string& out, std::string_view text);
+
+/// <summary>
+/// パスからファイル名部分を取得（コンパイル時評価可能）
+/// LOG_*マクロで__FILE__に適用し、レコードごとの抽出処理をなくす
+/// </summary>
+/// <param name="path">ファイルパス</param>
+/// <returns>ファイル名部分の先頭</returns>
+constexpr const char* LogBaseName(const char* path) {
+    const char* name = path;
+    for (const char* p = path; *p != '\0'; ++p) {
+        if (*p == '/' || *p == '\\') {
+            name = p + 1;
+        }
+    }
+    return name;
+}
+
+} // namespace RenderingSandbox
@@ -1,14 +1,41 @@
 #pragma once
 
 #include "LogSink.h"
+#include "LogCategory.h"
+#include "LogCompileLevel.h"
+#include "LogField.h"
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <atomic>
+#include <condition_variable>
+#include <initializer_list>
+#include <thread>
+#include <type_traits>
 
 namespace RenderingSandbox {
 
+class LogQueue;
+class LogScopeStats;
+struct ThreadLogBuffer;
+struct LogSinkReaderSlot;
+
+/// <summary>
+/// 非同期モードでキューが満杯になった時（スレッドごとのバッファリングモードでは上限に達した時）の挙動
+/// </summary>
+enum class LogOverflowPolicy : uint8_t {
+    Block,          // 空きができるまで呼び出し元スレッドを待機させる
+    DropNewest,     // 追加しようとしたレコードを破棄
+    DropOldest      // キュー内の最古のレコードを破棄して追加
+};
+
+/// <summary>
+/// 登録したSinkを指すハンドル（RemoveSinkに渡す、0は無効）
+/// </summary>
+using LogSinkHandle = uint64_t;
+
 /// <summary>
 /// Loggerメインクラス（Singletonパターン）
 /// 複数のSinkを管理し、ログメッセージをすべてのSinkに配信する
@@ -29,12 +56,28 @@ class Logger {
 
     /// <summary>
     /// Sinkを追加
+    /// Sinkリストは不変のスナップショットを差し替える方式のため、ログ出力中のスレッドを止めずに追加できる
+    /// 古いリストで配信中のスレッドがすべて抜けるまで呼び出し側はブロックする
+    /// Sinkの中（Write/Flush）から呼んだ場合は自身の配信の終了を待ってデッドロックするため、何もせずに0を返す
     /// </summary>
-    /// <param name="sink">追加するSink（unique_ptr）</param>
-    void AddSink(std::unique_ptr<ILogSink> sink);
+    /// <param name="sink">追加するSink（unique_ptrも渡せる。呼び出し側も参照を持ち続ける場合はshared_ptrで渡す）</param>
+    /// <returns>RemoveSinkに渡すハンドル（sinkがnullptrの場合、Sinkの中から呼んだ場合は0）</returns>
+    LogSinkHandle AddSink(std::shared_ptr<ILogSink> sink);
 
     /// <summary>
-    /// すべてのSinkをクリア
+    /// Sinkを取り除く
+    /// 戻った時点で、取り除いたSinkへ配信中のスレッドはいない（以降のWriteも呼ばれない）
+    /// そのため配信中のスレッドがすべて抜けるまで呼び出し側はブロックする
+    /// Sinkの中（Write/Flush）から呼んだ場合は何もせずにnullptrを返す
+    /// </summary>
+    /// <param name="handle">AddSinkが返したハンドル</param>
+    /// <returns>取り除いたSink（見つからない場合、Sinkの中から呼んだ場合はnullptr）</returns>
+    std::shared_ptr<ILogSink> RemoveSink(LogSinkHandle handle);
+
+    /// <summary>
+    /// すべてのSinkをクリア（戻った時点で配信中のスレッドはいない）
+    /// 配信中のスレッドがすべて抜けるまで呼び出し側はブロックする
+    /// Sinkの中（Write/Flush）から呼んだ場合は何もしない
     /// </summary>
     void ClearSinks();
 
@@ -42,45 +85,136 @@ class Logger {
     /// ログメッセージを出力（汎用メソッド）
     /// </summary>
     /// <param name="level">ログレベル</param>
-    /// <param name="category">カテゴリ</param>
+    /// <param name="category">カテゴリ（文字列リテラルなどの定数式。実行時に決まるカテゴリはRegisterCategoryで得たハンドルを渡す）</param>
+    /// <param name="message">メッセージ本文</param>
+    /// <param name="file">ソースファイル名（省略可、静的な文字列であること。出力時はそのまま表示される）</param>
+    /// <param name="line">行番号（省略可）</param>
+    void Log(LogLevel level,
+             LogCategoryName category,
+             std::string_view message,
+             const char* file = "",
+             int line = 0);
+
+    /// <summary>
+    /// ログメッセージを出力（カテゴリハンドル指定）
+    /// レベル判定は呼び出し側（IsEnabled）で済んでいる前提で、判定を行わずに配信する
+    /// </summary>
+    /// <param name="level">ログレベル</param>
+    /// <param name="category">カテゴリハンドル</param>
     /// <param name="message">メッセージ本文</param>
     /// <param name="file">ソースファイル名（省略可）</param>
     /// <param name="line">行番号（省略可）</param>
     void Log(LogLevel level,
-             const std::string& category,
-             const std::string& message,
+             LogCategoryId category,
+             std::string_view message,
              const char* file = "",
              int line = 0);
 
+    /// <summary>
+    /// 構造化フィールド付きでログを出力（カテゴリハンドル指定）
+    /// フィールドはレコードのバッファにコピーされ、テキスト出力ではkey=value、JsonLinesSinkではJSONのメンバーになる
+    /// レベル判定は呼び出し側（IsEnabled）で済んでいる前提
+    /// </summary>
+    /// <param name="level">ログレベル</param>
+    /// <param name="category">カテゴリハンドル</param>
+    /// <param name="message">メッセージ本文</param>
+    /// <param name="fields">フィールド（例: { { "vendorId", desc.VendorId }, { "frameTime", elapsed } }）</param>
+    /// <param name="file">ソースファイル名（省略可）</param>
+    /// <param name="line">行番号（省略可）</param>
+    void LogFields(LogLevel level,
+                   LogCategoryId category,
+                   std::string_view message,
+                   std::initializer_list<LogField> fields,
+                   const char* file = "",
+                   int line = 0);
+
+    /// <summary>
+    /// 書式と引数を指定してログを出力（遅延フォーマット）
+    /// 引数はバッファにコピーするだけで、std::vformatはSinkへの出力時（非同期モードではドレインスレッド）に行う
+    /// レベル判定は呼び出し側（IsEnabled）で済んでいる前提
+    /// </summary>
+    /// <param name="level">ログレベル</param>
+    /// <param name="category">カテゴリハンドル</param>
+    /// <param name="file">ソースファイル名</param>
+    /// <param name="line">行番号</param>
+    /// <param name="format">書式文字列（コンパイル時に検証される）</param>
+    /// <param name="args">フォーマット引数（文字列または trivially copyable な値）</param>
+    template <class... Args>
+    void LogFormat(LogLevel level,
+                   LogCategoryId category,
+                   const char* file,
+                   int line,
+                   std::format_string<Args...> format,
+                   Args&&... args)
+    {
+        LogMessage logMessage = MakeMessage(level, category, file, line);
+        logMessage.formatString = format.get();
+        logMessage.formatter = &FormatLogArgs<std::remove_cvref_t<Args>...>;
+        logMessage.argKinds = kLogArgKinds<std::remove_cvref_t<Args>...>;
+        EncodeLogArgs(logMessage.payload, args...);
+        Submit(std::move(logMessage));
+    }
+
+    /// <summary>
+    /// カテゴリを登録してハンドルを取得（登録済みの場合は既存のハンドル）
+    /// マクロ展開箇所のstaticローカル変数で一度だけ解決することを想定
+    /// </summary>
+    /// <param name="category">カテゴリ名</param>
+    /// <returns>カテゴリハンドル</returns>
+    LogCategoryId RegisterCategory(std::string_view category) { return m_categories.Register(category); }
+
+    /// <summary>
+    /// カテゴリハンドルからカテゴリ名を取得（ロックなし、登録後は不変）
+    /// </summary>
+    /// <param name="category">カテゴリハンドル</param>
+    /// <returns>カテゴリ名（未登録のハンドルとkInvalidCategoryの場合は空）</returns>
+    const std::string& GetCategoryName(LogCategoryId category) const { return m_categories.GetName(category); }
+
+    /// <summary>
+    /// 登録済みのカテゴリ数を取得（有効なカテゴリハンドルはこれ未満）
+    /// </summary>
+    /// <returns>カテゴリ数</returns>
+    size_t GetCategoryCount() const { return m_categories.GetCount(); }
+
+    /// <summary>
+    /// 指定カテゴリ・レベルのログが出力対象かどうかを判定（ロックなし）
+    /// </summary>
+    /// <param name="category">カテゴリハンドル</param>
+    /// <param name="level">ログレベル</param>
+    /// <returns>出力対象の場合true</returns>
+    bool IsEnabled(LogCategoryId category, LogLevel level) const {
+        return level >= m_categories.GetMinLevel(category);
+    }
+
     /// <summary>
     /// Traceレベルのログを出力
     /// </summary>
-    void Trace(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Trace(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// Debugレベルのログを出力
     /// </summary>
-    void Debug(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Debug(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// Infoレベルのログを出力
     /// </summary>
-    void Info(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Info(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// Warningレベルのログを出力
     /// </summary>
-    void Warning(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Warning(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// Errorレベルのログを出力
     /// </summary>
-    void Error(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Error(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// Fatalレベルのログを出力
     /// </summary>
-    void Fatal(const std::string& category, const std::string& message, const char* file = "", int line = 0);
+    void Fatal(LogCategoryName category, std::string_view message, const char* file = "", int line = 0);
 
     /// <summary>
     /// グローバル最小ログレベルを設定（これ以下は全Sinkで出力しない）
@@ -99,34 +233,261 @@ class Logger {
     /// </summary>
     /// <param name="category">カテゴリ名</param>
     /// <param name="level">カテゴリ固有の最小ログレベル</param>
-    void SetCategoryLevel(const std::string& category, LogLevel level);
+    void SetCategoryLevel(std::string_view category, LogLevel level);
 
     /// <summary>
     /// カテゴリ固有の最小ログレベルをクリア（グローバルレベルに戻す）
     /// </summary>
     /// <param name="category">カテゴリ名</param>
-    void ClearCategoryLevel(const std::string& category);
+    void ClearCategoryLevel(std::string_view category);
 
     /// <summary>
     /// カテゴリ固有の最小ログレベルを取得
     /// </summary>
     /// <param name="category">カテゴリ名</param>
     /// <returns>カテゴリ固有のレベル（未設定の場合はグローバルレベル）</returns>
-    LogLevel GetCategoryLevel(const std::string& category) const;
+    LogLevel GetCategoryLevel(std::string_view category) const;
 
     /// <summary>
     /// すべてのSinkをフラッシュ
+    /// LOG_SCOPE_TIMER_ACCUMの集計があれば、先に要約表を出力してリセットする
+    /// 非同期モードでは、呼び出し時点までにキューへ積まれたレコードの配信完了を待ってからフラッシュする
     /// </summary>
     void Flush();
 
+    /// <summary>
+    /// LOG_SCOPE_TIMER_ACCUMの集計を要約表（1レコード、Infoレベル、カテゴリ"ScopeTimer"）として出力してリセット
+    /// 前回の出力以降に1回も計測されていない呼び出し箇所は含めない
+    /// </summary>
+    void WriteScopeStatsSummary();
+
+    /// <summary>
+    /// 集計対象の呼び出し箇所を登録（LogScopeStatsのコンストラクタから呼ばれる）
+    /// </summary>
+    void RegisterScopeStats(LogScopeStats* stats);
+
+    /// <summary>
+    /// 集計対象の呼び出し箇所を登録解除（LogScopeStatsのデストラクタから呼ばれる）
+    /// </summary>
+    void UnregisterScopeStats(LogScopeStats* stats);
+
+    /// <summary>
+    /// 非同期モードを有効化
+    /// 以降のログはキューに積まれ、専用のドレインスレッドがSinkへ配信する
+    /// ログ出力中のスレッドがある状態での切り替えは想定しない（初期化時に呼ぶこと）
+    /// </summary>
+    /// <param name="capacity">キューに保持できるレコード数（2のべき乗に切り上げ）</param>
+    /// <param name="policy">キューが満杯になった時の挙動</param>
+    void EnableAsync(size_t capacity = 8192, LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+    /// <summary>
+    /// 非同期モードを無効化（キューに残ったレコードを配信してからドレインスレッドを停止）
+    /// 切り替え時点でキューに積んでいる最中のレコードも、積み終わるのを待ってから配信する
+    /// 無効化が終わるまで、他のスレッドのログは同期配信に切り替えずに待機する（スレッド内の順序を保つため）
+    /// </summary>
+    void DisableAsync();
+
+    /// <summary>
+    /// 非同期モードかどうかを取得
+    /// </summary>
+    /// <returns>非同期モードの場合true</returns>
+    bool IsAsync() const { return m_asyncEnabled.load(std::memory_order_acquire); }
+
+    /// <summary>
+    /// スレッドごとのバッファリングモードを有効化
+    /// 以降のログは各スレッドが自分専用のバッファに積むだけで戻り（Sinkのロックを取らない）、
+    /// CollectThreadBuffers()またはFlush()の呼び出し時にタイムスタンプ順にマージしてSinkへ配信する
+    /// 同じスレッドのレコードは出力順が保たれる（時刻が逆行した場合もスレッド内の順序を優先する）
+    /// </summary>
+    /// <param name="budgetBytes">1スレッドあたりのバッファ上限（バイト）</param>
+    /// <param name="policy">上限に達した時の挙動（Blockの場合はそのスレッドが全スレッド分をマージして配信する）</param>
+    void EnableThreadBuffers(size_t budgetBytes = 1024 * 1024, LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+    /// <summary>
+    /// スレッドごとのバッファリングモードを無効化（バッファに残ったレコードを配信する）
+    /// </summary>
+    void DisableThreadBuffers();
+
+    /// <summary>
+    /// スレッドごとのバッファリングモードかどうかを取得
+    /// </summary>
+    /// <returns>有効な場合true</returns>
+    bool IsThreadBuffered() const { return m_threadBuffered.load(std::memory_order_acquire); }
+
+    /// <summary>
+    /// 全スレッドのバッファをタイムスタンプ順にマージしてSinkへ配信（フレーム境界で呼ぶ）
+    /// 配信はバッファの回収用ロックを解放してから行う。配信中のSinkから呼ばれた場合は何もしない
+    /// （Sinkが配信中に出したログは呼び出しスレッドのバッファに積まれ、次の回収で配信される）
+    /// </summary>
+    void CollectThreadBuffers();
+
+    /// <summary>
+    /// キューあふれで破棄されたレコード数を取得
+    /// </summary>
+    /// <returns>破棄されたレコードの累計</returns>
+    uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// スレッドの開始時に呼ぶフックを設定（nullptrで解除）
+    /// LogCrashHandlerが登録中だけ代替スタックの設定を登録する（Logger自身はクラッシュハンドラに依存しない）
+    /// </summary>
+    /// <param name="hook">フック（呼び出したスレッドで実行される）</param>
+    void SetThreadStartHook(void (*hook)()) { m_threadStartHook.store(hook, std::memory_order_release); }
+
+    /// <summary>
+    /// スレッドの開始時に呼ぶ（フックが設定されていれば実行する）
+    /// Loggerのドレインスレッド・Sinkのバックグラウンドスレッド・アプリのワーカースレッドの先頭で呼ぶ
+    /// </summary>
+    void OnThreadStart() const {
+        if (void (*hook)() = m_threadStartHook.load(std::memory_order_acquire)) {
+            hook();
+        }
+    }
+
+    /// <summary>
+    /// 登録済みのSinkを列挙（LogCrashHandler用）
+    /// ロックとヒープ確保を行わないため、シグナルハンドラから呼べる（Sinkの付け替えと同時にクラッシュした場合は保証しない）
+    /// </summary>
+    /// <param name="function">各Sinkに対して呼び出す関数（ILogSink&を受け取る）</param>
+    template <class Function>
+    void ForEachSinkUnsafe(Function&& function) noexcept {
+        if (const SinkList* sinks = m_sinks.load(std::memory_order_acquire)) {
+            for (const SinkEntry& entry : *sinks) {
+                function(*entry.sink);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Sinkへ配信される前のレコード（非同期キュー・スレッドごとのバッファ）を列挙（LogCrashHandler用）
+    /// ロックとヒープ確保を行わないため、シグナルハンドラから呼べる
+    /// スレッドごとのバッファはミューテックスを使わず、変更中のフラグが立っているバッファは読み飛ばす
+    /// </summary>
+    /// <param name="function">各レコードに対して呼び出す関数（const LogMessage&を受け取る）</param>
+    template <class Function>
+    void ForEachPendingRecord(Function&& function) noexcept {
+        VisitPendingRecords([](const LogMessage& message, void* context) {
+            (*static_cast<std::remove_reference_t<Function>*>(context))(message);
+        }, &function);
+    }
+
 private:
     Logger();
     ~Logger();
 
-    std::vector<std::unique_ptr<ILogSink>> m_sinks;                     // 登録されたSinkのリスト
-    LogLevel m_globalMinLevel;                                          // グローバル最小ログレベル
-    std::unordered_map<std::string, LogLevel> m_categoryLevels;         // カテゴリ固有のログレベル
-    mutable std::mutex m_mutex;                                         // スレッドセーフのためのミューテックス
+    /// <summary>
+    /// タイムスタンプとスレッドIDを付けてレコードを構築（本文は空）
+    /// </summary>
+    LogMessage MakeMessage(LogLevel level, LogCategoryId category, const char* file, int line) const;
+
+    /// <summary>
+    /// レコードを配信（スレッドごとのバッファリングモードではスレッドのバッファへ、それ以外はDeliverへ）
+    /// </summary>
+    void Submit(LogMessage&& message);
+
+    /// <summary>
+    /// レコードを配信（非同期モードではキューに積み、それ以外は直接Sinkへ）
+    /// </summary>
+    void Deliver(LogMessage&& message);
+
+    /// <summary>
+    /// 呼び出しスレッドのバッファにレコードを積む
+    /// </summary>
+    /// <returns>積んだ（または破棄した）場合true、バッファリングモードでなくなっていた場合false</returns>
+    bool AppendToThreadBuffer(LogMessage& message);
+
+    /// <summary>
+    /// レコードをすべてのSinkに配信（Sinkリストのスナップショットを取得するだけでロックしない）
+    /// </summary>
+    void Dispatch(const LogMessage& message);
+
+    /// <summary>
+    /// 登録済みのSink
+    /// </summary>
+    struct SinkEntry {
+        LogSinkHandle handle;                   // ハンドル
+        std::shared_ptr<ILogSink> sink;         // Sink
+    };
+    using SinkList = std::vector<SinkEntry>;
+
+    /// <summary>
+    /// 配信用に現在のSinkリストを取得し、呼び出しスレッドのスロットに参照中として公開する（ハザードポインタ）
+    /// ReleaseSinksと対で呼ぶ。Sinkの中から再び呼ばれた場合は外側の取得をそのまま使う
+    /// </summary>
+    /// <returns>Sinkリスト（ReleaseSinksまで解放されない）</returns>
+    const SinkList* AcquireSinks();
+
+    /// <summary>
+    /// AcquireSinksで公開した参照を取り下げる
+    /// </summary>
+    void ReleaseSinks();
+
+    /// <summary>
+    /// AcquireSinks/ReleaseSinksを対で呼ぶスコープ（Logger.cppで定義）
+    /// </summary>
+    class SinkReadScope;
+
+    /// <summary>
+    /// 新しいSinkリストを公開し、古いリストを参照しているスロットがなくなるのを待って古いリストを解放する（m_sinkMutexを取得した状態で呼ぶ）
+    /// </summary>
+    void PublishSinks(std::unique_ptr<const SinkList> sinks);
+
+    /// <summary>
+    /// ForEachPendingRecordの本体
+    /// </summary>
+    void VisitPendingRecords(void (*visitor)(const LogMessage&, void*), void* context) noexcept;
+
+    /// <summary>
+    /// レコードを非同期キューに積む（オーバーフローポリシーに従う）
+    /// </summary>
+    void Enqueue(LogMessage&& message);
+
+    /// <summary>
+    /// ドレインスレッドを起こす（待機中の場合のみ）
+    /// </summary>
+    void WakeDrainThread();
+
+    /// <summary>
+    /// ドレインスレッドの本体
+    /// </summary>
+    void DrainLoop();
+
+    std::atomic<const SinkList*> m_sinks;                               // 登録されたSinkのリスト（不変のスナップショット、m_sinkMutexの下で差し替える）
+    std::unique_ptr<LogSinkReaderSlot[]> m_sinkReaders;                 // 配信中のスレッドが参照しているリストを公開するスロット
+    LogCategoryRegistry m_categories;                                   // カテゴリ名とカテゴリごとの最小ログレベル
+    std::mutex m_sinkMutex;                                             // Sinkリストの更新同士を排他するミューテックス（配信では取得しない）
+    LogSinkHandle m_nextSinkHandle;                                     // 次に割り当てるSinkハンドル
+    std::atomic<void (*)()> m_threadStartHook;                          // スレッドの開始時に呼ぶフック（未設定はnullptr）
+
+    // 非同期モード
+    std::unique_ptr<LogQueue> m_queue;                                  // 生産者→ドレインスレッドのキュー
+    LogOverflowPolicy m_overflowPolicy;                                 // 満杯時の挙動
+    std::thread m_drainThread;                                          // ドレインスレッド
+    std::mutex m_drainMutex;                                            // ドレインスレッドの待機用
+    std::condition_variable m_drainCondition;                           // ドレインスレッドの起床通知
+    std::condition_variable m_flushCondition;                           // Flush待ちへの配信完了通知
+    std::atomic<bool> m_asyncEnabled;                                   // 非同期モードが有効か
+    std::atomic<bool> m_drainStop;                                      // ドレインスレッドの停止要求
+    std::atomic<bool> m_drainWaiting;                                   // ドレインスレッドが待機中か
+    std::atomic<bool> m_asyncStopping;                                  // 非同期モードを無効化している最中か
+    std::atomic<uint32_t> m_asyncProducers;                             // キューに積んでいる最中のスレッド数
+    std::atomic<uint64_t> m_enqueuedCount;                              // キューに積んだレコードの累計
+    std::atomic<uint64_t> m_consumedCount;                              // キューから取り出したレコードの累計
+    std::atomic<uint64_t> m_droppedCount;                               // 破棄したレコードの累計
+
+    // スレッドごとのバッファリングモード
+    std::vector<std::shared_ptr<ThreadLogBuffer>> m_threadBuffers;      // 登録済みのスレッドバッファ
+    std::mutex m_threadBufferMutex;                                     // スレッドバッファの登録と回収を保護
+    std::mutex m_threadBufferDeliverMutex;                              // 回収したレコードの配信を直列化（回収の順に配信する）
+    std::vector<LogMessage> m_collectedRecords;                         // 回収してマージしたレコード（m_threadBufferDeliverMutexで保護、容量を使い回す）
+    std::atomic<bool> m_threadBuffered;                                 // スレッドごとのバッファリングモードが有効か
+    std::atomic<bool> m_threadBuffersWriting;                           // m_threadBuffersを変更中か（VisitPendingRecordsは読まない）
+    size_t m_threadBufferBudget;                                        // 1スレッドあたりのバッファ上限（バイト）
+    LogOverflowPolicy m_threadBufferPolicy;                             // 上限に達した時の挙動
+
+    // スコープ時間の集計
+    std::vector<LogScopeStats*> m_scopeStats;                           // 登録済みの呼び出し箇所
+    std::mutex m_scopeStatsMutex;                                       // m_scopeStatsの保護
 };
 
 } // namespace RenderingSandbox
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "LogSink.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// メモリマップドファイルへのリングバッファ出力Sink
+/// 固定サイズのファイルを事前に確保してマップし、レコードをバイナリのまま循環的に書き込む
+/// 書き込みはマップ領域へのmemcpyのみでシステムコールを伴わないため、高頻度のTraceログ向け
+/// プロセスがクラッシュしてもOSのページキャッシュに残るため、直近のログを事後に読み出せる
+///
+/// ファイル構成: [ヘッダ 64バイト][データ領域（リング）]
+///   ヘッダ: マジック、バージョン、データ領域サイズ、書き込み位置(head)、最古のレコード位置(tail)
+///   レコード: [固定長ヘッダ 32バイト][カテゴリ][ファイル名][本文]（8バイト境界に整列）
+///   head/tailは単調増加する論理オフセットで、実際の位置はデータ領域サイズでの剰余
+/// </summary>
+class MappedFileSink : public ILogSink {
+public:
+    /// <summary>
+    /// 既定のデータ領域サイズ（16MB）
+    /// </summary>
+    static constexpr size_t kDefaultCapacity = 16 * 1024 * 1024;
+
+    /// <summary>
+    /// ファイルパスとリングのサイズを指定してMappedFileSinkを構築
+    /// </summary>
+    /// <param name="filePath">ログファイルのパス</param>
+    /// <param name="capacity">データ領域のサイズ（バイト）</param>
+    /// <param name="append">trueの場合、同じサイズの有効なファイルがあれば続きから書き込む</param>
+    explicit MappedFileSink(const std::filesystem::path& filePath, size_t capacity = kDefaultCapacity, bool append = true);
+
+    ~MappedFileSink() override;
+
+    // コピー・ムーブ禁止
+    MappedFileSink(const MappedFileSink&) = delete;
+    MappedFileSink& operator=(const MappedFileSink&) = delete;
+
+    /// <summary>
+    /// ログメッセージをマップ領域に書き込む
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    void Write(const LogMessage& message) override;
+
+    /// <summary>
+    /// マップ領域をファイルに同期（通常は不要、OSクラッシュへの備え）
+    /// </summary>
+    void Flush() override;
+
+    /// <summary>
+    /// ファイルが正常にマップされているかを確認
+    /// </summary>
+    /// <returns>マップされている場合true</returns>
+    bool IsOpen() const { return m_view != nullptr; }
+
+    /// <summary>
+    /// ログファイルのパスを取得
+    /// </summary>
+    /// <returns>ログファイルのパス</returns>
+    const std::filesystem::path& GetFilePath() const { return m_filePath; }
+
+    /// <summary>
+    /// リングファイルを古い順に読み出す（MappedFileSinkが書いたファイル用）
+    /// </summary>
+    /// <param name="filePath">ログファイルのパス</param>
+    /// <param name="callback">レコードごとに呼ばれる関数（messageは呼び出し中のみ有効）</param>
+    /// <returns>ファイルが有効なリングファイルだった場合true</returns>
+    static bool ReadFile(const std::filesystem::path& filePath, const std::function<void(const LogMessage&)>& callback);
+
+private:
+    /// <summary>
+    /// ファイルを開いてマップする
+    /// </summary>
+    bool Map(size_t fileSize);
+
+    /// <summary>
+    /// マップを解除してファイルを閉じる
+    /// </summary>
+    void Unmap();
+
+    /// <summary>
+    /// 最古のレコードを1つ破棄（tailを進める）
+    /// </summary>
+    void EvictOldest();
+
+    /// <summary>
+    /// sizeバイト書き込めるまで古いレコードを破棄
+    /// </summary>
+    void Reserve(size_t size);
+
+    std::filesystem::path m_filePath;       // ログファイルのパス
+    size_t m_capacity;                      // データ領域のサイズ
+    uint8_t* m_view;                        // マップ領域の先頭（ヘッダ）
+    uint8_t* m_data;                        // データ領域の先頭
+    void* m_fileHandle;                     // ファイルハンドル（Windows）
+    void* m_mappingHandle;                  // マッピングハンドル（Windows）
+    int m_fd;                               // ファイルディスクリプタ（POSIX）
+    std::mutex m_mutex;                     // スレッドセーフのためのミューテックス
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "LogSink.h"
+#include "LogCategory.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// RingBufferSinkの絞り込み条件
+/// </summary>
+struct RingBufferFilter {
+    LogLevel minLevel = LogLevel::Trace;    // 表示する最小ログレベル
+    std::span<const bool> categories{};     // カテゴリハンドルごとの表示可否（範囲外のハンドルと空の場合は表示）
+    std::string_view text{};                // 本文に含まれる文字列（空の場合は絞り込まない、大文字小文字は区別する）
+};
+
+/// <summary>
+/// RingBufferSinkに保持されている1レコード
+/// </summary>
+struct RingBufferRecord {
+    LogLevel level = LogLevel::Info;        // ログレベル
+    LogCategoryId categoryId = 0;           // カテゴリハンドル（LoggerのLogCategoryRegistryが払い出したもの）
+    int64_t timestamp = 0;                  // タイムスタンプ（UNIX時刻、マイクロ秒）
+    std::string_view text{};                // 本文（Viewが有効な間だけ参照可能）
+};
+
+/// <summary>
+/// 直近のレコードをメモリ上のリングに保持するSink（ImGuiのログウィンドウ用）
+/// レコードは事前確保したSoA配列（レベル・カテゴリID・タイムスタンプ・本文の位置）と本文用のアリーナに格納し、
+/// 書き込み・絞り込みともにヒープ確保を行わない
+/// レコードには通し番号（シーケンス番号）が振られ、古いものから上書きされても番号は変わらない
+/// 読み出しはLock()が返すViewを通して行い、Viewが有効な間は書き込みが待たされる
+/// </summary>
+class RingBufferSink : public ILogSink {
+public:
+    /// <summary>
+    /// 読み出し用のビュー（保持している間はSinkのミューテックスを取得したまま）
+    /// 使用例（ImGuiClipperで可視範囲のみ描画）:
+    ///   auto view = sink.Lock();
+    ///   view.Filter(filter, sequences, cursor);
+    ///   clipper.Begin(static_cast<int>(sequences.size()));
+    ///   while (clipper.Step()) { for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) { auto record = view.Get(sequences[i]); ... } }
+    /// </summary>
+    class View {
+    public:
+        /// <summary>
+        /// 条件に合うレコードのシーケンス番号を古い順に集める
+        /// cursorには前回の呼び出しで返された値を渡すと、それ以降に追加されたレコードだけを調べて追記する
+        /// （条件を変えた場合はsequencesを空にしてcursorを0にする）。上書きされたレコードはsequencesの先頭から取り除く
+        /// </summary>
+        /// <param name="filter">絞り込み条件</param>
+        /// <param name="sequences">シーケンス番号の書き込み先（確保済みの容量を再利用）</param>
+        /// <param name="cursor">前回の続きの位置（次回用の値に更新される）</param>
+        void Filter(const RingBufferFilter& filter, std::vector<uint64_t>& sequences, uint64_t& cursor) const;
+
+        /// <summary>
+        /// 保持しているレコードを取得
+        /// </summary>
+        /// <param name="sequence">シーケンス番号（GetFirstSequence以上GetEndSequence未満）</param>
+        /// <returns>レコード</returns>
+        RingBufferRecord Get(uint64_t sequence) const;
+
+        /// <summary>
+        /// 保持している最古のレコードのシーケンス番号を取得
+        /// </summary>
+        uint64_t GetFirstSequence() const { return m_sink.m_tail; }
+
+        /// <summary>
+        /// 次に書き込まれるレコードのシーケンス番号を取得
+        /// </summary>
+        uint64_t GetEndSequence() const { return m_sink.m_head; }
+
+        /// <summary>
+        /// これまでに登録されたカテゴリ数を取得（LoggerのLogCategoryRegistryの登録数）
+        /// </summary>
+        size_t GetCategoryCount() const;
+
+        /// <summary>
+        /// カテゴリハンドルからカテゴリ名を取得
+        /// </summary>
+        std::string_view GetCategoryName(LogCategoryId categoryId) const;
+
+    private:
+        friend class RingBufferSink;
+        explicit View(const RingBufferSink& sink);
+
+        const RingBufferSink& m_sink;
+        std::unique_lock<std::mutex> m_lock;
+    };
+
+    /// <summary>
+    /// コンストラクタ（すべての領域をここで確保する）
+    /// </summary>
+    /// <param name="capacity">保持するレコード数の上限</param>
+    /// <param name="arenaBytes">本文用アリーナのバイト数（不足すると上限より前に古いレコードから上書きされる）</param>
+    explicit RingBufferSink(size_t capacity = 65536, size_t arenaBytes = 65536 * 128);
+    ~RingBufferSink() override = default;
+
+    /// <summary>
+    /// レコードを保持
+    /// </summary>
+    /// <param name="message">ログメッセージ</param>
+    void Write(const LogMessage& message) override;
+
+    /// <summary>
+    /// 読み出し用のビューを取得
+    /// </summary>
+    /// <returns>ビュー</returns>
+    View Lock() const { return View(*this); }
+
+    /// <summary>
+    /// 保持しているレコードを破棄（シーケンス番号は継続）
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// 保持するレコード数の上限を取得
+    /// </summary>
+    size_t GetCapacity() const { return m_capacity; }
+
+private:
+    /// <summary>
+    /// 本文を指定位置に書き込めるように、重なる古いレコードを取り除く
+    /// </summary>
+    void EvictUntil(uint64_t textEnd);
+
+    const size_t m_capacity;                                // 保持するレコード数の上限
+    const size_t m_arenaBytes;                              // アリーナのバイト数
+
+    // レコード（SoA、シーケンス番号 % m_capacity の位置に格納）
+    std::unique_ptr<LogLevel[]> m_levels;                   // ログレベル
+    std::unique_ptr<LogCategoryId[]> m_categoryIds;         // カテゴリハンドル
+    std::unique_ptr<int64_t[]> m_timestamps;                // タイムスタンプ（マイクロ秒）
+    std::unique_ptr<uint64_t[]> m_textOffsets;              // 本文の位置（アリーナ上の通算バイト位置）
+    std::unique_ptr<uint32_t[]> m_textLengths;              // 本文のバイト数
+    std::unique_ptr<char[]> m_arena;                        // 本文用アリーナ
+
+    uint64_t m_head = 0;                                    // 次に書き込むシーケンス番号
+    uint64_t m_tail = 0;                                    // 保持している最古のシーケンス番号
+    uint64_t m_arenaHead = 0;                               // アリーナの次の書き込み位置（通算バイト位置）
+
+    mutable std::mutex m_mutex;                             // スレッドセーフのためのミューテックス
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "MipChainBuilder.h"
+#include "TextureTaskPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// ブロック圧縮フォーマット（4x4ピクセルを1ブロックとして固定長に圧縮）
+/// </summary>
+enum class BlockFormat : uint8_t {
+    BC1,        // RGB＋1bitアルファ 8バイト/ブロック（不透明なアルベド等）
+    BC3,        // RGBA 16バイト/ブロック（BC4相当のアルファ＋BC1相当のカラー）
+    BC4,        // R 8バイト/ブロック（ラフネス・ハイト等の1チャンネル）
+    BC5,        // RG 16バイト/ブロック（BC4を2つ。法線マップのXY等）
+    BC6H,       // 符号なしHDR RGB 16バイト/ブロック（BC6H_UF16。環境マップ等）
+    BC7,        // RGBA 16バイト/ブロック（モード・パーティションを選んで高品質に表す。アルベド等）
+};
+
+/// <summary>
+/// 1ブロックあたりのバイト数を取得
+/// </summary>
+/// <param name="format">ブロック圧縮フォーマット</param>
+/// <returns>バイト数</returns>
+constexpr size_t GetBlockSize(BlockFormat format) {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+}
+
+/// <summary>
+/// 圧縮品質
+/// </summary>
+enum class BlockQuality : uint8_t {
+    Fast,       // 範囲の端点を内側へ寄せて使い、インデックスをSIMDで選ぶ（ベイク時の既定）。BC6H/BC7は見積もりの良いパーティションのみ試す
+    High,       // カラーはクラスタフィット、単チャンネルは端点の探索で誤差を最小化する（数倍〜十数倍遅い）。BC6H/BC7はすべてのモード・パーティションを試す
+};
+
+/// <summary>
+/// 使用するSIMD命令セット
+/// </summary>
+enum class BlockSimdLevel : uint8_t {
+    Scalar,     // SIMDを使わない
+    SSE2,       // 4ピクセル単位
+    AVX2,       // 8ピクセル単位
+};
+
+/// <summary>
+/// 圧縮設定
+/// </summary>
+struct BlockCompressOptions {
+    BlockQuality quality = BlockQuality::Fast;              // 圧縮品質
+    BlockSimdLevel maxSimdLevel = BlockSimdLevel::AVX2;     // 使用するSIMDの上限（CPUが対応していない命令は使わない）
+};
+
+/// <summary>
+/// 圧縮済みテクスチャの1レベル
+/// </summary>
+struct CompressedLevel {
+    uint32_t width = 0;         // 幅（ピクセル）
+    uint32_t height = 0;        // 高さ（ピクセル）
+    size_t offset = 0;          // CompressedTexture::data内の先頭位置（バイト）
+    size_t rowPitch = 0;        // ブロック1行あたりのバイト数
+    size_t size = 0;            // レベル全体のバイト数
+};
+
+/// <summary>
+/// 圧縮済みテクスチャ（全レベルを1つのバッファに連続して格納。各レベルはそのままGPUへ転送できる）
+/// </summary>
+struct CompressedTexture {
+    BlockFormat format = BlockFormat::BC1;      // ブロック圧縮フォーマット
+    bool srgb = false;                          // カラーがsRGBか（DXGI_FORMAT_BC1_UNORM_SRGB等として扱う）
+    std::vector<CompressedLevel> levels;        // 各レベルの情報（0が元のサイズ）
+    std::vector<uint8_t> data;                  // 全レベルのブロック
+
+    /// <summary>
+    /// レベルのブロックを取得
+    /// </summary>
+    std::span<const uint8_t> GetLevelData(size_t level) const {
+        return { data.data() + levels[level].offset, levels[level].size };
+    }
+};
+
+/// <summary>
+/// RGBA8の画像をBC1/BC3/BC4/BC5/BC7に、浮動小数点のHDR画像をBC6Hに圧縮するCPUエンコーダ
+/// 出力をブロック行の帯に分けてワーカースレッドと呼び出しスレッドで並列に処理する
+/// SIMDで選ぶのはBC1〜BC5のインデックスのみ（BC6H/BC7はモード・パーティションの探索が大半を占め、並列化で速くする）
+/// 幅・高さが4の倍数でないブロックは端のピクセルを繰り返して埋める
+/// 同時に呼び出せるのは1スレッドのみ（並列に圧縮する場合はエンコーダをスレッドごとに用意する）
+/// 使用例:
+///   MipChainBuilder builder; MipChain chain;
+///   builder.Build(image.pixels.get(), image.width, image.height, 0, MipPixelFormat::RGBA8UnormSrgb, chain);
+///   BlockCompressor compressor; CompressedTexture texture;
+///   compressor.Compress(chain, BlockFormat::BC1, texture);
+/// </summary>
+class BlockCompressor {
+public:
+    /// <summary>
+    /// ワーカースレッドを起動
+    /// </summary>
+    /// <param name="threadCount">並列数（呼び出しスレッドを含む。0の場合はハードウェアスレッド数、1の場合はワーカーなし）</param>
+    explicit BlockCompressor(uint32_t threadCount = 0);
+
+    // コピー禁止
+    BlockCompressor(const BlockCompressor&) = delete;
+    BlockCompressor& operator=(const BlockCompressor&) = delete;
+
+    /// <summary>
+    /// ミップチェーンの全レベルを圧縮
+    /// </summary>
+    /// <param name="chain">ミップチェーン（BC6HはRGBA16FloatまたはRGBA32Float、それ以外はRGBA8UnormまたはRGBA8UnormSrgb）</param>
+    /// <param name="format">ブロック圧縮フォーマット</param>
+    /// <param name="texture">圧縮結果（dataの確保済みの容量を再利用する）</param>
+    /// <param name="options">圧縮設定</param>
+    /// <returns>圧縮できた場合true（チェーンの画素フォーマットがformatに合わない場合はfalse）</returns>
+    bool Compress(const MipChain& chain, BlockFormat format, CompressedTexture& texture, const BlockCompressOptions& options = {});
+
+    /// <summary>
+    /// 1枚のRGBA8の画像を圧縮
+    /// </summary>
+    /// <param name="pixels">RGBA8の画素</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <param name="rowPitch">1行あたりのバイト数（0の場合は隙間なし）</param>
+    /// <param name="format">ブロック圧縮フォーマット（BC6H以外）</param>
+    /// <param name="blocks">出力先（GetCompressedSize以上のバイト数。ブロック行の間に隙間なし）</param>
+    /// <param name="options">圧縮設定</param>
+    /// <returns>圧縮できた場合true（formatがBC6Hの場合はfalse。CompressHdrImageを使う）</returns>
+    bool CompressImage(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, BlockFormat format,
+                       uint8_t* blocks, const BlockCompressOptions& options = {});
+
+    /// <summary>
+    /// 1枚の浮動小数点のHDR画像をBC6Hに圧縮（アルファは捨てる。負の値は0、半精度の最大値を超える値は最大値にする）
+    /// </summary>
+    /// <param name="pixels">pixelFormatの画素</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <param name="rowPitch">1行あたりのバイト数（0の場合は隙間なし）</param>
+    /// <param name="pixelFormat">RGBA16FloatまたはRGBA32Float（TextureLoaderのFloat32の4チャンネル画像はそのまま渡せる）</param>
+    /// <param name="blocks">出力先（GetCompressedSize以上のバイト数。ブロック行の間に隙間なし）</param>
+    /// <param name="options">圧縮設定</param>
+    /// <returns>圧縮できた場合true（pixelFormatが浮動小数点のRGBAでない場合はfalse）</returns>
+    bool CompressHdrImage(const void* pixels, uint32_t width, uint32_t height, size_t rowPitch, MipPixelFormat pixelFormat,
+                          uint8_t* blocks, const BlockCompressOptions& options = {});
+
+    /// <summary>
+    /// 並列数を取得（呼び出しスレッドを含む）
+    /// </summary>
+    uint32_t GetThreadCount() const { return m_pool.GetThreadCount(); }
+
+    /// <summary>
+    /// ブロックをRGBA8に展開（検証用の参照デコーダ。BC4は(R, 0, 0, 255)、BC5は(R, G, 0, 255)になる）
+    /// </summary>
+    /// <param name="blocks">圧縮済みのブロック（ブロック行の間に隙間なし）</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <param name="format">ブロック圧縮フォーマット（BC6H以外）</param>
+    /// <param name="pixels">出力先のRGBA8の画素</param>
+    /// <param name="rowPitch">出力の1行あたりのバイト数（0の場合は隙間なし）</param>
+    /// <returns>展開できた場合true（formatがBC6Hの場合はfalse。DecompressHdrImageを使う）</returns>
+    static bool DecompressImage(const uint8_t* blocks, uint32_t width, uint32_t height, BlockFormat format,
+                                uint8_t* pixels, size_t rowPitch = 0);
+
+    /// <summary>
+    /// BC6Hのブロックを半精度浮動小数点のRGBA（RGBA16Float、アルファは1.0）に展開（検証用の参照デコーダ）
+    /// </summary>
+    /// <param name="blocks">圧縮済みのブロック（ブロック行の間に隙間なし）</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <param name="pixels">出力先の画素（半精度浮動小数点のビット列×4）</param>
+    /// <param name="rowPitch">出力の1行あたりのバイト数（0の場合は隙間なし）</param>
+    static void DecompressHdrImage(const uint8_t* blocks, uint32_t width, uint32_t height, uint16_t* pixels, size_t rowPitch = 0);
+
+    /// <summary>
+    /// 圧縮後のバイト数を取得
+    /// </summary>
+    /// <param name="format">ブロック圧縮フォーマット</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <returns>バイト数</returns>
+    static size_t GetCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+    /// <summary>
+    /// CPUとOSが対応している最上位のSIMD命令セットを取得
+    /// </summary>
+    static BlockSimdLevel GetSupportedSimdLevel();
+
+private:
+    /// <summary>
+    /// ブロック行を帯に分けて並列に処理する
+    /// </summary>
+    /// <param name="blocksY">ブロックの行数</param>
+    /// <param name="blockCount">ブロックの総数</param>
+    /// <param name="minBlocksPerBand">1つの帯が担当する最小のブロック数</param>
+    /// <param name="processRows">帯（開始行、終了行）を処理する関数</param>
+    void ForEachBand(uint32_t blocksY, uint64_t blockCount, uint64_t minBlocksPerBand, const std::function<void(uint32_t, uint32_t)>& processRows);
+
+    TextureTaskPool m_pool;     // ブロック行の帯を並列に処理するワーカー
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RenderingSandbox {
+
+enum class BlockQuality : uint8_t;
+
+/// <summary>
+/// BC6H/BC7（BPTC）の1ブロック単位のエンコーダ・デコーダ
+/// エンコーダはモード・パーティションごとに端点を主軸から求めて最小二乗で合わせ直し、誤差が最小の組み合わせを選ぶ
+/// パーティションの選び方は品質で切り替える
+///   Fast: 各パーティションの誤差を主軸からの距離で見積もり、見積もりの良いものだけを実際に圧縮する
+///   High: すべてのモード・パーティション（BC7はモード4/5の回転も）を実際に圧縮して比べる
+/// ブロックは16バイト、画素は4x4を行優先で並べる
+/// </summary>
+class BptcCodec {
+public:
+    /// <summary>
+    /// BC7ブロックを圧縮
+    /// </summary>
+    /// <param name="pixels">16ピクセルのRGBA8（64バイト）</param>
+    /// <param name="quality">圧縮品質</param>
+    /// <param name="block">出力先（16バイト）</param>
+    static void EncodeBC7Block(const uint8_t* pixels, BlockQuality quality, uint8_t* block);
+
+    /// <summary>
+    /// BC7ブロックを展開
+    /// </summary>
+    /// <param name="block">ブロック（16バイト）</param>
+    /// <param name="pixels">出力先の16ピクセルのRGBA8（64バイト）</param>
+    /// <returns>展開できた場合true（予約されたモードの場合はすべて0を書き込んでfalse）</returns>
+    static bool DecodeBC7Block(const uint8_t* block, uint8_t* pixels);
+
+    /// <summary>
+    /// BC6H（符号なし、DXGI_FORMAT_BC6H_UF16）ブロックを圧縮
+    /// </summary>
+    /// <param name="pixels">16ピクセルのRGBの半精度浮動小数点のビット列（48要素。負の値とNaNは0、無限大は最大値として扱う）</param>
+    /// <param name="quality">圧縮品質</param>
+    /// <param name="block">出力先（16バイト）</param>
+    static void EncodeBC6HBlock(const uint16_t* pixels, BlockQuality quality, uint8_t* block);
+
+    /// <summary>
+    /// BC6H（符号なし）ブロックを展開
+    /// </summary>
+    /// <param name="block">ブロック（16バイト）</param>
+    /// <param name="pixels">出力先の16ピクセルのRGBの半精度浮動小数点のビット列（48要素）</param>
+    /// <returns>展開できた場合true（予約されたモードの場合はすべて0を書き込んでfalse）</returns>
+    static bool DecodeBC6HBlock(const uint8_t* block, uint16_t* pixels);
+
+    /// <summary>
+    /// ブロックのモード番号を取得（BC7は0〜7、BC6Hは仕様書の1〜14。予約されたモードは-1）
+    /// </summary>
+    static int GetBC7Mode(const uint8_t* block);
+    static int GetBC6HMode(const uint8_t* block);
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "TextureTaskPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// ミップチェーンの画素フォーマット（名前はDXGI_FORMATに対応）
+/// </summary>
+enum class MipPixelFormat : uint8_t {
+    RGBA8Unorm,         // 8bit RGBA（線形）
+    RGBA8UnormSrgb,     // 8bit RGBA（RGBはsRGB、アルファは線形）。縮小は線形空間で行う
+    RGBA16Float,        // 16bit浮動小数点 RGBA
+    R32Float,           // 32bit浮動小数点 1チャンネル
+    RGBA32Float,        // 32bit浮動小数点 RGBA（stbi_loadfで読み込んだHDR画像）
+};
+
+/// <summary>
+/// 画素フォーマットの1ピクセルあたりのバイト数を取得
+/// </summary>
+/// <param name="format">画素フォーマット</param>
+/// <returns>バイト数</returns>
+constexpr size_t GetMipPixelSize(MipPixelFormat format) {
+    switch (format) {
+        case MipPixelFormat::RGBA16Float: return 8;
+        case MipPixelFormat::RGBA32Float: return 16;
+        default:                          return 4;
+    }
+}
+
+/// <summary>
+/// 縮小フィルタ
+/// </summary>
+enum class MipFilter : uint8_t {
+    Box,            // 2x2の平均（2のべき乗のサイズで最も速い）
+    Triangle,       // 三角（テント）フィルタ
+    Mitchell,       // Mitchell-Netravali（stbir_resize_*の縮小時の既定）
+    CatmullRom,     // Catmull-Rom（シャープ）
+};
+
+/// <summary>
+/// ミップチェーンの生成設定
+/// </summary>
+struct MipChainOptions {
+    MipFilter filter = MipFilter::Box;  // 縮小フィルタ
+    bool wrapEdges = false;             // 端をラップして参照するか（タイリングするテクスチャ用、falseの場合はクランプ）
+    uint32_t maxLevels = 0;             // 生成する最大レベル数（0の場合は1x1まで）
+};
+
+/// <summary>
+/// ミップチェーンの1レベル
+/// </summary>
+struct MipLevel {
+    uint32_t width = 0;         // 幅（ピクセル）
+    uint32_t height = 0;        // 高さ（ピクセル）
+    size_t offset = 0;          // MipChain::data内の先頭位置（バイト）
+    size_t rowPitch = 0;        // 1行あたりのバイト数（隙間なし）
+};
+
+/// <summary>
+/// 生成したミップチェーン（全レベルを1つのバッファに連続して格納）
+/// </summary>
+struct MipChain {
+    MipPixelFormat format = MipPixelFormat::RGBA8Unorm;     // 画素フォーマット
+    std::vector<MipLevel> levels;                           // 各レベルの情報（0が元のサイズ）
+    std::vector<uint8_t> data;                              // 全レベルの画素データ
+
+    /// <summary>
+    /// レベルの画素データを取得
+    /// </summary>
+    std::span<const uint8_t> GetLevelData(size_t level) const {
+        return { data.data() + levels[level].offset, levels[level].rowPitch * levels[level].height };
+    }
+    std::span<uint8_t> GetLevelData(size_t level) {
+        return { data.data() + levels[level].offset, levels[level].rowPitch * levels[level].height };
+    }
+};
+
+/// <summary>
+/// stb_image_resize2でミップチェーンを生成するビルダー
+/// 各レベルは1つ上のレベルから縮小し、出力を走査線の帯（stbirのsplit）に分けてワーカースレッドと呼び出しスレッドで並列に処理する
+/// レベルごとのSTBIR_RESIZE（構築済みのサンプラー）は保持して再利用するため、
+/// 同じサイズ・フォーマットの画像を続けて処理する場合はフィルタ係数の計算とメモリ確保が初回だけになる
+/// 同時に呼び出せるのは1スレッドのみ（並列に生成する場合はビルダーをスレッドごとに用意する）
+/// </summary>
+class MipChainBuilder {
+public:
+    /// <summary>
+    /// ワーカースレッドを起動
+    /// </summary>
+    /// <param name="threadCount">並列数（呼び出しスレッドを含む。0の場合はハードウェアスレッド数、1の場合はワーカーなし）</param>
+    explicit MipChainBuilder(uint32_t threadCount = 0);
+
+    /// <summary>
+    /// ワーカースレッドを終了し、保持しているサンプラーを解放
+    /// </summary>
+    ~MipChainBuilder();
+
+    // コピー禁止
+    MipChainBuilder(const MipChainBuilder&) = delete;
+    MipChainBuilder& operator=(const MipChainBuilder&) = delete;
+
+    /// <summary>
+    /// ミップチェーンを生成
+    /// </summary>
+    /// <param name="pixels">レベル0の画素（formatと同じ形式）</param>
+    /// <param name="width">幅（ピクセル）</param>
+    /// <param name="height">高さ（ピクセル）</param>
+    /// <param name="rowPitch">1行あたりのバイト数（0の場合は隙間なし）</param>
+    /// <param name="format">画素フォーマット</param>
+    /// <param name="chain">生成結果（dataの確保済みの容量を再利用する）</param>
+    /// <param name="options">生成設定</param>
+    /// <returns>生成できた場合true</returns>
+    bool Build(const void* pixels, uint32_t width, uint32_t height, size_t rowPitch, MipPixelFormat format,
+               MipChain& chain, const MipChainOptions& options = {});
+
+    /// <summary>
+    /// 並列数を取得（呼び出しスレッドを含む）
+    /// </summary>
+    uint32_t GetThreadCount() const { return m_pool.GetThreadCount(); }
+
+    /// <summary>
+    /// 1x1までのレベル数を取得
+    /// </summary>
+    /// <param name="width">幅</param>
+    /// <param name="height">高さ</param>
+    /// <returns>レベル数</returns>
+    static uint32_t GetFullLevelCount(uint32_t width, uint32_t height);
+
+private:
+    struct LevelContext;
+
+    std::vector<std::unique_ptr<LevelContext>> m_levelContexts;     // レベルごとの縮小設定（サンプラーを再利用）
+    TextureTaskPool m_pool;                                         // レベル内の分割を並列に処理するワーカー
+};
+
+} // namespace RenderingSandbox
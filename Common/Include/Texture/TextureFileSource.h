@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 画像ファイルの読み込み方法
+/// </summary>
+enum class TextureFileReadMode : uint8_t {
+    Auto,       // kMapThreshold以上のファイルはメモリマップ、それ未満は一括読み込み
+    Map,        // 常にメモリマップ（失敗した場合は一括読み込み）
+    Read,       // 常に一括読み込み
+};
+
+/// <summary>
+/// デコーダ（stbi_load_from_memory）に渡すファイル内容を用意する読み込み元
+/// 大きいファイルは読み取り専用でメモリマップし、順次アクセスのヒント（POSIXはmadvise、WindowsはPrefetchVirtualMemory）を与える
+/// 小さいファイルはマップの作成・ページフォールトの方が高くつくため、呼び出し側が再利用するバッファへ1回の読み込み（pread/ReadFile）で読み込む
+/// stdioを経由しないため、stbi_loadのようにstbの内部バッファへ少しずつコピーされることもない
+/// </summary>
+class TextureFileSource {
+public:
+    /// <summary>
+    /// Autoでメモリマップに切り替えるファイルサイズ
+    /// </summary>
+    static constexpr size_t kMapThreshold = 256 * 1024;
+
+    TextureFileSource() = default;
+
+    /// <summary>
+    /// マップを解除
+    /// </summary>
+    ~TextureFileSource();
+
+    // コピー禁止
+    TextureFileSource(const TextureFileSource&) = delete;
+    TextureFileSource& operator=(const TextureFileSource&) = delete;
+
+    /// <summary>
+    /// ファイルを開いて内容を参照できるようにする（開いていたファイルは閉じる）
+    /// </summary>
+    /// <param name="path">ファイル</param>
+    /// <param name="scratch">一括読み込みの読み込み先（確保済みの容量を再利用し、Closeまで使用する）</param>
+    /// <param name="mode">読み込み方法</param>
+    /// <param name="error">失敗時の理由</param>
+    /// <returns>開けた場合true</returns>
+    bool Open(const std::filesystem::path& path, std::vector<uint8_t>& scratch, TextureFileReadMode mode, std::string& error);
+
+    /// <summary>
+    /// ファイルを閉じる（マップを解除する）
+    /// </summary>
+    void Close();
+
+    /// <summary>
+    /// ファイルの内容を取得（Closeまで有効）
+    /// </summary>
+    std::span<const uint8_t> GetData() const { return { m_data, m_size }; }
+
+    /// <summary>
+    /// メモリマップで参照しているかどうかを取得
+    /// </summary>
+    bool IsMapped() const { return m_mappedView != nullptr; }
+
+private:
+    const uint8_t* m_data = nullptr;        // ファイルの内容
+    size_t m_size = 0;                      // ファイルサイズ
+    void* m_mappedView = nullptr;           // マップ領域（一括読み込みの場合はnullptr）
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "TextureFileSource.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// 画素の成分の型
+/// </summary>
+enum class TextureComponentType : uint8_t {
+    UInt8,      // 8bit整数（LDR画像）
+    UInt16,     // 16bit整数（16bit PNG等、TextureLoadOptions::keep16Bitの場合のみ）
+    Float32,    // 32bit浮動小数点（HDR画像、TextureLoadOptions::loadHdrAsFloatの場合のみ）
+};
+
+/// <summary>
+/// 成分の型のバイト数を取得
+/// </summary>
+/// <param name="type">成分の型</param>
+/// <returns>1成分あたりのバイト数</returns>
+constexpr size_t GetComponentSize(TextureComponentType type) {
+    switch (type) {
+        case TextureComponentType::UInt16:  return 2;
+        case TextureComponentType::Float32: return 4;
+        default:                            return 1;
+    }
+}
+
+/// <summary>
+/// 画像の読み込み設定
+/// </summary>
+struct TextureLoadOptions {
+    int desiredChannels = 4;            // 出力するチャンネル数（1〜4、0の場合はファイルのチャンネル数のまま）
+    bool flipVertically = false;        // 上下を反転するか
+    bool loadHdrAsFloat = true;         // HDR画像（.hdr）をFloat32で読み込むか（falseの場合はトーンマップされたUInt8）
+    bool keep16Bit = false;             // 16bit画像をUInt16で読み込むか（falseの場合はUInt8に変換）
+    TextureFileReadMode readMode = TextureFileReadMode::Auto;   // ファイルの読み込み方法
+};
+
+/// <summary>
+/// stbが確保した画素データを解放するデリータ
+/// </summary>
+struct TexturePixelsDeleter {
+    void operator()(void* pixels) const noexcept;
+};
+
+/// <summary>
+/// デコード済みの画像（行は上から下へ隙間なく並ぶ）
+/// </summary>
+struct TextureImage {
+    std::filesystem::path path;                                     // 読み込んだファイル
+    uint32_t width = 0;                                             // 幅（ピクセル）
+    uint32_t height = 0;                                            // 高さ（ピクセル）
+    uint32_t channels = 0;                                          // 格納されているチャンネル数
+    uint32_t sourceChannels = 0;                                    // ファイル上のチャンネル数
+    TextureComponentType componentType = TextureComponentType::UInt8;   // 成分の型
+    std::unique_ptr<uint8_t, TexturePixelsDeleter> pixels;          // 画素データ（失敗時はnullptr）
+    std::string error;                                              // 失敗時の理由
+
+    /// <summary>
+    /// 読み込みに成功したかどうかを取得
+    /// </summary>
+    bool IsValid() const { return pixels != nullptr; }
+
+    /// <summary>
+    /// 1ピクセルあたりのバイト数を取得
+    /// </summary>
+    size_t GetPixelSize() const { return channels * GetComponentSize(componentType); }
+
+    /// <summary>
+    /// 1行あたりのバイト数を取得
+    /// </summary>
+    size_t GetRowPitch() const { return width * GetPixelSize(); }
+
+    /// <summary>
+    /// 画素データ全体のバイト数を取得
+    /// </summary>
+    size_t GetSizeInBytes() const { return GetRowPitch() * height; }
+
+    /// <summary>
+    /// 画素データをバイト列として取得
+    /// </summary>
+    std::span<const uint8_t> GetData() const { return { pixels.get(), IsValid() ? GetSizeInBytes() : 0 }; }
+};
+
+/// <summary>
+/// 画像ファイルをワーカースレッドでデコードするサービス（stb_imageを使用）
+/// ファイルをTextureFileSourceで用意し（大きいファイルはメモリマップ、小さいファイルは各ワーカーが再利用するバッファへ読み込み）、
+/// stbi_load_from_memoryでデコードする
+/// 結果はstd::futureで受け取る。大量のテクスチャを読み込むシーンの起動時間がコア数に応じて短くなる
+/// 使用例:
+///   TextureLoader loader;
+///   auto futures = loader.LoadBatch(paths);
+///   for (auto& future : futures) { TextureImage image = future.get(); if (image.IsValid()) { ... } }
+/// </summary>
+class TextureLoader {
+public:
+    /// <summary>
+    /// ワーカースレッドを起動
+    /// </summary>
+    /// <param name="threadCount">ワーカースレッド数（0の場合はハードウェアスレッド数）</param>
+    explicit TextureLoader(uint32_t threadCount = 0);
+
+    /// <summary>
+    /// 投入済みの読み込みをすべて完了させてからワーカースレッドを終了
+    /// </summary>
+    ~TextureLoader();
+
+    // コピー禁止
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    /// <summary>
+    /// 1枚の読み込みを投入
+    /// </summary>
+    /// <param name="path">画像ファイル</param>
+    /// <param name="options">読み込み設定</param>
+    /// <returns>デコード結果（失敗時はIsValid()がfalseでerrorに理由が入る）</returns>
+    std::future<TextureImage> Load(const std::filesystem::path& path, const TextureLoadOptions& options = {});
+
+    /// <summary>
+    /// 複数の読み込みをまとめて投入
+    /// 大きいファイルから順にワーカーへ渡し、最後に大きなファイルが1つだけ残って待たされることを避ける
+    /// </summary>
+    /// <param name="paths">画像ファイルの一覧</param>
+    /// <param name="options">読み込み設定（すべてのファイルで共通）</param>
+    /// <returns>pathsと同じ順のデコード結果</returns>
+    std::vector<std::future<TextureImage>> LoadBatch(std::span<const std::filesystem::path> paths, const TextureLoadOptions& options = {});
+
+    /// <summary>
+    /// 投入済みの読み込みがすべて完了するまで待機
+    /// </summary>
+    void WaitIdle();
+
+    /// <summary>
+    /// ワーカースレッド数を取得
+    /// </summary>
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    /// <summary>
+    /// メモリ上の画像ファイルをデコード（呼び出したスレッドで同期的に行う）
+    /// </summary>
+    /// <param name="bytes">画像ファイルの内容</param>
+    /// <param name="options">読み込み設定</param>
+    /// <returns>デコード結果（pathは空）</returns>
+    static TextureImage Decode(std::span<const uint8_t> bytes, const TextureLoadOptions& options = {});
+
+    /// <summary>
+    /// 画像ファイルを読み込んでデコード（呼び出したスレッドで同期的に行う）
+    /// </summary>
+    /// <param name="path">画像ファイル</param>
+    /// <param name="options">読み込み設定</param>
+    /// <param name="scratch">一括読み込みする場合の読み込みバッファ（確保済みの容量を再利用する）</param>
+    /// <returns>デコード結果</returns>
+    static TextureImage LoadFile(const std::filesystem::path& path, const TextureLoadOptions& options, std::vector<uint8_t>& scratch);
+
+private:
+    /// <summary>
+    /// 1枚分の読み込み要求
+    /// </summary>
+    struct Job {
+        std::filesystem::path path;             // 画像ファイル
+        TextureLoadOptions options;             // 読み込み設定
+        std::promise<TextureImage> promise;     // 結果の受け渡し先
+    };
+
+    /// <summary>
+    /// ワーカースレッドの処理（要求を取り出してデコードを繰り返す）
+    /// </summary>
+    void WorkerMain();
+
+    std::vector<std::thread> m_workers;         // ワーカースレッド
+    std::deque<Job> m_jobs;                     // 未処理の要求
+    std::mutex m_mutex;                         // m_jobs・m_activeJobs・m_stoppingを保護
+    std::condition_variable m_jobCondition;     // 要求の投入・終了通知
+    std::condition_variable m_idleCondition;    // すべての要求の完了通知
+    size_t m_activeJobs = 0;                    // デコード中の要求数
+    bool m_stopping = false;                    // 終了要求
+};
+
+} // namespace RenderingSandbox
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RenderingSandbox {
+
+/// <summary>
+/// テクスチャ加工（ミップ生成・ブロック圧縮）用のワーカースレッド群
+/// 処理を分割数だけ投入し、ワーカースレッドと呼び出しスレッドで分担して完了まで待つ（fork-join）
+/// 同時に投入できるのは1スレッドのみ
+/// </summary>
+class TextureTaskPool {
+public:
+    /// <summary>
+    /// ワーカースレッドを起動
+    /// </summary>
+    /// <param name="threadCount">並列数（呼び出しスレッドを含む。0の場合はハードウェアスレッド数、1の場合はワーカーなし）</param>
+    explicit TextureTaskPool(uint32_t threadCount = 0);
+
+    /// <summary>
+    /// ワーカースレッドを終了
+    /// </summary>
+    ~TextureTaskPool();
+
+    // コピー禁止
+    TextureTaskPool(const TextureTaskPool&) = delete;
+    TextureTaskPool& operator=(const TextureTaskPool&) = delete;
+
+    /// <summary>
+    /// function(0)〜function(count - 1)をワーカースレッドと呼び出しスレッドで分担して実行し、すべての完了を待つ
+    /// 各分割は任意のスレッドで任意の順に実行される
+    /// </summary>
+    /// <param name="count">分割数</param>
+    /// <param name="function">分割ごとの処理</param>
+    void ParallelFor(int count, const std::function<void(int)>& function);
+
+    /// <summary>
+    /// 並列数を取得（呼び出しスレッドを含む）
+    /// </summary>
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+private:
+    /// <summary>
+    /// ワーカースレッドの処理
+    /// </summary>
+    void WorkerMain();
+
+    std::vector<std::thread> m_workers;                             // ワーカースレッド
+    std::mutex m_mutex;                                             // 以下の投入状態を保護
+    std::condition_variable m_workCondition;                        // 処理の投入・終了通知
+    std::condition_variable m_doneCondition;                        // 処理の完了通知
+    const std::function<void(int)>* m_task = nullptr;               // 実行中の処理
+    int m_taskCount = 0;                                            // 実行中の処理の分割数
+    std::atomic<int> m_nextIndex{ 0 };                              // 次に実行する分割
+    int m_completedCount = 0;                                       // 完了した分割数
+    int m_joinedWorkers = 0;                                        // 実行中の処理に参加しているワーカー数
+    uint64_t m_generation = 0;                                      // 投入ごとに増える番号
+    bool m_stopping = false;                                        // 終了要求
+};
+
+} // namespace RenderingSandbox
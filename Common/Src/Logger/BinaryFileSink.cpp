@@ -0,0 +1,797 @@
+#include "Logger/BinaryFileSink.h"
+#include "Logger/LogCrashHandler.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace RenderingSandbox {
+
+namespace {
+
+    constexpr char kMagic[8] = { 'R', 'S', 'L', 'O', 'G', 'B', 'I', 'N' };
+    constexpr uint8_t kVersion = 2;
+
+    // エントリ種別（先頭バイトの上位4ビット）
+    constexpr uint8_t kEntryCategory = 1;       // カテゴリ定義: id, 長さ, バイト列
+    constexpr uint8_t kEntryFile = 2;           // ファイル名定義: id, 長さ, バイト列
+    constexpr uint8_t kEntryFormat = 3;         // 書式文字列定義: id, 長さ, バイト列, 引数の数, 型情報
+    constexpr uint8_t kEntryText = 4;           // レコード: 時刻差分, 呼び出し箇所id, 本文の長さ, 本文
+    constexpr uint8_t kEntryFormatted = 5;      // レコード: 時刻差分, 呼び出し箇所id, 引数列
+    constexpr uint8_t kEntrySite = 6;           // 呼び出し箇所定義: id, カテゴリid, ファイルid, 行番号, 書式文字列id + 1（0はなし）
+    constexpr uint8_t kEntryString = 7;         // 文字列引数定義: id, 長さ, バイト列
+    constexpr uint8_t kEntrySession = 15;       // セッション開始: バージョン
+
+    // レコード共通部分（種別・時刻差分・呼び出し箇所・本文長）の最大サイズ
+    constexpr size_t kMaxRecordHeaderSize = 32;
+
+    // 引数のまま書くレコードの引数の最大数（デコード時にこの数までの引数列をstd::vformatに渡す）
+    constexpr size_t kMaxDeferredArguments = 16;
+
+    // 辞書に登録する文字列引数の最大長と最大数（超えた分は毎回レコードに書く）
+    constexpr size_t kMaxInternedStringLength = 64;
+    constexpr size_t kMaxInternedStrings = 4096;
+
+    // 文字列引数を辞書に登録しなかったことを表すID
+    constexpr uint32_t kNotInterned = UINT32_MAX;
+
+    uint8_t* WriteVarint(uint8_t* out, uint64_t value) {
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+
+    uint64_t ZigZag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t UnZigZag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    template <class T>
+    T Load(const std::byte*& cursor) {
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    // 引数のまま書けるか（型を復元できる引数だけで、数が上限以内）
+    bool CanEncodeArguments(const LogArgKind* kinds) {
+        size_t count = 0;
+        for (; *kinds != LogArgKind::End; ++kinds, ++count) {
+            if (*kinds == LogArgKind::Opaque) {
+                return false;
+            }
+        }
+        return count <= kMaxDeferredArguments;
+    }
+
+    // 書式文字列がネストした置換フィールド（{:{}}のような動的な幅・精度）を含むか
+    // 含む場合はデコード時に引数を復元しても幅・精度の引数を渡せないため、テキストで書く
+    bool HasNestedReplacementField(std::string_view format) {
+        for (size_t i = 0; i < format.size(); ++i) {
+            if (format[i] != '{') {
+                continue;
+            }
+            if (i + 1 < format.size() && format[i + 1] == '{') {
+                ++i;
+                continue;
+            }
+            const size_t close = format.find_first_of("{}", i + 1);
+            if (close == std::string_view::npos || format[close] == '{') {
+                return true;
+            }
+            i = close;
+        }
+        return false;
+    }
+
+    bool HasStringArgument(const LogArgKind* kinds) {
+        for (; *kinds != LogArgKind::End; ++kinds) {
+            if (*kinds == LogArgKind::String) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 文字列以外の引数のシリアライズ済みサイズ
+    size_t ArgumentSize(LogArgKind kind) {
+        switch (kind) {
+            case LogArgKind::Int16:
+            case LogArgKind::UInt16:  return 2;
+            case LogArgKind::Int32:
+            case LogArgKind::UInt32:
+            case LogArgKind::Float:   return 4;
+            case LogArgKind::Int64:
+            case LogArgKind::UInt64:
+            case LogArgKind::Double:  return 8;
+            case LogArgKind::Pointer: return sizeof(uintptr_t);
+            default:                  return 1;
+        }
+    }
+
+    // デコード用の入力カーソル（範囲外の読み出しはokをfalseにして0を返す）
+    struct Reader {
+        const uint8_t* cursor;
+        const uint8_t* end;
+        bool ok = true;
+
+        bool AtEnd() const { return cursor >= end; }
+
+        uint8_t Byte() {
+            if (cursor >= end) {
+                ok = false;
+                return 0;
+            }
+            return *cursor++;
+        }
+
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const uint8_t byte = Byte();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            ok = false;
+            return 0;
+        }
+
+        std::string_view Bytes(uint64_t size) {
+            if (static_cast<uint64_t>(end - cursor) < size) {
+                ok = false;
+                cursor = end;
+                return {};
+            }
+            std::string_view bytes(reinterpret_cast<const char*>(cursor), static_cast<size_t>(size));
+            cursor += size;
+            return bytes;
+        }
+
+        template <class T>
+        T Raw() {
+            T value{};
+            std::string_view bytes = Bytes(sizeof(T));
+            if (ok) {
+                std::memcpy(&value, bytes.data(), sizeof(T));
+            }
+            return value;
+        }
+    };
+
+    using ArgumentValue = std::variant<bool, char, int8_t, int16_t, int32_t, int64_t,
+        uint8_t, uint16_t, uint32_t, uint64_t, float, double, std::string_view, const void*>;
+
+    ArgumentValue ReadArgument(Reader& reader, LogArgKind kind, const std::vector<std::string_view>& strings) {
+        switch (kind) {
+            case LogArgKind::Bool:    return reader.Byte() != 0;
+            case LogArgKind::Char:    return static_cast<char>(reader.Byte());
+            case LogArgKind::Int8:    return static_cast<int8_t>(reader.Byte());
+            case LogArgKind::UInt8:   return reader.Byte();
+            case LogArgKind::Int16:   return static_cast<int16_t>(UnZigZag(reader.Varint()));
+            case LogArgKind::Int32:   return static_cast<int32_t>(UnZigZag(reader.Varint()));
+            case LogArgKind::Int64:   return UnZigZag(reader.Varint());
+            case LogArgKind::UInt16:  return static_cast<uint16_t>(reader.Varint());
+            case LogArgKind::UInt32:  return static_cast<uint32_t>(reader.Varint());
+            case LogArgKind::UInt64:  return reader.Varint();
+            case LogArgKind::Pointer: return reinterpret_cast<const void*>(static_cast<uintptr_t>(reader.Varint()));
+            case LogArgKind::Float:   return reader.Raw<float>();
+            case LogArgKind::Double:  return reader.Raw<double>();
+            case LogArgKind::String: {
+                const uint64_t tag = reader.Varint();
+                if ((tag & 1) == 0) {
+                    return reader.Bytes(tag >> 1);
+                }
+                if ((tag >> 1) >= strings.size()) {
+                    reader.ok = false;
+                    return std::string_view();
+                }
+                return strings[static_cast<size_t>(tag >> 1)];
+            }
+            default:
+                reader.ok = false;
+                return false;
+        }
+    }
+
+    // デコードした引数をstd::vformatに渡すためのラッパー
+    // 置換フィールドの書式指定はラッパーのformatterが受け取り、実際の型のstd::formatterに渡し直す
+    struct LogDynamicArg {
+        const ArgumentValue* value;
+    };
+
+} // namespace
+
+} // namespace RenderingSandbox
+
+template <>
+struct std::formatter<RenderingSandbox::LogDynamicArg, char> {
+    std::string_view spec;      // 書式指定（閉じ波括弧は含まない）
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context& ctx) {
+        // 書式指定がない場合は空の範囲が渡されることもある
+        auto it = ctx.begin();
+        while (it != ctx.end() && *it != '}') {
+            ++it;
+        }
+        spec = std::string_view(ctx.begin(), it);
+        return it;
+    }
+
+    template <class FormatContext>
+    auto format(const RenderingSandbox::LogDynamicArg& arg, FormatContext& ctx) const {
+        return std::visit([&](const auto& value) {
+            std::formatter<std::decay_t<decltype(value)>, char> formatter;
+            std::format_parse_context parseContext(spec);
+            formatter.parse(parseContext);
+            return formatter.format(value, ctx);
+        }, *arg.value);
+    }
+};
+
+namespace RenderingSandbox {
+
+namespace {
+
+    template <size_t... I>
+    void FormatDynamicArguments(std::string_view format, const LogDynamicArg* args, std::string& out, std::index_sequence<I...>) {
+        std::vformat_to(std::back_inserter(out), format, std::make_format_args(args[I]...));
+    }
+
+    template <size_t N>
+    void FormatWithArgumentCount(std::string_view format, const LogDynamicArg* args, std::string& out) {
+        FormatDynamicArguments(format, args, out, std::make_index_sequence<N>());
+    }
+
+    template <size_t... N>
+    constexpr auto MakeFormatTable(std::index_sequence<N...>) {
+        return std::array{ &FormatWithArgumentCount<N>... };
+    }
+
+    // 引数の数ごとの展開関数
+    constexpr auto kFormatTable = MakeFormatTable(std::make_index_sequence<kMaxDeferredArguments + 1>());
+
+    // 型をコンパイル時に知らない引数列で書式文字列を展開する（書式文字列全体を一度のstd::vformatで処理する）
+    void FormatArguments(std::string_view format, const std::vector<ArgumentValue>& values, std::string& out) {
+        std::array<LogDynamicArg, kMaxDeferredArguments> args{};
+        for (size_t i = 0; i < values.size(); ++i) {
+            args[i].value = &values[i];
+        }
+
+        out.clear();
+        try {
+            kFormatTable[values.size()](format, args.data(), out);
+        } catch (const std::exception& e) {
+            // LogMessage::GetTextと同じ形式
+            out.assign("<format error: ");
+            out.append(e.what());
+            out.append("> ");
+            out.append(format);
+        }
+    }
+
+} // namespace
+
+size_t BinaryFileSink::KeyHash::operator()(const DictionaryKey& key) const {
+    const size_t data = std::hash<const void*>()(key.data);
+    const size_t extra = std::hash<const void*>()(key.extra);
+    return data ^ (extra + 0x9e3779b97f4a7c15ull + (data << 6) + (data >> 2)) ^ key.size;
+}
+
+size_t BinaryFileSink::KeyHash::operator()(const SiteKey& key) const {
+    size_t hash = std::hash<const void*>()(key.format);
+    for (const void* pointer : { key.file, key.category, key.kinds }) {
+        hash ^= std::hash<const void*>()(pointer) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash ^ static_cast<size_t>(key.line);
+}
+
+BinaryFileSink::BinaryFileSink(const std::filesystem::path& filePath, bool append)
+    : m_filePath(filePath)
+    , m_fd(-1)
+    , m_bufferUsed(0)
+    , m_flushInterval(1000)             // デフォルト1秒
+    , m_lastFlushTimestamp(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count())
+    , m_lastString(nullptr)
+    , m_lastSiteKey{}
+    , m_lastSite(nullptr)
+    , m_lastTimestamp(0)
+{
+    // 親ディレクトリが存在しない場合は作成
+    if (filePath.has_parent_path()) {
+        std::filesystem::path parentPath = filePath.parent_path();
+        if (!parentPath.empty() && !std::filesystem::exists(parentPath)) {
+            std::filesystem::create_directories(parentPath);
+        }
+    }
+
+    m_buffer.resize(kBufferSize);
+
+    std::error_code error;
+    const bool empty = !append || std::filesystem::file_size(filePath, error) == 0 || error;
+
+    OpenFile(!append);
+    if (m_fd < 0) {
+        std::cerr << "BinaryFileSink: Failed to open log file: " << filePath << std::endl;
+        return;
+    }
+
+    if (empty) {
+        WriteToFile(reinterpret_cast<const uint8_t*>(kMagic), sizeof(kMagic));
+    }
+    BeginSession();
+}
+
+BinaryFileSink::~BinaryFileSink() {
+    if (m_fd >= 0) {
+        Flush();
+        CloseFile();
+    }
+}
+
+void BinaryFileSink::BeginSession() {
+    uint8_t* out = Reserve(2);
+    *out++ = kEntrySession << 4;
+    *out++ = kVersion;
+    m_bufferUsed += 2;
+
+    m_categories.clear();
+    m_files.clear();
+    m_formats.clear();
+    m_strings.clear();
+    m_lastString = nullptr;
+    m_sites.clear();
+    m_lastSite = nullptr;
+    m_lastTimestamp = 0;
+}
+
+uint8_t* BinaryFileSink::Reserve(size_t size) {
+    if (m_bufferUsed + size > m_buffer.size()) {
+        FlushBuffer();
+        if (size > m_buffer.size()) {
+            m_buffer.resize(size);
+        }
+    }
+    return reinterpret_cast<uint8_t*>(m_buffer.data()) + m_bufferUsed;
+}
+
+uint32_t BinaryFileSink::Intern(Dictionary& dictionary, uint8_t entryType, std::string_view text, const LogArgKind* kinds) {
+    const DictionaryKey key{ text.data(), text.size(), kinds };
+    auto it = dictionary.find(key);
+    if (it != dictionary.end()) {
+        return it->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(dictionary.size());
+    dictionary.emplace(key, id);
+
+    size_t kindCount = 0;
+    while (kinds && kinds[kindCount] != LogArgKind::End) {
+        ++kindCount;
+    }
+
+    uint8_t* begin = Reserve(1 + 10 + 10 + text.size() + 10 + kindCount);
+    uint8_t* out = begin;
+    *out++ = static_cast<uint8_t>(entryType << 4);
+    out = WriteVarint(out, id);
+    out = WriteVarint(out, text.size());
+    if (!text.empty()) {
+        std::memcpy(out, text.data(), text.size());
+        out += text.size();
+    }
+    if (entryType == kEntryFormat) {
+        out = WriteVarint(out, kindCount);
+        std::memcpy(out, kinds, kindCount);
+        out += kindCount;
+    }
+    m_bufferUsed += static_cast<size_t>(out - begin);
+    return id;
+}
+
+const BinaryFileSink::SiteInfo& BinaryFileSink::InternSite(const LogMessage& message) {
+    const bool formatted = message.formatter != nullptr && message.argKinds != nullptr;
+    const SiteKey key{ message.category.data(), message.file,
+        formatted ? message.formatString.data() : nullptr, formatted ? message.argKinds : nullptr, message.line };
+    if (m_lastSite != nullptr && key == m_lastSiteKey) {
+        return *m_lastSite;
+    }
+    auto it = m_sites.find(key);
+    if (it == m_sites.end()) {
+        // 未フォーマットで型情報が揃っていて、デコード時に書式文字列だけで展開できれば本文を生成せずに引数のまま書く
+        const bool deferred = formatted && CanEncodeArguments(message.argKinds)
+            && !HasNestedReplacementField(message.formatString);
+        const SiteInfo info{ WriteSite(message, deferred), deferred, deferred && HasStringArgument(message.argKinds) };
+        it = m_sites.emplace(key, info).first;
+    }
+    m_lastSiteKey = key;
+    m_lastSite = &it->second;
+    return it->second;
+}
+
+uint32_t BinaryFileSink::WriteSite(const LogMessage& message, bool deferred) {
+    const uint32_t category = Intern(m_categories, kEntryCategory, message.category, nullptr);
+    const uint32_t file = Intern(m_files, kEntryFile, message.file, nullptr);
+    const uint32_t format = deferred ? Intern(m_formats, kEntryFormat, message.formatString, message.argKinds) + 1 : 0;
+
+    const uint32_t id = static_cast<uint32_t>(m_sites.size());
+
+    uint8_t* begin = Reserve(1 + 10 * 5);
+    uint8_t* out = begin;
+    *out++ = kEntrySite << 4;
+    out = WriteVarint(out, id);
+    out = WriteVarint(out, category);
+    out = WriteVarint(out, file);
+    out = WriteVarint(out, static_cast<uint32_t>(message.line));
+    out = WriteVarint(out, format);
+    m_bufferUsed += static_cast<size_t>(out - begin);
+    return id;
+}
+
+uint32_t BinaryFileSink::InternString(std::string_view text) {
+    if (m_lastString != nullptr && m_lastString->first == text) {
+        return m_lastString->second;
+    }
+    auto it = m_strings.find(text);
+    if (it != m_strings.end()) {
+        m_lastString = &*it;
+        return it->second;
+    }
+    if (text.size() > kMaxInternedStringLength || m_strings.size() >= kMaxInternedStrings) {
+        return kNotInterned;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(m_strings.size());
+    m_lastString = &*m_strings.emplace(text, id).first;
+
+    uint8_t* begin = Reserve(1 + 10 + 10 + text.size());
+    uint8_t* out = begin;
+    *out++ = kEntryString << 4;
+    out = WriteVarint(out, id);
+    out = WriteVarint(out, text.size());
+    if (!text.empty()) {
+        std::memcpy(out, text.data(), text.size());
+        out += text.size();
+    }
+    m_bufferUsed += static_cast<size_t>(out - begin);
+    return id;
+}
+
+uint8_t* BinaryFileSink::WriteArguments(uint8_t* out, const LogArgKind* kinds, const LogBuffer& payload, const uint32_t* stringIds) {
+    const std::byte* cursor = payload.GetData();
+    for (; *kinds != LogArgKind::End; ++kinds) {
+        switch (*kinds) {
+            case LogArgKind::Bool:
+            case LogArgKind::Char:
+            case LogArgKind::Int8:
+            case LogArgKind::UInt8:
+                *out++ = static_cast<uint8_t>(Load<char>(cursor));
+                break;
+            case LogArgKind::Int16:  out = WriteVarint(out, ZigZag(Load<int16_t>(cursor))); break;
+            case LogArgKind::Int32:  out = WriteVarint(out, ZigZag(Load<int32_t>(cursor))); break;
+            case LogArgKind::Int64:  out = WriteVarint(out, ZigZag(Load<int64_t>(cursor))); break;
+            case LogArgKind::UInt16: out = WriteVarint(out, Load<uint16_t>(cursor)); break;
+            case LogArgKind::UInt32: out = WriteVarint(out, Load<uint32_t>(cursor)); break;
+            case LogArgKind::UInt64: out = WriteVarint(out, Load<uint64_t>(cursor)); break;
+            case LogArgKind::Pointer: out = WriteVarint(out, Load<uintptr_t>(cursor)); break;
+            case LogArgKind::Float:
+                std::memcpy(out, cursor, sizeof(float));
+                out += sizeof(float);
+                cursor += sizeof(float);
+                break;
+            case LogArgKind::Double:
+                std::memcpy(out, cursor, sizeof(double));
+                out += sizeof(double);
+                cursor += sizeof(double);
+                break;
+            case LogArgKind::String: {
+                // 辞書に登録した文字列は (id << 1) | 1、それ以外は (長さ << 1) + バイト列
+                const uint32_t length = Load<uint32_t>(cursor);
+                const uint32_t id = *stringIds++;
+                if (id != kNotInterned) {
+                    out = WriteVarint(out, (static_cast<uint64_t>(id) << 1) | 1);
+                } else {
+                    out = WriteVarint(out, static_cast<uint64_t>(length) << 1);
+                    std::memcpy(out, cursor, length);
+                    out += length;
+                }
+                cursor += length;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return out;
+}
+
+void BinaryFileSink::Write(const LogMessage& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!ShouldWrite(message) || m_fd < 0) {
+        return;
+    }
+
+    const SiteInfo& site = InternSite(message);
+    const bool deferred = site.deferred;
+
+    // 文字列引数の定義エントリはレコードより前に出力する
+    uint32_t stringIds[kMaxDeferredArguments];
+    if (site.hasStrings) {
+        const std::byte* cursor = message.payload.GetData();
+        size_t stringCount = 0;
+        for (const LogArgKind* kind = message.argKinds; *kind != LogArgKind::End; ++kind) {
+            if (*kind == LogArgKind::String) {
+                const uint32_t length = Load<uint32_t>(cursor);
+                stringIds[stringCount++] = InternString(std::string_view(reinterpret_cast<const char*>(cursor), length));
+                cursor += length;
+            } else {
+                cursor += ArgumentSize(*kind);
+            }
+        }
+    }
+
+    const std::string_view text = deferred ? std::string_view() : message.GetText();
+    const size_t bodySize = deferred ? message.payload.GetSize() * 2 : text.size();
+
+    uint8_t* begin = Reserve(kMaxRecordHeaderSize + bodySize);
+    uint8_t* out = begin;
+
+    const int64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(message.timestamp.time_since_epoch()).count();
+    *out++ = static_cast<uint8_t>(((deferred ? kEntryFormatted : kEntryText) << 4) | static_cast<uint8_t>(message.level));
+    out = WriteVarint(out, ZigZag(timestamp - m_lastTimestamp));
+    out = WriteVarint(out, site.id);
+    m_lastTimestamp = timestamp;
+
+    if (deferred) {
+        out = WriteArguments(out, message.argKinds, message.payload, stringIds);
+    } else {
+        out = WriteVarint(out, text.size());
+        if (!text.empty()) {
+            std::memcpy(out, text.data(), text.size());
+            out += text.size();
+        }
+    }
+    m_bufferUsed += static_cast<size_t>(out - begin);
+
+    // Error以上・書き出し間隔の経過時はすぐに書き出す（経過時間はレコードのタイムスタンプで判定する）
+    if (message.level >= LogLevel::Error
+        || timestamp - m_lastFlushTimestamp >= std::chrono::duration_cast<std::chrono::microseconds>(m_flushInterval).count()) {
+        FlushBuffer();
+        m_lastFlushTimestamp = timestamp;
+    }
+}
+
+void BinaryFileSink::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd >= 0) {
+        FlushBuffer();
+    }
+}
+
+int BinaryFileSink::EmergencyFlush() noexcept {
+    // シグナルハンドラから呼ばれるため、ミューテックスは取得せずwriteだけを行う
+    if (m_fd >= 0 && m_bufferUsed > 0) {
+        LogCrashHandler::WriteAll(m_fd, m_buffer.data(), m_bufferUsed);
+        m_bufferUsed = 0;
+    }
+    return -1;
+}
+
+void BinaryFileSink::FlushBuffer() {
+    if (m_bufferUsed > 0 && m_fd >= 0) {
+        WriteToFile(reinterpret_cast<const uint8_t*>(m_buffer.data()), m_bufferUsed);
+    }
+    m_bufferUsed = 0;
+}
+
+void BinaryFileSink::WriteToFile(const uint8_t* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(m_fd, data, static_cast<unsigned int>(std::min<size_t>(size, 0x40000000)));
+#else
+        ssize_t written = ::write(m_fd, data, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (written <= 0) {
+            std::cerr << "BinaryFileSink: Failed to write log file: " << m_filePath << std::endl;
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void BinaryFileSink::OpenFile(bool truncate) {
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : _O_APPEND);
+    if (_wsopen_s(&m_fd, m_filePath.c_str(), flags, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) {
+        m_fd = -1;
+    }
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND);
+    m_fd = ::open(m_filePath.c_str(), flags, 0644);
+#endif
+}
+
+void BinaryFileSink::CloseFile() {
+    if (m_fd < 0) {
+        return;
+    }
+#ifdef _WIN32
+    _close(m_fd);
+#else
+    ::close(m_fd);
+#endif
+    m_fd = -1;
+}
+
+bool BinaryFileSink::ReadFile(const std::filesystem::path& filePath, const std::function<void(const LogMessage&)>& callback) {
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(kMagic) || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    struct FormatEntry {
+        std::string_view format;
+        std::vector<LogArgKind> kinds;
+    };
+
+    struct SiteEntry {
+        size_t category;
+        size_t file;
+        int line;
+        size_t format;                          // 書式文字列id + 1（0はなし）
+    };
+
+    std::vector<std::string_view> categories;
+    std::vector<std::string> files;             // LogMessage::fileは終端文字が必要なためコピーして保持
+    std::vector<FormatEntry> formats;
+    std::vector<std::string_view> strings;
+    std::vector<SiteEntry> sites;
+    std::vector<ArgumentValue> values;
+    std::string text;
+    int64_t timestamp = 0;
+    LogMessage message;
+
+    Reader reader{ bytes.data() + sizeof(kMagic), bytes.data() + bytes.size() };
+    while (!reader.AtEnd()) {
+        const uint8_t head = reader.Byte();
+        const uint8_t type = head >> 4;
+
+        switch (type) {
+            case kEntrySession: {
+                if (reader.Byte() != kVersion) {
+                    return reader.ok;
+                }
+                categories.clear();
+                files.clear();
+                formats.clear();
+                strings.clear();
+                sites.clear();
+                timestamp = 0;
+                break;
+            }
+            case kEntryCategory:
+            case kEntryFile:
+            case kEntryFormat:
+            case kEntryString: {
+                const uint64_t id = reader.Varint();
+                const std::string_view value = reader.Bytes(reader.Varint());
+                if (type == kEntryCategory && id == categories.size()) {
+                    categories.push_back(value);
+                } else if (type == kEntryFile && id == files.size()) {
+                    files.emplace_back(value);
+                } else if (type == kEntryFormat && id == formats.size()) {
+                    FormatEntry& entry = formats.emplace_back();
+                    entry.format = value;
+                    const std::string_view kinds = reader.Bytes(reader.Varint());
+                    for (char kind : kinds) {
+                        entry.kinds.push_back(static_cast<LogArgKind>(kind));
+                    }
+                    if (entry.kinds.size() > kMaxDeferredArguments) {
+                        reader.ok = false;
+                    }
+                } else if (type == kEntryString && id == strings.size()) {
+                    strings.push_back(value);
+                } else {
+                    reader.ok = false;
+                }
+                break;
+            }
+            case kEntrySite: {
+                const uint64_t id = reader.Varint();
+                SiteEntry site{};
+                site.category = static_cast<size_t>(reader.Varint());
+                site.file = static_cast<size_t>(reader.Varint());
+                site.line = static_cast<int>(reader.Varint());
+                site.format = static_cast<size_t>(reader.Varint());
+                if (id != sites.size() || site.category >= categories.size() || site.file >= files.size()
+                    || site.format > formats.size()) {
+                    reader.ok = false;
+                    break;
+                }
+                sites.push_back(site);
+                break;
+            }
+            case kEntryText:
+            case kEntryFormatted: {
+                timestamp += UnZigZag(reader.Varint());
+                const uint64_t siteId = reader.Varint();
+                if (siteId >= sites.size() || (type == kEntryFormatted && sites[siteId].format == 0)) {
+                    reader.ok = false;
+                    break;
+                }
+                const SiteEntry& site = sites[siteId];
+
+                if (type == kEntryText) {
+                    message.SetText(reader.Bytes(reader.Varint()));
+                } else {
+                    const FormatEntry& format = formats[site.format - 1];
+                    values.clear();
+                    for (LogArgKind kind : format.kinds) {
+                        values.push_back(ReadArgument(reader, kind, strings));
+                    }
+                    if (!reader.ok) {
+                        break;
+                    }
+                    FormatArguments(format.format, values, text);
+                    message.SetText(text);
+                }
+
+                message.level = static_cast<LogLevel>(head & 0x0F);
+                message.category = categories[site.category];
+                message.file = files[site.file].c_str();
+                message.line = site.line;
+                message.timestamp = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(timestamp)));
+                if (reader.ok) {
+                    callback(message);
+                }
+                break;
+            }
+            default:
+                reader.ok = false;
+                break;
+        }
+
+        if (!reader.ok) {
+            // 書き込み途中で途切れた末尾のエントリ
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace RenderingSandbox
@@ -4,12 +4,38 @@
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 #endif
 
 namespace RenderingSandbox {
 
+#ifndef _WIN32
+namespace {
+
+    // fdが色付けできる端末かどうか（NO_COLOR・TERM=dumbの場合は色を付けない）
+    bool IsColorTerminal(int fd) {
+        if (!::isatty(fd)) {
+            return false;
+        }
+        const char* noColor = std::getenv("NO_COLOR");
+        if (noColor != nullptr && noColor[0] != '\0') {
+            return false;
+        }
+        const char* term = std::getenv("TERM");
+        return term == nullptr || std::strcmp(term, "dumb") != 0;
+    }
+
+} // namespace
+#endif
+
 ConsoleSink::ConsoleSink()
     : m_colorEnabled(true)
+    , m_stdoutColor(false)
+    , m_stderrColor(false)
 {
 #ifdef _WIN32
     // Windows Console APIの標準出力ハンドルを取得
@@ -19,6 +45,8 @@ ConsoleSink::ConsoleSink()
     SetConsoleOutputCP(CP_UTF8);
 #else
     m_consoleHandle = nullptr;
+    m_stdoutColor = IsColorTerminal(STDOUT_FILENO);
+    m_stderrColor = IsColorTerminal(STDERR_FILENO);
 #endif
 }
 
@@ -34,7 +62,7 @@ void ConsoleSink::Write(const LogMessage& message) {
     }
 
     // フォーマット済みメッセージを取得
-    std::string formattedMessage = message.Format();
+    std::string_view formattedMessage = FormatRecord(message);
 
 #ifdef _WIN32
     if (m_colorEnabled && m_consoleHandle) {
@@ -65,19 +93,53 @@ void ConsoleSink::Write(const LogMessage& message) {
         }
     }
 #else
-    // Windows以外のプラットフォーム（将来の拡張用）
+    // 標準出力・標準エラー出力へ直接書き込む（iostreamのバッファと同期を経由しない）
     if (message.level >= LogLevel::Error) {
-        std::cerr << formattedMessage << std::endl;
+        WriteRecord(STDERR_FILENO, m_colorEnabled && m_stderrColor, message.level, formattedMessage);
     } else {
-        std::cout << formattedMessage << std::endl;
+        WriteRecord(STDOUT_FILENO, m_colorEnabled && m_stdoutColor, message.level, formattedMessage);
     }
 #endif
 }
 
 void ConsoleSink::Flush() {
     std::lock_guard<std::mutex> lock(m_mutex);
+    // POSIXではレコードごとにwrite(2)済みだが、同じストリームへの他の出力のためにiostreamもフラッシュする
     std::cout.flush();
     std::cerr.flush();
 }
 
+#ifndef _WIN32
+void ConsoleSink::WriteRecord(int fd, bool useColor, LogLevel level, std::string_view text) {
+    // 色の指定・本文・色のリセット・改行を1つのバッファにまとめ、他のプロセスやスレッドの出力と混ざらないようにする
+    m_lineBuffer.clear();
+    if (useColor) {
+        const int color = LogLevelToAnsiColor(level);
+        m_lineBuffer += "\x1b[";
+        m_lineBuffer += static_cast<char>('0' + color / 10);
+        m_lineBuffer += static_cast<char>('0' + color % 10);
+        m_lineBuffer += 'm';
+        m_lineBuffer += text;
+        m_lineBuffer += "\x1b[0m\n";
+    } else {
+        m_lineBuffer += text;
+        m_lineBuffer += '\n';
+    }
+
+    const char* data = m_lineBuffer.data();
+    size_t size = m_lineBuffer.size();
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+#endif
+
 } // namespace RenderingSandbox
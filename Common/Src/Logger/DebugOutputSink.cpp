@@ -16,14 +16,14 @@ void DebugOutputSink::Write(const LogMessage& message) {
 
 #ifdef _WIN32
     // フォーマット済みメッセージを取得
-    std::string formattedMessage = message.Format();
-    formattedMessage += "\n";
-
-    // UTF-8からUTF-16への変換
-    int wideSize = MultiByteToWideChar(CP_UTF8, 0, formattedMessage.c_str(), -1, nullptr, 0);
-    if (wideSize > 0) {
-        std::wstring wideMessage(wideSize, L'\0');
-        MultiByteToWideChar(CP_UTF8, 0, formattedMessage.c_str(), -1, &wideMessage[0], wideSize);
+    std::string_view formattedMessage = FormatRecord(message);
+
+    // UTF-8からUTF-16への変換（改行と終端文字の分を加えて確保）
+    int length = static_cast<int>(formattedMessage.size());
+    int wideSize = MultiByteToWideChar(CP_UTF8, 0, formattedMessage.data(), length, nullptr, 0);
+    if (wideSize > 0 || length == 0) {
+        std::wstring wideMessage(wideSize + 1, L'\n');
+        MultiByteToWideChar(CP_UTF8, 0, formattedMessage.data(), length, &wideMessage[0], wideSize);
 
         // Visual Studio出力ウィンドウに送信
         OutputDebugStringW(wideMessage.c_str());
@@ -0,0 +1,104 @@
+#include "Logger/DedupSink.h"
+#include <cstring>
+#include <format>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    // 構造化フィールドのエンコード済みバイト列（比較用）
+    std::string_view GetFieldBytes(const LogMessage& message) {
+        return std::string_view(reinterpret_cast<const char*>(message.fields.GetData()), message.fields.GetSize());
+    }
+
+} // namespace
+
+DedupSink::DedupSink(std::unique_ptr<ILogSink> inner, std::chrono::milliseconds summaryInterval)
+    : m_inner(std::move(inner))
+    , m_summaryInterval(summaryInterval) {
+}
+
+DedupSink::~DedupSink() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteSummary();
+}
+
+void DedupSink::Write(const LogMessage& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!ShouldWrite(message) || !m_inner) {
+        return;
+    }
+
+    if (IsRepeat(message)) {
+        if (m_repeatCount == 0) {
+            m_repeatStart = message.timestamp;
+        }
+        ++m_repeatCount;
+        ++m_suppressedTotal;
+        m_repeatLast = message.timestamp;
+        m_repeatThread = message.threadId;
+
+        // 集約が長く続く場合も、一定間隔で要約を出して発生し続けていることを残す
+        if (message.timestamp - m_repeatStart >= m_summaryInterval) {
+            WriteSummary();
+        }
+        return;
+    }
+
+    WriteSummary();
+
+    m_hasLast = true;
+    m_lastLevel = message.level;
+    m_lastCategory.assign(message.category);
+    m_lastFile = message.file;
+    m_lastLine = message.line;
+    m_lastText.assign(message.GetText());
+    m_lastFields.assign(GetFieldBytes(message));
+
+    m_inner->Write(message);
+}
+
+void DedupSink::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteSummary();
+    if (m_inner) {
+        m_inner->Flush();
+    }
+}
+
+uint64_t DedupSink::GetSuppressedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_suppressedTotal;
+}
+
+bool DedupSink::IsRepeat(const LogMessage& message) const {
+    // 安価な比較から順に行い、呼び出し箇所が同じ場合のみ本文を比較する
+    if (!m_hasLast || message.level != m_lastLevel || message.line != m_lastLine) {
+        return false;
+    }
+    if (message.file != m_lastFile && std::strcmp(message.file, m_lastFile) != 0) {
+        return false;
+    }
+    return message.category == m_lastCategory && message.GetText() == m_lastText && GetFieldBytes(message) == m_lastFields;
+}
+
+void DedupSink::WriteSummary() {
+    if (m_repeatCount == 0 || !m_inner) {
+        return;
+    }
+
+    LogMessage summary;
+    summary.level = m_lastLevel;
+    summary.category = m_lastCategory;
+    summary.file = m_lastFile;
+    summary.line = m_lastLine;
+    summary.timestamp = m_repeatLast;
+    summary.threadId = m_repeatThread;
+    summary.SetText(std::format("Last message repeated {} times", m_repeatCount));
+
+    m_repeatCount = 0;
+    m_inner->Write(summary);
+}
+
+} // namespace RenderingSandbox
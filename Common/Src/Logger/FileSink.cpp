@@ -1,13 +1,64 @@
 #include "Logger/FileSink.h"
+#include "Logger/LogCrashHandler.h"
+#include "Logger/LogCompression.h"
+#include "Logger/Logger.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace RenderingSandbox {
 
+namespace {
+
+    // バッファの整列単位（ページサイズ）
+    constexpr size_t kBufferAlignment = 4096;
+
+    // バッファリング無効時に1レコード分（本文 + 改行）を組み立てるためのバッファサイズ
+    constexpr size_t kLineBufferSize = 4096;
+
+    // 行末（ファイルはバイナリモードで開くため、Windowsでは明示的にCRLFを書く）
+#ifdef _WIN32
+    constexpr std::string_view kLineEnding = "\r\n";
+#else
+    constexpr std::string_view kLineEnding = "\n";
+#endif
+
+} // namespace
+
+void FileSink::AlignedDeleter::operator()(char* buffer) const {
+    ::operator delete[](buffer, std::align_val_t{ kBufferAlignment });
+}
+
 FileSink::FileSink(const std::filesystem::path& filePath, bool append)
     : m_filePath(filePath)
+    , m_fd(-1)
     , m_currentSize(0)
     , m_maxFileSize(10 * 1024 * 1024)  // デフォルト10MB
     , m_maxFiles(5)                     // デフォルト5世代
+    , m_bufferCapacity(0)
+    , m_bufferUsed(0)
+    , m_buffered(false)
+    , m_flushInterval(1000)             // デフォルト1秒
+    , m_lastFlushTime(std::chrono::steady_clock::now())
+    , m_rotationInterval(0)             // デフォルトは時間によるローテーションなし
+    , m_openedTime(std::chrono::steady_clock::now())
+    , m_compressRotated(false)
+    , m_rotationSequence(0)
+    , m_flushTimerEnabled(false)
+    , m_rotationBusy(false)
+    , m_rotationStop(false)
 {
     // 親ディレクトリが存在しない場合は作成
     if (filePath.has_parent_path()) {
@@ -17,17 +68,12 @@ FileSink::FileSink(const std::filesystem::path& filePath, bool append)
         }
     }
 
-    // ファイルを開く
-    auto mode = std::ios::out;
-    if (append) {
-        mode |= std::ios::app;
-    } else {
-        mode |= std::ios::trunc;
-    }
+    AllocateBuffer(kLineBufferSize);
 
-    m_file.open(filePath, mode);
+    // ファイルを開く
+    OpenFile(!append);
 
-    if (!m_file.is_open()) {
+    if (m_fd < 0) {
         // ファイルオープンに失敗した場合はエラー出力（標準エラー出力へ）
         std::cerr << "FileSink: Failed to open log file: " << filePath << std::endl;
     } else if (append && std::filesystem::exists(filePath)) {
@@ -37,64 +83,313 @@ FileSink::FileSink(const std::filesystem::path& filePath, bool append)
 }
 
 FileSink::~FileSink() {
-    if (m_file.is_open()) {
+    // 投入済みのローテーション処理を終えてからスレッドを停止（定期書き出しと競合しないよう、ファイルを閉じる前に止める）
+    if (m_rotationThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_rotationMutex);
+            m_rotationStop = true;
+        }
+        m_rotationCondition.notify_all();
+        m_rotationThread.join();
+    }
+
+    if (m_fd >= 0) {
         Flush();
-        m_file.close();
+        CloseFile();
     }
 }
 
 void FileSink::Write(const LogMessage& message) {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (!ShouldWrite(message) || !m_file.is_open()) {
+    if (!ShouldWrite(message) || m_fd < 0) {
         return;
     }
 
     // ファイルサイズチェックとローテーション
     CheckAndRotate();
 
-    // フォーマット済みメッセージを取得してファイルに書き込み
-    std::string formattedMessage = message.Format();
-    m_file << formattedMessage << std::endl;
+    // フォーマット済みメッセージを取得してバッファに追記
+    std::string_view formattedMessage = FormatLine(message);
+    size_t lineSize = formattedMessage.size() + kLineEnding.size();
+
+    if (m_bufferUsed + lineSize > m_bufferCapacity) {
+        FlushBuffer();
+    }
+    if (lineSize <= m_bufferCapacity) {
+        std::memcpy(m_buffer.get() + m_bufferUsed, formattedMessage.data(), formattedMessage.size());
+        std::memcpy(m_buffer.get() + m_bufferUsed + formattedMessage.size(), kLineEnding.data(), kLineEnding.size());
+        m_bufferUsed += lineSize;
+    } else {
+        // バッファより大きいレコードは直接書き込む
+        WriteToFile(formattedMessage.data(), formattedMessage.size());
+        WriteToFile(kLineEnding.data(), kLineEnding.size());
+    }
+
+    // 書き込んだサイズを加算（行末も含む）
+    m_currentSize += lineSize;
 
-    // 書き込んだサイズを加算（改行文字も含む）
-    m_currentSize += formattedMessage.size() + 1;
+    // バッファリング無効時・Error以上・書き出し間隔の経過時はすぐに書き出す
+    if (!m_buffered
+        || message.level >= LogLevel::Error
+        || std::chrono::steady_clock::now() - m_lastFlushTime >= m_flushInterval) {
+        FlushBuffer();
+    }
 }
 
 void FileSink::Flush() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_file.is_open()) {
-        m_file.flush();
+    if (m_fd >= 0) {
+        FlushBuffer();
+    }
+}
+
+int FileSink::EmergencyFlush() noexcept {
+    // シグナルハンドラから呼ばれるため、ミューテックスは取得せずwriteだけを行う
+    if (m_fd < 0) {
+        return -1;
+    }
+    if (m_bufferUsed > 0) {
+        LogCrashHandler::WriteAll(m_fd, m_buffer.get(), m_bufferUsed);
+        m_bufferUsed = 0;
     }
+    return m_fd;
 }
 
 bool FileSink::IsOpen() const {
-    return m_file.is_open();
+    return m_fd >= 0;
+}
+
+void FileSink::SetBuffered(bool enabled, size_t bufferSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushBuffer();
+    m_buffered = enabled;
+    AllocateBuffer(enabled ? std::max(bufferSize, kLineBufferSize) : kLineBufferSize);
+    UpdateFlushTimer();
+}
+
+void FileSink::SetFlushInterval(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_flushInterval = interval;
+    UpdateFlushTimer();
+}
+
+std::chrono::milliseconds FileSink::GetFlushInterval() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_flushInterval;
+}
+
+void FileSink::UpdateFlushTimer() {
+    {
+        std::lock_guard<std::mutex> lock(m_rotationMutex);
+        m_flushTimerEnabled = m_buffered;
+        if (m_flushTimerEnabled && !m_rotationThread.joinable()) {
+            m_rotationThread = std::thread(&FileSink::BackgroundLoop, this);
+        }
+    }
+    // 待機中のスレッドに新しい間隔で待ち直させる
+    m_rotationCondition.notify_all();
+}
+
+std::chrono::steady_clock::duration FileSink::FlushIfDue() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto elapsed = std::chrono::steady_clock::now() - m_lastFlushTime;
+    if (elapsed < m_flushInterval) {
+        return m_flushInterval - elapsed;
+    }
+    if (m_bufferUsed > 0 && m_fd >= 0) {
+        FlushBuffer();
+    }
+    return m_flushInterval;
+}
+
+void FileSink::AllocateBuffer(size_t bufferSize) {
+    // ページ境界に切り上げて整列確保
+    size_t capacity = (bufferSize + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+    if (capacity == m_bufferCapacity) {
+        return;
+    }
+    m_buffer.reset(static_cast<char*>(::operator new[](capacity, std::align_val_t{ kBufferAlignment })));
+    m_bufferCapacity = capacity;
+    m_bufferUsed = 0;
+}
+
+void FileSink::FlushBuffer() {
+    if (m_bufferUsed > 0 && m_fd >= 0) {
+        WriteToFile(m_buffer.get(), m_bufferUsed);
+    }
+    m_bufferUsed = 0;
+    m_lastFlushTime = std::chrono::steady_clock::now();
+}
+
+void FileSink::WriteToFile(const char* data, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(m_fd, data, static_cast<unsigned int>(std::min<size_t>(size, 0x40000000)));
+#else
+        ssize_t written = ::write(m_fd, data, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (written <= 0) {
+            std::cerr << "FileSink: Failed to write log file: " << m_filePath << std::endl;
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void FileSink::OpenFile(bool truncate) {
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : _O_APPEND);
+    if (_wsopen_s(&m_fd, m_filePath.c_str(), flags, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) {
+        m_fd = -1;
+    }
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND);
+    m_fd = ::open(m_filePath.c_str(), flags, 0644);
+#endif
+}
+
+void FileSink::CloseFile() {
+    if (m_fd < 0) {
+        return;
+    }
+#ifdef _WIN32
+    _close(m_fd);
+#else
+    ::close(m_fd);
+#endif
+    m_fd = -1;
 }
 
 void FileSink::CheckAndRotate() {
-    // ファイルサイズが最大サイズを超えていない場合は何もしない
-    if (m_currentSize < m_maxFileSize) {
+    // ファイルサイズが最大サイズを超えておらず、ローテーション間隔も経過していない場合は何もしない
+    const bool sizeExceeded = m_currentSize >= m_maxFileSize;
+    if (!sizeExceeded && m_rotationInterval.count() <= 0) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!sizeExceeded && now - m_openedTime < m_rotationInterval) {
+        return;
+    }
+    if (m_currentSize == 0) {
+        // 空のファイルは時間が経過してもローテーションしない
+        m_openedTime = now;
         return;
     }
 
-    // 現在のファイルを閉じる
-    if (m_file.is_open()) {
-        m_file.close();
+    // バッファの内容を書き出してから現在のファイルを閉じる
+    FlushBuffer();
+    CloseFile();
+
+    // 現在のログファイルを一時的な名前に退避し、すぐに新しいファイルを開く
+    // 世代のリネームと圧縮はバックグラウンドで行うため、書き込み側の停止はリネーム1回分で済む
+    std::filesystem::path pendingPath;
+    do {
+        pendingPath = m_filePath.string() + ".rotating." + std::to_string(++m_rotationSequence);
+    } while (std::filesystem::exists(pendingPath));
+
+    std::error_code ec;
+    std::filesystem::rename(m_filePath, pendingPath, ec);
+    if (ec) {
+        std::cerr << "FileSink: Failed to rename " << m_filePath << " to " << pendingPath
+                  << " : " << ec.message() << std::endl;
+        // 退避できなかった場合は同じファイルに追記を続ける
+        OpenFile(false);
+        m_currentSize = 0;
+        m_openedTime = now;
+        return;
     }
 
-    // 既存のバックアップファイルをローテーション
+    OpenFile(true);
+    m_currentSize = 0;
+    m_openedTime = now;
+
+    if (m_fd < 0) {
+        std::cerr << "FileSink: Failed to reopen log file after rotation: " << m_filePath << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_rotationMutex);
+        m_rotationJobs.push_back({ std::move(pendingPath), m_maxFiles, m_compressRotated });
+        if (!m_rotationThread.joinable()) {
+            m_rotationThread = std::thread(&FileSink::BackgroundLoop, this);
+        }
+    }
+    m_rotationCondition.notify_all();
+}
+
+void FileSink::WaitForRotation() {
+    std::unique_lock<std::mutex> lock(m_rotationMutex);
+    m_rotationCondition.wait(lock, [this] { return m_rotationJobs.empty() && !m_rotationBusy; });
+}
+
+void FileSink::BackgroundLoop() {
+    Logger::GetInstance().OnThreadStart();
+
+    // 定期書き出しの間隔の下限（間隔が0でも待機せずに回り続けないようにする）
+    constexpr auto kMinFlushWait = std::chrono::milliseconds(1);
+
+    std::unique_lock<std::mutex> lock(m_rotationMutex);
+    std::chrono::steady_clock::duration flushWait = std::chrono::steady_clock::duration::zero();
+    while (true) {
+        if (!m_rotationStop && m_rotationJobs.empty()) {
+            if (m_flushTimerEnabled) {
+                m_rotationCondition.wait_for(lock, std::max<std::chrono::steady_clock::duration>(flushWait, kMinFlushWait));
+            } else {
+                m_rotationCondition.wait(lock, [this] { return m_rotationStop || m_flushTimerEnabled || !m_rotationJobs.empty(); });
+            }
+        }
+        if (m_rotationJobs.empty()) {
+            if (m_rotationStop) {
+                return;
+            }
+
+            // 書き込みがなくても、間隔が経過したバッファは書き出す（m_mutexは書き込みスレッドと同じくこのミューテックスより先に取る）
+            if (m_flushTimerEnabled) {
+                lock.unlock();
+                flushWait = FlushIfDue();
+                lock.lock();
+            }
+            continue;
+        }
+
+        RotationJob job = std::move(m_rotationJobs.front());
+        m_rotationJobs.pop_front();
+        m_rotationBusy = true;
+
+        lock.unlock();
+        ProcessRotation(job);
+        lock.lock();
+
+        m_rotationBusy = false;
+        m_rotationCondition.notify_all();
+    }
+}
+
+void FileSink::ProcessRotation(const RotationJob& job) {
+    auto generationPath = [this](size_t index, bool compressed) {
+        return std::filesystem::path(m_filePath.string() + "." + std::to_string(index) + (compressed ? ".gz" : ""));
+    };
+
+    // 既存のバックアップファイルをローテーション（圧縮済みの世代も同様に扱う）
     // 例: .log.4 -> .log.5, .log.3 -> .log.4, ... , .log.1 -> .log.2
-    for (int i = static_cast<int>(m_maxFiles) - 1; i >= 1; --i) {
-        std::filesystem::path oldPath = m_filePath.string() + "." + std::to_string(i);
-        std::filesystem::path newPath = m_filePath.string() + "." + std::to_string(i + 1);
+    for (int i = static_cast<int>(job.maxFiles) - 1; i >= 1; --i) {
+        for (bool compressed : { false, true }) {
+            std::filesystem::path oldPath = generationPath(static_cast<size_t>(i), compressed);
+            if (!std::filesystem::exists(oldPath)) {
+                continue;
+            }
 
-        if (std::filesystem::exists(oldPath)) {
             // 最古のファイルは削除、それ以外はリネーム
-            if (i == static_cast<int>(m_maxFiles) - 1) {
-                std::filesystem::remove(oldPath);
+            std::error_code ec;
+            if (i == static_cast<int>(job.maxFiles) - 1) {
+                std::filesystem::remove(oldPath, ec);
             } else {
-                std::error_code ec;
+                std::filesystem::path newPath = generationPath(static_cast<size_t>(i) + 1, compressed);
                 std::filesystem::rename(oldPath, newPath, ec);
                 if (ec) {
                     std::cerr << "FileSink: Failed to rename " << oldPath << " to " << newPath
@@ -104,23 +399,24 @@ void FileSink::CheckAndRotate() {
         }
     }
 
-    // 現在のログファイルを .log.1 にリネーム
-    if (std::filesystem::exists(m_filePath)) {
-        std::filesystem::path backupPath = m_filePath.string() + ".1";
-        std::error_code ec;
-        std::filesystem::rename(m_filePath, backupPath, ec);
-        if (ec) {
-            std::cerr << "FileSink: Failed to rename " << m_filePath << " to " << backupPath
-                      << " : " << ec.message() << std::endl;
-        }
+    // 退避したファイルを .log.1 にリネーム
+    const std::filesystem::path backupPath = generationPath(1, false);
+    std::error_code ec;
+    std::filesystem::rename(job.pendingPath, backupPath, ec);
+    if (ec) {
+        std::cerr << "FileSink: Failed to rename " << job.pendingPath << " to " << backupPath
+                  << " : " << ec.message() << std::endl;
+        return;
     }
 
-    // 新しいファイルを開く
-    m_file.open(m_filePath, std::ios::out | std::ios::trunc);
-    m_currentSize = 0;
-
-    if (!m_file.is_open()) {
-        std::cerr << "FileSink: Failed to reopen log file after rotation: " << m_filePath << std::endl;
+    if (job.compress) {
+        const std::filesystem::path compressedPath = generationPath(1, true);
+        if (LogGzipCompressFile(backupPath, compressedPath)) {
+            std::filesystem::remove(backupPath, ec);
+        } else {
+            std::cerr << "FileSink: Failed to compress " << backupPath << std::endl;
+            std::filesystem::remove(compressedPath, ec);
+        }
     }
 }
 
@@ -0,0 +1,46 @@
+#include "Logger/JsonLinesSink.h"
+#include "Logger/LogTextWriter.h"
+#include <chrono>
+
+namespace RenderingSandbox {
+
+void JsonLinesSink::FormatJson(const LogMessage& message, std::string& out) {
+    char number[20];
+    const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(message.timestamp.time_since_epoch()).count();
+    char time[kLogTimeLength];
+    LogWriteTime(time, message.timestamp);
+
+    std::string_view level = LogLevelToString(message.level);
+    level = level.substr(0, level.find(' '));
+
+    out.assign("{\"time\":\"");
+    out.append(time, kLogTimeLength);
+    out.append("\",\"timestamp_us\":");
+    if (microseconds < 0) {
+        out.push_back('-');
+    }
+    out.append(number, LogWriteUInt(number, static_cast<uint64_t>(microseconds < 0 ? -microseconds : microseconds)));
+    out.append(",\"level\":");
+    LogAppendJsonString(out, level);
+    out.append(",\"category\":");
+    LogAppendJsonString(out, message.category);
+    out.append(",\"file\":");
+    LogAppendJsonString(out, message.file);
+    out.append(",\"line\":");
+    out.append(number, LogWriteUInt(number, static_cast<uint32_t>(message.line)));
+    out.append(",\"message\":");
+    LogAppendJsonString(out, message.GetText());
+    if (message.HasFields()) {
+        out.append(",\"fields\":{");
+        AppendLogFieldsJson(out, message.fields);
+        out.push_back('}');
+    }
+    out.push_back('}');
+}
+
+std::string_view JsonLinesSink::FormatLine(const LogMessage& message) {
+    FormatJson(message, m_lineBuffer);
+    return m_lineBuffer;
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,85 @@
+#include "Logger/LogBuffer.h"
+#include <cstring>
+
+namespace RenderingSandbox {
+
+template <size_t InlineCapacity>
+BasicLogBuffer<InlineCapacity>::BasicLogBuffer(const BasicLogBuffer& other) {
+    std::memcpy(Resize(other.m_size), other.GetData(), other.m_size);
+}
+
+template <size_t InlineCapacity>
+BasicLogBuffer<InlineCapacity>& BasicLogBuffer<InlineCapacity>::operator=(const BasicLogBuffer& other) {
+    if (this != &other) {
+        std::memcpy(Resize(other.m_size), other.GetData(), other.m_size);
+    }
+    return *this;
+}
+
+template <size_t InlineCapacity>
+BasicLogBuffer<InlineCapacity>::BasicLogBuffer(BasicLogBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+template <size_t InlineCapacity>
+BasicLogBuffer<InlineCapacity>& BasicLogBuffer<InlineCapacity>::operator=(BasicLogBuffer&& other) noexcept {
+    if (this != &other) {
+        if (other.m_heap) {
+            m_heap = std::move(other.m_heap);
+        } else {
+            m_heap.reset();
+            std::memcpy(m_inline.data(), other.m_inline.data(), other.m_size);
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+template <size_t InlineCapacity>
+std::byte* BasicLogBuffer<InlineCapacity>::Resize(size_t size) {
+    m_size = size;
+    if (size <= kInlineCapacity) {
+        m_heap.reset();
+        return m_inline.data();
+    }
+    m_heap = std::make_unique_for_overwrite<std::byte[]>(size);
+    return m_heap.get();
+}
+
+template <size_t InlineCapacity>
+void BasicLogBuffer<InlineCapacity>::Assign(std::string_view text) {
+    std::memcpy(Resize(text.size()), text.data(), text.size());
+}
+
+template <size_t InlineCapacity>
+void BasicLogBuffer<InlineCapacity>::Append(std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+
+    // インラインに収まる間はヒープを使っていない（Resizeの不変条件）
+    const size_t size = m_size + text.size();
+    if (size <= kInlineCapacity) {
+        std::memcpy(m_inline.data() + m_size, text.data(), text.size());
+        m_size = size;
+        return;
+    }
+
+    auto heap = std::make_unique_for_overwrite<std::byte[]>(size);
+    std::memcpy(heap.get(), GetData(), m_size);
+    std::memcpy(heap.get() + m_size, text.data(), text.size());
+    m_heap = std::move(heap);
+    m_size = size;
+}
+
+template <size_t InlineCapacity>
+void BasicLogBuffer<InlineCapacity>::Clear() {
+    m_heap.reset();
+    m_size = 0;
+}
+
+template class BasicLogBuffer<192>;
+template class BasicLogBuffer<64>;
+
+} // namespace RenderingSandbox
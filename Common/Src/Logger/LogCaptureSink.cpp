@@ -0,0 +1,86 @@
+#include "Logger/LogCaptureSink.h"
+#include <algorithm>
+
+namespace RenderingSandbox {
+
+LogCaptureSink::LogCaptureSink(size_t maxRecords)
+    : m_maxRecords(maxRecords > 0 ? maxRecords : 1) {
+}
+
+void LogCaptureSink::Write(const LogMessage& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!ShouldWrite(message)) {
+        return;
+    }
+
+    // 本文を確定させたコピーを保持する（遅延フォーマットの引数や呼び出し元の寿命に依存しない）
+    LogMessage copy;
+    copy.level = message.level;
+    copy.category = message.category;
+    copy.file = message.file;
+    copy.line = message.line;
+    copy.timestamp = message.timestamp;
+    copy.threadId = message.threadId;
+    copy.SetText(message.GetText());
+    copy.fields = message.fields;
+
+    if (m_records.size() < m_maxRecords) {
+        m_records.push_back(std::move(copy));
+        return;
+    }
+
+    // 上限に達したら最古のレコードを上書きする
+    m_records[m_head] = std::move(copy);
+    m_head = (m_head + 1) % m_records.size();
+    ++m_dropped;
+}
+
+std::vector<LogMessage> LogCaptureSink::GetMessages() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<LogMessage> messages;
+    messages.reserve(m_records.size());
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        messages.push_back(m_records[(m_head + i) % m_records.size()]);
+    }
+    return messages;
+}
+
+std::vector<LogMessage> LogCaptureSink::TakeMessages() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::rotate(m_records.begin(), m_records.begin() + static_cast<ptrdiff_t>(m_head), m_records.end());
+    m_head = 0;
+    std::vector<LogMessage> messages;
+    messages.swap(m_records);
+    return messages;
+}
+
+size_t LogCaptureSink::GetCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records.size();
+}
+
+size_t LogCaptureSink::GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void LogCaptureSink::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    m_head = 0;
+}
+
+ScopedLogCapture::ScopedLogCapture(LogLevel minLevel, size_t maxRecords)
+    : m_sink(std::make_shared<LogCaptureSink>(maxRecords)) {
+    m_sink->SetMinLevel(minLevel);
+    m_handle = Logger::GetInstance().AddSink(m_sink);
+}
+
+ScopedLogCapture::~ScopedLogCapture() {
+    Logger& logger = Logger::GetInstance();
+    logger.Flush();
+    logger.RemoveSink(m_handle);
+}
+
+} // namespace RenderingSandbox
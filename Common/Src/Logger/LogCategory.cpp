@@ -0,0 +1,97 @@
+#include "Logger/LogCategory.h"
+#include <mutex>
+
+namespace RenderingSandbox {
+
+LogCategoryRegistry::LogCategoryRegistry()
+    : m_count(1)
+    , m_globalLevel(LogLevel::Trace)
+{
+    for (auto& level : m_minLevels) {
+        level.store(LogLevel::Trace, std::memory_order_relaxed);
+    }
+    m_hasOverride.fill(false);
+
+    // ハンドル0は「カテゴリ指定なし」として予約
+    m_ids.emplace(std::string(), kDefaultCategory);
+}
+
+LogCategoryId LogCategoryRegistry::Register(std::string_view name) {
+    // 登録済みの場合は共有ロックのみで済ませる
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    const size_t count = m_count.load(std::memory_order_relaxed);
+    if (count >= kMaxCategories) {
+        return kInvalidCategory;
+    }
+
+    LogCategoryId id = static_cast<LogCategoryId>(count);
+    m_names[id] = name;
+    m_minLevels[id].store(m_globalLevel.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_ids.emplace(m_names[id], id);
+
+    // ロックなしのGetNameが名前を読めるよう、書き込んだ後に公開する
+    m_count.store(count + 1, std::memory_order_release);
+    return id;
+}
+
+size_t LogCategoryRegistry::GetCount() const {
+    return m_count.load(std::memory_order_acquire);
+}
+
+LogLevel LogCategoryRegistry::FindMinLevel(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return GetMinLevel(it->second);
+    }
+    return m_globalLevel.load(std::memory_order_relaxed);
+}
+
+void LogCategoryRegistry::SetGlobalLevel(LogLevel level) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_globalLevel.store(level, std::memory_order_relaxed);
+
+    // 個別設定のないカテゴリへ反映
+    const size_t count = m_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_hasOverride[i]) {
+            m_minLevels[i].store(level, std::memory_order_relaxed);
+        }
+    }
+    m_minLevels[kInvalidCategory].store(level, std::memory_order_relaxed);
+}
+
+void LogCategoryRegistry::SetLevel(LogCategoryId id, LogLevel level) {
+    if (id >= kMaxCategories) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_hasOverride[id] = true;
+    m_minLevels[id].store(level, std::memory_order_relaxed);
+}
+
+void LogCategoryRegistry::ClearLevel(LogCategoryId id) {
+    if (id >= kMaxCategories) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_hasOverride[id] = false;
+    m_minLevels[id].store(m_globalLevel.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,247 @@
+#include "Logger/LogCompression.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    constexpr size_t kWindowSize = 32768;           // deflateの最大参照距離
+    constexpr size_t kMinMatch = 3;
+    constexpr size_t kMaxMatch = 258;
+    constexpr int kHashBits = 15;
+    constexpr size_t kMaxChain = 64;                // 一致候補の探索回数の上限
+
+    constexpr uint16_t kLengthBase[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr uint8_t kLengthExtra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr uint16_t kDistanceBase[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr uint8_t kDistanceExtra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    struct HuffmanCode {
+        uint16_t bits;          // ビット順を反転済みの符号（LSBから出力する）
+        uint8_t length;
+    };
+
+    uint16_t ReverseBits(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        return static_cast<uint16_t>(reversed);
+    }
+
+    // 固定ハフマン符号の表（RFC 1951 3.2.6）
+    struct FixedTables {
+        std::array<HuffmanCode, 288> literals{};
+        std::array<HuffmanCode, 30> distances{};
+        std::array<uint8_t, kMaxMatch + 1> lengthSymbols{};         // 一致長 → 長さ符号（257からのオフセット）
+        std::array<uint32_t, 256> crc{};
+
+        FixedTables() {
+            for (uint32_t symbol = 0; symbol < 288; ++symbol) {
+                uint32_t code = 0;
+                int length = 0;
+                if (symbol < 144) {
+                    code = 0x30 + symbol;
+                    length = 8;
+                } else if (symbol < 256) {
+                    code = 0x190 + (symbol - 144);
+                    length = 9;
+                } else if (symbol < 280) {
+                    code = symbol - 256;
+                    length = 7;
+                } else {
+                    code = 0xC0 + (symbol - 280);
+                    length = 8;
+                }
+                literals[symbol] = { ReverseBits(code, length), static_cast<uint8_t>(length) };
+            }
+            for (uint32_t symbol = 0; symbol < 30; ++symbol) {
+                distances[symbol] = { ReverseBits(symbol, 5), 5 };
+            }
+            for (size_t length = kMinMatch; length <= kMaxMatch; ++length) {
+                uint8_t symbol = 0;
+                while (symbol + 1 < 29 && kLengthBase[symbol + 1] <= length) {
+                    ++symbol;
+                }
+                lengthSymbols[length] = symbol;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                crc[i] = value;
+            }
+        }
+    };
+
+    const FixedTables& GetTables() {
+        static const FixedTables tables;
+        return tables;
+    }
+
+    // LSBから詰めるビット出力
+    struct BitWriter {
+        std::string& out;
+        uint64_t buffer = 0;
+        int count = 0;
+
+        void Put(uint32_t bits, int length) {
+            buffer |= static_cast<uint64_t>(bits) << count;
+            count += length;
+            while (count >= 8) {
+                out.push_back(static_cast<char>(buffer & 0xFF));
+                buffer >>= 8;
+                count -= 8;
+            }
+        }
+
+        void Put(const HuffmanCode& code) {
+            Put(code.bits, code.length);
+        }
+
+        void Finish() {
+            if (count > 0) {
+                out.push_back(static_cast<char>(buffer & 0xFF));
+            }
+            buffer = 0;
+            count = 0;
+        }
+    };
+
+    uint32_t Hash3(const uint8_t* p) {
+        const uint32_t value = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16);
+        return (value * 2654435761u) >> (32 - kHashBits);
+    }
+
+    void PutLittleEndian32(std::string& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+    }
+
+} // namespace
+
+void LogGzipCompress(std::string_view data, std::string& out) {
+    const FixedTables& tables = GetTables();
+    const auto* input = reinterpret_cast<const uint8_t*>(data.data());
+    const size_t size = data.size();
+
+    out.clear();
+    out.reserve(size / 3 + 64);
+
+    // gzipヘッダ（deflate、フラグなし、時刻なし、OS不明）
+    static constexpr uint8_t kHeader[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF };
+    out.append(reinterpret_cast<const char*>(kHeader), sizeof(kHeader));
+
+    BitWriter writer{ out };
+    writer.Put(1, 1);           // BFINAL: 最後のブロック
+    writer.Put(1, 2);           // BTYPE: 固定ハフマン
+
+    std::vector<int32_t> head(size_t{ 1 } << kHashBits, -1);
+    std::vector<int32_t> previous(kWindowSize, -1);
+    auto insert = [&](size_t position) {
+        if (position + kMinMatch <= size) {
+            const uint32_t hash = Hash3(input + position);
+            previous[position % kWindowSize] = head[hash];
+            head[hash] = static_cast<int32_t>(position);
+        }
+    };
+
+    size_t position = 0;
+    while (position < size) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+
+        if (position + kMinMatch <= size) {
+            const size_t maxLength = std::min(kMaxMatch, size - position);
+            int32_t candidate = head[Hash3(input + position)];
+            for (size_t chain = 0; candidate >= 0 && chain < kMaxChain; ++chain) {
+                const size_t distance = position - static_cast<size_t>(candidate);
+                if (distance > kWindowSize) {
+                    break;
+                }
+                const uint8_t* match = input + candidate;
+                if (match[bestLength] == input[position + bestLength]) {
+                    size_t length = 0;
+                    while (length < maxLength && match[length] == input[position + length]) {
+                        ++length;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = distance;
+                        if (length == maxLength) {
+                            break;
+                        }
+                    }
+                }
+                const int32_t next = previous[static_cast<size_t>(candidate) % kWindowSize];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= kMinMatch) {
+            const uint8_t lengthSymbol = tables.lengthSymbols[bestLength];
+            writer.Put(tables.literals[257 + lengthSymbol]);
+            writer.Put(static_cast<uint32_t>(bestLength - kLengthBase[lengthSymbol]), kLengthExtra[lengthSymbol]);
+
+            const auto distanceSymbol = static_cast<size_t>(
+                std::upper_bound(std::begin(kDistanceBase), std::end(kDistanceBase), bestDistance) - std::begin(kDistanceBase) - 1);
+            writer.Put(tables.distances[distanceSymbol]);
+            writer.Put(static_cast<uint32_t>(bestDistance - kDistanceBase[distanceSymbol]), kDistanceExtra[distanceSymbol]);
+
+            for (size_t i = 0; i < bestLength; ++i) {
+                insert(position + i);
+            }
+            position += bestLength;
+        } else {
+            writer.Put(tables.literals[input[position]]);
+            insert(position);
+            ++position;
+        }
+    }
+
+    writer.Put(tables.literals[256]);       // ブロック終端
+    writer.Finish();
+
+    // gzipトレーラ（CRC32・元のサイズ）
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = tables.crc[(crc ^ input[i]) & 0xFF] ^ (crc >> 8);
+    }
+    PutLittleEndian32(out, crc ^ 0xFFFFFFFFu);
+    PutLittleEndian32(out, static_cast<uint32_t>(size));
+}
+
+bool LogGzipCompressFile(const std::filesystem::path& source, const std::filesystem::path& destination) {
+    std::ifstream input(source, std::ios::binary);
+    if (!input) {
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    std::string compressed;
+    LogGzipCompress(data, compressed);
+
+    std::ofstream output(destination, std::ios::binary | std::ios::trunc);
+    output.write(compressed.data(), static_cast<std::streamsize>(compressed.size()));
+    return static_cast<bool>(output);
+}
+
+} // namespace RenderingSandbox
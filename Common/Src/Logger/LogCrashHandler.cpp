@@ -0,0 +1,567 @@
+#include "Logger/LogCrashHandler.h"
+#include "Logger/Logger.h"
+#include "Logger/LogTextWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <io.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define LOG_CRASH_HAS_BACKTRACE 1
+#endif
+#endif
+
+namespace RenderingSandbox {
+
+namespace {
+
+    constexpr size_t kMaxTargets = 16;              // クラッシュレポートの出力先の上限
+    constexpr size_t kRecordBufferSize = 4096;      // 1レコード分の整形バッファ（スタック上）
+    constexpr int kMaxFrames = 64;                  // バックトレースのフレーム数の上限
+
+    std::atomic<bool> g_installed{ false };
+    std::atomic_flag g_reporting = ATOMIC_FLAG_INIT;    // 多重クラッシュ時に二重に書き出さないためのフラグ
+    int64_t g_utcOffsetSeconds = 0;                     // ローカル時刻の時差（Installで取得）
+
+    // クラッシュレポートの出力先
+    struct CrashTarget {
+        int fd;
+        LogLevel minLevel;
+    };
+
+    // 固定長バッファへの書き込み（溢れた分は捨てる）
+    struct FixedWriter {
+        char* cursor;
+        char* end;
+
+        void Append(std::string_view text) noexcept {
+            const size_t length = std::min(text.size(), static_cast<size_t>(end - cursor));
+            std::memcpy(cursor, text.data(), length);
+            cursor += length;
+        }
+
+        void Append(char c) noexcept {
+            if (cursor < end) {
+                *cursor++ = c;
+            }
+        }
+
+        void AppendUInt(uint64_t value) noexcept {
+            char digits[20];
+            Append(std::string_view(digits, static_cast<size_t>(LogWriteUInt(digits, value) - digits)));
+        }
+
+        void AppendInt(int64_t value) noexcept {
+            uint64_t magnitude = static_cast<uint64_t>(value);
+            if (value < 0) {
+                Append('-');
+                magnitude = ~magnitude + 1;
+            }
+            AppendUInt(magnitude);
+        }
+
+        void AppendHex(uint64_t value) noexcept {
+            static constexpr char kHex[] = "0123456789abcdef";
+            char digits[18] = { '0', 'x' };
+            for (int i = 0; i < 16; ++i) {
+                digits[17 - i] = kHex[(value >> (i * 4)) & 0x0F];
+            }
+            Append(std::string_view(digits, sizeof(digits)));
+        }
+
+        template <class T>
+        void AppendFloat(T value) noexcept {
+            char text[32];
+            const auto result = std::to_chars(text, text + sizeof(text), value);
+            Append(std::string_view(text, static_cast<size_t>(result.ptr - text)));
+        }
+    };
+
+    // 範囲を確認しながら引数バッファから値を読み出す
+    template <class T>
+    bool Load(const std::byte*& cursor, const std::byte* end, T& value) noexcept {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    // シリアライズ済みの引数を1つ既定の表記で書き込む（型を復元できない場合はfalse）
+    bool AppendArg(FixedWriter& out, LogArgKind kind, const std::byte*& cursor, const std::byte* end) noexcept {
+        switch (kind) {
+            case LogArgKind::Bool:   { bool v;     if (!Load(cursor, end, v)) return false; out.Append(v ? "true" : "false"); return true; }
+            case LogArgKind::Char:   { char v;     if (!Load(cursor, end, v)) return false; out.Append(v); return true; }
+            case LogArgKind::Int8:   { int8_t v;   if (!Load(cursor, end, v)) return false; out.AppendInt(v); return true; }
+            case LogArgKind::Int16:  { int16_t v;  if (!Load(cursor, end, v)) return false; out.AppendInt(v); return true; }
+            case LogArgKind::Int32:  { int32_t v;  if (!Load(cursor, end, v)) return false; out.AppendInt(v); return true; }
+            case LogArgKind::Int64:  { int64_t v;  if (!Load(cursor, end, v)) return false; out.AppendInt(v); return true; }
+            case LogArgKind::UInt8:  { uint8_t v;  if (!Load(cursor, end, v)) return false; out.AppendUInt(v); return true; }
+            case LogArgKind::UInt16: { uint16_t v; if (!Load(cursor, end, v)) return false; out.AppendUInt(v); return true; }
+            case LogArgKind::UInt32: { uint32_t v; if (!Load(cursor, end, v)) return false; out.AppendUInt(v); return true; }
+            case LogArgKind::UInt64: { uint64_t v; if (!Load(cursor, end, v)) return false; out.AppendUInt(v); return true; }
+            case LogArgKind::Float:  { float v;    if (!Load(cursor, end, v)) return false; out.AppendFloat(v); return true; }
+            case LogArgKind::Double: { double v;   if (!Load(cursor, end, v)) return false; out.AppendFloat(v); return true; }
+            case LogArgKind::Pointer: {
+                uintptr_t v;
+                if (!Load(cursor, end, v)) return false;
+                out.AppendHex(v);
+                return true;
+            }
+            case LogArgKind::String: {
+                uint32_t length;
+                if (!Load(cursor, end, length) || static_cast<size_t>(end - cursor) < length) {
+                    return false;
+                }
+                out.Append(std::string_view(reinterpret_cast<const char*>(cursor), length));
+                cursor += length;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // 遅延フォーマットのレコードの本文を、std::vformatを使わずに組み立てる
+    // 置換フィールドは順に引数で置き換え、復元できない引数以降は置換フィールドをそのまま残す
+    void AppendDeferredText(FixedWriter& out, const LogMessage& message) noexcept {
+        const std::string_view format = message.formatString;
+        const LogArgKind* kind = message.argKinds;
+        const std::byte* cursor = message.payload.GetData();
+        const std::byte* end = cursor + message.payload.GetSize();
+
+        for (size_t i = 0; i < format.size(); ++i) {
+            const char c = format[i];
+            if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+                out.Append(c);
+                ++i;
+                continue;
+            }
+            if (c != '{') {
+                out.Append(c);
+                continue;
+            }
+
+            const size_t close = format.find('}', i);
+            if (close == std::string_view::npos) {
+                out.Append(format.substr(i));
+                break;
+            }
+            if (kind && *kind != LogArgKind::End && AppendArg(out, *kind, cursor, end)) {
+                ++kind;
+            } else {
+                kind = nullptr;
+                out.Append(format.substr(i, close - i + 1));
+            }
+            i = close;
+        }
+    }
+
+    // 構造化フィールドを「 key=value」の並びで書き込む（時間はナノ秒、文字列はエスケープしない簡略表記）
+    void AppendFields(FixedWriter& out, const LogMessage& message) noexcept {
+        LogFieldReader reader(message.fields);
+        LogFieldView field;
+        while (reader.Next(field)) {
+            out.Append(' ');
+            out.Append(field.key);
+            out.Append('=');
+            switch (field.type) {
+                case LogFieldType::Bool:     out.Append(field.boolValue ? "true" : "false"); break;
+                case LogFieldType::Int:      out.AppendInt(field.intValue); break;
+                case LogFieldType::UInt:     out.AppendUInt(field.uintValue); break;
+                case LogFieldType::Float:    out.AppendFloat(field.floatValue); break;
+                case LogFieldType::Duration: out.AppendInt(field.intValue); out.Append("ns"); break;
+                case LogFieldType::String:
+                    out.Append('"');
+                    out.Append(field.stringValue);
+                    out.Append('"');
+                    break;
+            }
+        }
+    }
+
+    // 「HH:MM:SS.mmm」を書き込む（localtimeはシグナルハンドラで使えないため、Installで取得した時差を足す）
+    void AppendTime(FixedWriter& out, std::chrono::system_clock::time_point timestamp) noexcept {
+        const int64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count()
+            + g_utcOffsetSeconds * 1000;
+        constexpr int64_t kMillisecondsPerDay = 24 * 60 * 60 * 1000;
+        int64_t ofDay = milliseconds % kMillisecondsPerDay;
+        if (ofDay < 0) {
+            ofDay += kMillisecondsPerDay;
+        }
+
+        char text[kLogTimeLength];
+        char* p = text;
+        p = LogWriteUIntPadded(p, static_cast<uint32_t>(ofDay / 3600000), 2);
+        *p++ = ':';
+        p = LogWriteUIntPadded(p, static_cast<uint32_t>(ofDay / 60000 % 60), 2);
+        *p++ = ':';
+        p = LogWriteUIntPadded(p, static_cast<uint32_t>(ofDay / 1000 % 60), 2);
+        *p++ = '.';
+        LogWriteUIntPadded(p, static_cast<uint32_t>(ofDay % 1000), 3);
+        out.Append(std::string_view(text, kLogTimeLength));
+    }
+
+    // ローカル時刻とUTCの差（秒）
+    int64_t GetUtcOffsetSeconds() {
+        const std::time_t now = std::time(nullptr);
+        std::tm local{};
+        std::tm utc{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+        gmtime_s(&utc, &now);
+#else
+        localtime_r(&now, &local);
+        gmtime_r(&now, &utc);
+#endif
+        int64_t days = local.tm_yday - utc.tm_yday;
+        if (local.tm_year != utc.tm_year) {
+            days = local.tm_year > utc.tm_year ? 1 : -1;
+        }
+        return days * 86400
+            + static_cast<int64_t>(local.tm_hour - utc.tm_hour) * 3600
+            + static_cast<int64_t>(local.tm_min - utc.tm_min) * 60
+            + (local.tm_sec - utc.tm_sec);
+    }
+
+    void WriteToTargets(const CrashTarget* targets, size_t count, std::string_view text, LogLevel level = LogLevel::Fatal) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            if (level >= targets[i].minLevel) {
+                LogCrashHandler::WriteAll(targets[i].fd, text.data(), text.size());
+            }
+        }
+    }
+
+    void WriteBacktrace(const CrashTarget* targets, size_t count) noexcept {
+#if defined(LOG_CRASH_HAS_BACKTRACE)
+        void* frames[kMaxFrames];
+        const int frameCount = backtrace(frames, kMaxFrames);
+        for (size_t i = 0; i < count; ++i) {
+            backtrace_symbols_fd(frames, frameCount, targets[i].fd);
+        }
+#elif defined(_WIN32)
+        // シンボル解決（DbgHelp）はシグナル安全ではないため、アドレスだけを出力する
+        void* frames[kMaxFrames];
+        const USHORT frameCount = CaptureStackBackTrace(0, kMaxFrames, frames, nullptr);
+        for (USHORT frame = 0; frame < frameCount; ++frame) {
+            char line[48];
+            FixedWriter out{ line, line + sizeof(line) };
+            out.Append("  #");
+            out.AppendUInt(frame);
+            out.Append(' ');
+            out.AppendHex(reinterpret_cast<uintptr_t>(frames[frame]));
+            out.Append('\n');
+            WriteToTargets(targets, count, std::string_view(line, static_cast<size_t>(out.cursor - line)));
+        }
+#else
+        WriteToTargets(targets, count, "  (backtrace is not available on this platform)\n");
+#endif
+    }
+
+    // Sinkのバッファを書き出し、テキストを追記できる出力先であれば加える（同じ出力先は1つにまとめる）
+    void AddTarget(CrashTarget* targets, size_t& count, ILogSink& sink) noexcept {
+        const int fd = sink.EmergencyFlush();
+        if (fd < 0 || !sink.IsEnabled()) {
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (targets[i].fd == fd) {
+                targets[i].minLevel = std::min(targets[i].minLevel, sink.GetMinLevel());
+                return;
+            }
+        }
+        if (count < kMaxTargets) {
+            targets[count++] = { fd, sink.GetMinLevel() };
+        }
+    }
+
+    // クラッシュの理由、配信前のレコード、バックトレースの順に書き出す
+    void WriteReportToTargets(std::string_view reason, CrashTarget* targets, size_t count) noexcept {
+        // 出力先がない場合は標準エラー出力へ
+        if (count == 0) {
+            targets[count++] = { 2, LogLevel::Trace };
+        }
+
+        char line[kRecordBufferSize];
+        FixedWriter header{ line, line + sizeof(line) };
+        header.Append("\n*** Crash: ");
+        header.Append(reason);
+        header.Append(" ***\n*** Pending log records ***\n");
+        WriteToTargets(targets, count, std::string_view(line, static_cast<size_t>(header.cursor - line)));
+
+        // 配信前のレコードを出力先ごとの最小レベルで絞り込んで書き出す
+        Logger::GetInstance().ForEachPendingRecord([&](const LogMessage& message) {
+            const size_t size = LogCrashHandler::FormatRecord(message, line, sizeof(line));
+            WriteToTargets(targets, count, std::string_view(line, size), message.level);
+        });
+
+        WriteToTargets(targets, count, "*** Backtrace ***\n");
+        WriteBacktrace(targets, count);
+    }
+
+#ifdef _WIN32
+    LPTOP_LEVEL_EXCEPTION_FILTER g_previousFilter = nullptr;
+    void (*g_previousAbortHandler)(int) = SIG_DFL;
+
+    LONG WINAPI HandleException(EXCEPTION_POINTERS* exception) {
+        if (!g_reporting.test_and_set()) {
+            const EXCEPTION_RECORD* record = exception->ExceptionRecord;
+            char reason[64];
+            FixedWriter out{ reason, reason + sizeof(reason) };
+            out.Append("Exception ");
+            out.AppendHex(record->ExceptionCode);
+            out.Append(" at ");
+            out.AppendHex(reinterpret_cast<uintptr_t>(record->ExceptionAddress));
+            LogCrashHandler::WriteReport(std::string_view(reason, static_cast<size_t>(out.cursor - reason)));
+        }
+        return g_previousFilter ? g_previousFilter(exception) : EXCEPTION_CONTINUE_SEARCH;
+    }
+
+    void HandleAbort(int signal) {
+        if (!g_reporting.test_and_set()) {
+            LogCrashHandler::WriteReport("SIGABRT");
+        }
+        // 戻るとabortが既定の終了処理を続ける
+        std::signal(signal, g_previousAbortHandler);
+    }
+#else
+    constexpr int kSignals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGILL, SIGFPE };
+    constexpr size_t kSignalCount = sizeof(kSignals) / sizeof(kSignals[0]);
+    constexpr size_t kAltStackSize = 64 * 1024;
+
+    struct sigaction g_previousActions[kSignalCount];
+    alignas(16) char g_altStack[kAltStackSize];     // スタックオーバーフロー時に使う代替スタック（Installを呼んだスレッド用）
+
+    // InstallThreadAltStackで設定したスレッドごとの代替スタック（スレッドの終了時に解除してから解放する）
+    struct ThreadAltStack {
+        std::unique_ptr<char[]> memory;
+
+        ~ThreadAltStack() {
+            if (memory) {
+                stack_t disable{};
+                disable.ss_flags = SS_DISABLE;
+                sigaltstack(&disable, nullptr);
+            }
+        }
+    };
+    thread_local ThreadAltStack t_altStack;
+
+    const char* GetSignalName(int signal) {
+        switch (signal) {
+            case SIGSEGV: return "SIGSEGV";
+            case SIGABRT: return "SIGABRT";
+            case SIGBUS:  return "SIGBUS";
+            case SIGILL:  return "SIGILL";
+            case SIGFPE:  return "SIGFPE";
+            default:      return "signal";
+        }
+    }
+
+    void HandleSignal(int signal, siginfo_t* info, void*) {
+        const int savedErrno = errno;
+        if (!g_reporting.test_and_set()) {
+            char reason[64];
+            FixedWriter out{ reason, reason + sizeof(reason) };
+            out.Append(GetSignalName(signal));
+            if (signal != SIGABRT && info) {
+                out.Append(" at ");
+                out.AppendHex(reinterpret_cast<uintptr_t>(info->si_addr));
+            }
+            LogCrashHandler::WriteReport(std::string_view(reason, static_cast<size_t>(out.cursor - reason)));
+        }
+
+        // 元のハンドラ（通常は既定の動作）に戻して再送し、コアダンプ・終了ステータスを通常どおりにする
+        // ハンドラ内ではこのシグナルはブロックされているため、戻った時点で配送される
+        for (size_t i = 0; i < kSignalCount; ++i) {
+            if (kSignals[i] == signal) {
+                sigaction(signal, &g_previousActions[i], nullptr);
+            }
+        }
+        errno = savedErrno;
+        raise(signal);
+    }
+#endif
+
+} // namespace
+
+bool LogCrashHandler::Install() {
+    if (g_installed.exchange(true)) {
+        return true;
+    }
+    g_utcOffsetSeconds = GetUtcOffsetSeconds();
+
+#ifdef _WIN32
+    g_previousFilter = SetUnhandledExceptionFilter(&HandleException);
+    g_previousAbortHandler = std::signal(SIGABRT, &HandleAbort);
+    if (g_previousAbortHandler == SIG_ERR) {
+        g_previousAbortHandler = SIG_DFL;
+    }
+#else
+#if defined(LOG_CRASH_HAS_BACKTRACE)
+    // 初回のbacktraceは内部で共有ライブラリを読み込む（ヒープ確保する）ため、ここで済ませておく
+    void* frames[1];
+    backtrace(frames, 1);
+#endif
+
+    stack_t altStack{};
+    altStack.ss_sp = g_altStack;
+    altStack.ss_size = kAltStackSize;
+    sigaltstack(&altStack, nullptr);
+
+    struct sigaction action{};
+    action.sa_sigaction = &HandleSignal;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < kSignalCount; ++i) {
+        if (sigaction(kSignals[i], &action, &g_previousActions[i]) != 0) {
+            Uninstall();
+            return false;
+        }
+    }
+#endif
+
+    // Loggerや各Sinkがこれ以降に起動するスレッドにも代替スタックを設定する
+    Logger::GetInstance().SetThreadStartHook(&InstallThreadAltStack);
+    return true;
+}
+
+void LogCrashHandler::InstallThreadAltStack() {
+#ifndef _WIN32
+    // ハンドラを登録していなければ代替スタックは使われないため、確保しない
+    if (!g_installed.load()) {
+        return;
+    }
+
+    stack_t current{};
+    if (sigaltstack(nullptr, &current) == 0 && !(current.ss_flags & SS_DISABLE)) {
+        return;
+    }
+
+    auto memory = std::make_unique_for_overwrite<char[]>(kAltStackSize);
+    stack_t altStack{};
+    altStack.ss_sp = memory.get();
+    altStack.ss_size = kAltStackSize;
+    if (sigaltstack(&altStack, nullptr) == 0) {
+        t_altStack.memory = std::move(memory);
+    }
+#endif
+}
+
+void LogCrashHandler::Uninstall() {
+    if (!g_installed.exchange(false)) {
+        return;
+    }
+    Logger::GetInstance().SetThreadStartHook(nullptr);
+
+#ifdef _WIN32
+    SetUnhandledExceptionFilter(g_previousFilter);
+    std::signal(SIGABRT, g_previousAbortHandler);
+#else
+    for (size_t i = 0; i < kSignalCount; ++i) {
+        struct sigaction current{};
+        sigaction(kSignals[i], nullptr, &current);
+        if ((current.sa_flags & SA_SIGINFO) && current.sa_sigaction == &HandleSignal) {
+            sigaction(kSignals[i], &g_previousActions[i], nullptr);
+        }
+    }
+#endif
+}
+
+bool LogCrashHandler::IsInstalled() {
+    return g_installed.load();
+}
+
+void LogCrashHandler::WriteReport(std::string_view reason) noexcept {
+    // 各Sinkのバッファを書き出し、テキストを追記できる出力先を集める（同じ出力先は1つにまとめる）
+    CrashTarget targets[kMaxTargets];
+    size_t targetCount = 0;
+    Logger::GetInstance().ForEachSinkUnsafe([&](ILogSink& sink) {
+        AddTarget(targets, targetCount, sink);
+    });
+    WriteReportToTargets(reason, targets, targetCount);
+}
+
+void LogCrashHandler::WriteReport(std::string_view reason, ILogSink* const* sinks, size_t count) noexcept {
+    CrashTarget targets[kMaxTargets];
+    size_t targetCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        AddTarget(targets, targetCount, *sinks[i]);
+    }
+    WriteReportToTargets(reason, targets, targetCount);
+}
+
+size_t LogCrashHandler::FormatRecord(const LogMessage& message, char* buffer, size_t capacity) noexcept {
+    if (capacity == 0) {
+        return 0;
+    }
+    // 末尾の改行の分を残して書き込む
+    FixedWriter out{ buffer, buffer + capacity - 1 };
+
+    out.Append('[');
+    AppendTime(out, message.timestamp);
+    out.Append("] [");
+    out.Append(LogLevelToString(message.level));
+    out.Append("] ");
+    if (!message.category.empty()) {
+        out.Append('[');
+        out.Append(message.category);
+        out.Append("] ");
+    }
+
+    // 遅延フォーマットのレコードはGetText（std::vformat・ヒープ確保を伴う）を呼ばずに組み立てる
+    if (message.formatter) {
+        AppendDeferredText(out, message);
+    } else {
+        out.Append(message.payload.GetView());
+    }
+    if (message.HasFields()) {
+        AppendFields(out, message);
+    }
+
+    if (message.file && message.file[0] != '\0' && message.line > 0) {
+        out.Append(" (");
+        out.Append(message.file);
+        out.Append(':');
+        out.AppendUInt(static_cast<uint32_t>(message.line));
+        out.Append(')');
+    }
+
+    *out.cursor++ = '\n';
+    return static_cast<size_t>(out.cursor - buffer);
+}
+
+bool LogCrashHandler::WriteAll(int fd, const void* data, size_t size) noexcept {
+    const char* cursor = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef _WIN32
+        const int written = _write(fd, cursor, static_cast<unsigned int>(std::min<size_t>(size, 0x40000000)));
+#else
+        const ssize_t written = ::write(fd, cursor, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        cursor += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace RenderingSandbox
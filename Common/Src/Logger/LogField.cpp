@@ -0,0 +1,228 @@
+#include "Logger/LogField.h"
+#include "Logger/LogTextWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    constexpr size_t kMaxKeyLength = 255;
+
+    size_t GetEncodedSize(const LogField& field) {
+        const size_t keyLength = std::min(field.key.size(), kMaxKeyLength);
+        const size_t valueSize = field.type == LogFieldType::String ? sizeof(uint32_t) + field.stringValue.size() : sizeof(uint64_t);
+        return 2 + keyLength + valueSize;
+    }
+
+    void AppendInt(std::string& out, int64_t value) {
+        char digits[24];
+        char* p = digits;
+        uint64_t magnitude = static_cast<uint64_t>(value);
+        if (value < 0) {
+            *p++ = '-';
+            magnitude = ~magnitude + 1;
+        }
+        out.append(digits, static_cast<size_t>(LogWriteUInt(p, magnitude) - digits));
+    }
+
+    void AppendUInt(std::string& out, uint64_t value) {
+        char digits[20];
+        out.append(digits, static_cast<size_t>(LogWriteUInt(digits, value) - digits));
+    }
+
+    // 最短で元の値に戻る表記（JSONで表せないNaN・無限大はnullにする）
+    void AppendFloat(std::string& out, double value, bool json) {
+        if (json && !std::isfinite(value)) {
+            out.append("null");
+            return;
+        }
+        char text[32];
+        const auto result = std::to_chars(text, text + sizeof(text), value);
+        out.append(text, result.ptr);
+    }
+
+    // 小数点以下3桁の固定小数点表記（時間の表示用）
+    void AppendFixed3(std::string& out, int64_t thousandths) {
+        // INT64_MINも符号反転できるよう、絶対値は符号なしで求める
+        uint64_t magnitude = static_cast<uint64_t>(thousandths);
+        if (thousandths < 0) {
+            out.push_back('-');
+            magnitude = 0 - magnitude;
+        }
+        AppendUInt(out, magnitude / 1000);
+        char fraction[3];
+        LogWriteUIntPadded(fraction, static_cast<uint32_t>(magnitude % 1000), 3);
+        out.push_back('.');
+        out.append(fraction, 3);
+    }
+
+    // key=value形式で値を引用符で囲む必要があるか
+    bool NeedsQuote(std::string_view text) {
+        if (text.empty()) {
+            return true;
+        }
+        return std::any_of(text.begin(), text.end(), [](char c) {
+            return c == ' ' || c == '=' || c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+        });
+    }
+
+} // namespace
+
+void AppendLogDuration(std::string& out, int64_t nanoseconds) {
+    const uint64_t magnitude = nanoseconds < 0 ? 0 - static_cast<uint64_t>(nanoseconds) : static_cast<uint64_t>(nanoseconds);
+    if (magnitude < 1000) {
+        AppendInt(out, nanoseconds);
+        out.append("ns");
+    } else if (magnitude < 1000000) {
+        AppendFixed3(out, nanoseconds);
+        out.append("us");
+    } else if (magnitude < 1000000000) {
+        AppendFixed3(out, nanoseconds / 1000);
+        out.append("ms");
+    } else {
+        AppendFixed3(out, nanoseconds / 1000000);
+        out.append("s");
+    }
+}
+
+void EncodeLogFields(LogFieldBuffer& buffer, const LogField* fields, size_t count) {
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size += GetEncodedSize(fields[i]);
+    }
+
+    std::byte* cursor = buffer.Resize(size);
+    for (size_t i = 0; i < count; ++i) {
+        const LogField& field = fields[i];
+        const auto keyLength = static_cast<uint8_t>(std::min(field.key.size(), kMaxKeyLength));
+        *cursor++ = static_cast<std::byte>(field.type);
+        *cursor++ = static_cast<std::byte>(keyLength);
+        std::memcpy(cursor, field.key.data(), keyLength);
+        cursor += keyLength;
+
+        if (field.type == LogFieldType::String) {
+            const auto length = static_cast<uint32_t>(field.stringValue.size());
+            std::memcpy(cursor, &length, sizeof(length));
+            cursor += sizeof(length);
+            if (length > 0) {
+                std::memcpy(cursor, field.stringValue.data(), length);
+            }
+            cursor += length;
+        } else {
+            uint64_t bits = 0;
+            switch (field.type) {
+                case LogFieldType::Bool:  bits = field.boolValue ? 1 : 0; break;
+                case LogFieldType::Float: std::memcpy(&bits, &field.floatValue, sizeof(bits)); break;
+                default:                  bits = field.uintValue; break;
+            }
+            std::memcpy(cursor, &bits, sizeof(bits));
+            cursor += sizeof(bits);
+        }
+    }
+}
+
+bool LogFieldReader::Next(LogFieldView& field) {
+    if (m_end - m_cursor < 2) {
+        return false;
+    }
+    const auto type = static_cast<LogFieldType>(m_cursor[0]);
+    const auto keyLength = static_cast<size_t>(m_cursor[1]);
+    const std::byte* value = m_cursor + 2 + keyLength;
+    if (value > m_end) {
+        return false;
+    }
+
+    field.key = std::string_view(reinterpret_cast<const char*>(m_cursor + 2), keyLength);
+    field.type = type;
+    field.stringValue = {};
+
+    if (type == LogFieldType::String) {
+        uint32_t length = 0;
+        if (static_cast<size_t>(m_end - value) < sizeof(length)) {
+            return false;
+        }
+        std::memcpy(&length, value, sizeof(length));
+        value += sizeof(length);
+        if (static_cast<size_t>(m_end - value) < length) {
+            return false;
+        }
+        field.stringValue = std::string_view(reinterpret_cast<const char*>(value), length);
+        field.intValue = 0;
+        m_cursor = value + length;
+        return true;
+    }
+
+    uint64_t bits = 0;
+    if (static_cast<size_t>(m_end - value) < sizeof(bits)) {
+        return false;
+    }
+    std::memcpy(&bits, value, sizeof(bits));
+    switch (type) {
+        case LogFieldType::Bool:  field.boolValue = bits != 0; break;
+        case LogFieldType::Float: std::memcpy(&field.floatValue, &bits, sizeof(bits)); break;
+        default:                  field.uintValue = bits; break;
+    }
+    m_cursor = value + sizeof(bits);
+    return true;
+}
+
+void AppendLogFieldsText(std::string& out, const LogFieldBuffer& fields) {
+    LogFieldReader reader(fields);
+    LogFieldView field;
+    bool first = true;
+    while (reader.Next(field)) {
+        if (!first) {
+            out.push_back(' ');
+        }
+        first = false;
+        out.append(field.key);
+        out.push_back('=');
+        switch (field.type) {
+            case LogFieldType::Bool:     out.append(field.boolValue ? "true" : "false"); break;
+            case LogFieldType::Int:      AppendInt(out, field.intValue); break;
+            case LogFieldType::UInt:     AppendUInt(out, field.uintValue); break;
+            case LogFieldType::Float:    AppendFloat(out, field.floatValue, false); break;
+            case LogFieldType::Duration: AppendLogDuration(out, field.intValue); break;
+            case LogFieldType::String:
+                if (NeedsQuote(field.stringValue)) {
+                    // JSONと同じエスケープ規則で引用符付きにする
+                    LogAppendJsonString(out, field.stringValue);
+                } else {
+                    out.append(field.stringValue);
+                }
+                break;
+        }
+    }
+}
+
+void AppendLogFieldsJson(std::string& out, const LogFieldBuffer& fields) {
+    LogFieldReader reader(fields);
+    LogFieldView field;
+    bool first = true;
+    while (reader.Next(field)) {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        LogAppendJsonString(out, field.key);
+        if (field.type == LogFieldType::Duration) {
+            // 単位をキーに含める（閉じ引用符の手前に接尾辞を入れる）
+            out.pop_back();
+            out.append("_ns\"");
+        }
+        out.push_back(':');
+        switch (field.type) {
+            case LogFieldType::Bool:     out.append(field.boolValue ? "true" : "false"); break;
+            case LogFieldType::Int:      AppendInt(out, field.intValue); break;
+            case LogFieldType::UInt:     AppendUInt(out, field.uintValue); break;
+            case LogFieldType::Float:    AppendFloat(out, field.floatValue, true); break;
+            case LogFieldType::Duration: AppendInt(out, field.intValue); break;
+            case LogFieldType::String:   LogAppendJsonString(out, field.stringValue); break;
+        }
+    }
+}
+
+} // namespace RenderingSandbox
@@ -1,51 +1,159 @@
 #include "Logger/LogMessage.h"
-#include <sstream>
-#include <iomanip>
-#include <ctime>
+#include "Logger/LogTextWriter.h"
+#include <algorithm>
+#include <cstring>
 
 namespace RenderingSandbox {
 
+std::string_view LogMessage::GetText() const {
+    if (!formatter) {
+        return payload.GetView();
+    }
+
+    if (textOffset == kNoText) {
+        // フォーマット結果の一時領域はスレッドごとに使い回す
+        thread_local std::string scratch;
+
+        try {
+            formatter(formatString, payload, scratch);
+        } catch (const std::exception& e) {
+            scratch = std::string("<format error: ") + e.what() + "> " + std::string(formatString);
+        }
+        textOffset = static_cast<uint32_t>(payload.GetSize());
+        payload.Append(scratch);
+    }
+    return payload.GetView().substr(textOffset);
+}
+
+namespace {
+
+    // 書き込み先の残り容量を超えないように追記する
+    struct BoundedWriter {
+        char* cursor;
+        char* end;
+
+        void Append(std::string_view text) {
+            size_t length = std::min(text.size(), static_cast<size_t>(end - cursor));
+            std::memcpy(cursor, text.data(), length);
+            cursor += length;
+        }
+    };
+
+    // 「 (file:line)」部分を出力するかどうか
+    bool HasSourceLocation(const LogMessage& message) {
+        return message.file && message.file[0] != '\0' && message.line > 0;
+    }
+
+    // 構造化フィールドの「 key=value ...」部分（スレッドごとの一時領域、次の呼び出しまで有効）
+    std::string_view GetFieldsText(const LogMessage& message) {
+        thread_local std::string text;
+        text.clear();
+        if (message.HasFields()) {
+            text.push_back(' ');
+            AppendLogFieldsText(text, message.fields);
+        }
+        return text;
+    }
+
+    // 「 (file:line)」部分の長さ
+    size_t GetSourceLocationSize(const LogMessage& message) {
+        char digits[20];
+        return std::strlen(message.file) + static_cast<size_t>(LogWriteUInt(digits, static_cast<uint32_t>(message.line)) - digits) + 4;
+    }
+
+} // namespace
+
 std::string LogMessage::Format() const {
-    std::ostringstream oss;
+    std::string formatted;
+    FormatTo(formatted);
+    return formatted;
+}
+
+void LogMessage::FormatTo(std::string& out) const {
+    out.resize(GetFormattedSize());
+    out.resize(FormatTo(out.data(), out.size()));
+}
 
-    // タイムスタンプ [HH:MM:SS.mmm]
-    auto timeT = std::chrono::system_clock::to_time_t(timestamp);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        timestamp.time_since_epoch()) % 1000;
+size_t LogMessage::GetFormattedSize() const {
+    // "[HH:MM:SS.mmm] [LEVEL] "
+    size_t size = kLogTimeLength + 3 + std::strlen(LogLevelToString(level)) + 3;
+    if (!category.empty()) {
+        size += category.size() + 3;
+    }
+    size += GetText().size();
+    if (HasFields()) {
+        size += GetFieldsText(*this).size();
+    }
+    if (HasSourceLocation(*this)) {
+        size += GetSourceLocationSize(*this);
+    }
+    return size;
+}
 
-    std::tm tmBuf{};
-#ifdef _WIN32
-    localtime_s(&tmBuf, &timeT);
-#else
-    localtime_r(&timeT, &tmBuf);
-#endif
+size_t LogMessage::FormatTo(char* buffer, size_t capacity) const {
+    // ヘッダ（タイムスタンプ・レベル）は固定長なので一時領域で組み立ててから追記
+    char header[kLogTimeLength + 16];
+    char* p = header;
+    *p++ = '[';
+    p = LogWriteTime(p, timestamp);
+    *p++ = ']';
+    *p++ = ' ';
+    *p++ = '[';
+    const char* levelText = LogLevelToString(level);
+    size_t levelLength = std::strlen(levelText);
+    std::memcpy(p, levelText, levelLength);
+    p += levelLength;
+    *p++ = ']';
+    *p++ = ' ';
 
-    oss << "[" << std::put_time(&tmBuf, "%H:%M:%S")
-        << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
+    // 末尾の「 (file:line)」は本文より優先して残す
+    char location[32];
+    char* locationEnd = location;
+    size_t fileLength = 0;
+    if (HasSourceLocation(*this)) {
+        fileLength = std::strlen(file);
+        *locationEnd++ = ':';
+        locationEnd = LogWriteUInt(locationEnd, static_cast<uint32_t>(line));
+        *locationEnd++ = ')';
+    }
+    size_t suffixSize = (locationEnd != location) ? 2 + fileLength + static_cast<size_t>(locationEnd - location) : 0;
 
-    // ログレベル [LEVEL]
-    oss << "[" << LogLevelToString(level) << "] ";
+    BoundedWriter writer{ buffer, buffer + capacity };
+    writer.Append(std::string_view(header, static_cast<size_t>(p - header)));
 
     // カテゴリ [Category]（指定されている場合）
     if (!category.empty()) {
-        oss << "[" << category << "] ";
+        writer.Append("[");
+        writer.Append(category);
+        writer.Append("] ");
+    }
+
+    // メッセージ本文（ファイル名部分の領域を残して切り詰める）
+    std::string_view text = GetText();
+    size_t remaining = static_cast<size_t>(writer.end - writer.cursor);
+    if (remaining > suffixSize && text.size() > remaining - suffixSize) {
+        text = text.substr(0, remaining - suffixSize);
     }
+    writer.Append(text);
 
-    // メッセージ本文
-    oss << message;
+    // 構造化フィールド（本文と同様にファイル名部分の領域を残して切り詰める）
+    if (HasFields()) {
+        std::string_view fieldsText = GetFieldsText(*this);
+        remaining = static_cast<size_t>(writer.end - writer.cursor);
+        if (remaining > suffixSize && fieldsText.size() > remaining - suffixSize) {
+            fieldsText = fieldsText.substr(0, remaining - suffixSize);
+        }
+        writer.Append(fieldsText);
+    }
 
     // ファイル名と行番号（指定されている場合）
-    if (!file.empty() && line > 0) {
-        // ファイルパスからファイル名のみを抽出
-        std::string filename = file;
-        size_t lastSlash = filename.find_last_of("/\\");
-        if (lastSlash != std::string::npos) {
-            filename = filename.substr(lastSlash + 1);
-        }
-        oss << " (" << filename << ":" << line << ")";
+    if (suffixSize > 0) {
+        writer.Append(" (");
+        writer.Append(std::string_view(file, fileLength));
+        writer.Append(std::string_view(location, static_cast<size_t>(locationEnd - location)));
     }
 
-    return oss.str();
+    return static_cast<size_t>(writer.cursor - buffer);
 }
 
 } // namespace RenderingSandbox
@@ -0,0 +1,254 @@
+#include "Logger/LogPattern.h"
+#include "Logger/LogTextWriter.h"
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    // 配信中のレコードと、パターンごとの整形結果（スレッドごと、文字列の容量は使い回す）
+    struct CacheEntry {
+        const LogPattern* pattern = nullptr;
+        std::string text;
+    };
+
+    struct CacheState {
+        static constexpr size_t kMaxEntries = 4;
+
+        const LogMessage* message = nullptr;
+        size_t count = 0;
+        std::array<CacheEntry, kMaxEntries> entries;
+    };
+
+    thread_local CacheState t_cache;
+
+    // スレッドIDの文字列表現（IDが変わった時だけ作り直す）
+    std::string_view GetThreadIdText(std::thread::id id) {
+        thread_local std::thread::id cachedId;
+        thread_local std::string cachedText;
+        if (id != cachedId || cachedText.empty()) {
+            std::ostringstream oss;
+            oss << id;
+            cachedText = oss.str();
+            cachedId = id;
+        }
+        return cachedText;
+    }
+
+    void AppendUInt(std::string& out, uint64_t value) {
+        char digits[20];
+        out.append(digits, static_cast<size_t>(LogWriteUInt(digits, value) - digits));
+    }
+
+} // namespace
+
+std::shared_ptr<const LogPattern> LogPattern::Compile(std::string_view pattern) {
+    // パターン文字列ごとに1つだけコンパイルし、Sink間で共有する（キャッシュのキーがポインタのため）
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::weak_ptr<const LogPattern>> compiled;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string key(pattern);
+    if (auto existing = compiled[key].lock()) {
+        return existing;
+    }
+    auto created = std::make_shared<const LogPattern>(pattern);
+    compiled[key] = created;
+    return created;
+}
+
+const std::shared_ptr<const LogPattern>& LogPattern::GetDefault() {
+    static const std::shared_ptr<const LogPattern> defaultPattern = Compile(kDefaultPattern);
+    return defaultPattern;
+}
+
+LogPattern::LogPattern(std::string_view pattern)
+    : m_source(pattern)
+{
+    std::vector<size_t> openGroups;
+    std::string literal;
+
+    auto flushLiteral = [&]() {
+        if (!literal.empty()) {
+            Op op{ OpType::Literal };
+            op.literalOffset = static_cast<uint32_t>(m_literals.size());
+            op.literalLength = static_cast<uint32_t>(literal.size());
+            m_literals += literal;
+            m_ops.push_back(op);
+            literal.clear();
+        }
+    };
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c != '%' || i + 1 >= pattern.size()) {
+            literal += c;
+            continue;
+        }
+
+        char spec = pattern[++i];
+        OpType type;
+        switch (spec) {
+            case 'T': type = OpType::Time; break;
+            case 'L': type = OpType::Level; break;
+            case 'c': type = OpType::Category; break;
+            case 'v': type = OpType::Text; break;
+            case 'k': type = OpType::Fields; break;
+            case 's': type = OpType::File; break;
+            case '#': type = OpType::Line; break;
+            case 't': type = OpType::Thread; break;
+            case '[': type = OpType::GroupBegin; break;
+            case ']': type = OpType::GroupEnd; break;
+            case '%': literal += '%'; continue;
+            default:
+                // 未知の指定子はそのまま出力
+                literal += '%';
+                literal += spec;
+                continue;
+        }
+
+        flushLiteral();
+        if (type == OpType::GroupEnd) {
+            if (openGroups.empty()) {
+                continue;
+            }
+            m_ops[openGroups.back()].groupEnd = static_cast<uint32_t>(m_ops.size() + 1);
+            openGroups.pop_back();
+        } else if (type == OpType::GroupBegin) {
+            openGroups.push_back(m_ops.size());
+        }
+        m_ops.push_back(Op{ type });
+    }
+    flushLiteral();
+
+    // 閉じられていないグループは末尾までとする
+    for (size_t index : openGroups) {
+        m_ops[index].groupEnd = static_cast<uint32_t>(m_ops.size());
+    }
+}
+
+bool LogPattern::IsGroupPresent(const LogMessage& message, size_t begin, size_t end) const {
+    for (size_t i = begin; i < end; ++i) {
+        switch (m_ops[i].type) {
+            case OpType::Category:
+                if (message.category.empty()) return false;
+                break;
+            case OpType::Text:
+                if (message.GetText().empty()) return false;
+                break;
+            case OpType::Fields:
+                if (!message.HasFields()) return false;
+                break;
+            case OpType::File:
+                if (!message.file || message.file[0] == '\0') return false;
+                break;
+            case OpType::Line:
+                if (message.line <= 0) return false;
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+void LogPattern::FormatTo(const LogMessage& message, std::string& out) const {
+    out.clear();
+
+    for (size_t i = 0; i < m_ops.size(); ++i) {
+        const Op& op = m_ops[i];
+        switch (op.type) {
+            case OpType::Literal:
+                out.append(m_literals, op.literalOffset, op.literalLength);
+                break;
+
+            case OpType::Time: {
+                char time[kLogTimeLength];
+                LogWriteTime(time, message.timestamp);
+                out.append(time, kLogTimeLength);
+                break;
+            }
+
+            case OpType::Level:
+                out.append(LogLevelToString(message.level));
+                break;
+
+            case OpType::Category:
+                out.append(message.category);
+                break;
+
+            case OpType::Text:
+                out.append(message.GetText());
+                break;
+
+            case OpType::Fields:
+                AppendLogFieldsText(out, message.fields);
+                break;
+
+            case OpType::File:
+                if (message.file) {
+                    out.append(message.file);
+                }
+                break;
+
+            case OpType::Line:
+                AppendUInt(out, static_cast<uint32_t>(message.line));
+                break;
+
+            case OpType::Thread:
+                out.append(GetThreadIdText(message.threadId));
+                break;
+
+            case OpType::GroupBegin:
+                // グループ内のフィールドが欠けている場合はグループごと飛ばす
+                if (!IsGroupPresent(message, i + 1, op.groupEnd)) {
+                    i = op.groupEnd - 1;
+                }
+                break;
+
+            case OpType::GroupEnd:
+                break;
+        }
+    }
+}
+
+LogFormatCache::LogFormatCache(const LogMessage& message) {
+    t_cache.message = &message;
+    t_cache.count = 0;
+}
+
+LogFormatCache::~LogFormatCache() {
+    t_cache.message = nullptr;
+    t_cache.count = 0;
+}
+
+std::string_view LogFormatCache::Format(const LogMessage& message, const LogPattern& pattern, std::string& fallback) {
+    CacheState& cache = t_cache;
+    if (cache.message != &message) {
+        pattern.FormatTo(message, fallback);
+        return fallback;
+    }
+
+    for (size_t i = 0; i < cache.count; ++i) {
+        if (cache.entries[i].pattern == &pattern) {
+            return cache.entries[i].text;
+        }
+    }
+
+    if (cache.count >= CacheState::kMaxEntries) {
+        pattern.FormatTo(message, fallback);
+        return fallback;
+    }
+
+    CacheEntry& entry = cache.entries[cache.count++];
+    entry.pattern = &pattern;
+    pattern.FormatTo(message, entry.text);
+    return entry.text;
+}
+
+} // namespace RenderingSandbox
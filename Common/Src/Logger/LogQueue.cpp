@@ -0,0 +1,72 @@
+#include "Logger/LogQueue.h"
+#include <bit>
+#include <cstdint>
+
+namespace RenderingSandbox {
+
+LogQueue::LogQueue(size_t capacity)
+    : m_mask(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1)
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+{
+    m_slots = std::make_unique<Slot[]>(m_mask + 1);
+    for (size_t i = 0; i <= m_mask; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::TryPush(LogMessage&& message) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & m_mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // 空きスロット：書き込み位置の確保を試みる
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.message = std::move(message);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 一周前のレコードがまだ読み出されていない（満杯）
+            return false;
+        } else {
+            // 他の生産者に先を越された
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogQueue::TryPop(LogMessage& message) {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & m_mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            // 書き込み済みスロット：読み出し位置の確保を試みる
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                message = std::move(slot.message);
+                slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // まだ書き込まれていない（空）
+            return false;
+        } else {
+            // 他の消費者に先を越された
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogQueue::IsEmpty() const {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    const Slot& slot = m_slots[pos & m_mask];
+    return slot.sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+} // namespace RenderingSandbox
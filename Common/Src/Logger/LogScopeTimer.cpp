@@ -0,0 +1,30 @@
+#include "Logger/LogScopeTimer.h"
+
+namespace RenderingSandbox {
+
+LogScopeStats::LogScopeStats(std::string_view category, std::string_view name, const char* file, int line)
+    : m_category(category)
+    , m_categoryId(Logger::GetInstance().RegisterCategory(category))
+    , m_name(name)
+    , m_file(file ? file : "")
+    , m_line(line) {
+    Logger::GetInstance().RegisterScopeStats(this);
+}
+
+LogScopeStats::~LogScopeStats() {
+    Logger::GetInstance().UnregisterScopeStats(this);
+}
+
+LogScopeStats::Snapshot LogScopeStats::TakeSnapshot() {
+    Snapshot snapshot;
+    snapshot.count = m_count.exchange(0, std::memory_order_relaxed);
+    snapshot.totalNs = m_totalNs.exchange(0, std::memory_order_relaxed);
+    snapshot.minNs = m_minNs.exchange(UINT64_MAX, std::memory_order_relaxed);
+    snapshot.maxNs = m_maxNs.exchange(0, std::memory_order_relaxed);
+    if (snapshot.count == 0) {
+        snapshot.minNs = 0;
+    }
+    return snapshot;
+}
+
+} // namespace RenderingSandbox
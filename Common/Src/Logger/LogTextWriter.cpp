@@ -0,0 +1,120 @@
+#include "Logger/LogTextWriter.h"
+#include <cstring>
+#include <ctime>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    // 00〜99の2桁文字列表（2桁ずつ変換して除算回数を半分にする）
+    constexpr char kDigitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    // スレッドごとの HH:MM:SS キャッシュ
+    struct TimeCache {
+        int64_t second = INT64_MIN;         // キャッシュしているエポック秒
+        char text[8] = {};                  // "HH:MM:SS"
+    };
+
+} // namespace
+
+char* LogWriteUInt(char* out, uint64_t value) {
+    char buffer[20];
+    char* p = buffer + sizeof(buffer);
+
+    while (value >= 100) {
+        const size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--p = kDigitPairs[pair + 1];
+        *--p = kDigitPairs[pair];
+    }
+    if (value >= 10) {
+        const size_t pair = static_cast<size_t>(value) * 2;
+        *--p = kDigitPairs[pair + 1];
+        *--p = kDigitPairs[pair];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+
+    const size_t length = static_cast<size_t>(buffer + sizeof(buffer) - p);
+    std::memcpy(out, p, length);
+    return out + length;
+}
+
+char* LogWriteUIntPadded(char* out, uint32_t value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+char* LogWriteTime(char* out, std::chrono::system_clock::time_point timestamp) {
+    thread_local TimeCache cache;
+
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch());
+    int64_t milliseconds = sinceEpoch.count();
+    int64_t second = milliseconds / 1000;
+    int64_t millisecond = milliseconds % 1000;
+    if (millisecond < 0) {
+        millisecond += 1000;
+        second -= 1;
+    }
+
+    // 秒が変わった時だけローカル時刻に分解する
+    if (second != cache.second) {
+        std::time_t timeT = static_cast<std::time_t>(second);
+        std::tm tmBuf{};
+#ifdef _WIN32
+        localtime_s(&tmBuf, &timeT);
+#else
+        localtime_r(&timeT, &tmBuf);
+#endif
+        char* p = cache.text;
+        p = LogWriteUIntPadded(p, static_cast<uint32_t>(tmBuf.tm_hour), 2);
+        *p++ = ':';
+        p = LogWriteUIntPadded(p, static_cast<uint32_t>(tmBuf.tm_min), 2);
+        *p++ = ':';
+        LogWriteUIntPadded(p, static_cast<uint32_t>(tmBuf.tm_sec), 2);
+        cache.second = second;
+    }
+
+    std::memcpy(out, cache.text, sizeof(cache.text));
+    out[8] = '.';
+    return LogWriteUIntPadded(out + 9, static_cast<uint32_t>(millisecond), 3);
+}
+
+void LogAppendJsonString(std::string& out, std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : text) {
+        switch (c) {
+            case '"':  out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out.append("\\u00");
+                    out.push_back(kHex[(c >> 4) & 0x0F]);
+                    out.push_back(kHex[c & 0x0F]);
+                } else {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+} // namespace RenderingSandbox
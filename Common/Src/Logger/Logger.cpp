@@ -1,137 +1,762 @@
 #include "Logger/Logger.h"
+#include "Logger/LogQueue.h"
+#include "Logger/LogScopeTimer.h"
+#include <algorithm>
 #include <chrono>
+#include <format>
+#include <queue>
 #include <thread>
 
 namespace RenderingSandbox {
 
+/// <summary>
+/// スレッドごとのログバッファ
+/// 書き込みは所有スレッドのみ、回収はCollectThreadBuffersのみが行うため、mutexは通常競合しない
+/// </summary>
+struct ThreadLogBuffer {
+    std::mutex mutex;                       // 所有スレッドと回収処理の排他
+    std::vector<LogMessage> records;        // 所有スレッドが積むレコード（出力順）
+    std::vector<LogMessage> collected;      // 回収処理が入れ替えて配信するレコード（容量を使い回す）
+    size_t head = 0;                        // recordsの先頭（DropOldestで破棄した分）
+    size_t bytes = 0;                       // recordsが使用しているバイト数（概算）
+    std::atomic<bool> writing{ false };     // records・headを変更中か（VisitPendingRecordsは読み飛ばす）
+};
+
+/// <summary>
+/// 配信中のスレッドが参照しているSinkリストを公開するスロット（スレッドごとに1つ割り当てる）
+/// Sinkリストを差し替えたスレッドは、古いリストを指すスロットがなくなるまで待ってから解放する
+/// </summary>
+struct LogSinkReaderSlot {
+    std::atomic<const void*> list{ nullptr };   // 参照中のSinkリスト（配信していない間はnullptr）
+    std::atomic<bool> owned{ false };           // いずれかのスレッドに割り当て済みか
+};
+
+namespace {
+
+    // Sinkリストを参照するスロットの数（割り当てられなかったスレッドはm_sinkMutexを取って配信する）
+    constexpr size_t kSinkReaderSlots = 256;
+
+    // 呼び出しスレッドのスロットと配信の入れ子の状態
+    struct SinkReader {
+        LogSinkReaderSlot* slot = nullptr;      // 割り当てられたスロット
+        const void* list = nullptr;             // 外側の配信が取得したSinkリスト
+        uint32_t depth = 0;                     // 配信（Dispatch/Flush）の入れ子の深さ
+        bool locked = false;                    // スロットの代わりにm_sinkMutexを取得しているか
+
+        ~SinkReader() {
+            if (slot) {
+                slot->owned.store(false, std::memory_order_release);
+                slot = nullptr;
+            }
+        }
+    };
+    thread_local SinkReader t_sinkReader;
+
+    // シグナルハンドラ（VisitPendingRecords）に構造を変更中であることを知らせるスコープ
+    // ハンドラはミューテックスを使えないため、フラグが立っている間はその構造を読まない
+    class ScopedWriteFlag {
+    public:
+        explicit ScopedWriteFlag(std::atomic<bool>& flag) : m_flag(flag) {
+            m_flag.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~ScopedWriteFlag() { m_flag.store(false, std::memory_order_release); }
+
+        ScopedWriteFlag(const ScopedWriteFlag&) = delete;
+        ScopedWriteFlag& operator=(const ScopedWriteFlag&) = delete;
+
+    private:
+        std::atomic<bool>& m_flag;
+    };
+
+    // 呼び出しスレッドのバッファ（スレッド終了後もLoggerが回収するまで保持される）
+    thread_local std::shared_ptr<ThreadLogBuffer> t_threadBuffer;
+
+    // 呼び出しスレッドがCollectThreadBuffersで配信中か（Sinkからの再入を検出する）
+    thread_local bool t_collectingThreadBuffers = false;
+
+    // バッファ上限の計算に使う1レコードあたりのバイト数（インラインに収まらずヒープに確保した分を含む）
+    size_t GetRecordBytes(const LogMessage& message) {
+        const size_t payloadSpill = message.payload.GetSize() > LogBuffer::kInlineCapacity ? message.payload.GetSize() : 0;
+        const size_t fieldsSpill = message.fields.GetSize() > LogFieldBuffer::kInlineCapacity ? message.fields.GetSize() : 0;
+        return sizeof(LogMessage) + payloadSpill + fieldsSpill;
+    }
+
+} // namespace
+
 Logger& Logger::GetInstance() {
     // C++11以降、staticローカル変数の初期化はスレッドセーフ
     static Logger instance;
     return instance;
 }
 
+/// <summary>
+/// 配信の間Sinkリストを参照中として公開するスコープ
+/// </summary>
+class Logger::SinkReadScope {
+public:
+    explicit SinkReadScope(Logger& logger) : m_logger(logger), m_sinks(logger.AcquireSinks()) {}
+    ~SinkReadScope() { m_logger.ReleaseSinks(); }
+
+    SinkReadScope(const SinkReadScope&) = delete;
+    SinkReadScope& operator=(const SinkReadScope&) = delete;
+
+    const SinkList& GetSinks() const { return *m_sinks; }
+
+private:
+    Logger& m_logger;                           // 取得元のLogger
+    const SinkList* m_sinks;                    // 取得したSinkリスト
+};
+
 Logger::Logger()
-    : m_globalMinLevel(LogLevel::Trace)
+    : m_sinks(new SinkList())
+    , m_sinkReaders(std::make_unique<LogSinkReaderSlot[]>(kSinkReaderSlots))
+    , m_nextSinkHandle(1)
+    , m_threadStartHook(nullptr)
+    , m_overflowPolicy(LogOverflowPolicy::Block)
+    , m_asyncEnabled(false)
+    , m_drainStop(false)
+    , m_drainWaiting(false)
+    , m_asyncStopping(false)
+    , m_asyncProducers(0)
+    , m_enqueuedCount(0)
+    , m_consumedCount(0)
+    , m_droppedCount(0)
+    , m_threadBuffered(false)
+    , m_threadBuffersWriting(false)
+    , m_threadBufferBudget(0)
+    , m_threadBufferPolicy(LogOverflowPolicy::Block)
 {
 }
 
 Logger::~Logger() {
+    DisableThreadBuffers();
+    DisableAsync();
     Flush();
+    delete m_sinks.exchange(nullptr, std::memory_order_acq_rel);
 }
 
-void Logger::AddSink(std::unique_ptr<ILogSink> sink) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (sink) {
-        m_sinks.push_back(std::move(sink));
+LogSinkHandle Logger::AddSink(std::shared_ptr<ILogSink> sink) {
+    // Sinkの中から差し替えると、自身の配信が古いリストを参照したまま終わりを待つことになる
+    if (!sink || t_sinkReader.depth > 0) {
+        return 0;
     }
+
+    // 現在のリストをコピーして追加し、差し替える（配信中のスレッドは古いリストを使い続ける）
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    auto sinks = std::make_unique<SinkList>(*m_sinks.load(std::memory_order_acquire));
+    const LogSinkHandle handle = m_nextSinkHandle++;
+    sinks->push_back({ handle, std::move(sink) });
+    PublishSinks(std::move(sinks));
+    return handle;
+}
+
+std::shared_ptr<ILogSink> Logger::RemoveSink(LogSinkHandle handle) {
+    if (t_sinkReader.depth > 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    auto sinks = std::make_unique<SinkList>(*m_sinks.load(std::memory_order_acquire));
+    auto it = std::find_if(sinks->begin(), sinks->end(), [&](const SinkEntry& entry) { return entry.handle == handle; });
+    if (it == sinks->end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ILogSink> removed = std::move(it->sink);
+    sinks->erase(it);
+    PublishSinks(std::move(sinks));
+    return removed;
 }
 
 void Logger::ClearSinks() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_sinks.clear();
+    if (t_sinkReader.depth > 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    PublishSinks(std::make_unique<const SinkList>());
+}
+
+void Logger::PublishSinks(std::unique_ptr<const SinkList> sinks) {
+    // 古いリストを公開しているスロットがなくなるまで待ってから解放する
+    // これにより、戻った後は取り除いたSinkのWriteが呼ばれないことを保証する
+    // （差し替え後に配信を始めたスレッドは、AcquireSinksの再確認で必ず新しいリストを取得する）
+    std::unique_ptr<const SinkList> previous(m_sinks.exchange(sinks.release(), std::memory_order_seq_cst));
+    for (size_t i = 0; i < kSinkReaderSlots; ++i) {
+        while (m_sinkReaders[i].list.load(std::memory_order_seq_cst) == previous.get()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+const Logger::SinkList* Logger::AcquireSinks() {
+    SinkReader& reader = t_sinkReader;
+    if (reader.depth++ > 0) {
+        return static_cast<const SinkList*>(reader.list);
+    }
+
+    if (!reader.slot) {
+        for (size_t i = 0; i < kSinkReaderSlots; ++i) {
+            bool expected = false;
+            if (!m_sinkReaders[i].owned.load(std::memory_order_relaxed)
+                && m_sinkReaders[i].owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                reader.slot = &m_sinkReaders[i];
+                break;
+            }
+        }
+    }
+
+    // スロットが足りない場合は差し替えと排他して読む
+    if (!reader.slot) {
+        m_sinkMutex.lock();
+        reader.locked = true;
+        reader.list = m_sinks.load(std::memory_order_acquire);
+        return static_cast<const SinkList*>(reader.list);
+    }
+
+    // 公開してから読み直し、差し替えと行き違っていないことを確認する
+    const SinkList* sinks = m_sinks.load(std::memory_order_acquire);
+    for (;;) {
+        reader.slot->list.store(sinks, std::memory_order_seq_cst);
+        const SinkList* current = m_sinks.load(std::memory_order_seq_cst);
+        if (current == sinks) {
+            break;
+        }
+        sinks = current;
+    }
+    reader.list = sinks;
+    return sinks;
+}
+
+void Logger::ReleaseSinks() {
+    SinkReader& reader = t_sinkReader;
+    if (--reader.depth > 0) {
+        return;
+    }
+
+    reader.list = nullptr;
+    if (reader.locked) {
+        reader.locked = false;
+        m_sinkMutex.unlock();
+    } else {
+        reader.slot->list.store(nullptr, std::memory_order_release);
+    }
 }
 
 void Logger::Log(LogLevel level,
-                 const std::string& category,
-                 const std::string& message,
+                 LogCategoryName category,
+                 std::string_view message,
                  const char* file,
                  int line)
 {
-    // カテゴリ固有のレベルチェック（設定されている場合）
-    LogLevel minLevel = m_globalMinLevel;
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_categoryLevels.find(category);
-        if (it != m_categoryLevels.end()) {
-            minLevel = it->second;
-        }
+    // カテゴリハンドルを解決してレベルチェック（登録済みカテゴリの解決は共有ロックのみ、
+    // 高頻度の呼び出しはLOG_*マクロのようにRegisterCategoryで得たハンドル版を使う）
+    LogCategoryId categoryId = m_categories.Register(category);
+    if (!IsEnabled(categoryId, level)) {
+        return;
     }
 
-    // レベルチェックで早期リターン
-    if (level < minLevel) {
+    Log(level, categoryId, message, file, line);
+}
+
+void Logger::Log(LogLevel level,
+                 LogCategoryId category,
+                 std::string_view message,
+                 const char* file,
+                 int line)
+{
+    LogMessage logMessage = MakeMessage(level, category, file, line);
+    logMessage.SetText(message);
+    Submit(std::move(logMessage));
+}
+
+void Logger::LogFields(LogLevel level,
+                       LogCategoryId category,
+                       std::string_view message,
+                       std::initializer_list<LogField> fields,
+                       const char* file,
+                       int line)
+{
+    LogMessage logMessage = MakeMessage(level, category, file, line);
+    logMessage.SetText(message);
+    EncodeLogFields(logMessage.fields, fields.begin(), fields.size());
+    Submit(std::move(logMessage));
+}
+
+LogMessage Logger::MakeMessage(LogLevel level, LogCategoryId category, const char* file, int line) const {
+    LogMessage logMessage;
+    logMessage.level = level;
+    logMessage.category = m_categories.GetName(category);
+    logMessage.categoryId = category;
+    logMessage.file = file ? file : "";
+    logMessage.line = line;
+    logMessage.timestamp = std::chrono::system_clock::now();
+    logMessage.threadId = std::this_thread::get_id();
+    return logMessage;
+}
+
+void Logger::Submit(LogMessage&& message) {
+    // スレッドごとのバッファリングモードでは自スレッドのバッファに積むだけで戻る
+    if (m_threadBuffered.load(std::memory_order_acquire) && AppendToThreadBuffer(message)) {
         return;
     }
 
-    // LogMessageの構築
-    LogMessage logMessage{
-        level,
-        message,
-        category,
-        file ? file : "",
-        line,
-        std::chrono::system_clock::now(),
-        std::this_thread::get_id()
-    };
+    Deliver(std::move(message));
+}
 
-    // すべてのSinkにメッセージを配信
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& sink : m_sinks) {
-        if (sink) {
-            sink->Write(logMessage);
+void Logger::Deliver(LogMessage&& message) {
+    // 非同期モードではキューに積むだけで戻る（Sinkへの配信はドレインスレッドが行う）
+    // DisableAsyncが積み終わるのを待てるよう、積んでいる間は生産者数に数える
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        m_asyncProducers.fetch_add(1, std::memory_order_seq_cst);
+        if (m_asyncEnabled.load(std::memory_order_seq_cst)) {
+            Enqueue(std::move(message));
+            m_asyncProducers.fetch_sub(1, std::memory_order_release);
+            return;
         }
+        m_asyncProducers.fetch_sub(1, std::memory_order_release);
+    }
+
+    // 無効化の途中では、キューに残った自スレッドのレコードより先に配信しないよう無効化の完了を待つ
+    // （配信中のSinkからのログはドレインスレッド自身の場合があるため待たない）
+    while (m_asyncStopping.load(std::memory_order_acquire) && t_sinkReader.depth == 0) {
+        std::this_thread::yield();
+    }
+
+    Dispatch(message);
+}
+
+void Logger::Dispatch(const LogMessage& message) {
+    // すべてのSinkにメッセージを配信
+    // Sinkリストは不変のスナップショットなのでロックせずに走査する（各Sinkは自身で排他する）
+    // 同じパターンを使うSink同士は、この配信の間だけ整形結果を共有する
+    // 遅延フォーマットの本文は配信前に一度だけ生成しておき、Sinkの呼び出し中はレコードを書き換えない
+    const SinkReadScope scope(*this);
+    if (message.formatter && !scope.GetSinks().empty()) {
+        message.GetText();
+    }
+    LogFormatCache formatCache(message);
+    for (const SinkEntry& entry : scope.GetSinks()) {
+        entry.sink->Write(message);
     }
 }
 
-void Logger::Trace(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Trace(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Trace, category, message, file, line);
 }
 
-void Logger::Debug(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Debug(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Debug, category, message, file, line);
 }
 
-void Logger::Info(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Info(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Info, category, message, file, line);
 }
 
-void Logger::Warning(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Warning(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Warning, category, message, file, line);
 }
 
-void Logger::Error(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Error(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Error, category, message, file, line);
 }
 
-void Logger::Fatal(const std::string& category, const std::string& message, const char* file, int line) {
+void Logger::Fatal(LogCategoryName category, std::string_view message, const char* file, int line) {
     Log(LogLevel::Fatal, category, message, file, line);
 }
 
 void Logger::SetGlobalMinLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_globalMinLevel = level;
+    m_categories.SetGlobalLevel(level);
 }
 
 LogLevel Logger::GetGlobalMinLevel() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_globalMinLevel;
+    return m_categories.GetGlobalLevel();
 }
 
 void Logger::Flush() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& sink : m_sinks) {
-        if (sink) {
-            sink->Flush();
+    // スコープ時間の集計の要約も、以降の処理で他のレコードと一緒に配信・フラッシュされる
+    WriteScopeStatsSummary();
+
+    // スレッドごとのバッファに残ったレコードを先に配信
+    if (m_threadBuffered.load(std::memory_order_acquire)) {
+        CollectThreadBuffers();
+    }
+
+    // 非同期モードでは、この時点までに積まれたレコードがすべて取り出されるのを待つ
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        uint64_t target = m_enqueuedCount.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> drainLock(m_drainMutex);
+        m_drainCondition.notify_one();
+        m_flushCondition.wait(drainLock, [&] {
+            return m_consumedCount.load(std::memory_order_acquire) >= target
+                || !m_asyncEnabled.load(std::memory_order_acquire);
+        });
+    }
+
+    const SinkReadScope scope(*this);
+    for (const SinkEntry& entry : scope.GetSinks()) {
+        entry.sink->Flush();
+    }
+}
+
+void Logger::RegisterScopeStats(LogScopeStats* stats) {
+    std::lock_guard<std::mutex> lock(m_scopeStatsMutex);
+    m_scopeStats.push_back(stats);
+}
+
+void Logger::UnregisterScopeStats(LogScopeStats* stats) {
+    std::lock_guard<std::mutex> lock(m_scopeStatsMutex);
+    std::erase(m_scopeStats, stats);
+}
+
+void Logger::WriteScopeStatsSummary() {
+    struct Row {
+        const LogScopeStats* stats;
+        LogScopeStats::Snapshot snapshot;
+        std::string total, mean, min, max;
+    };
+    std::vector<Row> rows;
+    {
+        std::lock_guard<std::mutex> lock(m_scopeStatsMutex);
+        for (LogScopeStats* stats : m_scopeStats) {
+            LogScopeStats::Snapshot snapshot = stats->TakeSnapshot();
+            if (snapshot.count > 0) {
+                rows.push_back({ stats, snapshot, {}, {}, {}, {} });
+            }
         }
     }
+    if (rows.empty()) {
+        return;
+    }
+
+    // 合計時間の長い順に並べ、列幅は内容に合わせる
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.snapshot.totalNs > b.snapshot.totalNs; });
+    size_t categoryWidth = 8;
+    size_t nameWidth = 5;
+    for (Row& row : rows) {
+        AppendLogDuration(row.total, static_cast<int64_t>(row.snapshot.totalNs));
+        AppendLogDuration(row.mean, static_cast<int64_t>(row.snapshot.totalNs / row.snapshot.count));
+        AppendLogDuration(row.min, static_cast<int64_t>(row.snapshot.minNs));
+        AppendLogDuration(row.max, static_cast<int64_t>(row.snapshot.maxNs));
+        categoryWidth = std::max(categoryWidth, row.stats->GetCategory().size());
+        nameWidth = std::max(nameWidth, row.stats->GetName().size());
+    }
+
+    std::string table = std::format("Scope timer summary ({} scopes)\n  {:<{}}  {:<{}}  {:>10}  {:>12}  {:>12}  {:>12}  {:>12}",
+        rows.size(), "Category", categoryWidth, "Scope", nameWidth, "Count", "Total", "Mean", "Min", "Max");
+    for (const Row& row : rows) {
+        std::format_to(std::back_inserter(table), "\n  {:<{}}  {:<{}}  {:>10}  {:>12}  {:>12}  {:>12}  {:>12}  ({}:{})",
+            row.stats->GetCategory(), categoryWidth, row.stats->GetName(), nameWidth, row.snapshot.count,
+            row.total, row.mean, row.min, row.max, row.stats->GetFile(), row.stats->GetLine());
+    }
+    Log(LogLevel::Info, "ScopeTimer", table);
+}
+
+void Logger::SetCategoryLevel(std::string_view category, LogLevel level) {
+    m_categories.SetLevel(m_categories.Register(category), level);
+}
+
+void Logger::ClearCategoryLevel(std::string_view category) {
+    m_categories.ClearLevel(m_categories.Register(category));
+}
+
+LogLevel Logger::GetCategoryLevel(std::string_view category) const {
+    return m_categories.FindMinLevel(category);
 }
 
-void Logger::SetCategoryLevel(const std::string& category, LogLevel level) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_categoryLevels[category] = level;
+void Logger::EnableAsync(size_t capacity, LogOverflowPolicy policy) {
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    m_queue = std::make_unique<LogQueue>(capacity);
+    m_overflowPolicy = policy;
+    m_drainStop.store(false, std::memory_order_relaxed);
+    m_drainThread = std::thread(&Logger::DrainLoop, this);
+    m_asyncEnabled.store(true, std::memory_order_release);
 }
 
-void Logger::ClearCategoryLevel(const std::string& category) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_categoryLevels.erase(category);
+void Logger::DisableAsync() {
+    // 無効化中の印を先に立ててから切り替える（切り替えを見た生産者が待機できるように）
+    if (!m_asyncEnabled.load(std::memory_order_acquire)
+        || m_asyncStopping.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (!m_asyncEnabled.exchange(false, std::memory_order_seq_cst)) {
+        m_asyncStopping.store(false, std::memory_order_release);
+        return;
+    }
+
+    // 切り替え前に非同期モードを確認した生産者が積み終わるまで待つ
+    // （Blockポリシーの生産者が進めるよう、この間もドレインスレッドは動かしておく）
+    while (m_asyncProducers.load(std::memory_order_seq_cst) != 0) {
+        WakeDrainThread();
+        std::this_thread::yield();
+    }
+
+    // ドレインスレッドを停止（停止前にキューは空になる）
+    {
+        std::lock_guard<std::mutex> drainLock(m_drainMutex);
+        m_drainStop.store(true, std::memory_order_release);
+    }
+    m_drainCondition.notify_one();
+    if (m_drainThread.joinable()) {
+        m_drainThread.join();
+    }
+
+    // 切り替え直前に積まれたレコードを同期的に配信
+    LogMessage message;
+    while (m_queue->TryPop(message)) {
+        m_consumedCount.fetch_add(1, std::memory_order_release);
+        Dispatch(message);
+    }
+    m_asyncStopping.store(false, std::memory_order_release);
+    m_flushCondition.notify_all();
+}
+
+void Logger::EnableThreadBuffers(size_t budgetBytes, LogOverflowPolicy policy) {
+    std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+    m_threadBufferBudget = std::max(budgetBytes, sizeof(LogMessage));
+    m_threadBufferPolicy = policy;
+    m_threadBuffered.store(true, std::memory_order_release);
+}
+
+void Logger::DisableThreadBuffers() {
+    if (!m_threadBuffered.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // 切り替え前に積まれたレコードを配信
+    CollectThreadBuffers();
+}
+
+bool Logger::AppendToThreadBuffer(LogMessage& message) {
+    if (!t_threadBuffer) {
+        t_threadBuffer = std::make_shared<ThreadLogBuffer>();
+        std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+        ScopedWriteFlag writing(m_threadBuffersWriting);
+        m_threadBuffers.push_back(t_threadBuffer);
+    }
+
+    ThreadLogBuffer& buffer = *t_threadBuffer;
+    const size_t recordBytes = GetRecordBytes(message);
+
+    for (;;) {
+        std::unique_lock<std::mutex> lock(buffer.mutex);
+        if (!m_threadBuffered.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        // 配信中のSinkが出したログは回収を待てないため、上限を超えても積む
+        if (buffer.bytes + recordBytes <= m_threadBufferBudget || buffer.head == buffer.records.size()
+            || t_collectingThreadBuffers) {
+            ScopedWriteFlag writing(buffer.writing);
+            buffer.records.push_back(std::move(message));
+            buffer.bytes += recordBytes;
+            return true;
+        }
+
+        switch (m_threadBufferPolicy) {
+            case LogOverflowPolicy::DropNewest:
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+
+            case LogOverflowPolicy::DropOldest: {
+                // 空きができるまで先頭から破棄（要素の移動は回収時まで行わない）
+                ScopedWriteFlag writing(buffer.writing);
+                while (buffer.head < buffer.records.size() && buffer.bytes + recordBytes > m_threadBufferBudget) {
+                    buffer.bytes -= GetRecordBytes(buffer.records[buffer.head]);
+                    buffer.records[buffer.head] = LogMessage();
+                    ++buffer.head;
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+
+            case LogOverflowPolicy::Block:
+            default:
+                // このスレッドが全スレッド分をマージして配信してから積み直す
+                lock.unlock();
+                CollectThreadBuffers();
+                break;
+        }
+    }
 }
 
-LogLevel Logger::GetCategoryLevel(const std::string& category) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_categoryLevels.find(category);
-    if (it != m_categoryLevels.end()) {
-        return it->second;
+void Logger::CollectThreadBuffers() {
+    // 配信中のSinkからの再入（配信用のロックを自分で持っている）
+    if (t_collectingThreadBuffers) {
+        return;
+    }
+
+    // 回収から配信までを直列化し、先に回収したレコードを先に配信する
+    std::lock_guard<std::mutex> deliverLock(m_threadBufferDeliverMutex);
+    {
+        std::lock_guard<std::mutex> collectLock(m_threadBufferMutex);
+
+        // 各スレッドのバッファを入れ替えて回収（所有スレッドのロック時間は入れ替えの間だけ）
+        struct Cursor {
+            std::vector<LogMessage>* records;
+            size_t index;
+            size_t order;           // 同時刻の場合の決定的な順序
+        };
+        std::vector<Cursor> cursors;
+        cursors.reserve(m_threadBuffers.size());
+
+        for (size_t i = 0; i < m_threadBuffers.size(); ++i) {
+            ThreadLogBuffer& buffer = *m_threadBuffers[i];
+            size_t head = 0;
+            {
+                std::lock_guard<std::mutex> lock(buffer.mutex);
+                ScopedWriteFlag writing(buffer.writing);
+                buffer.collected.swap(buffer.records);
+                head = buffer.head;
+                buffer.head = 0;
+                buffer.bytes = 0;
+            }
+            if (head < buffer.collected.size()) {
+                cursors.push_back({ &buffer.collected, head, i });
+            }
+        }
+
+        // スレッドごとの列はそれぞれ出力順に並んでいるので、先頭同士を比べるk-wayマージで全体を時刻順にする
+        auto later = [&](size_t a, size_t b) {
+            const LogMessage& left = (*cursors[a].records)[cursors[a].index];
+            const LogMessage& right = (*cursors[b].records)[cursors[b].index];
+            if (left.timestamp != right.timestamp) {
+                return left.timestamp > right.timestamp;
+            }
+            return cursors[a].order > cursors[b].order;
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heads(later);
+        for (size_t i = 0; i < cursors.size(); ++i) {
+            heads.push(i);
+        }
+
+        while (!heads.empty()) {
+            const size_t current = heads.top();
+            heads.pop();
+
+            Cursor& cursor = cursors[current];
+            m_collectedRecords.push_back(std::move((*cursor.records)[cursor.index]));
+            if (++cursor.index < cursor.records->size()) {
+                heads.push(current);
+            }
+        }
+
+        // 回収用の配列は容量を残して空にし、終了済みスレッドの空のバッファは登録を解除する
+        for (auto& buffer : m_threadBuffers) {
+            buffer->collected.clear();
+        }
+        ScopedWriteFlag writing(m_threadBuffersWriting);
+        std::erase_if(m_threadBuffers, [](const std::shared_ptr<ThreadLogBuffer>& buffer) {
+            if (buffer.use_count() > 1) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            return buffer->records.empty();
+        });
+    }
+
+    // 回収用のロックを解放してから配信する（Sinkが配信中にログを出してもスレッドバッファに積めるように）
+    t_collectingThreadBuffers = true;
+    for (LogMessage& message : m_collectedRecords) {
+        Deliver(std::move(message));
+    }
+    t_collectingThreadBuffers = false;
+    m_collectedRecords.clear();
+}
+
+void Logger::VisitPendingRecords(void (*visitor)(const LogMessage&, void*), void* context) noexcept {
+    // 非同期キューのレコードは、スレッドごとのバッファに残っているレコードより先に積まれている
+    if (LogQueue* queue = m_queue.get()) {
+        queue->ForEachPending([&](const LogMessage& message) { visitor(message, context); });
+    }
+
+    // シグナルハンドラではミューテックスを使えない（クラッシュしたスレッドが保持している場合もある）ため、
+    // 変更中のフラグが立っていない構造だけを読む（確認した後に他のスレッドが変更を始めた場合は保証しない）
+    if (m_threadBuffersWriting.load(std::memory_order_acquire)) {
+        return;
+    }
+    for (const auto& buffer : m_threadBuffers) {
+        if (buffer->writing.load(std::memory_order_acquire)) {
+            continue;
+        }
+        for (size_t i = buffer->head; i < buffer->records.size(); ++i) {
+            visitor(buffer->records[i], context);
+        }
+    }
+}
+
+void Logger::Enqueue(LogMessage&& message) {
+    // ホットパスはTryPushの1回だけ。満杯の場合のみポリシーに従う
+    while (!m_queue->TryPush(std::move(message))) {
+        switch (m_overflowPolicy) {
+            case LogOverflowPolicy::DropNewest:
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+
+            case LogOverflowPolicy::DropOldest: {
+                LogMessage oldest;
+                if (m_queue->TryPop(oldest)) {
+                    m_consumedCount.fetch_add(1, std::memory_order_release);
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+
+            case LogOverflowPolicy::Block:
+            default:
+                WakeDrainThread();
+                std::this_thread::yield();
+                break;
+        }
+    }
+
+    m_enqueuedCount.fetch_add(1, std::memory_order_release);
+    WakeDrainThread();
+}
+
+void Logger::WakeDrainThread() {
+    // Push（またはカウンタ更新）とm_drainWaitingの読み出しの順序を保証する
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_drainWaiting.load(std::memory_order_relaxed)) {
+        m_drainCondition.notify_one();
+    }
+}
+
+void Logger::DrainLoop() {
+    // ドレインスレッドでのスタックオーバーフローもクラッシュレポートに残す（クラッシュハンドラの登録中のみ）
+    OnThreadStart();
+
+    // 取りこぼした通知があっても、この間隔で必ずキューを確認する
+    constexpr auto kIdleTimeout = std::chrono::milliseconds(10);
+
+    LogMessage message;
+    for (;;) {
+        bool drained = false;
+        while (m_queue->TryPop(message)) {
+            Dispatch(message);
+            m_consumedCount.fetch_add(1, std::memory_order_release);
+            drained = true;
+        }
+
+        std::unique_lock<std::mutex> drainLock(m_drainMutex);
+        if (drained) {
+            m_flushCondition.notify_all();
+        }
+        if (m_drainStop.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        m_drainWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue->IsEmpty()) {
+            m_drainCondition.wait_for(drainLock, kIdleTimeout);
+        }
+        m_drainWaiting.store(false, std::memory_order_relaxed);
     }
-    return m_globalMinLevel;
 }
 
 } // namespace RenderingSandbox
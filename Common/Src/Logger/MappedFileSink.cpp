@@ -0,0 +1,350 @@
+#include "Logger/MappedFileSink.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace RenderingSandbox {
+
+namespace {
+
+    constexpr char kMagic[8] = { 'R', 'S', 'L', 'O', 'G', 'M', 'A', 'P' };
+    constexpr uint32_t kVersion = 1;
+
+    // レコードの整列単位
+    constexpr size_t kRecordAlignment = 8;
+
+    // データ領域の最小サイズ
+    constexpr size_t kMinCapacity = 4096;
+
+    // ファイル先頭のヘッダ
+    struct RingHeader {
+        char magic[8];                  // "RSLOGMAP"
+        uint32_t version;               // フォーマットのバージョン
+        uint32_t headerSize;            // ヘッダのサイズ（データ領域の開始位置）
+        uint64_t capacity;              // データ領域のサイズ
+        uint64_t head;                  // 次に書き込む論理オフセット
+        uint64_t tail;                  // 最古のレコードの論理オフセット
+        uint64_t recordCount;           // これまでに書き込んだレコード数
+        uint8_t reserved[16];
+    };
+    static_assert(sizeof(RingHeader) == 64);
+
+    // レコードの固定長ヘッダ（size == 0 はラップマーカー：データ領域の先頭へ戻る）
+    struct RecordHeader {
+        uint32_t size;                  // レコード全体のサイズ（整列後）
+        uint32_t line;                  // 行番号
+        int64_t timestamp;              // エポックからのマイクロ秒
+        uint32_t textLength;            // 本文の長さ
+        uint16_t categoryLength;        // カテゴリの長さ
+        uint16_t fileLength;            // ファイル名の長さ
+        uint8_t level;                  // ログレベル
+        uint8_t reserved[7];
+    };
+    static_assert(sizeof(RecordHeader) == 32);
+
+    constexpr size_t AlignRecord(size_t size) {
+        return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+    }
+
+    // 論理オフセットがラップ位置（ラップマーカーまたはレコードヘッダが収まらない末尾の余白）かを判定
+    bool IsWrapPoint(const uint8_t* data, uint64_t capacity, uint64_t cursor) {
+        const uint64_t position = cursor % capacity;
+        if (capacity - position < sizeof(RecordHeader)) {
+            return true;
+        }
+        uint32_t size = 0;
+        std::memcpy(&size, data + position, sizeof(size));
+        return size == 0;
+    }
+
+    // 論理オフセットにあるレコードのサイズを取得（ラップ位置の場合は次の周回までの距離）
+    uint64_t RecordSpan(const uint8_t* data, uint64_t capacity, uint64_t cursor) {
+        const uint64_t position = cursor % capacity;
+        if (IsWrapPoint(data, capacity, cursor)) {
+            return capacity - position;
+        }
+        uint32_t size = 0;
+        std::memcpy(&size, data + position, sizeof(size));
+        return size;
+    }
+
+} // namespace
+
+MappedFileSink::MappedFileSink(const std::filesystem::path& filePath, size_t capacity, bool append)
+    : m_filePath(filePath)
+    , m_capacity(AlignRecord(std::max(capacity, kMinCapacity)))
+    , m_view(nullptr)
+    , m_data(nullptr)
+    , m_fileHandle(nullptr)
+    , m_mappingHandle(nullptr)
+    , m_fd(-1)
+{
+    // 親ディレクトリが存在しない場合は作成
+    if (filePath.has_parent_path()) {
+        std::filesystem::path parentPath = filePath.parent_path();
+        if (!parentPath.empty() && !std::filesystem::exists(parentPath)) {
+            std::filesystem::create_directories(parentPath);
+        }
+    }
+
+    const size_t fileSize = sizeof(RingHeader) + m_capacity;
+    std::error_code error;
+    const bool reuse = append && std::filesystem::file_size(filePath, error) == fileSize && !error;
+
+    if (!Map(fileSize)) {
+        std::cerr << "MappedFileSink: Failed to map log file: " << filePath << std::endl;
+        return;
+    }
+
+    // 既存のファイルが同じレイアウトで整合していればそのまま続きから書く
+    auto* header = reinterpret_cast<RingHeader*>(m_view);
+    const bool valid = reuse
+        && std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0
+        && header->version == kVersion
+        && header->headerSize == sizeof(RingHeader)
+        && header->capacity == m_capacity
+        && header->head >= header->tail
+        && header->head - header->tail <= m_capacity;
+
+    if (!valid) {
+        std::memset(header, 0, sizeof(RingHeader));
+        std::memcpy(header->magic, kMagic, sizeof(kMagic));
+        header->version = kVersion;
+        header->headerSize = sizeof(RingHeader);
+        header->capacity = m_capacity;
+    }
+}
+
+MappedFileSink::~MappedFileSink() {
+    Unmap();
+}
+
+bool MappedFileSink::Map(size_t fileSize) {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(m_filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+        nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    m_fileHandle = file;
+
+    // マッピング作成時にファイルは指定サイズまで拡張される
+    ULARGE_INTEGER size;
+    size.QuadPart = fileSize;
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+    if (mapping == nullptr) {
+        Unmap();
+        return false;
+    }
+    m_mappingHandle = mapping;
+
+    m_view = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, fileSize));
+#else
+    m_fd = ::open(m_filePath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        return false;
+    }
+    if (::ftruncate(m_fd, static_cast<off_t>(fileSize)) != 0) {
+        Unmap();
+        return false;
+    }
+
+    void* view = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    m_view = view == MAP_FAILED ? nullptr : static_cast<uint8_t*>(view);
+#endif
+
+    if (m_view == nullptr) {
+        Unmap();
+        return false;
+    }
+    m_data = m_view + sizeof(RingHeader);
+    return true;
+}
+
+void MappedFileSink::Unmap() {
+#ifdef _WIN32
+    if (m_view != nullptr) {
+        UnmapViewOfFile(m_view);
+    }
+    if (m_mappingHandle != nullptr) {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle != nullptr) {
+        CloseHandle(m_fileHandle);
+    }
+#else
+    if (m_view != nullptr) {
+        ::munmap(m_view, sizeof(RingHeader) + m_capacity);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+    m_view = nullptr;
+    m_data = nullptr;
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+    m_fd = -1;
+}
+
+void MappedFileSink::EvictOldest() {
+    auto* header = reinterpret_cast<RingHeader*>(m_view);
+    header->tail += RecordSpan(m_data, m_capacity, header->tail);
+}
+
+void MappedFileSink::Reserve(size_t size) {
+    auto* header = reinterpret_cast<RingHeader*>(m_view);
+    while (header->head + size - header->tail > m_capacity) {
+        EvictOldest();
+    }
+    // tailの更新を上書きより先にメモリへ反映させる（クラッシュ時に読み手が壊れたレコードを辿らないように）
+    std::atomic_signal_fence(std::memory_order_release);
+}
+
+void MappedFileSink::Write(const LogMessage& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!ShouldWrite(message) || m_view == nullptr) {
+        return;
+    }
+
+    const std::string_view category = message.category.substr(0, UINT16_MAX);
+    const std::string_view file = std::string_view(message.file).substr(0, UINT16_MAX);
+    std::string_view text = message.GetText();
+
+    // 1レコードはリングの1/4まで（超える分は本文を切り詰める）
+    const size_t maxRecordSize = m_capacity / 4;
+    const size_t fixedSize = sizeof(RecordHeader) + category.size() + file.size();
+    if (fixedSize >= maxRecordSize) {
+        return;
+    }
+    text = text.substr(0, maxRecordSize - fixedSize);
+    const size_t recordSize = AlignRecord(fixedSize + text.size());
+
+    auto* header = reinterpret_cast<RingHeader*>(m_view);
+
+    // レコードはデータ領域の末尾をまたがない（収まらなければラップマーカーを置いて先頭へ）
+    const size_t position = static_cast<size_t>(header->head % m_capacity);
+    if (position + recordSize > m_capacity) {
+        const size_t padding = m_capacity - position;
+        Reserve(padding);
+        const uint32_t marker = 0;
+        std::memcpy(m_data + position, &marker, sizeof(marker));
+        header->head += padding;
+    }
+    Reserve(recordSize);
+
+    RecordHeader record{};
+    record.size = static_cast<uint32_t>(recordSize);
+    record.line = static_cast<uint32_t>(message.line);
+    record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(message.timestamp.time_since_epoch()).count();
+    record.textLength = static_cast<uint32_t>(text.size());
+    record.categoryLength = static_cast<uint16_t>(category.size());
+    record.fileLength = static_cast<uint16_t>(file.size());
+    record.level = static_cast<uint8_t>(message.level);
+
+    uint8_t* out = m_data + header->head % m_capacity;
+    std::memcpy(out, &record, sizeof(record));
+    out += sizeof(record);
+    std::memcpy(out, category.data(), category.size());
+    out += category.size();
+    std::memcpy(out, file.data(), file.size());
+    out += file.size();
+    std::memcpy(out, text.data(), text.size());
+
+    // レコード本体を書き終えてからheadを進める
+    std::atomic_signal_fence(std::memory_order_release);
+    header->head += recordSize;
+    header->recordCount += 1;
+}
+
+void MappedFileSink::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_view == nullptr) {
+        return;
+    }
+
+    // プロセスのクラッシュではページキャッシュが残るため、書き出しの開始だけ要求して待たない
+#ifdef _WIN32
+    FlushViewOfFile(m_view, 0);
+#else
+    ::msync(m_view, sizeof(RingHeader) + m_capacity, MS_ASYNC);
+#endif
+}
+
+bool MappedFileSink::ReadFile(const std::filesystem::path& filePath, const std::function<void(const LogMessage&)>& callback) {
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    RingHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+        || header.version != kVersion
+        || header.headerSize != sizeof(RingHeader)
+        || header.capacity == 0
+        || bytes.size() < sizeof(RingHeader) + header.capacity
+        || header.head < header.tail
+        || header.head - header.tail > header.capacity) {
+        return false;
+    }
+
+    const uint8_t* data = bytes.data() + sizeof(RingHeader);
+    const uint64_t capacity = header.capacity;
+
+    LogMessage message;
+    std::string file;
+    uint64_t cursor = header.tail;
+    while (cursor < header.head) {
+        const uint64_t position = cursor % capacity;
+        if (IsWrapPoint(data, capacity, cursor)) {
+            cursor += capacity - position;
+            continue;
+        }
+
+        RecordHeader record{};
+        std::memcpy(&record, data + position, sizeof(record));
+        const uint64_t contentSize = uint64_t{ sizeof(record) } + record.categoryLength + record.fileLength + record.textLength;
+        if (record.size < sizeof(record) || position + record.size > capacity || contentSize > record.size
+            || cursor + record.size > header.head) {
+            // 書き込み途中で途切れたレコード
+            break;
+        }
+
+        const char* content = reinterpret_cast<const char*>(data + position + sizeof(record));
+        file.assign(content + record.categoryLength, record.fileLength);
+
+        message.level = static_cast<LogLevel>(record.level);
+        message.category = std::string_view(content, record.categoryLength);
+        message.file = file.c_str();
+        message.line = static_cast<int>(record.line);
+        message.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(record.timestamp)));
+        message.SetText(std::string_view(content + record.categoryLength + record.fileLength, record.textLength));
+        callback(message);
+
+        cursor += record.size;
+    }
+    return true;
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,150 @@
+#include "Logger/RingBufferSink.h"
+#include "Logger/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace RenderingSandbox {
+
+namespace {
+
+    // レコードのカテゴリハンドル（Loggerを通さずに作ったレコードはカテゴリ名からレジストリで解決する）
+    LogCategoryId ResolveCategory(const LogMessage& message) {
+        if (message.categoryId != LogCategoryRegistry::kDefaultCategory || message.category.empty()) {
+            return message.categoryId;
+        }
+        return Logger::GetInstance().RegisterCategory(message.category);
+    }
+
+} // namespace
+
+RingBufferSink::RingBufferSink(size_t capacity, size_t arenaBytes)
+    : m_capacity(std::max<size_t>(capacity, 1))
+    , m_arenaBytes(std::max<size_t>(arenaBytes, 256))
+    , m_levels(std::make_unique<LogLevel[]>(m_capacity))
+    , m_categoryIds(std::make_unique<LogCategoryId[]>(m_capacity))
+    , m_timestamps(std::make_unique<int64_t[]>(m_capacity))
+    , m_textOffsets(std::make_unique<uint64_t[]>(m_capacity))
+    , m_textLengths(std::make_unique<uint32_t[]>(m_capacity))
+    , m_arena(std::make_unique<char[]>(m_arenaBytes)) {
+}
+
+void RingBufferSink::Write(const LogMessage& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!ShouldWrite(message)) {
+        return;
+    }
+
+    // アリーナより長い本文は切り詰める
+    std::string_view text = message.GetText();
+    if (text.size() > m_arenaBytes / 2) {
+        text = text.substr(0, m_arenaBytes / 2);
+    }
+
+    // 本文はアリーナ上で連続させる（末尾で収まらない場合は先頭に折り返す）
+    uint64_t textOffset = m_arenaHead;
+    const size_t physical = static_cast<size_t>(textOffset % m_arenaBytes);
+    if (physical + text.size() > m_arenaBytes) {
+        textOffset += m_arenaBytes - physical;
+    }
+    const uint64_t textEnd = textOffset + text.size();
+
+    // レコード数の上限と、本文が重なる古いレコードを取り除く
+    if (m_head - m_tail >= m_capacity) {
+        ++m_tail;
+    }
+    EvictUntil(textEnd);
+
+    if (!text.empty()) {
+        std::copy(text.begin(), text.end(), m_arena.get() + textOffset % m_arenaBytes);
+    }
+    m_arenaHead = textEnd;
+
+    const size_t index = static_cast<size_t>(m_head % m_capacity);
+    m_levels[index] = message.level;
+    m_categoryIds[index] = ResolveCategory(message);
+    m_timestamps[index] = std::chrono::duration_cast<std::chrono::microseconds>(message.timestamp.time_since_epoch()).count();
+    m_textOffsets[index] = textOffset;
+    m_textLengths[index] = static_cast<uint32_t>(text.size());
+    ++m_head;
+}
+
+void RingBufferSink::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tail = m_head;
+}
+
+void RingBufferSink::EvictUntil(uint64_t textEnd) {
+    // 本文がアリーナ上で1周以上前の位置にあるレコードは上書きされる
+    while (m_tail < m_head && m_textOffsets[m_tail % m_capacity] + m_arenaBytes < textEnd) {
+        ++m_tail;
+    }
+}
+
+RingBufferSink::View::View(const RingBufferSink& sink)
+    : m_sink(sink)
+    , m_lock(sink.m_mutex) {
+}
+
+void RingBufferSink::View::Filter(const RingBufferFilter& filter, std::vector<uint64_t>& sequences, uint64_t& cursor) const {
+    const RingBufferSink& sink = m_sink;
+
+    // 上書きされたレコードを先頭から取り除く
+    auto firstValid = std::lower_bound(sequences.begin(), sequences.end(), sink.m_tail);
+    sequences.erase(sequences.begin(), firstValid);
+
+    const uint8_t minLevel = static_cast<uint8_t>(filter.minLevel);
+    const bool filterCategory = !filter.categories.empty();
+    const bool filterText = !filter.text.empty();
+    const char* arena = sink.m_arena.get();
+
+    // 判定の安いものから順に行い、本文の検索は残ったレコードだけにする
+    for (uint64_t sequence = std::max(cursor, sink.m_tail); sequence < sink.m_head; ++sequence) {
+        const size_t index = static_cast<size_t>(sequence % sink.m_capacity);
+        if (static_cast<uint8_t>(sink.m_levels[index]) < minLevel) {
+            continue;
+        }
+        if (filterCategory) {
+            const uint16_t categoryId = sink.m_categoryIds[index];
+            if (categoryId < filter.categories.size() && !filter.categories[categoryId]) {
+                continue;
+            }
+        }
+        if (filterText) {
+            const std::string_view text(arena + sink.m_textOffsets[index] % sink.m_arenaBytes, sink.m_textLengths[index]);
+            if (text.find(filter.text) == std::string_view::npos) {
+                continue;
+            }
+        }
+        sequences.push_back(sequence);
+    }
+    cursor = sink.m_head;
+}
+
+RingBufferRecord RingBufferSink::View::Get(uint64_t sequence) const {
+    const RingBufferSink& sink = m_sink;
+    if (sequence < sink.m_tail || sequence >= sink.m_head) {
+        return {};
+    }
+
+    const size_t index = static_cast<size_t>(sequence % sink.m_capacity);
+    RingBufferRecord record;
+    record.level = sink.m_levels[index];
+    record.categoryId = sink.m_categoryIds[index];
+    record.timestamp = sink.m_timestamps[index];
+    record.text = std::string_view(sink.m_arena.get() + sink.m_textOffsets[index] % sink.m_arenaBytes, sink.m_textLengths[index]);
+    return record;
+}
+
+size_t RingBufferSink::View::GetCategoryCount() const {
+    return Logger::GetInstance().GetCategoryCount();
+}
+
+std::string_view RingBufferSink::View::GetCategoryName(LogCategoryId categoryId) const {
+    if (categoryId >= LogCategoryRegistry::kInvalidCategory) {
+        return {};
+    }
+    return Logger::GetInstance().GetCategoryName(categoryId);
+}
+
+} // namespace RenderingSandbox
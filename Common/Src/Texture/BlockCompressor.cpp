@@ -0,0 +1,1190 @@
+#include "Texture/BlockCompressor.h"
+#include "Texture/BptcCodec.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define BLOCK_COMPRESSOR_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/ClangではAVX2を使う関数に命令セットの指定が必要（MSVCは/arch:AVX2なしでも組み込み関数を使える）
+#if defined(BLOCK_COMPRESSOR_X64) && (defined(__GNUC__) || defined(__clang__))
+#define BLOCK_COMPRESSOR_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define BLOCK_COMPRESSOR_AVX2_TARGET
+#endif
+
+namespace RenderingSandbox {
+
+namespace {
+
+// 1つの帯が担当する最小のブロック数（ミップ生成の分割と同程度の128x128ピクセル）
+constexpr uint32_t kMinBlocksPerBand = 32 * 32;
+
+// BC6H/BC7の帯の最小のブロック数（1ブロックあたりの時間がBC1〜BC5の数十倍あるため、小さな画像やミップでも分ける）
+constexpr uint32_t kMinBptcBlocksPerBand = 64;
+
+// 3色モードの4番目（透明な黒）は不透明なピクセルに選ばせないため、どの色からも十分遠い値にする
+constexpr float kUnusedPaletteValue = 1.0e6f;
+
+/// <summary>
+/// 1ブロック分の画素（成分ごとに並べ、SIMDで4/8ピクセルずつ読めるようにする）
+/// </summary>
+struct BlockPixels {
+    alignas(32) float r[16];
+    alignas(32) float g[16];
+    alignas(32) float b[16];
+    alignas(32) float a[16];
+};
+
+/// <summary>
+/// BC1形式のカラーブロック
+/// </summary>
+struct ColorBlock {
+    uint16_t color0 = 0;        // 端点0（RGB565）
+    uint16_t color1 = 0;        // 端点1（RGB565）
+    uint32_t indices = 0;       // 2bit×16のインデックス
+    float error = std::numeric_limits<float>::max();    // 二乗誤差の合計
+};
+
+/// <summary>
+/// BC4形式の単チャンネルブロック
+/// </summary>
+struct ScalarBlock {
+    uint8_t endpoint0 = 0;      // 端点0
+    uint8_t endpoint1 = 0;      // 端点1
+    uint64_t indices = 0;       // 3bit×16のインデックス
+    float error = std::numeric_limits<float>::max();    // 二乗誤差の合計
+};
+
+/// <summary>
+/// インデックス選択の実装（命令セットごとに切り替える）
+/// パレットの値はすべて整数のため、どの実装でも誤差は厳密に計算され、同じ結果になる
+/// </summary>
+struct IndexSelectors {
+    uint32_t (*selectColor)(const BlockPixels& block, const float (*palette)[3], float& error);
+    uint64_t (*selectScalar)(const float* values, const float* palette, float& error);
+};
+
+// ---- パレット（エンコーダとデコーダで共通） ----
+
+void UnpackColor565(uint16_t color, int rgb[3]) {
+    const int r = (color >> 11) & 31;
+    const int g = (color >> 5) & 63;
+    const int b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+uint16_t PackColor565(const float rgb[3]) {
+    const int r = std::clamp(static_cast<int>(rgb[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+    const int g = std::clamp(static_cast<int>(rgb[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+    const int b = std::clamp(static_cast<int>(rgb[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+/// <summary>
+/// カラーブロックのパレットを作成（fourColorがfalseの場合は3色＋透明な黒）
+/// </summary>
+void MakeColorPalette(uint16_t color0, uint16_t color1, bool fourColor, int palette[4][3]) {
+    UnpackColor565(color0, palette[0]);
+    UnpackColor565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        }
+        else {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+    }
+}
+
+/// <summary>
+/// 単チャンネルブロックのパレットを作成（endpoint0 > endpoint1の場合は8段階、それ以外は6段階＋0と255）
+/// </summary>
+void MakeScalarPalette(int endpoint0, int endpoint1, int palette[8]) {
+    palette[0] = endpoint0;
+    palette[1] = endpoint1;
+    if (endpoint0 > endpoint1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * endpoint0 + (i - 1) * endpoint1 + 3) / 7;
+        }
+    }
+    else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * endpoint0 + (i - 1) * endpoint1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// ---- インデックス選択 ----
+
+uint32_t SelectColorIndicesScalar(const BlockPixels& block, const float (*palette)[3], float& error) {
+    uint32_t indices = 0;
+    error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        uint32_t bestIndex = 0;
+        for (uint32_t k = 0; k < 4; ++k) {
+            const float dr = block.r[i] - palette[k][0];
+            const float dg = block.g[i] - palette[k][1];
+            const float db = block.b[i] - palette[k][2];
+            const float distance = dr * dr + dg * dg + db * db;
+            if (distance < best) {
+                best = distance;
+                bestIndex = k;
+            }
+        }
+        indices |= bestIndex << (i * 2);
+        error += best;
+    }
+    return indices;
+}
+
+uint64_t SelectScalarIndicesScalar(const float* values, const float* palette, float& error) {
+    uint64_t indices = 0;
+    error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        uint64_t bestIndex = 0;
+        for (uint64_t k = 0; k < 8; ++k) {
+            const float d = values[i] - palette[k];
+            if (d * d < best) {
+                best = d * d;
+                bestIndex = k;
+            }
+        }
+        indices |= bestIndex << (i * 3);
+        error += best;
+    }
+    return indices;
+}
+
+#ifdef BLOCK_COMPRESSOR_X64
+
+float HorizontalSum(__m128 value) {
+    const __m128 high = _mm_movehl_ps(value, value);
+    const __m128 sum2 = _mm_add_ps(value, high);
+    return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+}
+
+uint32_t SelectColorIndicesSse2(const BlockPixels& block, const float (*palette)[3], float& error) {
+    alignas(16) int32_t selected[16];
+    __m128 total = _mm_setzero_ps();
+    for (int i = 0; i < 16; i += 4) {
+        const __m128 r = _mm_load_ps(block.r + i);
+        const __m128 g = _mm_load_ps(block.g + i);
+        const __m128 b = _mm_load_ps(block.b + i);
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIndex = _mm_setzero_si128();
+        for (int k = 0; k < 4; ++k) {
+            const __m128 dr = _mm_sub_ps(r, _mm_set1_ps(palette[k][0]));
+            const __m128 dg = _mm_sub_ps(g, _mm_set1_ps(palette[k][1]));
+            const __m128 db = _mm_sub_ps(b, _mm_set1_ps(palette[k][2]));
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+            // 等しい場合は小さいインデックスを残す（スカラー版と同じ選び方）
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+            best = _mm_min_ps(distance, best);
+            bestIndex = _mm_or_si128(_mm_andnot_si128(closer, bestIndex), _mm_and_si128(closer, _mm_set1_epi32(k)));
+        }
+        total = _mm_add_ps(total, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(selected + i), bestIndex);
+    }
+    error = HorizontalSum(total);
+
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        indices |= static_cast<uint32_t>(selected[i]) << (i * 2);
+    }
+    return indices;
+}
+
+uint64_t SelectScalarIndicesSse2(const float* values, const float* palette, float& error) {
+    alignas(16) int32_t selected[16];
+    __m128 total = _mm_setzero_ps();
+    for (int i = 0; i < 16; i += 4) {
+        const __m128 v = _mm_loadu_ps(values + i);
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIndex = _mm_setzero_si128();
+        for (int k = 0; k < 8; ++k) {
+            const __m128 d = _mm_sub_ps(v, _mm_set1_ps(palette[k]));
+            const __m128 distance = _mm_mul_ps(d, d);
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+            best = _mm_min_ps(distance, best);
+            bestIndex = _mm_or_si128(_mm_andnot_si128(closer, bestIndex), _mm_and_si128(closer, _mm_set1_epi32(k)));
+        }
+        total = _mm_add_ps(total, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(selected + i), bestIndex);
+    }
+    error = HorizontalSum(total);
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        indices |= static_cast<uint64_t>(selected[i]) << (i * 3);
+    }
+    return indices;
+}
+
+BLOCK_COMPRESSOR_AVX2_TARGET
+float HorizontalSumAvx2(__m256 value) {
+    const __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    const __m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+}
+
+BLOCK_COMPRESSOR_AVX2_TARGET
+uint32_t SelectColorIndicesAvx2(const BlockPixels& block, const float (*palette)[3], float& error) {
+    alignas(32) int32_t selected[16];
+    __m256 total = _mm256_setzero_ps();
+    for (int i = 0; i < 16; i += 8) {
+        const __m256 r = _mm256_load_ps(block.r + i);
+        const __m256 g = _mm256_load_ps(block.g + i);
+        const __m256 b = _mm256_load_ps(block.b + i);
+        __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256i bestIndex = _mm256_setzero_si256();
+        for (int k = 0; k < 4; ++k) {
+            const __m256 dr = _mm256_sub_ps(r, _mm256_set1_ps(palette[k][0]));
+            const __m256 dg = _mm256_sub_ps(g, _mm256_set1_ps(palette[k][1]));
+            const __m256 db = _mm256_sub_ps(b, _mm256_set1_ps(palette[k][2]));
+            const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dr, dr), _mm256_mul_ps(dg, dg)), _mm256_mul_ps(db, db));
+            const __m256 closer = _mm256_cmp_ps(distance, best, _CMP_LT_OQ);
+            best = _mm256_min_ps(distance, best);
+            bestIndex = _mm256_blendv_epi8(bestIndex, _mm256_set1_epi32(k), _mm256_castps_si256(closer));
+        }
+        total = _mm256_add_ps(total, best);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(selected + i), bestIndex);
+    }
+    error = HorizontalSumAvx2(total);
+
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        indices |= static_cast<uint32_t>(selected[i]) << (i * 2);
+    }
+    return indices;
+}
+
+BLOCK_COMPRESSOR_AVX2_TARGET
+uint64_t SelectScalarIndicesAvx2(const float* values, const float* palette, float& error) {
+    alignas(32) int32_t selected[16];
+    __m256 total = _mm256_setzero_ps();
+    for (int i = 0; i < 16; i += 8) {
+        const __m256 v = _mm256_loadu_ps(values + i);
+        __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256i bestIndex = _mm256_setzero_si256();
+        for (int k = 0; k < 8; ++k) {
+            const __m256 d = _mm256_sub_ps(v, _mm256_set1_ps(palette[k]));
+            const __m256 distance = _mm256_mul_ps(d, d);
+            const __m256 closer = _mm256_cmp_ps(distance, best, _CMP_LT_OQ);
+            best = _mm256_min_ps(distance, best);
+            bestIndex = _mm256_blendv_epi8(bestIndex, _mm256_set1_epi32(k), _mm256_castps_si256(closer));
+        }
+        total = _mm256_add_ps(total, best);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(selected + i), bestIndex);
+    }
+    error = HorizontalSumAvx2(total);
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        indices |= static_cast<uint64_t>(selected[i]) << (i * 3);
+    }
+    return indices;
+}
+
+#endif
+
+const IndexSelectors& GetIndexSelectors(BlockSimdLevel level) {
+    static const IndexSelectors scalar{ SelectColorIndicesScalar, SelectScalarIndicesScalar };
+#ifdef BLOCK_COMPRESSOR_X64
+    static const IndexSelectors sse2{ SelectColorIndicesSse2, SelectScalarIndicesSse2 };
+    static const IndexSelectors avx2{ SelectColorIndicesAvx2, SelectScalarIndicesAvx2 };
+    switch (std::min(level, BlockCompressor::GetSupportedSimdLevel())) {
+        case BlockSimdLevel::AVX2: return avx2;
+        case BlockSimdLevel::SSE2: return sse2;
+        default:                   return scalar;
+    }
+#else
+    (void)level;
+    return scalar;
+#endif
+}
+
+// ---- カラー（BC1/BC3のRGB） ----
+
+/// <summary>
+/// 単色を最も近く表せる端点の組
+/// 4色モードはインデックス2 = (2 * high + low) / 3、3色モードはインデックス2 = (high + low) / 2 で表す
+/// </summary>
+struct SingleColorTable {
+    uint8_t high[256];      // 端点0の量子化値
+    uint8_t low[256];       // 端点1の量子化値
+
+    SingleColorTable(int bits, bool fourColor) {
+        const int maxValue = (1 << bits) - 1;
+        const auto expand = [bits](int value) { return bits == 5 ? (value << 3) | (value >> 2) : (value << 2) | (value >> 4); };
+        for (int target = 0; target < 256; ++target) {
+            int bestError = 256;
+            for (int hi = 0; hi <= maxValue; ++hi) {
+                for (int lo = 0; lo <= maxValue; ++lo) {
+                    const int value = fourColor ? (2 * expand(hi) + expand(lo) + 1) / 3 : (expand(hi) + expand(lo) + 1) / 2;
+                    const int error = std::abs(value - target);
+                    if (error < bestError) {
+                        bestError = error;
+                        high[target] = static_cast<uint8_t>(hi);
+                        low[target] = static_cast<uint8_t>(lo);
+                    }
+                }
+            }
+        }
+    }
+};
+
+/// <summary>
+/// ブロック内の不透明なピクセルを受け取るカラーエンコーダ
+/// </summary>
+class ColorEncoder {
+public:
+    ColorEncoder(const BlockPixels& block, uint32_t transparentMask, bool forceFourColor, const IndexSelectors& selectors)
+        : m_block(block), m_transparentMask(transparentMask), m_forceFourColor(forceFourColor), m_selectors(selectors) {
+    }
+
+    /// <summary>
+    /// 端点の候補を量子化してインデックスを選び、誤差の小さい方をbestに残す
+    /// </summary>
+    void Evaluate(const float endpoint0[3], const float endpoint1[3], bool fourColor, ColorBlock& best) const {
+        ColorBlock candidate;
+        candidate.color0 = PackColor565(endpoint0);
+        candidate.color1 = PackColor565(endpoint1);
+        // 4色モードはcolor0 > color1、3色モードはcolor0 <= color1で表す（BC3のカラーは常に4色）
+        if (fourColor ? candidate.color0 < candidate.color1 : candidate.color0 > candidate.color1) {
+            std::swap(candidate.color0, candidate.color1);
+        }
+        const bool decodedFourColor = m_forceFourColor || candidate.color0 > candidate.color1;
+
+        int palette[4][3];
+        MakeColorPalette(candidate.color0, candidate.color1, decodedFourColor, palette);
+        float paletteValues[4][3];
+        for (int k = 0; k < 4; ++k) {
+            for (int c = 0; c < 3; ++c) {
+                paletteValues[k][c] = (!decodedFourColor && k == 3) ? kUnusedPaletteValue : static_cast<float>(palette[k][c]);
+            }
+        }
+
+        if (m_transparentMask == 0) {
+            candidate.indices = m_selectors.selectColor(m_block, paletteValues, candidate.error);
+        }
+        else {
+            // 透明なピクセルはインデックス3に固定し、残りを3色から選ぶ
+            candidate.error = 0.0f;
+            for (int i = 0; i < 16; ++i) {
+                uint32_t bestIndex = 3;
+                if ((m_transparentMask & (1u << i)) == 0) {
+                    float bestDistance = std::numeric_limits<float>::max();
+                    for (uint32_t k = 0; k < 3; ++k) {
+                        const float dr = m_block.r[i] - paletteValues[k][0];
+                        const float dg = m_block.g[i] - paletteValues[k][1];
+                        const float db = m_block.b[i] - paletteValues[k][2];
+                        const float distance = dr * dr + dg * dg + db * db;
+                        if (distance < bestDistance) {
+                            bestDistance = distance;
+                            bestIndex = k;
+                        }
+                    }
+                    candidate.error += bestDistance;
+                }
+                candidate.indices |= bestIndex << (i * 2);
+            }
+        }
+
+        if (candidate.error < best.error) {
+            best = candidate;
+        }
+    }
+
+    /// <summary>
+    /// 選ばれたインデックスに対して端点を最小二乗で合わせ直す
+    /// </summary>
+    bool Refit(const ColorBlock& block, float endpoint0[3], float endpoint1[3]) const {
+        const bool fourColor = m_forceFourColor || block.color0 > block.color1;
+        // インデックスごとの端点0の重み（端点1の重みは1 - α）
+        static constexpr float kFourColorWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        static constexpr float kThreeColorWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+        const float* weights = fourColor ? kFourColorWeights : kThreeColorWeights;
+
+        float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+        float alphaX[3] = {}, betaX[3] = {};
+        for (int i = 0; i < 16; ++i) {
+            const uint32_t index = (block.indices >> (i * 2)) & 3;
+            if (!IsActive(i) || (!fourColor && index == 3)) {
+                continue;
+            }
+            const float alpha = weights[index];
+            const float beta = 1.0f - alpha;
+            const float x[3] = { m_block.r[i], m_block.g[i], m_block.b[i] };
+            alpha2 += alpha * alpha;
+            beta2 += beta * beta;
+            alphaBeta += alpha * beta;
+            for (int c = 0; c < 3; ++c) {
+                alphaX[c] += alpha * x[c];
+                betaX[c] += beta * x[c];
+            }
+        }
+        const float factor = alpha2 * beta2 - alphaBeta * alphaBeta;
+        if (factor < 1.0e-4f) {
+            return false;
+        }
+        for (int c = 0; c < 3; ++c) {
+            endpoint0[c] = std::clamp((alphaX[c] * beta2 - betaX[c] * alphaBeta) / factor, 0.0f, 255.0f);
+            endpoint1[c] = std::clamp((betaX[c] * alpha2 - alphaX[c] * alphaBeta) / factor, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// 主軸上の並びを保ったままピクセルを4つ（3色モードは3つ）のクラスタに分ける全通りを試し、
+    /// 量子化後の端点で誤差が最小になる分け方の端点を求める
+    /// </summary>
+    bool ClusterFit(const float axis[3], bool fourColor, float endpoint0[3], float endpoint1[3]) const {
+        // 主軸への射影の順に並べる
+        std::array<int, 16> order{};
+        std::array<float, 16> projection{};
+        int count = 0;
+        for (int i = 0; i < 16; ++i) {
+            if (IsActive(i)) {
+                order[count] = i;
+                projection[i] = m_block.r[i] * axis[0] + m_block.g[i] * axis[1] + m_block.b[i] * axis[2];
+                ++count;
+            }
+        }
+        std::sort(order.begin(), order.begin() + count, [&projection](int a, int b) { return projection[a] < projection[b]; });
+
+        // 先頭からの累積和でクラスタごとの合計を求める
+        float prefix[17][3] = {};
+        for (int i = 0; i < count; ++i) {
+            const int p = order[i];
+            prefix[i + 1][0] = prefix[i][0] + m_block.r[p];
+            prefix[i + 1][1] = prefix[i][1] + m_block.g[p];
+            prefix[i + 1][2] = prefix[i][2] + m_block.b[p];
+        }
+
+        float bestError = std::numeric_limits<float>::max();
+        const auto tryPartition = [&](float alpha2, float beta2, float alphaBeta, const float alphaX[3], const float betaX[3]) {
+            const float factor = alpha2 * beta2 - alphaBeta * alphaBeta;
+            if (factor < 1.0e-4f) {
+                return;
+            }
+            float a[3], b[3];
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                // 量子化後の値で評価しないと、表せない端点を選んでしまう
+                const float scale = c == 1 ? 63.0f : 31.0f;
+                a[c] = QuantizeToGrid((alphaX[c] * beta2 - betaX[c] * alphaBeta) / factor, scale);
+                b[c] = QuantizeToGrid((betaX[c] * alpha2 - alphaX[c] * alphaBeta) / factor, scale);
+                // Σ|αa + βb - x|^2 からxだけの項を除いたもの
+                error += a[c] * a[c] * alpha2 + b[c] * b[c] * beta2
+                    + 2.0f * (a[c] * b[c] * alphaBeta - a[c] * alphaX[c] - b[c] * betaX[c]);
+            }
+            if (error < bestError) {
+                bestError = error;
+                std::copy(a, a + 3, endpoint0);
+                std::copy(b, b + 3, endpoint1);
+            }
+        };
+
+        const float* total = prefix[count];
+        if (fourColor) {
+            // クラスタの重み α = 1, 2/3, 1/3, 0
+            for (int i = 0; i <= count; ++i) {
+                for (int j = i; j <= count; ++j) {
+                    for (int k = j; k <= count; ++k) {
+                        const float n0 = static_cast<float>(i);
+                        const float n1 = static_cast<float>(j - i);
+                        const float n2 = static_cast<float>(k - j);
+                        const float n3 = static_cast<float>(count - k);
+                        const float alpha2 = n0 + n1 * (4.0f / 9.0f) + n2 * (1.0f / 9.0f);
+                        const float beta2 = n3 + n2 * (4.0f / 9.0f) + n1 * (1.0f / 9.0f);
+                        const float alphaBeta = (n1 + n2) * (2.0f / 9.0f);
+                        float alphaX[3], betaX[3];
+                        for (int c = 0; c < 3; ++c) {
+                            const float x0 = prefix[i][c];
+                            const float x1 = prefix[j][c] - prefix[i][c];
+                            const float x2 = prefix[k][c] - prefix[j][c];
+                            const float x3 = total[c] - prefix[k][c];
+                            alphaX[c] = x0 + x1 * (2.0f / 3.0f) + x2 * (1.0f / 3.0f);
+                            betaX[c] = x3 + x2 * (2.0f / 3.0f) + x1 * (1.0f / 3.0f);
+                        }
+                        tryPartition(alpha2, beta2, alphaBeta, alphaX, betaX);
+                    }
+                }
+            }
+        }
+        else {
+            // クラスタの重み α = 1, 1/2, 0
+            for (int i = 0; i <= count; ++i) {
+                for (int j = i; j <= count; ++j) {
+                    const float n0 = static_cast<float>(i);
+                    const float n1 = static_cast<float>(j - i);
+                    const float n2 = static_cast<float>(count - j);
+                    const float alpha2 = n0 + n1 * 0.25f;
+                    const float beta2 = n2 + n1 * 0.25f;
+                    const float alphaBeta = n1 * 0.25f;
+                    float alphaX[3], betaX[3];
+                    for (int c = 0; c < 3; ++c) {
+                        const float x0 = prefix[i][c];
+                        const float x1 = prefix[j][c] - prefix[i][c];
+                        const float x2 = total[c] - prefix[j][c];
+                        alphaX[c] = x0 + x1 * 0.5f;
+                        betaX[c] = x2 + x1 * 0.5f;
+                    }
+                    tryPartition(alpha2, beta2, alphaBeta, alphaX, betaX);
+                }
+            }
+        }
+        return bestError != std::numeric_limits<float>::max();
+    }
+
+    /// <summary>
+    /// ピクセルの平均と主軸（共分散行列の最大固有ベクトル）を求める
+    /// </summary>
+    void ComputePrincipalAxis(float mean[3], float axis[3]) const {
+        float sum[3] = {};
+        int count = 0;
+        for (int i = 0; i < 16; ++i) {
+            if (IsActive(i)) {
+                sum[0] += m_block.r[i];
+                sum[1] += m_block.g[i];
+                sum[2] += m_block.b[i];
+                ++count;
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            mean[c] = sum[c] / static_cast<float>(count);
+        }
+
+        float covariance[6] = {};
+        for (int i = 0; i < 16; ++i) {
+            if (IsActive(i)) {
+                const float d[3] = { m_block.r[i] - mean[0], m_block.g[i] - mean[1], m_block.b[i] - mean[2] };
+                covariance[0] += d[0] * d[0];
+                covariance[1] += d[0] * d[1];
+                covariance[2] += d[0] * d[2];
+                covariance[3] += d[1] * d[1];
+                covariance[4] += d[1] * d[2];
+                covariance[5] += d[2] * d[2];
+            }
+        }
+
+        // べき乗法（輝度方向から始めると少ない反復で収束する）
+        float v[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            const float x = v[0] * covariance[0] + v[1] * covariance[1] + v[2] * covariance[2];
+            const float y = v[0] * covariance[1] + v[1] * covariance[3] + v[2] * covariance[4];
+            const float z = v[0] * covariance[2] + v[1] * covariance[4] + v[2] * covariance[5];
+            const float length = std::max({ std::abs(x), std::abs(y), std::abs(z) });
+            if (length < 1.0e-6f) {
+                break;
+            }
+            v[0] = x / length;
+            v[1] = y / length;
+            v[2] = z / length;
+        }
+        const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        for (int c = 0; c < 3; ++c) {
+            axis[c] = v[c] / length;
+        }
+    }
+
+    bool IsActive(int index) const { return (m_transparentMask & (1u << index)) == 0; }
+
+private:
+    static float QuantizeToGrid(float value, float scale) {
+        return std::floor(std::clamp(value, 0.0f, 255.0f) * (scale / 255.0f) + 0.5f) * (255.0f / scale);
+    }
+
+    const BlockPixels& m_block;             // 圧縮するブロック
+    uint32_t m_transparentMask;             // 透明として扱うピクセル（BC1のみ）
+    bool m_forceFourColor;                  // 端点の大小によらず4色モードで展開されるか（BC3）
+    const IndexSelectors& m_selectors;      // インデックス選択の実装
+};
+
+ColorBlock EncodeColorBlock(const BlockPixels& block, uint32_t transparentMask, bool forceFourColor,
+                            BlockQuality quality, const IndexSelectors& selectors) {
+    ColorBlock best;
+    if (transparentMask == 0xFFFF) {
+        // すべて透明（3色モードのインデックス3）
+        best.indices = 0xFFFFFFFF;
+        return best;
+    }
+
+    const ColorEncoder encoder(block, transparentMask, forceFourColor, selectors);
+    const bool needsThreeColor = transparentMask != 0;
+
+    // 単色のブロックは端点の間の色で表すと565の量子化より近くなる
+    // （2つの端点が同じ値になった場合は3色モードになるが、インデックス2の端点の平均も同じ色になる）
+    int first = 0;
+    while (!encoder.IsActive(first)) {
+        ++first;
+    }
+    bool solid = true;
+    for (int i = first + 1; i < 16 && solid; ++i) {
+        solid = !encoder.IsActive(i) || (block.r[i] == block.r[first] && block.g[i] == block.g[first] && block.b[i] == block.b[first]);
+    }
+    if (solid) {
+        static const SingleColorTable fourColor5(5, true);
+        static const SingleColorTable fourColor6(6, true);
+        static const SingleColorTable threeColor5(5, false);
+        static const SingleColorTable threeColor6(6, false);
+        const SingleColorTable& table5 = needsThreeColor ? threeColor5 : fourColor5;
+        const SingleColorTable& table6 = needsThreeColor ? threeColor6 : fourColor6;
+        const int r = static_cast<int>(block.r[first]);
+        const int g = static_cast<int>(block.g[first]);
+        const int b = static_cast<int>(block.b[first]);
+        best.color0 = static_cast<uint16_t>((table5.high[r] << 11) | (table6.high[g] << 5) | table5.high[b]);
+        best.color1 = static_cast<uint16_t>((table5.low[r] << 11) | (table6.low[g] << 5) | table5.low[b]);
+        uint32_t index = 2;
+        if (needsThreeColor ? best.color0 > best.color1 : best.color0 < best.color1) {
+            // 3色モードのインデックス2は端点について対称なので、入れ替えても同じ色になる
+            std::swap(best.color0, best.color1);
+            index = needsThreeColor ? 2 : 3;
+        }
+        best.indices = 0;
+        for (int i = 0; i < 16; ++i) {
+            best.indices |= (encoder.IsActive(i) ? index : 3) << (i * 2);
+        }
+        return best;
+    }
+
+    // 主軸上の両端のピクセルを端点とし、選ばれたインデックスで一度だけ合わせ直す
+    float mean[3], axis[3];
+    encoder.ComputePrincipalAxis(mean, axis);
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 16; ++i) {
+        if (encoder.IsActive(i)) {
+            const float t = (block.r[i] - mean[0]) * axis[0] + (block.g[i] - mean[1]) * axis[1] + (block.b[i] - mean[2]) * axis[2];
+            minProjection = std::min(minProjection, t);
+            maxProjection = std::max(maxProjection, t);
+        }
+    }
+    float endpoint0[3], endpoint1[3];
+    for (int c = 0; c < 3; ++c) {
+        endpoint0[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+        endpoint1[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+    }
+    encoder.Evaluate(endpoint0, endpoint1, !needsThreeColor, best);
+    if (encoder.Refit(best, endpoint0, endpoint1)) {
+        encoder.Evaluate(endpoint0, endpoint1, !needsThreeColor, best);
+    }
+
+    if (quality == BlockQuality::High) {
+        if (!needsThreeColor && encoder.ClusterFit(axis, true, endpoint0, endpoint1)) {
+            encoder.Evaluate(endpoint0, endpoint1, true, best);
+        }
+        // BC1は不透明なブロックでも3色モードの方が近い場合がある
+        if (!forceFourColor && encoder.ClusterFit(axis, false, endpoint0, endpoint1)) {
+            encoder.Evaluate(endpoint0, endpoint1, false, best);
+        }
+    }
+    return best;
+}
+
+void StoreColorBlock(const ColorBlock& block, uint8_t* output) {
+    output[0] = static_cast<uint8_t>(block.color0);
+    output[1] = static_cast<uint8_t>(block.color0 >> 8);
+    output[2] = static_cast<uint8_t>(block.color1);
+    output[3] = static_cast<uint8_t>(block.color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        output[4 + i] = static_cast<uint8_t>(block.indices >> (i * 8));
+    }
+}
+
+// ---- 単チャンネル（BC4、BC3のアルファ、BC5の各チャンネル） ----
+
+void EvaluateScalar(const float* values, int endpoint0, int endpoint1, const IndexSelectors& selectors, ScalarBlock& best) {
+    int palette[8];
+    MakeScalarPalette(endpoint0, endpoint1, palette);
+    float paletteValues[8];
+    for (int k = 0; k < 8; ++k) {
+        paletteValues[k] = static_cast<float>(palette[k]);
+    }
+    ScalarBlock candidate;
+    candidate.endpoint0 = static_cast<uint8_t>(endpoint0);
+    candidate.endpoint1 = static_cast<uint8_t>(endpoint1);
+    candidate.indices = selectors.selectScalar(values, paletteValues, candidate.error);
+    if (candidate.error < best.error) {
+        best = candidate;
+    }
+}
+
+ScalarBlock EncodeScalarBlock(const float* values, BlockQuality quality, const IndexSelectors& selectors) {
+    const auto [minIt, maxIt] = std::minmax_element(values, values + 16);
+    const int minValue = static_cast<int>(*minIt);
+    const int maxValue = static_cast<int>(*maxIt);
+
+    ScalarBlock best;
+    if (minValue == maxValue) {
+        best.endpoint0 = static_cast<uint8_t>(minValue);
+        best.endpoint1 = static_cast<uint8_t>(minValue);
+        best.error = 0.0f;
+        return best;
+    }
+
+    // 8段階モードで最小値〜最大値を等分する
+    EvaluateScalar(values, maxValue, minValue, selectors, best);
+    if (quality != BlockQuality::High) {
+        return best;
+    }
+
+    // 選ばれたインデックスで端点を最小二乗で合わせ直す
+    for (int iteration = 0; iteration < 2 && best.endpoint0 > best.endpoint1; ++iteration) {
+        float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f, alphaX = 0.0f, betaX = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            const int index = static_cast<int>((best.indices >> (i * 3)) & 7);
+            const float alpha = index == 0 ? 1.0f : index == 1 ? 0.0f : static_cast<float>(8 - index) / 7.0f;
+            const float beta = 1.0f - alpha;
+            alpha2 += alpha * alpha;
+            beta2 += beta * beta;
+            alphaBeta += alpha * beta;
+            alphaX += alpha * values[i];
+            betaX += beta * values[i];
+        }
+        const float factor = alpha2 * beta2 - alphaBeta * alphaBeta;
+        if (factor < 1.0e-4f) {
+            break;
+        }
+        const int endpoint0 = std::clamp(static_cast<int>((alphaX * beta2 - betaX * alphaBeta) / factor + 0.5f), 0, 255);
+        const int endpoint1 = std::clamp(static_cast<int>((betaX * alpha2 - alphaX * alphaBeta) / factor + 0.5f), 0, 255);
+        if (endpoint0 <= endpoint1) {
+            break;
+        }
+        EvaluateScalar(values, endpoint0, endpoint1, selectors, best);
+    }
+
+    // 端点の近傍を探索する（量子化後の誤差は端点について滑らかでないため）
+    if (best.endpoint0 > best.endpoint1) {
+        const int center0 = best.endpoint0;
+        const int center1 = best.endpoint1;
+        for (int d0 = -2; d0 <= 2; ++d0) {
+            for (int d1 = -2; d1 <= 2; ++d1) {
+                const int endpoint0 = center0 + d0;
+                const int endpoint1 = center1 + d1;
+                if ((d0 != 0 || d1 != 0) && endpoint0 <= 255 && endpoint1 >= 0 && endpoint0 > endpoint1) {
+                    EvaluateScalar(values, endpoint0, endpoint1, selectors, best);
+                }
+            }
+        }
+    }
+
+    // 0や255を含むブロックは、それらを専用の値に任せて残りを6段階で表す方が近い場合がある
+    int innerMin = 255;
+    int innerMax = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int value = static_cast<int>(values[i]);
+        if (value != 0 && value != 255) {
+            innerMin = std::min(innerMin, value);
+            innerMax = std::max(innerMax, value);
+        }
+    }
+    if (innerMin <= innerMax) {
+        EvaluateScalar(values, innerMin, innerMax, selectors, best);
+    }
+    return best;
+}
+
+void StoreScalarBlock(const ScalarBlock& block, uint8_t* output) {
+    output[0] = block.endpoint0;
+    output[1] = block.endpoint1;
+    for (int i = 0; i < 6; ++i) {
+        output[2 + i] = static_cast<uint8_t>(block.indices >> (i * 8));
+    }
+}
+
+// ---- ブロック単位の処理 ----
+
+void LoadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, uint32_t blockX, uint32_t blockY, BlockPixels& block) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        // 画像の外は端のピクセルを繰り返す
+        const uint8_t* row = pixels + std::min(blockY * 4 + y, height - 1) * rowPitch;
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint8_t* pixel = row + std::min(blockX * 4 + x, width - 1) * 4;
+            const uint32_t i = y * 4 + x;
+            block.r[i] = pixel[0];
+            block.g[i] = pixel[1];
+            block.b[i] = pixel[2];
+            block.a[i] = pixel[3];
+        }
+    }
+}
+
+void EncodeBlock(const BlockPixels& block, BlockFormat format, BlockQuality quality, const IndexSelectors& selectors, uint8_t* output) {
+    switch (format) {
+        case BlockFormat::BC1: {
+            uint32_t transparentMask = 0;
+            for (int i = 0; i < 16; ++i) {
+                if (block.a[i] < 128.0f) {
+                    transparentMask |= 1u << i;
+                }
+            }
+            StoreColorBlock(EncodeColorBlock(block, transparentMask, false, quality, selectors), output);
+            break;
+        }
+        case BlockFormat::BC3:
+            StoreScalarBlock(EncodeScalarBlock(block.a, quality, selectors), output);
+            StoreColorBlock(EncodeColorBlock(block, 0, true, quality, selectors), output + 8);
+            break;
+        case BlockFormat::BC4:
+            StoreScalarBlock(EncodeScalarBlock(block.r, quality, selectors), output);
+            break;
+        case BlockFormat::BC5:
+            StoreScalarBlock(EncodeScalarBlock(block.r, quality, selectors), output);
+            StoreScalarBlock(EncodeScalarBlock(block.g, quality, selectors), output + 8);
+            break;
+        case BlockFormat::BC7: {
+            uint8_t pixels[16][4];
+            for (int i = 0; i < 16; ++i) {
+                pixels[i][0] = static_cast<uint8_t>(block.r[i]);
+                pixels[i][1] = static_cast<uint8_t>(block.g[i]);
+                pixels[i][2] = static_cast<uint8_t>(block.b[i]);
+                pixels[i][3] = static_cast<uint8_t>(block.a[i]);
+            }
+            BptcCodec::EncodeBC7Block(pixels[0], quality, output);
+            break;
+        }
+        case BlockFormat::BC6H:
+            // 浮動小数点の画素はLoadHdrBlockで読み込んで直接BptcCodecへ渡す
+            break;
+    }
+}
+
+// ---- HDR（BC6H） ----
+
+/// <summary>
+/// 浮動小数点を符号なしの半精度浮動小数点のビット列に変換（最近接偶数への丸め。負の値とNaNは0、範囲外は最大値）
+/// </summary>
+uint16_t ToUnsignedHalf(float value) {
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+    if (value >= 65504.0f) {
+        return 0x7BFF;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const int exponent = static_cast<int>(bits >> 23) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+    uint32_t half;
+    uint32_t remainder;
+    uint32_t halfway;
+    if (exponent <= 0) {
+        // 非正規化数
+        if (exponent < -10) {
+            return 0;
+        }
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    }
+    else {
+        half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1FFF;
+        halfway = 0x1000;
+    }
+    if (remainder > halfway || (remainder == halfway && (half & 1) != 0)) {
+        ++half;     // 仮数部の桁上がりは指数部へ繰り上がる
+    }
+    return static_cast<uint16_t>(std::min<uint32_t>(half, 0x7BFF));
+}
+
+void LoadHdrBlock(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, MipPixelFormat pixelFormat,
+                  uint32_t blockX, uint32_t blockY, uint16_t (*block)[3]) {
+    const size_t pixelSize = GetMipPixelSize(pixelFormat);
+    for (uint32_t y = 0; y < 4; ++y) {
+        // 画像の外は端のピクセルを繰り返す
+        const uint8_t* row = pixels + std::min(blockY * 4 + y, height - 1) * rowPitch;
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint8_t* pixel = row + std::min(blockX * 4 + x, width - 1) * pixelSize;
+            uint16_t* output = block[y * 4 + x];
+            if (pixelFormat == MipPixelFormat::RGBA16Float) {
+                std::memcpy(output, pixel, sizeof(uint16_t) * 3);
+            }
+            else {
+                float rgb[3];
+                std::memcpy(rgb, pixel, sizeof(rgb));
+                for (int c = 0; c < 3; ++c) {
+                    output[c] = ToUnsignedHalf(rgb[c]);
+                }
+            }
+        }
+    }
+}
+
+void DecodeColorBlock(const uint8_t* input, bool forceFourColor, uint8_t (*pixels)[4]) {
+    const uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+    const uint16_t color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+    const uint32_t indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+    const bool fourColor = forceFourColor || color0 > color1;
+    int palette[4][3];
+    MakeColorPalette(color0, color1, fourColor, palette);
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t index = (indices >> (i * 2)) & 3;
+        for (int c = 0; c < 3; ++c) {
+            pixels[i][c] = static_cast<uint8_t>(palette[index][c]);
+        }
+        pixels[i][3] = (!fourColor && index == 3) ? 0 : 255;
+    }
+}
+
+void DecodeScalarBlock(const uint8_t* input, uint8_t (*pixels)[4], int channel) {
+    int palette[8];
+    MakeScalarPalette(input[0], input[1], palette);
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        pixels[i][channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+    }
+}
+
+} // namespace
+
+BlockCompressor::BlockCompressor(uint32_t threadCount)
+    : m_pool(threadCount) {
+}
+
+bool BlockCompressor::Compress(const MipChain& chain, BlockFormat format, CompressedTexture& texture, const BlockCompressOptions& options) {
+    const bool hdr = chain.format == MipPixelFormat::RGBA16Float || chain.format == MipPixelFormat::RGBA32Float;
+    const bool ldr = chain.format == MipPixelFormat::RGBA8Unorm || chain.format == MipPixelFormat::RGBA8UnormSrgb;
+    if (chain.levels.empty() || (format == BlockFormat::BC6H ? !hdr : !ldr)) {
+        return false;
+    }
+
+    // BC4/BC5/BC6HにsRGBの形式はない
+    texture.format = format;
+    texture.srgb = chain.format == MipPixelFormat::RGBA8UnormSrgb
+        && (format == BlockFormat::BC1 || format == BlockFormat::BC3 || format == BlockFormat::BC7);
+    texture.levels.resize(chain.levels.size());
+    size_t totalSize = 0;
+    for (size_t level = 0; level < chain.levels.size(); ++level) {
+        CompressedLevel& compressed = texture.levels[level];
+        compressed.width = chain.levels[level].width;
+        compressed.height = chain.levels[level].height;
+        compressed.rowPitch = ((compressed.width + 3) / 4) * GetBlockSize(format);
+        compressed.size = GetCompressedSize(format, compressed.width, compressed.height);
+        compressed.offset = totalSize;
+        totalSize += compressed.size;
+    }
+    texture.data.resize(totalSize);
+
+    for (size_t level = 0; level < chain.levels.size(); ++level) {
+        const MipLevel& mip = chain.levels[level];
+        uint8_t* blocks = texture.data.data() + texture.levels[level].offset;
+        if (hdr) {
+            CompressHdrImage(chain.GetLevelData(level).data(), mip.width, mip.height, mip.rowPitch, chain.format, blocks, options);
+        }
+        else {
+            CompressImage(chain.GetLevelData(level).data(), mip.width, mip.height, mip.rowPitch, format, blocks, options);
+        }
+    }
+    return true;
+}
+
+bool BlockCompressor::CompressImage(const uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch, BlockFormat format,
+                                    uint8_t* blocks, const BlockCompressOptions& options) {
+    if (!pixels || !blocks || width == 0 || height == 0 || format == BlockFormat::BC6H) {
+        return false;
+    }
+    if (rowPitch == 0) {
+        rowPitch = static_cast<size_t>(width) * 4;
+    }
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockSize = GetBlockSize(format);
+    const IndexSelectors& selectors = GetIndexSelectors(options.maxSimdLevel);
+    const uint64_t minBlocksPerBand = format == BlockFormat::BC7 ? kMinBptcBlocksPerBand : kMinBlocksPerBand;
+    ForEachBand(blocksY, static_cast<uint64_t>(blocksX) * blocksY, minBlocksPerBand, [&](uint32_t firstRow, uint32_t lastRow) {
+        BlockPixels block;
+        for (uint32_t blockY = firstRow; blockY < lastRow; ++blockY) {
+            uint8_t* output = blocks + blockY * blocksX * blockSize;
+            for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+                LoadBlock(pixels, width, height, rowPitch, blockX, blockY, block);
+                EncodeBlock(block, format, options.quality, selectors, output + blockX * blockSize);
+            }
+        }
+    });
+    return true;
+}
+
+bool BlockCompressor::CompressHdrImage(const void* pixels, uint32_t width, uint32_t height, size_t rowPitch, MipPixelFormat pixelFormat,
+                                       uint8_t* blocks, const BlockCompressOptions& options) {
+    if (!pixels || !blocks || width == 0 || height == 0
+        || (pixelFormat != MipPixelFormat::RGBA16Float && pixelFormat != MipPixelFormat::RGBA32Float)) {
+        return false;
+    }
+    if (rowPitch == 0) {
+        rowPitch = static_cast<size_t>(width) * GetMipPixelSize(pixelFormat);
+    }
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockSize = GetBlockSize(BlockFormat::BC6H);
+    ForEachBand(blocksY, static_cast<uint64_t>(blocksX) * blocksY, kMinBptcBlocksPerBand, [&](uint32_t firstRow, uint32_t lastRow) {
+        uint16_t block[16][3];
+        for (uint32_t blockY = firstRow; blockY < lastRow; ++blockY) {
+            uint8_t* output = blocks + blockY * blocksX * blockSize;
+            for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+                LoadHdrBlock(static_cast<const uint8_t*>(pixels), width, height, rowPitch, pixelFormat, blockX, blockY, block);
+                BptcCodec::EncodeBC6HBlock(block[0], options.quality, output + blockX * blockSize);
+            }
+        }
+    });
+    return true;
+}
+
+void BlockCompressor::ForEachBand(uint32_t blocksY, uint64_t blockCount, uint64_t minBlocksPerBand,
+                                  const std::function<void(uint32_t, uint32_t)>& processRows) {
+    // High品質は単色のブロックと複雑なブロックで時間が大きく違うため、スレッド数より多めに分けて偏りをならす
+    const uint64_t maxBands = std::min<uint64_t>(blocksY, static_cast<uint64_t>(m_pool.GetThreadCount()) * 4);
+    const int bands = static_cast<int>(std::clamp<uint64_t>(blockCount / minBlocksPerBand, 1, maxBands));
+    m_pool.ParallelFor(bands, [&](int band) {
+        const uint32_t firstRow = static_cast<uint32_t>(static_cast<uint64_t>(blocksY) * band / bands);
+        const uint32_t lastRow = static_cast<uint32_t>(static_cast<uint64_t>(blocksY) * (band + 1) / bands);
+        processRows(firstRow, lastRow);
+    });
+}
+
+bool BlockCompressor::DecompressImage(const uint8_t* blocks, uint32_t width, uint32_t height, BlockFormat format,
+                                      uint8_t* pixels, size_t rowPitch) {
+    if (!blocks || !pixels || width == 0 || height == 0 || format == BlockFormat::BC6H) {
+        return false;
+    }
+    if (rowPitch == 0) {
+        rowPitch = static_cast<size_t>(width) * 4;
+    }
+
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockSize = GetBlockSize(format);
+    for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            const uint8_t* input = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+            uint8_t decoded[16][4] = {};
+            switch (format) {
+                case BlockFormat::BC1:
+                    DecodeColorBlock(input, false, decoded);
+                    break;
+                case BlockFormat::BC3:
+                    DecodeColorBlock(input + 8, true, decoded);
+                    DecodeScalarBlock(input, decoded, 3);
+                    break;
+                case BlockFormat::BC4:
+                    DecodeScalarBlock(input, decoded, 0);
+                    for (auto& pixel : decoded) {
+                        pixel[3] = 255;
+                    }
+                    break;
+                case BlockFormat::BC5:
+                    DecodeScalarBlock(input, decoded, 0);
+                    DecodeScalarBlock(input + 8, decoded, 1);
+                    for (auto& pixel : decoded) {
+                        pixel[3] = 255;
+                    }
+                    break;
+                case BlockFormat::BC7:
+                    BptcCodec::DecodeBC7Block(input, decoded[0]);
+                    break;
+                case BlockFormat::BC6H:
+                    break;
+            }
+
+            // 画像の外にはみ出す部分は書き込まない
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+                uint8_t* row = pixels + (blockY * 4 + y) * rowPitch;
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+                    std::copy(decoded[y * 4 + x], decoded[y * 4 + x] + 4, row + (blockX * 4 + x) * 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void BlockCompressor::DecompressHdrImage(const uint8_t* blocks, uint32_t width, uint32_t height, uint16_t* pixels, size_t rowPitch) {
+    if (!blocks || !pixels || width == 0 || height == 0) {
+        return;
+    }
+    if (rowPitch == 0) {
+        rowPitch = static_cast<size_t>(width) * 4 * sizeof(uint16_t);
+    }
+
+    constexpr uint16_t kOne = 0x3C00;   // 半精度の1.0
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const size_t blockSize = GetBlockSize(BlockFormat::BC6H);
+    for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            uint16_t decoded[16][3];
+            BptcCodec::DecodeBC6HBlock(blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize, decoded[0]);
+
+            // 画像の外にはみ出す部分は書き込まない
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+                uint16_t* row = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(pixels) + (blockY * 4 + y) * rowPitch);
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+                    uint16_t* pixel = row + (blockX * 4 + x) * 4;
+                    std::copy(decoded[y * 4 + x], decoded[y * 4 + x] + 3, pixel);
+                    pixel[3] = kOne;
+                }
+            }
+        }
+    }
+}
+
+size_t BlockCompressor::GetCompressedSize(BlockFormat format, uint32_t width, uint32_t height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+BlockSimdLevel BlockCompressor::GetSupportedSimdLevel() {
+#ifdef BLOCK_COMPRESSOR_X64
+    // x64ではSSE2は常に使える。AVX2はCPUに加えてOSがYMMレジスタを保存するかも確認する
+    static const BlockSimdLevel level = [] {
+#ifdef _MSC_VER
+        int info[4] = {};
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return BlockSimdLevel::SSE2;
+        }
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+            return BlockSimdLevel::SSE2;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0 ? BlockSimdLevel::AVX2 : BlockSimdLevel::SSE2;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? BlockSimdLevel::AVX2 : BlockSimdLevel::SSE2;
+#endif
+    }();
+    return level;
+#else
+    return BlockSimdLevel::Scalar;
+#endif
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,1406 @@
+#include "Texture/BptcCodec.h"
+#include "Texture/BlockCompressor.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace RenderingSandbox {
+
+namespace {
+
+// Fast品質で実際に圧縮するパーティションの数（見積もりの良い順）
+constexpr int kFastPartitionCandidates = 2;
+
+// Fast品質のBC7で、モード6の誤差（RGBAの二乗誤差の合計）がこれ以下なら他のモードを試さない
+// 16ピクセル×RGBAの平均で1（PSNRで48dB程度）
+constexpr float kBc7FastSkipError = 16.0f * 4.0f;
+
+// Fast品質のBC6Hで、1領域のモードの誤差（半精度のビット列の差の二乗和）がこれ以下なら2領域のモードを試さない
+// 16ピクセル×RGBの平均で4ULP程度（仮数10bitに対して0.4%。RGBEの.hdrは仮数8bitのため、これより細かくしても品質はほぼ変わらない）
+constexpr float kBc6hFastSkipError = 16.0f * 3.0f * 16.0f;
+
+// 符号なし半精度浮動小数点の最大値（65504）のビット列
+constexpr int kMaxHalf = 0x7BFF;
+
+// ---- 共通: ビット列 ----
+
+/// <summary>
+/// 128bitのブロックへ最下位ビットから順に書き込む
+/// </summary>
+class BlockBitWriter {
+public:
+    explicit BlockBitWriter(uint8_t* block)
+        : m_block(block) {
+        std::memset(block, 0, 16);
+    }
+
+    void Write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++m_position) {
+            m_block[m_position >> 3] |= static_cast<uint8_t>(((value >> i) & 1u) << (m_position & 7));
+        }
+    }
+
+private:
+    uint8_t* m_block;       // 書き込み先
+    int m_position = 0;     // 次に書き込むビット位置
+};
+
+/// <summary>
+/// 128bitのブロックから最下位ビットから順に読み込む
+/// </summary>
+class BlockBitReader {
+public:
+    explicit BlockBitReader(const uint8_t* block)
+        : m_block(block) {
+    }
+
+    uint32_t Read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++m_position) {
+            value |= static_cast<uint32_t>((m_block[m_position >> 3] >> (m_position & 7)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_block;     // 読み込み元
+    int m_position = 0;         // 次に読み込むビット位置
+};
+
+// ---- 共通: 補間とパーティション ----
+
+// インデックスごとの端点1の重み（/64）
+constexpr int kWeights2[4] = { 0, 21, 43, 64 };
+constexpr int kWeights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+constexpr int kWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+const int* GetWeights(int indexBits) {
+    return indexBits == 2 ? kWeights2 : indexBits == 3 ? kWeights3 : kWeights4;
+}
+
+int Interpolate(int endpoint0, int endpoint1, int weight) {
+    return (endpoint0 * (64 - weight) + endpoint1 * weight + 32) >> 6;
+}
+
+/// <summary>
+/// パレットの先頭から末尾への方向を、射影した長さがそのままインデックスになる大きさで求める
+/// </summary>
+void GetPaletteDirection(const float (*palette)[4], int paletteSize, int channelBegin, int channelEnd, float direction[4]) {
+    float length2 = 0.0f;
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        direction[c] = palette[paletteSize - 1][c] - palette[0][c];
+        length2 += direction[c] * direction[c];
+    }
+    const float scale = length2 > 0.0f ? static_cast<float>(paletteSize - 1) / length2 : 0.0f;
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        direction[c] *= scale;
+    }
+}
+
+/// <summary>
+/// 端点を補間したパレット（ほぼ直線上に並ぶ）からピクセルに最も近い値のインデックスを選ぶ
+/// すべての値とは比べず、パレットの方向へ射影した位置とその前後の値のみを比べる（整数への丸めによるずれを前後で拾う）
+/// </summary>
+int FindNearestPaletteIndex(const float* pixel, const float (*palette)[4], int paletteSize, int channelBegin, int channelEnd,
+                            const float direction[4], float& distance) {
+    float t = 0.0f;
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        t += (pixel[c] - palette[0][c]) * direction[c];
+    }
+    const int center = std::clamp(static_cast<int>(t + 0.5f), 0, paletteSize - 1);
+    int bestIndex = center;
+    distance = std::numeric_limits<float>::max();
+    for (int k = std::max(center - 1, 0); k <= std::min(center + 1, paletteSize - 1); ++k) {
+        float d2 = 0.0f;
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            const float d = pixel[c] - palette[k][c];
+            d2 += d * d;
+        }
+        if (d2 < distance) {
+            distance = d2;
+            bestIndex = k;
+        }
+    }
+    return bestIndex;
+}
+
+// 2サブセットのパーティション（ビットiが1のピクセルがサブセット1。BC6Hは先頭の32個を使う）
+constexpr uint16_t kPartitions2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// 3サブセットのパーティション（ピクセルごとのサブセット）
+constexpr uint8_t kPartitions3[64][16] = {
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 }, { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+    { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 }, { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 }, { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+    { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+    { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 }, { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 }, { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 }, { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 }, { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 }, { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 }, { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 }, { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+    { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 }, { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 }, { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 }, { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 }, { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 }, { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 }, { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 }, { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 }, { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+    { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 }, { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 },
+};
+
+// サブセット1・2のアンカー（最上位ビットを省略して格納するインデックスのピクセル。サブセット0は常にピクセル0）
+constexpr uint8_t kAnchors2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+constexpr uint8_t kAnchors3First[64] = {
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+constexpr uint8_t kAnchors3Second[64] = {
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+int GetSubset(int subsets, int partition, int pixel) {
+    if (subsets == 2) {
+        return (kPartitions2[partition] >> pixel) & 1;
+    }
+    return subsets == 3 ? kPartitions3[partition][pixel] : 0;
+}
+
+int GetAnchor(int subsets, int partition, int subset) {
+    if (subset == 0) {
+        return 0;
+    }
+    if (subsets == 2) {
+        return kAnchors2[partition];
+    }
+    return subset == 1 ? kAnchors3First[partition] : kAnchors3Second[partition];
+}
+
+bool IsAnchor(int subsets, int partition, int pixel) {
+    return pixel == GetAnchor(subsets, partition, GetSubset(subsets, partition, pixel));
+}
+
+/// <summary>
+/// 共分散行列（上三角のみ使う）から直線からの距離の二乗和を見積もる（パーティションの見積もり用）
+/// 最大固有値は、分散の最も大きいチャンネルの列vからvC²v / vCv（べき乗法1回分のレイリー商）で下から見積もる
+/// </summary>
+float EstimateLineError(const float covariance[4][4], int channels) {
+    float full[4][4] = {};
+    float trace = 0.0f;
+    int largest = 0;
+    for (int c0 = 0; c0 < channels; ++c0) {
+        trace += covariance[c0][c0];
+        largest = covariance[c0][c0] > covariance[largest][largest] ? c0 : largest;
+        for (int c1 = c0; c1 < channels; ++c1) {
+            full[c0][c1] = full[c1][c0] = covariance[c0][c1];
+        }
+    }
+    float vCv = 0.0f;
+    float vC2v = 0.0f;
+    for (int c0 = 0; c0 < channels; ++c0) {
+        float w = 0.0f;
+        for (int c1 = 0; c1 < channels; ++c1) {
+            w += full[c0][c1] * full[c1][largest];
+        }
+        vCv += full[c0][largest] * w;
+        vC2v += w * w;
+    }
+    return vCv > 0.0f ? std::max(trace - vC2v / vCv, 0.0f) : trace;
+}
+
+/// <summary>
+/// ピクセルの集合に直線（平均と主軸）を当てはめ、直線からの距離の二乗和を返す
+/// </summary>
+float FitLine(const float (*pixels)[4], const uint8_t* members, int count, int channelBegin, int channelEnd,
+              float mean[4], float axis[4]) {
+    float sum[4] = {};
+    for (int m = 0; m < count; ++m) {
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            sum[c] += pixels[members[m]][c];
+        }
+    }
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        mean[c] = sum[c] / static_cast<float>(count);
+    }
+
+    float covariance[4][4] = {};
+    for (int m = 0; m < count; ++m) {
+        float d[4] = {};
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            d[c] = pixels[members[m]][c] - mean[c];
+        }
+        for (int c0 = channelBegin; c0 < channelEnd; ++c0) {
+            for (int c1 = c0; c1 < channelEnd; ++c1) {
+                covariance[c0][c1] += d[c0] * d[c1];
+            }
+        }
+    }
+    float trace = 0.0f;
+    int largest = channelBegin;
+    for (int c0 = channelBegin; c0 < channelEnd; ++c0) {
+        trace += covariance[c0][c0];
+        largest = covariance[c0][c0] > covariance[largest][largest] ? c0 : largest;
+        for (int c1 = channelBegin; c1 < c0; ++c1) {
+            covariance[c0][c1] = covariance[c1][c0];
+        }
+    }
+
+    // べき乗法（分散の最も大きいチャンネルの列から始める。全チャンネルの和の方向から始めると、
+    // 主軸がそれと直交する場合に収束しない）
+    float v[4] = {};
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        v[c] = covariance[c][largest];
+    }
+    float lambda = 0.0f;
+    for (int iteration = 0; iteration < 6; ++iteration) {
+        float next[4] = {};
+        float length = 0.0f;
+        for (int c0 = channelBegin; c0 < channelEnd; ++c0) {
+            for (int c1 = channelBegin; c1 < channelEnd; ++c1) {
+                next[c0] += covariance[c0][c1] * v[c1];
+            }
+            length = std::max(length, std::abs(next[c0]));
+        }
+        if (length < 1.0e-12f) {
+            break;
+        }
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            v[c] = next[c] / length;
+        }
+    }
+    float length2 = 0.0f;
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        length2 += v[c] * v[c];
+    }
+    if (length2 > 0.0f) {
+        const float scale = 1.0f / std::sqrt(length2);
+        for (int c0 = channelBegin; c0 < channelEnd; ++c0) {
+            axis[c0] = v[c0] * scale;
+        }
+        for (int c0 = channelBegin; c0 < channelEnd; ++c0) {
+            for (int c1 = channelBegin; c1 < channelEnd; ++c1) {
+                lambda += axis[c0] * covariance[c0][c1] * axis[c1];
+            }
+        }
+    }
+    else {
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            axis[c] = 0.0f;
+        }
+    }
+    return std::max(trace - lambda, 0.0f);
+}
+
+/// <summary>
+/// 主軸上の両端を端点にする（端点0がアンカーのピクセルに近くなる向きにする）
+/// </summary>
+void FitEndpoints(const float (*pixels)[4], const uint8_t* members, int count, int anchor, int channelBegin, int channelEnd,
+                  float maxValue, float endpoints[2][4]) {
+    float mean[4] = {}, axis[4] = {};
+    FitLine(pixels, members, count, channelBegin, channelEnd, mean, axis);
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    float anchorProjection = 0.0f;
+    for (int m = 0; m < count; ++m) {
+        float t = 0.0f;
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            t += (pixels[members[m]][c] - mean[c]) * axis[c];
+        }
+        minProjection = std::min(minProjection, t);
+        maxProjection = std::max(maxProjection, t);
+        if (members[m] == anchor) {
+            anchorProjection = t;
+        }
+    }
+    // アンカーのインデックスは最上位ビットが0でなければならない
+    if (anchorProjection - minProjection > maxProjection - anchorProjection) {
+        std::swap(minProjection, maxProjection);
+    }
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        endpoints[0][c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, maxValue);
+        endpoints[1][c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, maxValue);
+    }
+}
+
+/// <summary>
+/// 選ばれたインデックスに対して端点を最小二乗で合わせ直す
+/// </summary>
+bool RefitEndpoints(const float (*pixels)[4], const uint8_t* members, int count, const uint8_t* indices, int indexBits,
+                    int channelBegin, int channelEnd, float maxValue, float endpoints[2][4]) {
+    const int* weights = GetWeights(indexBits);
+    float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+    float alphaX[4] = {}, betaX[4] = {};
+    for (int m = 0; m < count; ++m) {
+        const int pixel = members[m];
+        const float beta = static_cast<float>(weights[indices[pixel]]) / 64.0f;
+        const float alpha = 1.0f - beta;
+        alpha2 += alpha * alpha;
+        beta2 += beta * beta;
+        alphaBeta += alpha * beta;
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            alphaX[c] += alpha * pixels[pixel][c];
+            betaX[c] += beta * pixels[pixel][c];
+        }
+    }
+    const float factor = alpha2 * beta2 - alphaBeta * alphaBeta;
+    if (factor < 1.0e-4f) {
+        return false;
+    }
+    for (int c = channelBegin; c < channelEnd; ++c) {
+        endpoints[0][c] = std::clamp((alphaX[c] * beta2 - betaX[c] * alphaBeta) / factor, 0.0f, maxValue);
+        endpoints[1][c] = std::clamp((betaX[c] * alpha2 - alphaX[c] * alphaBeta) / factor, 0.0f, maxValue);
+    }
+    return true;
+}
+
+/// <summary>
+/// 各パーティションの誤差を直線からの距離で見積もり、小さい順にcount個を返す
+/// ピクセルごとの値と積（モーメント）を先に求めておき、サブセットごとの合計から共分散を求める
+/// </summary>
+int FindBestPartitions(const float (*pixels)[4], int channels, int subsets, int partitionCount, int* partitions, int count) {
+    // 桁落ちを避けるため、ブロックの平均を引いてからモーメントを求める
+    // 各行は値4つ・積10個（上三角）・ピクセル数1・詰め物1
+    float mean[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            mean[c] += pixels[i][c] / 16.0f;
+        }
+    }
+    float moments[16][16] = {};
+    for (int i = 0; i < 16; ++i) {
+        float d[4] = {};
+        for (int c = 0; c < channels; ++c) {
+            d[c] = pixels[i][c] - mean[c];
+        }
+        int k = 4;
+        for (int c0 = 0; c0 < 4; ++c0) {
+            moments[i][c0] = d[c0];
+            for (int c1 = c0; c1 < 4; ++c1) {
+                moments[i][k++] = d[c0] * d[c1];
+            }
+        }
+        moments[i][14] = 1.0f;
+    }
+    float total[16] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int k = 0; k < 16; ++k) {
+            total[k] += moments[i][k];
+        }
+    }
+
+    std::array<std::pair<float, int>, 64> estimates{};
+    for (int partition = 0; partition < partitionCount; ++partition) {
+        // サブセット1以降のピクセルのみ足し合わせ、サブセット0は全体から引いて求める
+        float sums[3][16];
+        std::copy(total, total + 16, sums[0]);
+        for (int subset = 1; subset < subsets; ++subset) {
+            uint32_t mask = 0;
+            for (int i = 0; i < 16; ++i) {
+                mask |= (GetSubset(subsets, partition, i) == subset ? 1u : 0u) << i;
+            }
+            float sum[16] = {};
+            for (; mask != 0; mask &= mask - 1) {
+                const float* moment = moments[std::countr_zero(mask)];
+                for (int k = 0; k < 16; ++k) {
+                    sum[k] += moment[k];
+                }
+            }
+            for (int k = 0; k < 16; ++k) {
+                sums[subset][k] = sum[k];
+                sums[0][k] -= sum[k];
+            }
+        }
+        float error = 0.0f;
+        for (int subset = 0; subset < subsets; ++subset) {
+            const float* sum = sums[subset];
+            float covariance[4][4] = {};
+            int k = 4;
+            for (int c0 = 0; c0 < 4; ++c0) {
+                for (int c1 = c0; c1 < 4; ++c1) {
+                    covariance[c0][c1] = sum[k++] - sum[c0] * sum[c1] / sum[14];
+                }
+            }
+            error += EstimateLineError(covariance, channels);
+        }
+        estimates[partition] = { error, partition };
+    }
+    count = std::min(count, partitionCount);
+    std::partial_sort(estimates.begin(), estimates.begin() + count, estimates.begin() + partitionCount);
+    for (int i = 0; i < count; ++i) {
+        partitions[i] = estimates[i].second;
+    }
+    return count;
+}
+
+// ---- BC7 ----
+
+/// <summary>
+/// p-bit（端点の全チャンネルの最下位に共通で付くビット）の持ち方
+/// </summary>
+enum class PBitType : uint8_t {
+    None,       // なし
+    Endpoint,   // 端点ごと
+    Shared,     // サブセットの2つの端点で共通
+};
+
+/// <summary>
+/// BC7のモードの構成
+/// </summary>
+struct Bc7ModeInfo {
+    int subsets;                // サブセット数
+    int partitionBits;          // パーティション番号のビット数
+    int rotationBits;           // チャンネル回転（アルファと入れ替えるチャンネル）のビット数
+    int indexSelectionBits;     // インデックス選択（2つのインデックスをカラーとアルファのどちらに使うか）のビット数
+    int colorBits;              // RGBの端点のビット数
+    int alphaBits;              // アルファの端点のビット数（0の場合はアルファなし＝255）
+    PBitType pbits;             // p-bitの持ち方
+    int indexBits;              // 1つ目のインデックスのビット数
+    int secondaryIndexBits;     // 2つ目のインデックスのビット数（0の場合はなし）
+};
+
+constexpr Bc7ModeInfo kBc7Modes[8] = {
+    { 3, 4, 0, 0, 4, 0, PBitType::Endpoint, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, PBitType::Shared,   3, 0 },
+    { 3, 6, 0, 0, 5, 0, PBitType::None,     2, 0 },
+    { 2, 6, 0, 0, 7, 0, PBitType::Endpoint, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, PBitType::None,     2, 3 },
+    { 1, 0, 2, 0, 7, 8, PBitType::None,     2, 2 },
+    { 1, 0, 0, 0, 7, 7, PBitType::Endpoint, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, PBitType::Endpoint, 2, 0 },
+};
+
+/// <summary>
+/// BC7ブロックの内容（ビット列に詰める前の値）
+/// </summary>
+struct Bc7Block {
+    int mode = 0;                           // モード
+    int partition = 0;                      // パーティション番号
+    int rotation = 0;                       // アルファと入れ替えるチャンネル（0: なし、1: R、2: G、3: B）
+    int indexSelection = 0;                 // 1の場合、1つ目のインデックスをアルファ、2つ目をカラーに使う（モード4）
+    uint8_t endpoints[3][2][4] = {};        // サブセット・端点・チャンネルごとの量子化値（p-bitを含まない）
+    uint8_t pbits[3][2] = {};               // サブセット・端点ごとのp-bit
+    uint8_t indices[16] = {};               // 1つ目のインデックス
+    uint8_t secondaryIndices[16] = {};      // 2つ目のインデックス（モード4/5）
+};
+
+int ExpandBc7Endpoint(int value, int bits, int pbit) {
+    if (pbit >= 0) {
+        value = (value << 1) | pbit;
+        ++bits;
+    }
+    value <<= 8 - bits;
+    return value | (value >> bits);
+}
+
+int QuantizeBc7Endpoint(float value, int bits, int pbit) {
+    const int maxValue = (1 << bits) - 1;
+    const int totalBits = bits + (pbit >= 0 ? 1 : 0);
+    const float scaled = value * static_cast<float>((1 << totalBits) - 1) / 255.0f;
+    const int center = pbit >= 0 ? static_cast<int>(std::floor((scaled - static_cast<float>(pbit)) * 0.5f + 0.5f))
+                                 : static_cast<int>(scaled + 0.5f);
+    // 展開時のビットの複製で丸めがずれるため、隣の値も確かめる
+    int best = std::clamp(center, 0, maxValue);
+    float bestError = std::abs(static_cast<float>(ExpandBc7Endpoint(best, bits, pbit)) - value);
+    for (int candidate = center - 1; candidate <= center + 1; candidate += 2) {
+        if (candidate >= 0 && candidate <= maxValue) {
+            const float error = std::abs(static_cast<float>(ExpandBc7Endpoint(candidate, bits, pbit)) - value);
+            if (error < bestError) {
+                bestError = error;
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+void PackBc7Block(const Bc7Block& block, uint8_t* output) {
+    const Bc7ModeInfo& info = kBc7Modes[block.mode];
+    BlockBitWriter writer(output);
+    writer.Write(1u << block.mode, block.mode + 1);
+    writer.Write(static_cast<uint32_t>(block.partition), info.partitionBits);
+    writer.Write(static_cast<uint32_t>(block.rotation), info.rotationBits);
+    writer.Write(static_cast<uint32_t>(block.indexSelection), info.indexSelectionBits);
+    for (int c = 0; c < 4; ++c) {
+        const int bits = c < 3 ? info.colorBits : info.alphaBits;
+        for (int subset = 0; subset < info.subsets; ++subset) {
+            writer.Write(block.endpoints[subset][0][c], bits);
+            writer.Write(block.endpoints[subset][1][c], bits);
+        }
+    }
+    for (int subset = 0; subset < info.subsets; ++subset) {
+        if (info.pbits == PBitType::Endpoint) {
+            writer.Write(block.pbits[subset][0], 1);
+            writer.Write(block.pbits[subset][1], 1);
+        }
+        else if (info.pbits == PBitType::Shared) {
+            writer.Write(block.pbits[subset][0], 1);
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        writer.Write(block.indices[i], info.indexBits - (IsAnchor(info.subsets, block.partition, i) ? 1 : 0));
+    }
+    for (int i = 0; i < 16 && info.secondaryIndexBits != 0; ++i) {
+        writer.Write(block.secondaryIndices[i], info.secondaryIndexBits - (i == 0 ? 1 : 0));
+    }
+}
+
+bool UnpackBc7Block(const uint8_t* input, Bc7Block& block) {
+    BlockBitReader reader(input);
+    block.mode = 0;
+    while (block.mode < 8 && reader.Read(1) == 0) {
+        ++block.mode;
+    }
+    if (block.mode == 8) {
+        return false;
+    }
+    const Bc7ModeInfo& info = kBc7Modes[block.mode];
+    block.partition = static_cast<int>(reader.Read(info.partitionBits));
+    block.rotation = static_cast<int>(reader.Read(info.rotationBits));
+    block.indexSelection = static_cast<int>(reader.Read(info.indexSelectionBits));
+    for (int c = 0; c < 4; ++c) {
+        const int bits = c < 3 ? info.colorBits : info.alphaBits;
+        for (int subset = 0; subset < info.subsets; ++subset) {
+            block.endpoints[subset][0][c] = static_cast<uint8_t>(reader.Read(bits));
+            block.endpoints[subset][1][c] = static_cast<uint8_t>(reader.Read(bits));
+        }
+    }
+    for (int subset = 0; subset < info.subsets; ++subset) {
+        if (info.pbits == PBitType::Endpoint) {
+            block.pbits[subset][0] = static_cast<uint8_t>(reader.Read(1));
+            block.pbits[subset][1] = static_cast<uint8_t>(reader.Read(1));
+        }
+        else if (info.pbits == PBitType::Shared) {
+            block.pbits[subset][0] = block.pbits[subset][1] = static_cast<uint8_t>(reader.Read(1));
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        block.indices[i] = static_cast<uint8_t>(reader.Read(info.indexBits - (IsAnchor(info.subsets, block.partition, i) ? 1 : 0)));
+    }
+    for (int i = 0; i < 16 && info.secondaryIndexBits != 0; ++i) {
+        block.secondaryIndices[i] = static_cast<uint8_t>(reader.Read(info.secondaryIndexBits - (i == 0 ? 1 : 0)));
+    }
+    return true;
+}
+
+void DecodeBc7(const Bc7Block& block, uint8_t* pixels) {
+    const Bc7ModeInfo& info = kBc7Modes[block.mode];
+    int endpoints[3][2][4];
+    for (int subset = 0; subset < info.subsets; ++subset) {
+        for (int e = 0; e < 2; ++e) {
+            const int pbit = info.pbits == PBitType::None ? -1 : block.pbits[subset][e];
+            for (int c = 0; c < 3; ++c) {
+                endpoints[subset][e][c] = ExpandBc7Endpoint(block.endpoints[subset][e][c], info.colorBits, pbit);
+            }
+            endpoints[subset][e][3] = info.alphaBits != 0 ? ExpandBc7Endpoint(block.endpoints[subset][e][3], info.alphaBits, pbit) : 255;
+        }
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        const int subset = GetSubset(info.subsets, block.partition, i);
+        const int* e0 = endpoints[subset][0];
+        const int* e1 = endpoints[subset][1];
+        int colorWeight = GetWeights(info.indexBits)[block.indices[i]];
+        int alphaWeight = colorWeight;
+        if (info.secondaryIndexBits != 0) {
+            const int secondaryWeight = GetWeights(info.secondaryIndexBits)[block.secondaryIndices[i]];
+            (block.indexSelection ? colorWeight : alphaWeight) = secondaryWeight;
+        }
+        uint8_t* pixel = pixels + i * 4;
+        for (int c = 0; c < 3; ++c) {
+            pixel[c] = static_cast<uint8_t>(Interpolate(e0[c], e1[c], colorWeight));
+        }
+        pixel[3] = static_cast<uint8_t>(Interpolate(e0[3], e1[3], alphaWeight));
+        if (block.rotation != 0) {
+            std::swap(pixel[3], pixel[block.rotation - 1]);
+        }
+    }
+}
+
+/// <summary>
+/// 1つのサブセットの、同じインデックスで補間されるチャンネルの組の圧縮設定
+/// </summary>
+struct SubsetParams {
+    int channelBegin = 0;       // 対象のチャンネルの範囲
+    int channelEnd = 0;
+    int colorBits = 0;          // RGBの端点のビット数
+    int alphaBits = 0;          // アルファの端点のビット数
+    PBitType pbits = PBitType::None;    // p-bitの持ち方
+    int indexBits = 0;          // インデックスのビット数
+    int refineIterations = 0;   // 端点を合わせ直す回数
+};
+
+/// <summary>
+/// 量子化済みの端点でインデックスを選び、二乗誤差の合計を返す
+/// </summary>
+float SelectBc7Indices(const float (*pixels)[4], const uint8_t* members, int count, const SubsetParams& params,
+                       const uint8_t endpoints[2][4], const int pbits[2], uint8_t* indices) {
+    int expanded[2][4] = {};
+    for (int e = 0; e < 2; ++e) {
+        for (int c = params.channelBegin; c < params.channelEnd; ++c) {
+            expanded[e][c] = ExpandBc7Endpoint(endpoints[e][c], c < 3 ? params.colorBits : params.alphaBits, pbits[e]);
+        }
+    }
+    const int* weights = GetWeights(params.indexBits);
+    const int paletteSize = 1 << params.indexBits;
+    float palette[16][4] = {};
+    for (int k = 0; k < paletteSize; ++k) {
+        for (int c = params.channelBegin; c < params.channelEnd; ++c) {
+            palette[k][c] = static_cast<float>(Interpolate(expanded[0][c], expanded[1][c], weights[k]));
+        }
+    }
+
+    float direction[4] = {};
+    GetPaletteDirection(palette, paletteSize, params.channelBegin, params.channelEnd, direction);
+
+    float error = 0.0f;
+    for (int m = 0; m < count; ++m) {
+        float distance = 0.0f;
+        indices[members[m]] = static_cast<uint8_t>(FindNearestPaletteIndex(pixels[members[m]], palette, paletteSize,
+                                                                            params.channelBegin, params.channelEnd, direction, distance));
+        error += distance;
+    }
+    return error;
+}
+
+/// <summary>
+/// 1つのサブセットを圧縮し、二乗誤差の合計を返す（endpoints・pbits・indicesは対象のチャンネル・ピクセルのみ書き込む）
+/// </summary>
+float EncodeBc7Subset(const float (*pixels)[4], const uint8_t* members, int count, int anchor, const SubsetParams& params,
+                      uint8_t endpoints[2][4], uint8_t pbits[2], uint8_t* indices) {
+    if (count == 0) {
+        return 0.0f;
+    }
+    float ends[2][4] = {};
+    FitEndpoints(pixels, members, count, anchor, params.channelBegin, params.channelEnd, 255.0f, ends);
+
+    float bestError = std::numeric_limits<float>::max();
+    uint8_t candidateIndices[16];
+    for (int iteration = 0; ; ++iteration) {
+        // p-bitの候補（端点ごとの場合は端点の量子化誤差の小さい方、共通の場合は両方を試す）
+        int pbitCandidates[2][2] = { { -1, -1 }, { -1, -1 } };
+        int candidateCount = 1;
+        if (params.pbits == PBitType::Endpoint) {
+            for (int e = 0; e < 2; ++e) {
+                float errors[2] = {};
+                for (int pbit = 0; pbit < 2; ++pbit) {
+                    for (int c = params.channelBegin; c < params.channelEnd; ++c) {
+                        const int bits = c < 3 ? params.colorBits : params.alphaBits;
+                        const float d = static_cast<float>(ExpandBc7Endpoint(QuantizeBc7Endpoint(ends[e][c], bits, pbit), bits, pbit)) - ends[e][c];
+                        errors[pbit] += d * d;
+                    }
+                }
+                pbitCandidates[0][e] = errors[1] < errors[0] ? 1 : 0;
+            }
+        }
+        else if (params.pbits == PBitType::Shared) {
+            pbitCandidates[0][0] = pbitCandidates[0][1] = 0;
+            pbitCandidates[1][0] = pbitCandidates[1][1] = 1;
+            candidateCount = 2;
+        }
+
+        for (int candidate = 0; candidate < candidateCount; ++candidate) {
+            const int* pbit = pbitCandidates[candidate];
+            uint8_t quantized[2][4] = {};
+            for (int e = 0; e < 2; ++e) {
+                for (int c = params.channelBegin; c < params.channelEnd; ++c) {
+                    quantized[e][c] = static_cast<uint8_t>(QuantizeBc7Endpoint(ends[e][c], c < 3 ? params.colorBits : params.alphaBits, pbit[e]));
+                }
+            }
+            const float error = SelectBc7Indices(pixels, members, count, params, quantized, pbit, candidateIndices);
+            if (error < bestError) {
+                bestError = error;
+                for (int e = 0; e < 2; ++e) {
+                    for (int c = params.channelBegin; c < params.channelEnd; ++c) {
+                        endpoints[e][c] = quantized[e][c];
+                    }
+                    pbits[e] = static_cast<uint8_t>(std::max(pbit[e], 0));
+                }
+                for (int m = 0; m < count; ++m) {
+                    indices[members[m]] = candidateIndices[members[m]];
+                }
+            }
+        }
+
+        if (iteration == params.refineIterations || bestError == 0.0f
+            || !RefitEndpoints(pixels, members, count, indices, params.indexBits, params.channelBegin, params.channelEnd, 255.0f, ends)) {
+            break;
+        }
+    }
+    return bestError;
+}
+
+/// <summary>
+/// アンカーのインデックスの最上位ビットが立っている場合は端点を入れ替えてインデックスを反転する
+/// （重みは端点について対称なので展開結果は変わらない）
+/// </summary>
+void FixBc7Anchors(Bc7Block& block) {
+    const Bc7ModeInfo& info = kBc7Modes[block.mode];
+    const auto flip = [&block](uint8_t* indices, int indexBits, int subset, int channelBegin, int channelEnd, bool allPixels) {
+        const int maxIndex = (1 << indexBits) - 1;
+        for (int c = channelBegin; c < channelEnd; ++c) {
+            std::swap(block.endpoints[subset][0][c], block.endpoints[subset][1][c]);
+        }
+        for (int i = 0; i < 16; ++i) {
+            if (allPixels || GetSubset(kBc7Modes[block.mode].subsets, block.partition, i) == subset) {
+                indices[i] = static_cast<uint8_t>(maxIndex - indices[i]);
+            }
+        }
+    };
+
+    if (info.secondaryIndexBits == 0) {
+        for (int subset = 0; subset < info.subsets; ++subset) {
+            if ((block.indices[GetAnchor(info.subsets, block.partition, subset)] >> (info.indexBits - 1)) != 0) {
+                flip(block.indices, info.indexBits, subset, 0, 4, false);
+                std::swap(block.pbits[subset][0], block.pbits[subset][1]);
+            }
+        }
+        return;
+    }
+
+    // モード4/5はカラーとアルファのインデックスが別々（1サブセットなのでアンカーはピクセル0のみ）
+    const bool primaryIsAlpha = block.indexSelection != 0;
+    if ((block.indices[0] >> (info.indexBits - 1)) != 0) {
+        flip(block.indices, info.indexBits, 0, primaryIsAlpha ? 3 : 0, primaryIsAlpha ? 4 : 3, true);
+    }
+    if ((block.secondaryIndices[0] >> (info.secondaryIndexBits - 1)) != 0) {
+        flip(block.secondaryIndices, info.secondaryIndexBits, 0, primaryIsAlpha ? 0 : 3, primaryIsAlpha ? 3 : 4, true);
+    }
+}
+
+/// <summary>
+/// モード・パーティションの組み合わせを試して最も誤差の小さいBC7ブロックを選ぶエンコーダ
+/// </summary>
+class Bc7Encoder {
+public:
+    Bc7Encoder(const uint8_t* pixels, BlockQuality quality)
+        : m_quality(quality) {
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                m_pixels[i][c] = static_cast<float>(pixels[i * 4 + c]);
+            }
+            m_opaque = m_opaque && pixels[i * 4 + 3] == 255;
+        }
+    }
+
+    void Encode(uint8_t* output) {
+        TryMode(6, 0, 0, 0);
+        if (m_quality == BlockQuality::High) {
+            // モード4/5はアルファと入れ替えるチャンネルごとに試す（不透明なブロックでも1チャンネルを独立に表せる）
+            for (int rotation = 0; rotation < 4; ++rotation) {
+                TryMode(5, 0, rotation, 0);
+                TryMode(4, 0, rotation, 0);
+                TryMode(4, 0, rotation, 1);
+            }
+            for (int partition = 0; partition < 64; ++partition) {
+                if (m_opaque) {
+                    TryMode(1, partition, 0, 0);
+                    TryMode(3, partition, 0, 0);
+                    TryMode(2, partition, 0, 0);
+                    if (partition < 16) {
+                        TryMode(0, partition, 0, 0);
+                    }
+                }
+                else {
+                    TryMode(7, partition, 0, 0);
+                }
+            }
+        }
+        else if (m_bestError > kBc7FastSkipError) {
+            // モード0〜3はアルファを持たないため、不透明なブロックのみで使う
+            int partitions[kFastPartitionCandidates];
+            const int count = FindBestPartitions(m_pixels, m_opaque ? 3 : 4, 2, 64, partitions, kFastPartitionCandidates);
+            if (!m_opaque) {
+                TryMode(5, 0, 0, 0);
+            }
+            for (int i = 0; i < count; ++i) {
+                if (m_opaque) {
+                    TryMode(1, partitions[i], 0, 0);
+                    TryMode(3, partitions[i], 0, 0);
+                }
+                else {
+                    TryMode(7, partitions[i], 0, 0);
+                }
+            }
+        }
+        PackBc7Block(m_best, output);
+    }
+
+private:
+    void TryMode(int mode, int partition, int rotation, int indexSelection) {
+        const Bc7ModeInfo& info = kBc7Modes[mode];
+        float pixels[16][4];
+        std::memcpy(pixels, m_pixels, sizeof(pixels));
+        if (rotation != 0) {
+            for (auto& pixel : pixels) {
+                std::swap(pixel[3], pixel[rotation - 1]);
+            }
+        }
+
+        Bc7Block candidate;
+        candidate.mode = mode;
+        candidate.partition = partition;
+        candidate.rotation = rotation;
+        candidate.indexSelection = indexSelection;
+        uint8_t members[3][16];
+        int counts[3] = {};
+        for (int i = 0; i < 16; ++i) {
+            const int subset = GetSubset(info.subsets, partition, i);
+            members[subset][counts[subset]++] = static_cast<uint8_t>(i);
+        }
+
+        const int refineIterations = m_quality == BlockQuality::High ? 2 : 1;
+        float error = 0.0f;
+        for (int subset = 0; subset < info.subsets && error < m_bestError; ++subset) {
+            const int anchor = GetAnchor(info.subsets, partition, subset);
+            if (info.secondaryIndexBits == 0) {
+                const SubsetParams params{ 0, info.alphaBits != 0 ? 4 : 3, info.colorBits, info.alphaBits, info.pbits, info.indexBits, refineIterations };
+                error += EncodeBc7Subset(pixels, members[subset], counts[subset], anchor, params,
+                                         candidate.endpoints[subset], candidate.pbits[subset], candidate.indices);
+                if (info.alphaBits == 0) {
+                    for (int m = 0; m < counts[subset]; ++m) {
+                        const float d = 255.0f - pixels[members[subset][m]][3];
+                        error += d * d;
+                    }
+                }
+            }
+            else {
+                const int colorIndexBits = indexSelection ? info.secondaryIndexBits : info.indexBits;
+                const int alphaIndexBits = indexSelection ? info.indexBits : info.secondaryIndexBits;
+                uint8_t* colorIndices = indexSelection ? candidate.secondaryIndices : candidate.indices;
+                uint8_t* alphaIndices = indexSelection ? candidate.indices : candidate.secondaryIndices;
+                const SubsetParams colorParams{ 0, 3, info.colorBits, info.alphaBits, PBitType::None, colorIndexBits, refineIterations };
+                const SubsetParams alphaParams{ 3, 4, info.colorBits, info.alphaBits, PBitType::None, alphaIndexBits, refineIterations };
+                error += EncodeBc7Subset(pixels, members[0], counts[0], anchor, colorParams, candidate.endpoints[0], candidate.pbits[0], colorIndices);
+                error += EncodeBc7Subset(pixels, members[0], counts[0], anchor, alphaParams, candidate.endpoints[0], candidate.pbits[0], alphaIndices);
+            }
+        }
+        if (error < m_bestError) {
+            FixBc7Anchors(candidate);
+            m_best = candidate;
+            m_bestError = error;
+        }
+    }
+
+    float m_pixels[16][4] = {};                                     // 圧縮するブロック
+    bool m_opaque = true;                                           // すべてのピクセルのアルファが255か
+    BlockQuality m_quality;                                         // 圧縮品質
+    Bc7Block m_best;                                                // これまでで最も誤差の小さいブロック
+    float m_bestError = std::numeric_limits<float>::max();          // その二乗誤差の合計
+};
+
+// ---- BC6H ----
+
+/// <summary>
+/// BC6Hのモードの構成
+/// </summary>
+struct Bc6hModeInfo {
+    int number;                 // 仕様書のモード番号（1〜14）
+    uint32_t modeValue;         // モードを表すビット列の値
+    int modeBits;               // モードのビット数
+    int regions;                // 領域数
+    bool transformed;           // 端点0以外を端点0からの差分で格納するか
+    int endpointBits;           // 端点0のビット数
+    int deltaBits[3];           // 端点0以外のビット数（RGB）
+    const char* layout;         // モードに続く端点のビットの並び（仕様書の表の順。[a:b]はbからaへ順に格納する）
+};
+
+// 端点はw = r0/g0/b0、x = r1...（領域0）、y = r2...、z = r3...（領域1）
+constexpr Bc6hModeInfo kBc6hModes[14] = {
+    { 1, 0x00, 2, 2, true, 10, { 5, 5, 5 },
+      "g2[4],b2[4],b3[4],r0[9:0],g0[9:0],b0[9:0],r1[4:0],g3[4],g2[3:0],g1[4:0],b3[0],g3[3:0],b1[4:0],b3[1],b2[3:0],"
+      "r2[4:0],b3[2],r3[4:0],b3[3]" },
+    { 2, 0x01, 2, 2, true, 7, { 6, 6, 6 },
+      "g2[5],g3[4],g3[5],r0[6:0],b3[0],b3[1],b2[4],g0[6:0],b2[5],b3[2],g2[4],b0[6:0],b3[3],b3[5],b3[4],r1[5:0],g2[3:0],"
+      "g1[5:0],g3[3:0],b1[5:0],b2[3:0],r2[5:0],r3[5:0]" },
+    { 3, 0x02, 5, 2, true, 11, { 5, 4, 4 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[4:0],r0[10],g2[3:0],g1[3:0],g0[10],b3[0],g3[3:0],b1[3:0],b0[10],b3[1],b2[3:0],"
+      "r2[4:0],b3[2],r3[4:0],b3[3]" },
+    { 4, 0x06, 5, 2, true, 11, { 4, 5, 4 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[3:0],r0[10],g3[4],g2[3:0],g1[4:0],g0[10],g3[3:0],b1[3:0],b0[10],b3[1],b2[3:0],"
+      "r2[3:0],b3[0],b3[2],r3[3:0],g2[4],b3[3]" },
+    { 5, 0x0A, 5, 2, true, 11, { 4, 4, 5 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[3:0],r0[10],b2[4],g2[3:0],g1[3:0],g0[10],b3[0],g3[3:0],b1[4:0],b0[10],b2[3:0],"
+      "r2[3:0],b3[1],b3[2],r3[3:0],b3[4],b3[3]" },
+    { 6, 0x0E, 5, 2, true, 9, { 5, 5, 5 },
+      "r0[8:0],b2[4],g0[8:0],g2[4],b0[8:0],b3[4],r1[4:0],g3[4],g2[3:0],g1[4:0],b3[0],g3[3:0],b1[4:0],b3[1],b2[3:0],"
+      "r2[4:0],b3[2],r3[4:0],b3[3]" },
+    { 7, 0x12, 5, 2, true, 8, { 6, 5, 5 },
+      "r0[7:0],g3[4],b2[4],g0[7:0],b3[2],g2[4],b0[7:0],b3[3],b3[4],r1[5:0],g2[3:0],g1[4:0],b3[0],g3[3:0],b1[4:0],"
+      "b3[1],b2[3:0],r2[5:0],r3[5:0]" },
+    { 8, 0x16, 5, 2, true, 8, { 5, 6, 5 },
+      "r0[7:0],b3[0],b2[4],g0[7:0],g2[5],g2[4],b0[7:0],g3[5],b3[4],r1[4:0],g3[4],g2[3:0],g1[5:0],g3[3:0],b1[4:0],"
+      "b3[1],b2[3:0],r2[4:0],b3[2],r3[4:0],b3[3]" },
+    { 9, 0x1A, 5, 2, true, 8, { 5, 5, 6 },
+      "r0[7:0],b3[1],b2[4],g0[7:0],b2[5],g2[4],b0[7:0],b3[5],b3[4],r1[4:0],g3[4],g2[3:0],g1[4:0],b3[0],g3[3:0],"
+      "b1[5:0],b2[3:0],r2[4:0],b3[2],r3[4:0],b3[3]" },
+    { 10, 0x1E, 5, 2, false, 6, { 6, 6, 6 },
+      "r0[5:0],g3[4],b3[0],b3[1],b2[4],g0[5:0],g2[5],b2[5],b3[2],g2[4],b0[5:0],g3[5],b3[3],b3[5],b3[4],r1[5:0],"
+      "g2[3:0],g1[5:0],g3[3:0],b1[5:0],b2[3:0],r2[5:0],r3[5:0]" },
+    { 11, 0x03, 5, 1, false, 10, { 10, 10, 10 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[9:0],g1[9:0],b1[9:0]" },
+    { 12, 0x07, 5, 1, true, 11, { 9, 9, 9 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[8:0],r0[10],g1[8:0],g0[10],b1[8:0],b0[10]" },
+    { 13, 0x0B, 5, 1, true, 12, { 8, 8, 8 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[7:0],r0[10:11],g1[7:0],g0[10:11],b1[7:0],b0[10:11]" },
+    { 14, 0x0F, 5, 1, true, 16, { 4, 4, 4 },
+      "r0[9:0],g0[9:0],b0[9:0],r1[3:0],r0[10:15],g1[3:0],g0[10:15],b1[3:0],b0[10:15]" },
+};
+
+/// <summary>
+/// 端点の1ビット分の格納位置
+/// </summary>
+struct Bc6hField {
+    uint8_t endpoint;   // 端点（0〜3）
+    uint8_t channel;    // チャンネル（0〜2）
+    uint8_t bit;        // ビット位置
+};
+
+std::vector<Bc6hField> ParseBc6hLayout(std::string_view layout) {
+    std::vector<Bc6hField> fields;
+    size_t position = 0;
+    const auto readNumber = [&layout, &position] {
+        int value = 0;
+        while (position < layout.size() && layout[position] >= '0' && layout[position] <= '9') {
+            value = value * 10 + (layout[position++] - '0');
+        }
+        return value;
+    };
+    while (position < layout.size()) {
+        const uint8_t channel = static_cast<uint8_t>(layout[position] == 'r' ? 0 : layout[position] == 'g' ? 1 : 2);
+        const uint8_t endpoint = static_cast<uint8_t>(layout[position + 1] - '0');
+        position += 3;
+        const int first = readNumber();
+        int last = first;
+        if (layout[position] == ':') {
+            ++position;
+            last = readNumber();
+        }
+        position += 2;      // "]," を読み飛ばす
+        const int step = first >= last ? 1 : -1;
+        for (int bit = last; ; bit += step) {
+            fields.push_back({ endpoint, channel, static_cast<uint8_t>(bit) });
+            if (bit == first) {
+                break;
+            }
+        }
+    }
+    return fields;
+}
+
+const std::vector<Bc6hField>& GetBc6hLayout(int modeIndex) {
+    static const std::array<std::vector<Bc6hField>, 14> layouts = [] {
+        std::array<std::vector<Bc6hField>, 14> result;
+        for (int i = 0; i < 14; ++i) {
+            result[i] = ParseBc6hLayout(kBc6hModes[i].layout);
+        }
+        return result;
+    }();
+    return layouts[modeIndex];
+}
+
+int FindBc6hMode(uint32_t modeValue, int modeBits) {
+    for (int i = 0; i < 14; ++i) {
+        if (kBc6hModes[i].modeBits == modeBits && kBc6hModes[i].modeValue == modeValue) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int ReadBc6hMode(const uint8_t* block) {
+    BlockBitReader reader(block);
+    uint32_t modeValue = reader.Read(2);
+    if (modeValue < 2) {
+        return FindBc6hMode(modeValue, 2);
+    }
+    modeValue |= reader.Read(3) << 2;
+    return FindBc6hMode(modeValue, 5);
+}
+
+/// <summary>
+/// 量子化された端点を16bitに戻す（符号なし）
+/// </summary>
+int UnquantizeBc6h(int value, int bits) {
+    if (bits >= 15 || value == 0) {
+        return value;
+    }
+    if (value == (1 << bits) - 1) {
+        return 0xFFFF;
+    }
+    return ((value << 16) + 0x8000) >> bits;
+}
+
+/// <summary>
+/// 補間した16bitの値を半精度浮動小数点のビット列にする（符号なし）
+/// </summary>
+int FinishBc6h(int value) {
+    return (value * 31) >> 6;
+}
+
+/// <summary>
+/// 半精度のビット列の値に最も近く展開される量子化値を求める
+/// </summary>
+int QuantizeBc6hEndpoint(float value, int bits) {
+    const int maxValue = (1 << bits) - 1;
+    const float unquantized = value * (64.0f / 31.0f);
+    const int center = bits >= 15 ? static_cast<int>(unquantized + 0.5f) : static_cast<int>(unquantized) >> (16 - bits);
+    int best = std::clamp(center, 0, maxValue);
+    float bestError = std::abs(static_cast<float>(FinishBc6h(UnquantizeBc6h(best, bits))) - value);
+    for (int candidate = center - 1; candidate <= center + 1; candidate += 2) {
+        if (candidate >= 0 && candidate <= maxValue) {
+            const float error = std::abs(static_cast<float>(FinishBc6h(UnquantizeBc6h(candidate, bits))) - value);
+            if (error < bestError) {
+                bestError = error;
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+/// <summary>
+/// BC6Hブロックの内容（ビット列に詰める前の値）
+/// </summary>
+struct Bc6hBlock {
+    int modeIndex = 10;                     // kBc6hModesの位置
+    int partition = 0;                      // パーティション番号
+    int endpoints[4][3] = {};               // 量子化値（差分に変換する前の値）
+    uint8_t indices[16] = {};               // インデックス
+    float error = std::numeric_limits<float>::max();    // 二乗誤差の合計
+};
+
+bool DeltasFit(const Bc6hBlock& block) {
+    const Bc6hModeInfo& info = kBc6hModes[block.modeIndex];
+    if (!info.transformed) {
+        return true;
+    }
+    for (int e = 1; e < info.regions * 2; ++e) {
+        for (int c = 0; c < 3; ++c) {
+            const int limit = 1 << (info.deltaBits[c] - 1);
+            const int delta = block.endpoints[e][c] - block.endpoints[0][c];
+            if (delta < -limit || delta >= limit) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void PackBc6hBlock(const Bc6hBlock& block, uint8_t* output) {
+    const Bc6hModeInfo& info = kBc6hModes[block.modeIndex];
+    int stored[4][3];
+    for (int e = 0; e < info.regions * 2; ++e) {
+        for (int c = 0; c < 3; ++c) {
+            stored[e][c] = (info.transformed && e != 0)
+                ? (block.endpoints[e][c] - block.endpoints[0][c]) & ((1 << info.deltaBits[c]) - 1)
+                : block.endpoints[e][c];
+        }
+    }
+    BlockBitWriter writer(output);
+    writer.Write(info.modeValue, info.modeBits);
+    for (const Bc6hField& field : GetBc6hLayout(block.modeIndex)) {
+        writer.Write(static_cast<uint32_t>(stored[field.endpoint][field.channel] >> field.bit) & 1u, 1);
+    }
+    const int indexBits = info.regions == 2 ? 3 : 4;
+    if (info.regions == 2) {
+        writer.Write(static_cast<uint32_t>(block.partition), 5);
+    }
+    for (int i = 0; i < 16; ++i) {
+        writer.Write(block.indices[i], indexBits - (IsAnchor(info.regions, block.partition, i) ? 1 : 0));
+    }
+}
+
+bool UnpackBc6hBlock(const uint8_t* input, Bc6hBlock& block) {
+    block.modeIndex = ReadBc6hMode(input);
+    if (block.modeIndex < 0) {
+        return false;
+    }
+    const Bc6hModeInfo& info = kBc6hModes[block.modeIndex];
+    BlockBitReader reader(input);
+    reader.Read(info.modeBits);
+    int stored[4][3] = {};
+    for (const Bc6hField& field : GetBc6hLayout(block.modeIndex)) {
+        stored[field.endpoint][field.channel] |= static_cast<int>(reader.Read(1)) << field.bit;
+    }
+    block.partition = info.regions == 2 ? static_cast<int>(reader.Read(5)) : 0;
+    const int indexBits = info.regions == 2 ? 3 : 4;
+    for (int i = 0; i < 16; ++i) {
+        block.indices[i] = static_cast<uint8_t>(reader.Read(indexBits - (IsAnchor(info.regions, block.partition, i) ? 1 : 0)));
+    }
+
+    const int mask = (1 << info.endpointBits) - 1;
+    for (int e = 0; e < info.regions * 2; ++e) {
+        for (int c = 0; c < 3; ++c) {
+            int value = stored[e][c];
+            if (info.transformed && e != 0) {
+                // 差分を符号拡張して端点0に足す
+                const int signBit = 1 << (info.deltaBits[c] - 1);
+                value = (stored[0][c] + ((value ^ signBit) - signBit)) & mask;
+            }
+            block.endpoints[e][c] = value;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// 量子化済みの端点でインデックスを選び、block.errorに二乗誤差の合計を設定する
+/// </summary>
+void SelectBc6hIndices(const float (*pixels)[4], Bc6hBlock& block) {
+    const Bc6hModeInfo& info = kBc6hModes[block.modeIndex];
+    const int indexBits = info.regions == 2 ? 3 : 4;
+    const int paletteSize = 1 << indexBits;
+    const int* weights = GetWeights(indexBits);
+    float palette[2][16][4] = {};
+    float directions[2][4] = {};
+    for (int region = 0; region < info.regions; ++region) {
+        for (int c = 0; c < 3; ++c) {
+            const int e0 = UnquantizeBc6h(block.endpoints[region * 2][c], info.endpointBits);
+            const int e1 = UnquantizeBc6h(block.endpoints[region * 2 + 1][c], info.endpointBits);
+            for (int k = 0; k < paletteSize; ++k) {
+                palette[region][k][c] = static_cast<float>(FinishBc6h(Interpolate(e0, e1, weights[k])));
+            }
+        }
+        GetPaletteDirection(palette[region], paletteSize, 0, 3, directions[region]);
+    }
+
+    block.error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        const int region = GetSubset(info.regions, block.partition, i);
+        float distance = 0.0f;
+        block.indices[i] = static_cast<uint8_t>(FindNearestPaletteIndex(pixels[i], palette[region], paletteSize, 0, 3, directions[region], distance));
+        block.error += distance;
+    }
+}
+
+/// <summary>
+/// モード・パーティションの組み合わせを試して最も誤差の小さいBC6Hブロックを選ぶエンコーダ
+/// 誤差は半精度のビット列の差で測る（指数部を含むため相対誤差に近く、暗い部分と明るい部分を同じ重みで扱える）
+/// </summary>
+class Bc6hEncoder {
+public:
+    Bc6hEncoder(const uint16_t* pixels, BlockQuality quality)
+        : m_quality(quality) {
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                const int value = pixels[i * 3 + c];
+                // 符号なしの形式で表せない負の値とNaNは0、無限大は最大値にする
+                const int clamped = (value & 0x8000) != 0 ? 0 : value == 0x7C00 ? kMaxHalf : value > 0x7C00 ? 0 : value;
+                m_pixels[i][c] = static_cast<float>(clamped);
+            }
+        }
+    }
+
+    void Encode(uint8_t* output) {
+        const int refineIterations = m_quality == BlockQuality::High ? 2 : 1;
+        EncodePartition(1, 0, refineIterations);
+        if (m_quality == BlockQuality::High) {
+            for (int partition = 0; partition < 32; ++partition) {
+                EncodePartition(2, partition, refineIterations);
+            }
+        }
+        else if (m_best.error > kBc6hFastSkipError) {
+            int partitions[kFastPartitionCandidates];
+            const int count = FindBestPartitions(m_pixels, 3, 2, 32, partitions, kFastPartitionCandidates);
+            for (int i = 0; i < count; ++i) {
+                EncodePartition(2, partitions[i], refineIterations);
+            }
+        }
+        PackBc6hBlock(m_best, output);
+    }
+
+private:
+    /// <summary>
+    /// 領域数が同じすべてのモードを試し、最も良いモードの結果で端点を合わせ直して再び試す
+    /// （合わせ直した後に試すのは、Fastでは最も良いモードのみ、Highではすべてのモード）
+    /// </summary>
+    void EncodePartition(int regions, int partition, int refineIterations) {
+        uint8_t members[2][16];
+        int counts[2] = {};
+        for (int i = 0; i < 16; ++i) {
+            const int region = GetSubset(regions, partition, i);
+            members[region][counts[region]++] = static_cast<uint8_t>(i);
+        }
+        float ends[2][2][4] = {};
+        for (int region = 0; region < regions; ++region) {
+            FitEndpoints(m_pixels, members[region], counts[region], GetAnchor(regions, partition, region), 0, 3,
+                         static_cast<float>(kMaxHalf), ends[region]);
+        }
+
+        Bc6hBlock best;
+        for (int iteration = 0; ; ++iteration) {
+            if (iteration > 0 && m_quality == BlockQuality::Fast) {
+                TryMode(best.modeIndex, partition, ends, best);
+            }
+            else {
+                for (int modeIndex = 0; modeIndex < 14; ++modeIndex) {
+                    if (kBc6hModes[modeIndex].regions == regions) {
+                        TryMode(modeIndex, partition, ends, best);
+                    }
+                }
+            }
+            if (iteration == refineIterations || best.error == 0.0f || best.error == std::numeric_limits<float>::max()) {
+                break;
+            }
+            bool refitted = false;
+            for (int region = 0; region < regions; ++region) {
+                if (RefitEndpoints(m_pixels, members[region], counts[region], best.indices, regions == 2 ? 3 : 4, 0, 3,
+                                   static_cast<float>(kMaxHalf), ends[region])) {
+                    refitted = true;
+                }
+            }
+            if (!refitted) {
+                break;
+            }
+        }
+        if (best.error < m_best.error) {
+            m_best = best;
+        }
+    }
+
+    void TryMode(int modeIndex, int partition, const float ends[2][2][4], Bc6hBlock& best) const {
+        const Bc6hModeInfo& info = kBc6hModes[modeIndex];
+        Bc6hBlock candidate;
+        candidate.modeIndex = modeIndex;
+        candidate.partition = partition;
+        for (int region = 0; region < info.regions; ++region) {
+            for (int e = 0; e < 2; ++e) {
+                for (int c = 0; c < 3; ++c) {
+                    candidate.endpoints[region * 2 + e][c] = QuantizeBc6hEndpoint(ends[region][e][c], info.endpointBits);
+                }
+            }
+        }
+        if (info.transformed) {
+            // 差分のビット数に収まらない端点は端点0へ寄せる
+            for (int e = 1; e < info.regions * 2; ++e) {
+                for (int c = 0; c < 3; ++c) {
+                    const int limit = 1 << (info.deltaBits[c] - 1);
+                    const int delta = std::clamp(candidate.endpoints[e][c] - candidate.endpoints[0][c], -limit, limit - 1);
+                    candidate.endpoints[e][c] = candidate.endpoints[0][c] + delta;
+                }
+            }
+        }
+        SelectBc6hIndices(m_pixels, candidate);
+        if (candidate.error >= best.error) {
+            return;
+        }
+
+        // アンカーのインデックスの最上位ビットが立っている場合は端点を入れ替えてインデックスを反転する
+        const int indexBits = info.regions == 2 ? 3 : 4;
+        bool swapped = false;
+        for (int region = 0; region < info.regions; ++region) {
+            if ((candidate.indices[GetAnchor(info.regions, partition, region)] >> (indexBits - 1)) != 0) {
+                std::swap(candidate.endpoints[region * 2], candidate.endpoints[region * 2 + 1]);
+                for (int i = 0; i < 16; ++i) {
+                    if (GetSubset(info.regions, partition, i) == region) {
+                        candidate.indices[i] = static_cast<uint8_t>((1 << indexBits) - 1 - candidate.indices[i]);
+                    }
+                }
+                swapped = true;
+            }
+        }
+        // 入れ替えで端点0が変わると差分が収まらなくなる場合がある
+        if (swapped && !DeltasFit(candidate)) {
+            return;
+        }
+        best = candidate;
+    }
+
+    float m_pixels[16][4] = {};     // 圧縮するブロック（RGBの半精度のビット列の値）
+    BlockQuality m_quality;         // 圧縮品質
+    Bc6hBlock m_best;               // これまでで最も誤差の小さいブロック
+};
+
+} // namespace
+
+void BptcCodec::EncodeBC7Block(const uint8_t* pixels, BlockQuality quality, uint8_t* block) {
+    Bc7Encoder(pixels, quality).Encode(block);
+}
+
+bool BptcCodec::DecodeBC7Block(const uint8_t* block, uint8_t* pixels) {
+    Bc7Block unpacked;
+    if (!UnpackBc7Block(block, unpacked)) {
+        std::memset(pixels, 0, 64);
+        return false;
+    }
+    DecodeBc7(unpacked, pixels);
+    return true;
+}
+
+void BptcCodec::EncodeBC6HBlock(const uint16_t* pixels, BlockQuality quality, uint8_t* block) {
+    Bc6hEncoder(pixels, quality).Encode(block);
+}
+
+bool BptcCodec::DecodeBC6HBlock(const uint8_t* block, uint16_t* pixels) {
+    Bc6hBlock unpacked;
+    if (!UnpackBc6hBlock(block, unpacked)) {
+        std::memset(pixels, 0, 48 * sizeof(uint16_t));
+        return false;
+    }
+    const Bc6hModeInfo& info = kBc6hModes[unpacked.modeIndex];
+    const int* weights = GetWeights(info.regions == 2 ? 3 : 4);
+    for (int i = 0; i < 16; ++i) {
+        const int region = GetSubset(info.regions, unpacked.partition, i);
+        for (int c = 0; c < 3; ++c) {
+            const int e0 = UnquantizeBc6h(unpacked.endpoints[region * 2][c], info.endpointBits);
+            const int e1 = UnquantizeBc6h(unpacked.endpoints[region * 2 + 1][c], info.endpointBits);
+            pixels[i * 3 + c] = static_cast<uint16_t>(FinishBc6h(Interpolate(e0, e1, weights[unpacked.indices[i]])));
+        }
+    }
+    return true;
+}
+
+int BptcCodec::GetBC7Mode(const uint8_t* block) {
+    for (int mode = 0; mode < 8; ++mode) {
+        if ((block[0] >> mode) & 1) {
+            return mode;
+        }
+    }
+    return -1;
+}
+
+int BptcCodec::GetBC6HMode(const uint8_t* block) {
+    const int modeIndex = ReadBc6hMode(block);
+    return modeIndex < 0 ? -1 : kBc6hModes[modeIndex].number;
+}
+
+} // namespace RenderingSandbox
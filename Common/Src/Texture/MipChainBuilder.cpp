@@ -0,0 +1,181 @@
+#include "Texture/MipChainBuilder.h"
+#include "stb/stb_image_resize2.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace RenderingSandbox {
+
+namespace {
+
+// 1つの分割（走査線の帯）が担当する最小の出力ピクセル数
+// これより小さいレベルはスレッドの起床待ちの方が長くなるため分割しない
+constexpr uint64_t kMinPixelsPerSplit = 128 * 128;
+
+stbir_pixel_layout ToStbirLayout(MipPixelFormat format) {
+    return format == MipPixelFormat::R32Float ? STBIR_1CHANNEL : STBIR_RGBA;
+}
+
+stbir_datatype ToStbirDataType(MipPixelFormat format) {
+    switch (format) {
+        case MipPixelFormat::RGBA8UnormSrgb: return STBIR_TYPE_UINT8_SRGB;
+        case MipPixelFormat::RGBA16Float:    return STBIR_TYPE_HALF_FLOAT;
+        case MipPixelFormat::R32Float:       return STBIR_TYPE_FLOAT;
+        case MipPixelFormat::RGBA32Float:    return STBIR_TYPE_FLOAT;
+        default:                             return STBIR_TYPE_UINT8;
+    }
+}
+
+stbir_filter ToStbirFilter(MipFilter filter) {
+    switch (filter) {
+        case MipFilter::Triangle:   return STBIR_FILTER_TRIANGLE;
+        case MipFilter::Mitchell:   return STBIR_FILTER_MITCHELL;
+        case MipFilter::CatmullRom: return STBIR_FILTER_CATMULLROM;
+        default:                    return STBIR_FILTER_BOX;
+    }
+}
+
+} // namespace
+
+/// <summary>
+/// 1レベル分の縮小設定（構築済みのサンプラーを、同じ条件で次に呼ばれた時に再利用する）
+/// </summary>
+struct MipChainBuilder::LevelContext {
+    STBIR_RESIZE resize{};                      // stbirの縮小設定
+    bool built = false;                         // サンプラーを構築済みか
+    int splits = 0;                             // 構築された分割数
+    uint32_t inputWidth = 0;                    // 以下、サンプラーを構築した時の条件
+    uint32_t inputHeight = 0;
+    uint32_t outputWidth = 0;
+    uint32_t outputHeight = 0;
+    MipPixelFormat format = MipPixelFormat::RGBA8Unorm;
+    MipFilter filter = MipFilter::Box;
+    bool wrapEdges = false;
+    int requestedSplits = 0;
+
+    ~LevelContext() {
+        if (built) {
+            stbir_free_samplers(&resize);
+        }
+    }
+};
+
+MipChainBuilder::MipChainBuilder(uint32_t threadCount)
+    : m_pool(threadCount) {
+}
+
+MipChainBuilder::~MipChainBuilder() = default;
+
+uint32_t MipChainBuilder::GetFullLevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        ++levels;
+    }
+    return levels;
+}
+
+bool MipChainBuilder::Build(const void* pixels, uint32_t width, uint32_t height, size_t rowPitch, MipPixelFormat format,
+                            MipChain& chain, const MipChainOptions& options) {
+    if (!pixels || width == 0 || height == 0) {
+        return false;
+    }
+    const size_t pixelSize = GetMipPixelSize(format);
+    if (rowPitch == 0) {
+        rowPitch = width * pixelSize;
+    }
+
+    // レベルの配置を決める
+    uint32_t levelCount = GetFullLevelCount(width, height);
+    if (options.maxLevels != 0) {
+        levelCount = std::min(levelCount, options.maxLevels);
+    }
+    chain.format = format;
+    chain.levels.resize(levelCount);
+    size_t totalSize = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        MipLevel& mip = chain.levels[level];
+        mip.width = std::max(1u, width >> level);
+        mip.height = std::max(1u, height >> level);
+        mip.rowPitch = mip.width * pixelSize;
+        mip.offset = totalSize;
+        totalSize += mip.rowPitch * mip.height;
+    }
+    chain.data.resize(totalSize);
+
+    // レベル0は元の画素をそのまま写す
+    const uint8_t* source = static_cast<const uint8_t*>(pixels);
+    uint8_t* destination = chain.data.data();
+    if (rowPitch == chain.levels[0].rowPitch) {
+        std::memcpy(destination, source, rowPitch * height);
+    }
+    else {
+        for (uint32_t y = 0; y < height; ++y) {
+            std::memcpy(destination + y * chain.levels[0].rowPitch, source + y * rowPitch, chain.levels[0].rowPitch);
+        }
+    }
+
+    while (m_levelContexts.size() + 1 < levelCount) {
+        m_levelContexts.push_back(std::make_unique<LevelContext>());
+    }
+
+    const int threadCount = static_cast<int>(m_pool.GetThreadCount());
+    for (uint32_t level = 1; level < levelCount; ++level) {
+        const MipLevel& input = chain.levels[level - 1];
+        const MipLevel& output = chain.levels[level];
+        const void* inputPixels = chain.data.data() + input.offset;
+        void* outputPixels = chain.data.data() + output.offset;
+        const uint64_t outputPixelCount = static_cast<uint64_t>(output.width) * output.height;
+        const int requestedSplits = static_cast<int>(std::clamp<uint64_t>(outputPixelCount / kMinPixelsPerSplit, 1, threadCount));
+
+        LevelContext& context = *m_levelContexts[level - 1];
+        const bool reusable = context.built
+            && context.inputWidth == input.width && context.inputHeight == input.height
+            && context.outputWidth == output.width && context.outputHeight == output.height
+            && context.format == format && context.filter == options.filter
+            && context.wrapEdges == options.wrapEdges && context.requestedSplits == requestedSplits;
+        if (reusable) {
+            // 同じ条件であればバッファの差し替えだけで済む（サンプラーの再構築は起きない）
+            stbir_set_buffer_ptrs(&context.resize, inputPixels, static_cast<int>(input.rowPitch), outputPixels, static_cast<int>(output.rowPitch));
+        }
+        else {
+            if (context.built) {
+                stbir_free_samplers(&context.resize);
+                context.built = false;
+            }
+            stbir_resize_init(&context.resize,
+                              inputPixels, static_cast<int>(input.width), static_cast<int>(input.height), static_cast<int>(input.rowPitch),
+                              outputPixels, static_cast<int>(output.width), static_cast<int>(output.height), static_cast<int>(output.rowPitch),
+                              ToStbirLayout(format), ToStbirDataType(format));
+            const stbir_edge edge = options.wrapEdges ? STBIR_EDGE_WRAP : STBIR_EDGE_CLAMP;
+            stbir_set_edgemodes(&context.resize, edge, edge);
+            stbir_set_filters(&context.resize, ToStbirFilter(options.filter), ToStbirFilter(options.filter));
+            context.splits = stbir_build_samplers_with_splits(&context.resize, requestedSplits);
+            if (context.splits <= 0) {
+                return false;
+            }
+            context.built = true;
+            context.inputWidth = input.width;
+            context.inputHeight = input.height;
+            context.outputWidth = output.width;
+            context.outputHeight = output.height;
+            context.format = format;
+            context.filter = options.filter;
+            context.wrapEdges = options.wrapEdges;
+            context.requestedSplits = requestedSplits;
+        }
+
+        // 各分割は出力の異なる走査線の帯を書き込むため、同時に実行してよい
+        std::atomic<bool> succeeded{ true };
+        m_pool.ParallelFor(context.splits, [&context, &succeeded](int split) {
+            if (!stbir_resize_extended_split(&context.resize, split, 1)) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+        if (!succeeded.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace RenderingSandbox
@@ -0,0 +1,7 @@
+// stbライブラリの実装部（プロジェクト全体でこのファイルにのみ置く）
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb/stb_image_resize2.h"
@@ -0,0 +1,193 @@
+#include "Texture/TextureFileSource.h"
+
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RenderingSandbox {
+
+namespace {
+
+/// <summary>
+/// stbに渡せるファイルサイズか（stbi_load_from_memoryの長さはint）
+/// </summary>
+bool IsSupportedSize(uint64_t size, std::string& error) {
+    if (size == 0 || size > static_cast<uint64_t>(INT_MAX)) {
+        error = "Unsupported file size: " + std::to_string(size) + " bytes";
+        return false;
+    }
+    return true;
+}
+
+/// <summary>
+/// メモリマップを使うかどうかを判定
+/// </summary>
+bool ShouldMap(TextureFileReadMode mode, uint64_t size) {
+    return mode == TextureFileReadMode::Map
+        || (mode == TextureFileReadMode::Auto && size >= TextureFileSource::kMapThreshold);
+}
+
+} // namespace
+
+TextureFileSource::~TextureFileSource() {
+    Close();
+}
+
+void TextureFileSource::Close() {
+    if (m_mappedView) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_mappedView);
+#else
+        ::munmap(m_mappedView, m_size);
+#endif
+        m_mappedView = nullptr;
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#ifdef _WIN32
+
+bool TextureFileSource::Open(const std::filesystem::path& path, std::vector<uint8_t>& scratch, TextureFileReadMode mode, std::string& error) {
+    Close();
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "Cannot open file: " + std::system_category().message(static_cast<int>(GetLastError()));
+        return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        error = "Cannot get file size: " + std::system_category().message(static_cast<int>(GetLastError()));
+        CloseHandle(file);
+        return false;
+    }
+    const uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+    if (!IsSupportedSize(size, error)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (ShouldMap(mode, size)) {
+        // ビューがファイルとマッピングを参照し続けるため、ハンドルはすぐに閉じてよい
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size)) : nullptr;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (view) {
+            CloseHandle(file);
+            // デコーダは先頭から順に読むため、ページをまとめて先読みさせる
+            WIN32_MEMORY_RANGE_ENTRY range{ view, static_cast<SIZE_T>(size) };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            m_mappedView = view;
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(size);
+            return true;
+        }
+        // マップできない場合は一括読み込みに切り替える
+    }
+
+    if (scratch.size() < size) {
+        scratch.resize(static_cast<size_t>(size));
+    }
+    size_t total = 0;
+    while (total < size) {
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, scratch.data() + total, static_cast<DWORD>(size - total), &bytesRead, nullptr)) {
+            error = "Failed to read file: " + std::system_category().message(static_cast<int>(GetLastError()));
+            CloseHandle(file);
+            return false;
+        }
+        if (bytesRead == 0) {
+            error = "Unexpected end of file";
+            CloseHandle(file);
+            return false;
+        }
+        total += bytesRead;
+    }
+    CloseHandle(file);
+
+    m_data = scratch.data();
+    m_size = static_cast<size_t>(size);
+    return true;
+}
+
+#else
+
+bool TextureFileSource::Open(const std::filesystem::path& path, std::vector<uint8_t>& scratch, TextureFileReadMode mode, std::string& error) {
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = "Cannot open file: " + std::generic_category().message(errno);
+        return false;
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        error = "Cannot get file size: " + std::generic_category().message(errno);
+        ::close(fd);
+        return false;
+    }
+    const uint64_t size = static_cast<uint64_t>(status.st_size);
+    if (!IsSupportedSize(size, error)) {
+        ::close(fd);
+        return false;
+    }
+
+    if (ShouldMap(mode, size)) {
+        void* view = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            // マップはファイルを参照し続けるため、ディスクリプタはすぐに閉じてよい
+            ::close(fd);
+            // デコーダは先頭から順に読むため、先読みを強めてすぐに読み込みを始めさせる
+            ::madvise(view, static_cast<size_t>(size), MADV_SEQUENTIAL);
+            ::madvise(view, static_cast<size_t>(size), MADV_WILLNEED);
+            m_mappedView = view;
+            m_data = static_cast<const uint8_t*>(view);
+            m_size = static_cast<size_t>(size);
+            return true;
+        }
+        // マップできない場合は一括読み込みに切り替える
+    }
+
+    if (scratch.size() < size) {
+        scratch.resize(static_cast<size_t>(size));
+    }
+    size_t total = 0;
+    while (total < size) {
+        const ssize_t bytesRead = ::pread(fd, scratch.data() + total, static_cast<size_t>(size) - total, static_cast<off_t>(total));
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            error = bytesRead < 0 ? "Failed to read file: " + std::generic_category().message(errno) : "Unexpected end of file";
+            ::close(fd);
+            return false;
+        }
+        total += static_cast<size_t>(bytesRead);
+    }
+    ::close(fd);
+
+    m_data = scratch.data();
+    m_size = static_cast<size_t>(size);
+    return true;
+}
+
+#endif
+
+} // namespace RenderingSandbox
@@ -0,0 +1,184 @@
+#include "Texture/TextureLoader.h"
+#include "Logger/LogMacros.h"
+#include "stb/stb_image.h"
+
+#include <algorithm>
+#include <climits>
+#include <exception>
+#include <numeric>
+#include <system_error>
+
+namespace RenderingSandbox {
+
+void TexturePixelsDeleter::operator()(void* pixels) const noexcept {
+    stbi_image_free(pixels);
+}
+
+TextureLoader::TextureLoader(uint32_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&TextureLoader::WorkerMain, this);
+    }
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobCondition.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::future<TextureImage> TextureLoader::Load(const std::filesystem::path& path, const TextureLoadOptions& options) {
+    Job job{ path, options, {} };
+    std::future<TextureImage> future = job.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobCondition.notify_one();
+    return future;
+}
+
+std::vector<std::future<TextureImage>> TextureLoader::LoadBatch(std::span<const std::filesystem::path> paths, const TextureLoadOptions& options) {
+    std::vector<Job> jobs;
+    std::vector<std::future<TextureImage>> futures;
+    std::vector<uintmax_t> sizes;
+    jobs.reserve(paths.size());
+    futures.reserve(paths.size());
+    sizes.reserve(paths.size());
+    for (const std::filesystem::path& path : paths) {
+        jobs.push_back({ path, options, {} });
+        futures.push_back(jobs.back().promise.get_future());
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(path, ec);
+        sizes.push_back(ec ? 0 : size);
+    }
+
+    // デコード時間はおおむねファイルサイズに比例するため、大きいものから処理させる
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t index : order) {
+            m_jobs.push_back(std::move(jobs[index]));
+        }
+    }
+    m_jobCondition.notify_all();
+    return futures;
+}
+
+void TextureLoader::WaitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [this] { return m_jobs.empty() && m_activeJobs == 0; });
+}
+
+TextureImage TextureLoader::Decode(std::span<const uint8_t> bytes, const TextureLoadOptions& options) {
+    TextureImage image;
+    if (bytes.empty() || bytes.size() > static_cast<size_t>(INT_MAX)) {
+        image.error = "Unsupported data size";
+        return image;
+    }
+    if (options.desiredChannels < 0 || options.desiredChannels > 4) {
+        image.error = "desiredChannels must be 0 to 4";
+        return image;
+    }
+
+    const stbi_uc* data = bytes.data();
+    const int length = static_cast<int>(bytes.size());
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    void* pixels = nullptr;
+
+    // 上下反転の指定はスレッドごとに保持されるため、他のスレッドのデコードに影響しない
+    stbi_set_flip_vertically_on_load_thread(options.flipVertically ? 1 : 0);
+    if (options.loadHdrAsFloat && stbi_is_hdr_from_memory(data, length)) {
+        pixels = stbi_loadf_from_memory(data, length, &width, &height, &channels, options.desiredChannels);
+        image.componentType = TextureComponentType::Float32;
+    }
+    else if (options.keep16Bit && stbi_is_16_bit_from_memory(data, length)) {
+        pixels = stbi_load_16_from_memory(data, length, &width, &height, &channels, options.desiredChannels);
+        image.componentType = TextureComponentType::UInt16;
+    }
+    else {
+        pixels = stbi_load_from_memory(data, length, &width, &height, &channels, options.desiredChannels);
+        image.componentType = TextureComponentType::UInt8;
+    }
+
+    if (!pixels) {
+        // 失敗理由はstb_image内でスレッドごとに保持される
+        const char* reason = stbi_failure_reason();
+        image.error = reason ? reason : "Unknown decode error";
+        return image;
+    }
+
+    image.pixels.reset(static_cast<uint8_t*>(pixels));
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.sourceChannels = static_cast<uint32_t>(channels);
+    image.channels = static_cast<uint32_t>(options.desiredChannels != 0 ? options.desiredChannels : channels);
+    return image;
+}
+
+TextureImage TextureLoader::LoadFile(const std::filesystem::path& path, const TextureLoadOptions& options, std::vector<uint8_t>& scratch) {
+    TextureImage image;
+    TextureFileSource source;
+    if (source.Open(path, scratch, options.readMode, image.error)) {
+        image = Decode(source.GetData(), options);
+    }
+    image.path = path;
+    return image;
+}
+
+void TextureLoader::WorkerMain() {
+    // デコード中のスタックオーバーフローもクラッシュレポートに残す（クラッシュハンドラの登録中のみ）
+    Logger::GetInstance().OnThreadStart();
+
+    // 小さいファイルの読み込みバッファはワーカーごとに持ち、要求をまたいで再利用する
+    std::vector<uint8_t> scratch;
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobCondition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                // 終了要求があり、残りの要求もない
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            ++m_activeJobs;
+        }
+
+        try {
+            TextureImage image = LoadFile(job.path, job.options, scratch);
+            if (!image.IsValid()) {
+                LOG_WARNING_KV("Texture", "Failed to load texture", { "path", job.path.string() }, { "reason", image.error });
+            }
+            job.promise.set_value(std::move(image));
+        }
+        catch (...) {
+            // メモリ不足等はfuture::getで呼び出し側に伝える
+            job.promise.set_exception(std::current_exception());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeJobs;
+            if (m_jobs.empty() && m_activeJobs == 0) {
+                m_idleCondition.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace RenderingSandbox
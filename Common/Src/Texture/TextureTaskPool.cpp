@@ -0,0 +1,97 @@
+#include "Texture/TextureTaskPool.h"
+#include "Logger/Logger.h"
+
+#include <algorithm>
+
+namespace RenderingSandbox {
+
+TextureTaskPool::TextureTaskPool(uint32_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 呼び出しスレッドも分割を処理するため、ワーカーは1つ少なくてよい
+    m_workers.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        m_workers.emplace_back(&TextureTaskPool::WorkerMain, this);
+    }
+}
+
+TextureTaskPool::~TextureTaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workCondition.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void TextureTaskPool::ParallelFor(int count, const std::function<void(int)>& function) {
+    if (m_workers.empty() || count <= 1) {
+        for (int i = 0; i < count; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &function;
+        m_taskCount = count;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+        m_completedCount = 0;
+        ++m_generation;
+    }
+    m_workCondition.notify_all();
+
+    // 呼び出しスレッドも分割を取り出して処理する
+    int completed = 0;
+    for (int index = m_nextIndex.fetch_add(1, std::memory_order_relaxed); index < count; index = m_nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+        function(index);
+        ++completed;
+    }
+
+    // 参加したワーカーがすべて抜けるまで待つ（抜ける前に次の処理を投入すると、古い処理で新しい分割を実行してしまう）
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completedCount += completed;
+    m_doneCondition.wait(lock, [this, count] { return m_completedCount == count && m_joinedWorkers == 0; });
+    m_task = nullptr;
+}
+
+void TextureTaskPool::WorkerMain() {
+    // 圧縮処理中のスタックオーバーフローもクラッシュレポートに残す（クラッシュハンドラの登録中のみ）
+    Logger::GetInstance().OnThreadStart();
+
+    uint64_t seenGeneration = 0;
+    while (true) {
+        const std::function<void(int)>* task = nullptr;
+        int count = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [this, seenGeneration] { return m_stopping || (m_task && m_generation != seenGeneration); });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+            task = m_task;
+            count = m_taskCount;
+            ++m_joinedWorkers;
+        }
+
+        int completed = 0;
+        for (int index = m_nextIndex.fetch_add(1, std::memory_order_relaxed); index < count; index = m_nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+            (*task)(index);
+            ++completed;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completedCount += completed;
+            --m_joinedWorkers;
+        }
+        m_doneCondition.notify_one();
+    }
+}
+
+} // namespace RenderingSandbox
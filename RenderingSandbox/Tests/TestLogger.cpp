@@ -0,0 +1,1096 @@
+// Logger動作確認・性能測定テスト
+
+#include "TestLogger.h"
+#include "Logger/BinaryFileSink.h"
+#include "Logger/DedupSink.h"
+#include "Logger/FileSink.h"
+#include "Logger/JsonLinesSink.h"
+#include "Logger/LogCaptureSink.h"
+#include "Logger/LogCategory.h"
+#include "Logger/LogCompileLevel.h"
+#include "Logger/LogCrashHandler.h"
+#include "Logger/LogMacros.h"
+#include "Logger/LogMessage.h"
+#include "Logger/LogPattern.h"
+#include "Logger/LogRateLimit.h"
+#include "Logger/MappedFileSink.h"
+#include "Logger/RingBufferSink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using namespace RenderingSandbox;
+
+    // 旧実装のLogMessage::Format()（ostringstream + put_time + substr）を比較用に再現
+    std::string FormatWithStream(const LogMessage& message) {
+        std::ostringstream oss;
+
+        auto timeT = std::chrono::system_clock::to_time_t(message.timestamp);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            message.timestamp.time_since_epoch()) % 1000;
+
+        std::tm tmBuf{};
+#ifdef _WIN32
+        localtime_s(&tmBuf, &timeT);
+#else
+        localtime_r(&timeT, &tmBuf);
+#endif
+
+        oss << "[" << std::put_time(&tmBuf, "%H:%M:%S")
+            << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
+        oss << "[" << LogLevelToString(message.level) << "] ";
+        if (!message.category.empty()) {
+            oss << "[" << message.category << "] ";
+        }
+        oss << message.GetText();
+
+        std::string filename = message.file;
+        size_t lastSlash = filename.find_last_of("/\\");
+        if (lastSlash != std::string::npos) {
+            filename = filename.substr(lastSlash + 1);
+        }
+        oss << " (" << filename << ":" << message.line << ")";
+
+        return oss.str();
+    }
+
+    // LOG_*Fと同じ形の遅延フォーマットのレコードを組み立てる
+    template <class... Args>
+    void SetDeferredText(LogMessage& message, std::format_string<Args...> format, Args&&... args) {
+        message.formatString = format.get();
+        message.formatter = &FormatLogArgs<std::remove_cvref_t<Args>...>;
+        message.argKinds = kLogArgKinds<std::remove_cvref_t<Args>...>;
+        message.textOffset = LogMessage::kNoText;
+        EncodeLogArgs(message.payload, args...);
+    }
+
+    // 受け取ったレコードの本文を記録するだけのSink
+    class TextCollectorSink : public ILogSink {
+    public:
+        void Write(const LogMessage& message) override { texts.emplace_back(message.GetText()); }
+
+        std::vector<std::string> texts;
+    };
+
+    // 受け取った本文と、受け取った時点で遅延フォーマットの本文が生成済みだったかを記録するSink
+    class PreformattedCheckSink : public ILogSink {
+    public:
+        void Write(const LogMessage& message) override {
+            preformatted = preformatted && (!message.formatter || message.textOffset != LogMessage::kNoText);
+            texts.emplace_back(message.GetText());
+        }
+
+        std::vector<std::string> texts;
+        bool preformatted = true;
+    };
+
+    // Writeの中からSinkの付け替えを試み、拒否されたかを記録するSink
+    class ReentrantSink : public ILogSink {
+    public:
+        void Write(const LogMessage&) override {
+            Logger& logger = Logger::GetInstance();
+            rejected = logger.AddSink(std::make_shared<TextCollectorSink>()) == 0
+                && logger.RemoveSink(handle) == nullptr;
+            logger.ClearSinks();
+            ++writes;
+        }
+
+        LogSinkHandle handle = 0;
+        bool rejected = false;
+        int writes = 0;
+    };
+
+    // スレッドバッファの回収で配信されたレコードごとに、Writeの中から別カテゴリのログを2件出すSink
+    // （回収1回分の配信で、スレッドバッファの上限を超える量のログを出す）
+    class EchoSink : public ILogSink {
+    public:
+        void Write(const LogMessage& message) override {
+            if (message.category == "LoggerThreadBufferTest") {
+                Logger::GetInstance().Log(LogLevel::Info, "LoggerThreadBufferEcho", "Echo 1");
+                Logger::GetInstance().Log(LogLevel::Info, "LoggerThreadBufferEcho", "Echo 2");
+            }
+        }
+    };
+
+    // 1レコードあたりの処理をcount回実行し、records/secを返す
+    template <class Function>
+    double MeasureRecordsPerSecond(int count, Function&& function) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            function(i);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return count / elapsed.count();
+    }
+
+    /// <summary>
+    /// 本文が"<名前> <スレッド番号> <連番>"のレコードを数え、スレッドごとの連番が増加順に並んでいるかを確認した結果
+    /// </summary>
+    struct SequenceCheck {
+        size_t count = 0;           // categoryのレコード数
+        bool ordered = true;        // スレッドごとの連番が増加順か
+    };
+
+    SequenceCheck CheckSequences(const std::vector<LogMessage>& messages, std::string_view category, int threadCount) {
+        SequenceCheck result;
+        std::vector<int> last(threadCount, -1);
+        for (const LogMessage& record : messages) {
+            if (record.category != category) {
+                continue;
+            }
+            int thread = -1;
+            int index = -1;
+            const std::string text(record.GetText());
+            if (std::sscanf(text.c_str(), "%*s %d %d", &thread, &index) != 2 || thread < 0 || thread >= threadCount || index <= last[thread]) {
+                result.ordered = false;
+                continue;
+            }
+            last[thread] = index;
+            ++result.count;
+        }
+        return result;
+    }
+
+    // カテゴリ別しきい値の検索（最初に一致した要素を使い、番兵と未登録カテゴリは既定値）
+    constexpr LogCompileCategoryLevel kTestCompileLevels[] = {
+        { "Renderer", LogLevel::Warning },
+        { "D3D12", LogLevel::Trace },
+        { "Renderer", LogLevel::Error },
+        { std::string_view(), 6 } };
+    static_assert(FindLogCompileMinLevel(kTestCompileLevels, "Renderer", 2) == 3);
+    static_assert(FindLogCompileMinLevel(kTestCompileLevels, "D3D12", 6) == 0);
+    static_assert(FindLogCompileMinLevel(kTestCompileLevels, "Audio", 2) == 2);
+    static_assert(FindLogCompileMinLevel(kTestCompileLevels, "", 4) == 4);
+    static_assert(LogCompileMinLevel("LoggerTestUnlisted") == LOG_COMPILE_MIN_LEVEL);
+    static_assert(LogIsCompiledIn(LogLevel::Fatal, "LoggerTestUnlisted") == (LOG_COMPILE_MIN_LEVEL <= 5));
+    static_assert(LogIsCompiledIn(LogLevel::Trace, "LoggerTestUnlisted") == (LOG_COMPILE_MIN_LEVEL <= 0));
+
+} // namespace
+
+void RunLoggerTest()
+{
+    std::cout << "### Logger Test ###" << std::endl;
+    std::cout << std::endl;
+
+    // テスト1: 整形結果が旧実装と一致するか
+    std::cout << "[Logger Test 1] Format compatibility" << std::endl;
+
+    LogMessage message;
+    message.level = LogLevel::Info;
+    message.category = "Renderer";
+    message.file = "main.cpp";
+    message.line = 128;
+    message.timestamp = std::chrono::system_clock::now();
+    message.SetText("Frame presented: swap chain buffer 2, 16.6ms");
+
+    std::string expected = FormatWithStream(message);
+    std::string actual = message.Format();
+    std::cout << "  - Output: " << actual << std::endl;
+    std::cout << (expected == actual ? "  SUCCESS: matches previous formatter" : "  FAILED: differs from previous formatter") << std::endl;
+    std::cout << std::endl;
+
+    // テスト2: 整形のスループット比較
+    std::cout << "[Logger Test 2] Format throughput" << std::endl;
+
+    constexpr int kRecordCount = 200000;
+    const auto baseTime = message.timestamp;
+    size_t sink = 0;
+
+    double streamRate = MeasureRecordsPerSecond(kRecordCount, [&](int i) {
+        message.timestamp = baseTime + std::chrono::microseconds(i * 50);
+        sink += FormatWithStream(message).size();
+    });
+
+    std::string buffer;
+    double writerRate = MeasureRecordsPerSecond(kRecordCount, [&](int i) {
+        message.timestamp = baseTime + std::chrono::microseconds(i * 50);
+        message.FormatTo(buffer);
+        sink += buffer.size();
+    });
+
+    std::cout << "  - ostringstream + put_time: " << static_cast<uint64_t>(streamRate) << " records/sec" << std::endl;
+    std::cout << "  - LogMessage::FormatTo:     " << static_cast<uint64_t>(writerRate) << " records/sec" << std::endl;
+    std::cout << "  - Speedup: " << std::fixed << std::setprecision(1) << (writerRate / streamRate) << "x"
+              << std::defaultfloat << " (checksum " << sink << ")" << std::endl;
+    std::cout << std::endl;
+
+    // テスト3: 既定パターンがLogMessage::Format()と同じ出力になるか
+    std::cout << "[Logger Test 3] Default pattern" << std::endl;
+
+    std::string patterned;
+    LogPattern::GetDefault()->FormatTo(message, patterned);
+    std::cout << "  - Pattern: " << LogPattern::kDefaultPattern << std::endl;
+    std::cout << (patterned == message.Format() ? "  SUCCESS: matches LogMessage::Format()" : "  FAILED: differs from LogMessage::Format()") << std::endl;
+
+    LogMessage bare = message;
+    bare.category = {};
+    bare.file = "";
+    LogPattern::GetDefault()->FormatTo(bare, patterned);
+    std::cout << (patterned == bare.Format() ? "  SUCCESS: optional groups omitted" : "  FAILED: optional groups") << std::endl;
+    std::cout << std::endl;
+
+    // テスト4: リングファイルが周回後も古い順に連続して読み出せるか
+    std::cout << "[Logger Test 4] Mapped ring file" << std::endl;
+
+    const std::filesystem::path ringPath = std::filesystem::temp_directory_path() / "RenderingSandbox_ring_test.log";
+    constexpr int kRingRecordCount = 1000;
+    {
+        MappedFileSink ringSink(ringPath, 16 * 1024, false);
+        for (int i = 0; i < kRingRecordCount; ++i) {
+            message.line = i;
+            message.SetText("Ring record " + std::to_string(i));
+            ringSink.Write(message);
+        }
+    }
+
+    int readCount = 0;
+    int expectedLine = -1;
+    bool sequential = true;
+    bool ringValid = MappedFileSink::ReadFile(ringPath, [&](const LogMessage& record) {
+        if (expectedLine >= 0 && record.line != expectedLine) {
+            sequential = false;
+        }
+        expectedLine = record.line + 1;
+        ++readCount;
+    });
+    std::filesystem::remove(ringPath);
+
+    std::cout << "  - Records kept: " << readCount << " / " << kRingRecordCount << std::endl;
+    std::cout << (ringValid && sequential && expectedLine == kRingRecordCount
+        ? "  SUCCESS: newest records read back in order" : "  FAILED: ring file contents") << std::endl;
+    std::cout << std::endl;
+
+    // テスト5: バイナリ形式のサイズ・速度とデコード結果
+    std::cout << "[Logger Test 5] Binary file sink" << std::endl;
+
+    const std::filesystem::path textPath = std::filesystem::temp_directory_path() / "RenderingSandbox_text_test.log";
+    const std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / "RenderingSandbox_binary_test.bin";
+
+    // レコードの組み立ては計測から除き、Sink::Writeの時間だけを測る
+    // 同じレコードをテキスト→バイナリの順に渡し、先にGetTextされても引数のまま書けることも確認する
+    constexpr int kSinkBatchSize = 1000;
+    std::vector<LogMessage> batch(kSinkBatchSize);
+    std::chrono::duration<double> textTime{};
+    std::chrono::duration<double> binaryTime{};
+    {
+        FileSink textSink(textPath, false);
+        textSink.SetBuffered(true);
+        textSink.SetMaxFileSize(SIZE_MAX);
+        BinaryFileSink binarySink(binaryPath, false);
+
+        for (int base = 0; base < kRecordCount; base += kSinkBatchSize) {
+            for (int j = 0; j < kSinkBatchSize; ++j) {
+                const int i = base + j;
+                LogMessage& record = batch[j];
+                record.level = LogLevel::Info;
+                record.category = "Renderer";
+                record.file = "main.cpp";
+                record.line = 128;
+                record.timestamp = baseTime + std::chrono::microseconds(i * 50);
+                SetDeferredText(record, "Frame {} presented in {:.2f}ms on {}", i, 16.6 + (i % 7) * 0.1, "direct queue");
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (const LogMessage& record : batch) {
+                textSink.Write(record);
+            }
+            auto middle = std::chrono::steady_clock::now();
+            for (const LogMessage& record : batch) {
+                binarySink.Write(record);
+            }
+            binaryTime += std::chrono::steady_clock::now() - middle;
+            textTime += middle - start;
+        }
+    }
+    const double textRate = kRecordCount / textTime.count();
+    const double binaryRate = kRecordCount / binaryTime.count();
+
+    const auto textSize = std::filesystem::file_size(textPath);
+    const auto binarySize = std::filesystem::file_size(binaryPath);
+
+    // デコード結果がテキスト出力と一致するか
+    std::ifstream textFile(textPath, std::ios::binary);
+    std::string textLine;
+    int decodedCount = 0;
+    bool identical = true;
+    BinaryFileSink::ReadFile(binaryPath, [&](const LogMessage& record) {
+        std::getline(textFile, textLine);
+        // FileSinkの行末はWindowsではCRLF
+        if (textLine.ends_with('\r')) {
+            textLine.pop_back();
+        }
+        identical = identical && record.Format() == textLine;
+        ++decodedCount;
+    });
+    textFile.close();
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(binaryPath);
+
+    std::cout << "  - FileSink (buffered): " << static_cast<uint64_t>(textRate) << " records/sec, " << textSize << " bytes" << std::endl;
+    std::cout << "  - BinaryFileSink:      " << static_cast<uint64_t>(binaryRate) << " records/sec, " << binarySize << " bytes" << std::endl;
+    std::cout << "  - Size ratio: " << std::fixed << std::setprecision(1) << (static_cast<double>(textSize) / binarySize)
+              << "x, speedup: " << (binaryRate / textRate) << "x" << std::defaultfloat << std::endl;
+    std::cout << (identical && decodedCount == kRecordCount
+        ? "  SUCCESS: decoded records match text output" : "  FAILED: decoded records differ") << std::endl;
+
+    // ネストした置換フィールド（テキストで書かれる）と、辞書に登録しない長い文字列引数
+    {
+        const std::string longName(200, 'x');
+        std::vector<std::string> expected;
+        {
+            BinaryFileSink mixedSink(binaryPath, false);
+            LogMessage& record = batch[0];
+            for (int i = 0; i < 3; ++i) {
+                SetDeferredText(record, "Aligned [{:>{}}] {}", "queue", 8 + i, longName);
+                expected.push_back(std::string(record.GetText()));
+                mixedSink.Write(record);
+                SetDeferredText(record, "Short {} and {}", "direct queue", i);
+                expected.push_back(std::string(record.GetText()));
+                mixedSink.Write(record);
+            }
+        }
+        size_t index = 0;
+        bool mixedIdentical = true;
+        BinaryFileSink::ReadFile(binaryPath, [&](const LogMessage& record) {
+            mixedIdentical = mixedIdentical && index < expected.size() && record.GetText() == expected[index];
+            ++index;
+        });
+        std::filesystem::remove(binaryPath);
+        std::cout << (mixedIdentical && index == expected.size()
+            ? "  SUCCESS: nested fields and long strings decoded" : "  FAILED: nested fields or long strings differ") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト6: バックグラウンドでのローテーションと圧縮
+    std::cout << "[Logger Test 6] Background rotation" << std::endl;
+
+    const std::filesystem::path rotationDirectory = std::filesystem::temp_directory_path() / "RenderingSandbox_rotation_test";
+    std::filesystem::remove_all(rotationDirectory);
+    double slowestWrite = 0.0;
+    {
+        FileSink rotatingSink(rotationDirectory / "app.log", false);
+        rotatingSink.SetMaxFileSize(256 * 1024);
+        rotatingSink.SetMaxFiles(4);
+        rotatingSink.SetCompressRotated(true);
+        rotatingSink.SetBuffered(true);
+        for (int i = 0; i < kRecordCount; ++i) {
+            message.line = i;
+            message.SetText("Rotation record " + std::to_string(i));
+            const auto writeStart = std::chrono::steady_clock::now();
+            rotatingSink.Write(message);
+            const std::chrono::duration<double, std::milli> writeTime = std::chrono::steady_clock::now() - writeStart;
+            slowestWrite = std::max(slowestWrite, writeTime.count());
+        }
+        rotatingSink.WaitForRotation();
+    }
+
+    size_t compressedCount = 0;
+    size_t otherCount = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(rotationDirectory)) {
+        const std::string name = entry.path().filename().string();
+        if (name.ends_with(".gz")) {
+            ++compressedCount;
+            std::cout << "  - " << name << ": " << entry.file_size() << " bytes" << std::endl;
+        } else if (name != "app.log") {
+            ++otherCount;
+        }
+    }
+    std::filesystem::remove_all(rotationDirectory);
+
+    std::cout << "  - Slowest Write(): " << slowestWrite << " ms" << std::endl;
+    std::cout << (compressedCount == 3 && otherCount == 0
+        ? "  SUCCESS: generations rotated and compressed" : "  FAILED: unexpected rotated files") << std::endl;
+
+    // バッファリングモードでは、以降の書き込みがなくても書き出し間隔が経過すればバックグラウンドのスレッドが書き出す
+    const std::filesystem::path intervalPath = std::filesystem::temp_directory_path() / "RenderingSandbox_interval_test.log";
+    bool heldInBuffer = false;
+    bool intervalFlushed = false;
+    std::string intervalContent;
+    {
+        FileSink intervalSink(intervalPath, false);
+        intervalSink.SetBuffered(true);
+        intervalSink.SetFlushInterval(std::chrono::milliseconds(200));
+        message.SetText("Interval record");
+        intervalSink.Write(message);
+        heldInBuffer = std::filesystem::file_size(intervalPath) == 0;
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!intervalFlushed && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            intervalFlushed = std::filesystem::file_size(intervalPath) > 0;
+        }
+        std::ifstream intervalFile(intervalPath, std::ios::binary);
+        intervalContent.assign(std::istreambuf_iterator<char>(intervalFile), std::istreambuf_iterator<char>());
+    }
+    std::filesystem::remove(intervalPath);
+
+    // 行末はWindowsではCRLF
+#ifdef _WIN32
+    constexpr std::string_view kExpectedLineEnding = ")\r\n";
+#else
+    constexpr std::string_view kExpectedLineEnding = ")\n";
+#endif
+    std::cout << (heldInBuffer && intervalFlushed && intervalContent.find("Interval record") != std::string::npos
+        && intervalContent.ends_with(kExpectedLineEnding)
+        ? "  SUCCESS: buffered record written by the interval timer" : "  FAILED: interval flush") << std::endl;
+    std::cout << std::endl;
+
+    // テスト7: 間引きと重複の集約
+    std::cout << "[Logger Test 7] Rate limiting and dedup" << std::endl;
+
+    LogEveryN everyTen(10);
+    LogEveryMs everySecond(1000);
+    LogOnce once;
+    int everyTenPassed = 0;
+    int everySecondPassed = 0;
+    int oncePassed = 0;
+    for (int i = 0; i < 1000; ++i) {
+        everyTenPassed += everyTen.Check() ? 1 : 0;
+        everySecondPassed += everySecond.Check() ? 1 : 0;
+        oncePassed += once.Check() ? 1 : 0;
+    }
+    std::cout << "  - EVERY_N(10): " << everyTenPassed << ", EVERY_MS(1000): " << everySecondPassed
+              << ", ONCE: " << oncePassed << " of 1000 calls" << std::endl;
+
+    auto collector = std::make_unique<TextCollectorSink>();
+    TextCollectorSink* collected = collector.get();
+    DedupSink dedupSink(std::move(collector));
+    message.line = 1;
+    message.SetText("Resource state mismatch");
+    for (int i = 0; i < 1000; ++i) {
+        dedupSink.Write(message);
+    }
+    message.line = 2;
+    message.SetText("Device removed");
+    dedupSink.Write(message);
+    message.line = 1;
+    message.SetText("Resource state mismatch");
+    for (int i = 0; i < 3; ++i) {
+        dedupSink.Write(message);
+    }
+    dedupSink.Flush();
+
+    const std::vector<std::string> expectedTexts = {
+        "Resource state mismatch", "Last message repeated 999 times", "Device removed",
+        "Resource state mismatch", "Last message repeated 2 times" };
+    std::cout << "  - Records forwarded: " << collected->texts.size() << " of 1004, suppressed: "
+              << dedupSink.GetSuppressedCount() << std::endl;
+    std::cout << (everyTenPassed == 100 && everySecondPassed == 1 && oncePassed == 1 && collected->texts == expectedTexts
+        ? "  SUCCESS: storms collapsed into summaries" : "  FAILED: unexpected rate limiting or dedup output") << std::endl;
+    std::cout << std::endl;
+
+    // テスト8: ログ出力を止めずにSinkを取り付け・取り外し
+    std::cout << "[Logger Test 8] Hot sink add/remove" << std::endl;
+
+    Logger& logger = Logger::GetInstance();
+    std::atomic<bool> producing{ true };
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&logger, &producing, t] {
+            for (int i = 0; i < 20 && producing.load(); ++i) {
+                logger.Log(LogLevel::Info, "LoggerTest", "Hot swap record " + std::to_string(t) + "-" + std::to_string(i));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    size_t hotCaptured = 0;
+    for (int i = 0; i < 20; ++i) {
+        ScopedLogCapture hotCapture;
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        hotCaptured += hotCapture.GetSink().GetCount();
+    }
+    producing.store(false);
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    size_t capturedAfterRemove = 0;
+    std::vector<LogMessage> captured;
+    {
+        auto detached = std::make_shared<LogCaptureSink>();
+        {
+            ScopedLogCapture capture;
+            for (int i = 0; i < 10; ++i) {
+                logger.Log(LogLevel::Info, "LoggerTest", "Captured record " + std::to_string(i));
+            }
+            logger.Flush();
+            captured = capture.GetSink().TakeMessages();
+
+            const LogSinkHandle handle = logger.AddSink(detached);
+            logger.RemoveSink(handle);
+        }
+        logger.Log(LogLevel::Info, "LoggerTest", "After capture");
+        capturedAfterRemove = detached->GetCount();
+    }
+
+    bool capturedInOrder = captured.size() == 10;
+    for (size_t i = 0; capturedInOrder && i < captured.size(); ++i) {
+        capturedInOrder = captured[i].GetText() == "Captured record " + std::to_string(i);
+    }
+    std::cout << "  - Captured during hot swaps: " << hotCaptured << ", in scope: " << captured.size() << std::endl;
+    std::cout << (capturedInOrder && capturedAfterRemove == 0
+        ? "  SUCCESS: capture attached and detached while logging" : "  FAILED: unexpected captured records") << std::endl;
+    std::cout << std::endl;
+
+    // テスト9: ログウィンドウ用リングバッファの絞り込み
+    std::cout << "[Logger Test 9] Ring buffer sink filtering" << std::endl;
+
+    constexpr size_t kRingRecords = 1 << 20;
+    static constexpr std::string_view kRingCategories[] = { "Renderer", "D3D12", "Texture", "Audio", "Input", "System", "Shader", "Scene" };
+    RingBufferSink ringSink(kRingRecords, kRingRecords * 64);
+    size_t expectedLevel = 0;
+    size_t expectedCategory = 0;
+    size_t expectedText = 0;
+    for (size_t i = 0; i < kRingRecords + 1000; ++i) {
+        message.level = static_cast<LogLevel>(i % 5);
+        message.category = kRingCategories[i % 8];
+        message.line = static_cast<int>(i);
+        message.SetText("Frame " + std::to_string(i / 100) + (i % 1000 == 7 ? " device lost" : " draw ok"));
+        ringSink.Write(message);
+
+        // 最初の1000件は上書きされる
+        if (i >= 1000) {
+            expectedLevel += message.level >= LogLevel::Error ? 1 : 0;
+            expectedCategory += i % 8 < 2 ? 1 : 0;
+            expectedText += i % 1000 == 7 ? 1 : 0;
+        }
+    }
+
+    // 同じ条件で毎フレーム絞り込み直す場合と、追加分だけを調べる場合の所要時間
+    std::vector<uint64_t> sequences;
+    sequences.reserve(kRingRecords);
+    const size_t reservedCapacity = sequences.capacity();
+    // カテゴリの可否はLoggerのカテゴリハンドルで引く
+    const size_t categoryCount = logger.GetCategoryCount();
+    auto allowedCategories = std::make_unique<bool[]>(categoryCount);
+    allowedCategories[logger.RegisterCategory(kRingCategories[0])] = true;
+    allowedCategories[logger.RegisterCategory(kRingCategories[1])] = true;
+    auto measureFilter = [&](const RingBufferFilter& filter) {
+        auto view = ringSink.Lock();
+        uint64_t cursor = 0;
+        sequences.clear();
+        auto start = std::chrono::steady_clock::now();
+        view.Filter(filter, sequences, cursor);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    };
+
+    RingBufferFilter levelFilter;
+    levelFilter.minLevel = LogLevel::Error;
+    const double levelMs = measureFilter(levelFilter);
+    const size_t levelMatches = sequences.size();
+
+    RingBufferFilter categoryFilter;
+    categoryFilter.categories = std::span<const bool>(allowedCategories.get(), categoryCount);
+    const double categoryMs = measureFilter(categoryFilter);
+    const size_t categoryMatches = sequences.size();
+
+    RingBufferFilter textFilter;
+    textFilter.text = "device lost";
+    const double textMs = measureFilter(textFilter);
+    const size_t textMatches = sequences.size();
+
+    // 追加分のみの絞り込み
+    uint64_t cursor = 0;
+    sequences.clear();
+    ringSink.Lock().Filter(textFilter, sequences, cursor);
+    for (size_t i = 0; i < 1000; ++i) {
+        message.level = LogLevel::Warning;
+        message.category = kRingCategories[0];
+        message.SetText(i == 500 ? "late device lost" : "late draw ok");
+        ringSink.Write(message);
+    }
+    auto incrementalStart = std::chrono::steady_clock::now();
+    ringSink.Lock().Filter(textFilter, sequences, cursor);
+    std::chrono::duration<double, std::milli> incrementalMs = std::chrono::steady_clock::now() - incrementalStart;
+
+    RingBufferRecord lastMatch;
+    std::string lastCategory;
+    {
+        auto view = ringSink.Lock();
+        lastMatch = view.Get(sequences.back());
+        lastCategory = view.GetCategoryName(lastMatch.categoryId);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  - Level >= Error:   " << levelMatches << " records in " << levelMs << " ms" << std::endl;
+    std::cout << "  - Category (2/8):   " << categoryMatches << " records in " << categoryMs << " ms" << std::endl;
+    std::cout << "  - Substring:        " << textMatches << " records in " << textMs << " ms" << std::endl;
+    std::cout << "  - Incremental (+1000): " << incrementalMs.count() << " ms" << std::endl;
+    std::cout << std::defaultfloat;
+    const bool ringCountsMatch = levelMatches == expectedLevel && categoryMatches == expectedCategory
+        && textMatches == expectedText && sequences.size() == textMatches;
+    std::cout << (ringCountsMatch && lastMatch.text == "late device lost" && lastCategory == "Renderer"
+        && sequences.capacity() == reservedCapacity
+        ? "  SUCCESS: filtered without reallocation" : "  FAILED: unexpected filter results") << std::endl;
+    std::cout << std::endl;
+
+    // テスト10: 構造化フィールドのテキスト・JSON出力
+    std::cout << "[Logger Test 10] Structured fields" << std::endl;
+
+    std::vector<LogMessage> fieldMessages;
+    {
+        ScopedLogCapture capture;
+        logger.LogFields(LogLevel::Info, logger.RegisterCategory("DeviceInfo"), "Adapter", {
+            { "vendorId", 0x10DEu },
+            { "name", "GeForce RTX" },
+            { "dedicated", true },
+            { "frameTime", std::chrono::microseconds(16667) },
+            { "scale", 1.5 },
+            { "offset", -3 } }, "TestLogger.cpp", 10);
+        logger.Flush();
+        fieldMessages = capture.GetSink().TakeMessages();
+    }
+
+    bool fieldsMatch = false;
+    bool jsonMatch = false;
+    if (fieldMessages.size() == 1) {
+        const LogMessage& fieldMessage = fieldMessages.front();
+        const std::string text = fieldMessage.Format();
+        LogPattern::GetDefault()->FormatTo(fieldMessage, patterned);
+        std::cout << "  - Text: " << text << std::endl;
+        fieldsMatch = patterned == text
+            && text.find("Adapter vendorId=4318 name=\"GeForce RTX\" dedicated=true frameTime=16.667ms scale=1.5 offset=-3 (TestLogger.cpp:10)")
+                != std::string::npos;
+
+        std::string json;
+        JsonLinesSink::FormatJson(fieldMessage, json);
+        std::cout << "  - JSON: " << json << std::endl;
+        jsonMatch = json.find("\"message\":\"Adapter\",\"fields\":{\"vendorId\":4318,\"name\":\"GeForce RTX\","
+            "\"dedicated\":true,\"frameTime_ns\":16667000,\"scale\":1.5,\"offset\":-3}}") != std::string::npos;
+    }
+
+    // 時間の表示（符号反転で桁あふれする最小値を含む）
+    std::string durationText;
+    for (int64_t nanoseconds : { int64_t{ -850 }, int64_t{ -16667000 }, INT64_MIN }) {
+        AppendLogDuration(durationText, nanoseconds);
+        durationText.push_back(' ');
+    }
+    const bool durationMatch = durationText == "-850ns -16.667ms -9223372036.854s ";
+
+    std::cout << (fieldsMatch ? "  SUCCESS: key=value text output" : "  FAILED: key=value text output") << std::endl;
+    std::cout << (jsonMatch ? "  SUCCESS: JSON Lines output" : "  FAILED: JSON Lines output") << std::endl;
+    std::cout << (durationMatch ? "  SUCCESS: negative durations" : "  FAILED: negative durations: " + durationText) << std::endl;
+    std::cout << std::endl;
+
+    // テスト11: クラッシュレポート（配信前のレコードをシグナル安全な経路で書き出せるか）
+    std::cout << "[Logger Test 11] Crash report" << std::endl;
+
+    // 遅延フォーマットのレコードは、std::formatを使わない整形でも同じ本文になる
+    LogMessage crashMessage = message;
+    SetDeferredText(crashMessage, "Frame {} on {}, {} draws, visible={}", 42, "Main", 1234u, true);
+    char crashLine[512];
+    const size_t crashLineSize = LogCrashHandler::FormatRecord(crashMessage, crashLine, sizeof(crashLine));
+    const std::string crashExpected = crashMessage.Format() + "\n";
+    std::cout << (std::string_view(crashLine, crashLineSize) == crashExpected
+        ? "  SUCCESS: signal-safe format matches LogMessage::Format()" : "  FAILED: signal-safe format differs") << std::endl;
+
+    // スレッドごとのバッファに残したレコードと、FileSinkのバッファ内のレコードがレポートに含まれるか
+    const std::filesystem::path crashPath = std::filesystem::temp_directory_path() / "RenderingSandbox_crash_test.log";
+    {
+        auto crashSink = std::make_shared<FileSink>(crashPath, false);
+        crashSink->SetBuffered(true);
+        const LogSinkHandle crashHandle = logger.AddSink(crashSink);
+        logger.Log(LogLevel::Info, "LoggerTest", "Buffered before crash");
+        logger.EnableThreadBuffers();
+        logger.Log(LogLevel::Warning, "LoggerTest", "Pending at crash");
+        // レポートはこのSinkにだけ書き出す（アプリのログ・コンソールに偽のクラッシュレポートを残さない）
+        ILogSink* const reportSinks[] = { crashSink.get() };
+        LogCrashHandler::WriteReport("simulated by Logger Test 11", reportSinks, std::size(reportSinks));
+        logger.RemoveSink(crashHandle);
+        logger.DisableThreadBuffers();
+    }
+    std::ifstream crashFile(crashPath);
+    const std::string crashReport((std::istreambuf_iterator<char>(crashFile)), std::istreambuf_iterator<char>());
+    crashFile.close();
+    std::filesystem::remove(crashPath);
+
+    const size_t bufferedPos = crashReport.find("Buffered before crash");
+    const size_t headerPos = crashReport.find("*** Crash: simulated by Logger Test 11 ***");
+    const size_t pendingPos = crashReport.find("[WARN ] [LoggerTest] Pending at crash");
+    const size_t backtracePos = crashReport.find("*** Backtrace ***");
+    std::cout << "  - Report: " << crashReport.size() << " bytes" << std::endl;
+    std::cout << (bufferedPos < headerPos && headerPos < pendingPos && pendingPos < backtracePos && backtracePos != std::string::npos
+        ? "  SUCCESS: buffered and pending records written before the backtrace" : "  FAILED: crash report incomplete") << std::endl;
+    std::cout << std::endl;
+
+    // テスト12: スコープ時間計測（しきい値と呼び出し箇所ごとの集計）
+    std::cout << "[Logger Test 12] Scope timers" << std::endl;
+
+    // LOG_*マクロはコンパイル時しきい値（LogCompileLevel.h）で取り除かれる場合がある
+    if (!LogIsCompiledIn(LogLevel::Info, "LoggerTest")) {
+        std::cout << "  SKIPPED: LOG_* macros are compiled out in this build" << std::endl;
+    } else {
+        std::vector<LogMessage> timerMessages;
+        std::string timerSummary;
+        {
+            ScopedLogCapture capture;
+            {
+                LOG_SCOPE_TIMER_SLOW("LoggerTest", "Slow scope", 0);
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            {
+                // しきい値未満のため出力されない
+                LOG_SCOPE_TIMER_SLOW("LoggerTest", "Fast scope", 10000);
+            }
+            for (int i = 0; i < 3; ++i) {
+                LOG_SCOPE_TIMER_ACCUM("LoggerTest", "Accumulated scope");
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            logger.Flush();
+            timerMessages = capture.GetSink().TakeMessages();
+        }
+
+        bool timerMatch = false;
+        bool summaryMatch = false;
+        size_t timerRecords = 0;
+        for (const LogMessage& timerMessage : timerMessages) {
+            const std::string text = timerMessage.Format();
+            if (text.find("Fast scope") != std::string::npos) {
+                timerMatch = false;
+                break;
+            }
+            if (text.find("[WARN ] [LoggerTest] Slow scope elapsed=") != std::string::npos) {
+                std::cout << "  - Timer: " << text << std::endl;
+                timerMatch = text.find("ms (TestLogger.cpp:") != std::string::npos;
+                ++timerRecords;
+            }
+            if (text.find("Scope timer summary") != std::string::npos) {
+                timerSummary = text;
+            }
+        }
+        std::cout << (timerMatch && timerRecords == 1
+            ? "  SUCCESS: one record at scope exit, fast scope suppressed" : "  FAILED: unexpected timer records") << std::endl;
+
+        if (!timerSummary.empty()) {
+            std::cout << "  - Summary:\n" << timerSummary << std::endl;
+            const size_t rowPos = timerSummary.find("Accumulated scope");
+            summaryMatch = timerSummary.find("Count") != std::string::npos
+                && rowPos != std::string::npos
+                && timerSummary.find(" 3  ", rowPos) != std::string::npos
+                && timerSummary.find("(TestLogger.cpp:", rowPos) != std::string::npos;
+        }
+        std::cout << (summaryMatch ? "  SUCCESS: per-site summary written at Flush" : "  FAILED: scope summary missing") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト13: 非同期モード（小さいキューに複数スレッドから書き込み、満杯時のポリシーごとに件数と順序を確認）
+    std::cout << "[Logger Test 13] Async queue" << std::endl;
+
+    {
+        constexpr int kProducers = 4;
+        constexpr int kPerProducer = 250;
+        constexpr size_t kQueueCapacity = 16;
+        static constexpr std::string_view kAsyncCategory = "LoggerAsyncTest";
+        const std::pair<LogOverflowPolicy, const char*> policies[] = {
+            { LogOverflowPolicy::Block, "Block" },
+            { LogOverflowPolicy::DropNewest, "DropNewest" },
+            { LogOverflowPolicy::DropOldest, "DropOldest" } };
+
+        bool asyncMatch = true;
+        for (const auto& [policy, name] : policies) {
+            ScopedLogCapture capture(LogLevel::Trace, kProducers * kPerProducer + 16);
+            const uint64_t droppedBefore = logger.GetDroppedCount();
+            logger.EnableAsync(kQueueCapacity, policy);
+
+            std::vector<std::thread> asyncProducers;
+            for (int t = 0; t < kProducers; ++t) {
+                asyncProducers.emplace_back([&logger, t] {
+                    for (int i = 0; i < kPerProducer; ++i) {
+                        logger.Log(LogLevel::Info, kAsyncCategory, "Async " + std::to_string(t) + " " + std::to_string(i));
+                    }
+                });
+            }
+            for (std::thread& producer : asyncProducers) {
+                producer.join();
+            }
+
+            // Flushは呼び出し時点までに積まれたレコードの配信完了を待つ
+            logger.Flush();
+            const SequenceCheck flushed = CheckSequences(capture.GetSink().TakeMessages(), kAsyncCategory, kProducers);
+            const uint64_t dropped = logger.GetDroppedCount() - droppedBefore;
+
+            // DisableAsyncはキューに残ったレコードを配信してから戻る
+            for (int i = 0; i < 8; ++i) {
+                logger.Log(LogLevel::Info, kAsyncCategory, "Async 0 " + std::to_string(kPerProducer + i));
+            }
+            logger.DisableAsync();
+            const SequenceCheck drained = CheckSequences(capture.GetSink().TakeMessages(), kAsyncCategory, kProducers);
+            const uint64_t drainDropped = logger.GetDroppedCount() - droppedBefore - dropped;
+
+            std::cout << "  - " << name << ": delivered " << flushed.count << ", dropped " << dropped
+                      << ", drained at disable " << drained.count << " + dropped " << drainDropped << std::endl;
+            asyncMatch = asyncMatch && !logger.IsAsync() && flushed.ordered && drained.ordered
+                && flushed.count + dropped == static_cast<uint64_t>(kProducers * kPerProducer)
+                && drained.count + drainDropped == 8
+                && (policy != LogOverflowPolicy::Block || (dropped == 0 && drainDropped == 0));
+        }
+        std::cout << (asyncMatch ? "  SUCCESS: delivered + dropped = sent, per-thread order kept"
+                                 : "  FAILED: unexpected async delivery") << std::endl;
+
+        // 生産者が書き込んでいる最中に無効化しても、積みかけのレコードを失わずスレッド内の順序も保つ
+        {
+            ScopedLogCapture capture(LogLevel::Trace, kProducers * kPerProducer + 16);
+            const uint64_t droppedBefore = logger.GetDroppedCount();
+            logger.EnableAsync(kQueueCapacity, LogOverflowPolicy::Block);
+
+            std::atomic<int> started{ 0 };
+            std::vector<std::thread> asyncProducers;
+            for (int t = 0; t < kProducers; ++t) {
+                asyncProducers.emplace_back([&logger, &started, t] {
+                    started.fetch_add(1);
+                    for (int i = 0; i < kPerProducer; ++i) {
+                        logger.Log(LogLevel::Info, kAsyncCategory, "Async " + std::to_string(t) + " " + std::to_string(i));
+                    }
+                });
+            }
+            while (started.load() < kProducers) {
+                std::this_thread::yield();
+            }
+            logger.DisableAsync();
+            for (std::thread& producer : asyncProducers) {
+                producer.join();
+            }
+            logger.Flush();
+
+            const SequenceCheck live = CheckSequences(capture.GetSink().TakeMessages(), kAsyncCategory, kProducers);
+            const bool liveMatch = !logger.IsAsync() && live.ordered
+                && live.count == static_cast<size_t>(kProducers * kPerProducer)
+                && logger.GetDroppedCount() == droppedBefore;
+            std::cout << "  - Disable while producing: delivered " << live.count << std::endl;
+            std::cout << (liveMatch ? "  SUCCESS: no records lost when disabled under load"
+                                    : "  FAILED: records lost when disabled under load") << std::endl;
+        }
+    }
+    std::cout << std::endl;
+
+    // テスト14: カテゴリレジストリ（ハンドルの払い出し、レベル表の更新、上限超過）とコンパイル時しきい値
+    std::cout << "[Logger Test 14] Category registry" << std::endl;
+
+    {
+        auto registry = std::make_unique<LogCategoryRegistry>();
+        registry->SetGlobalLevel(LogLevel::Info);
+
+        const LogCategoryId renderer = registry->Register("Renderer");
+        const LogCategoryId audio = registry->Register("Audio");
+        const bool handleMatch = registry->Register("") == LogCategoryRegistry::kDefaultCategory
+            && renderer != LogCategoryRegistry::kDefaultCategory && renderer != audio
+            && registry->Register(std::string("Renderer")) == renderer
+            && registry->GetName(renderer) == "Renderer" && registry->GetName(audio) == "Audio"
+            && registry->GetName(static_cast<LogCategoryId>(registry->GetCount())).empty();
+
+        // 個別設定はグローバルレベルの変更で上書きされず、クリアするとグローバルレベルに戻る
+        registry->SetLevel(renderer, LogLevel::Error);
+        registry->SetGlobalLevel(LogLevel::Debug);
+        bool levelMatch = registry->GetMinLevel(renderer) == LogLevel::Error
+            && registry->GetMinLevel(audio) == LogLevel::Debug
+            && registry->FindMinLevel("Renderer") == LogLevel::Error
+            && registry->FindMinLevel("Unregistered") == LogLevel::Debug
+            && registry->Register("Late") != LogCategoryRegistry::kInvalidCategory
+            && registry->FindMinLevel("Late") == LogLevel::Debug;
+        registry->ClearLevel(renderer);
+        levelMatch = levelMatch && registry->GetMinLevel(renderer) == LogLevel::Debug;
+
+        // 上限を超えた登録は無効ハンドルになり、既定カテゴリの設定には影響しない
+        for (size_t i = 4; i < LogCategoryRegistry::kMaxCategories; ++i) {
+            registry->Register("Category" + std::to_string(i));
+        }
+        const LogCategoryId overflow = registry->Register("Overflow");
+        registry->SetLevel(overflow, LogLevel::Fatal);
+        registry->SetLevel(LogCategoryRegistry::kDefaultCategory, LogLevel::Warning);
+        registry->SetGlobalLevel(LogLevel::Error);
+        const bool overflowMatch = overflow == LogCategoryRegistry::kInvalidCategory
+            && registry->Register("Overflow2") == LogCategoryRegistry::kInvalidCategory
+            && registry->Register("Audio") == audio
+            && registry->GetName(overflow).empty()
+            && registry->GetMinLevel(overflow) == LogLevel::Error
+            && registry->GetMinLevel(LogCategoryRegistry::kDefaultCategory) == LogLevel::Warning
+            && registry->FindMinLevel("Overflow") == LogLevel::Error;
+
+        std::cout << "  - Compile threshold: " << LOG_COMPILE_MIN_LEVEL
+                  << ", LoggerTest Info compiled in: " << (LogIsCompiledIn(LogLevel::Info, "LoggerTest") ? "yes" : "no") << std::endl;
+        std::cout << (handleMatch ? "  SUCCESS: handles interned and reused" : "  FAILED: handle registration") << std::endl;
+        std::cout << (levelMatch ? "  SUCCESS: overrides kept across global level changes" : "  FAILED: level table") << std::endl;
+        std::cout << (overflowMatch ? "  SUCCESS: overflow returns invalid handle following global level"
+                                    : "  FAILED: category overflow") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト15: スレッドごとのバッファ（k-wayマージの時刻順・スレッド内の順序、上限に達した時のポリシー）
+    std::cout << "[Logger Test 15] Thread buffers" << std::endl;
+
+    {
+        constexpr int kBufferThreads = 4;
+        constexpr int kPerBufferThread = 200;
+        static constexpr std::string_view kBufferCategory = "LoggerThreadBufferTest";
+
+        bool mergeMatch = false;
+        {
+            ScopedLogCapture capture(LogLevel::Trace, kBufferThreads * kPerBufferThread + 16);
+            logger.EnableThreadBuffers();
+
+            std::vector<std::thread> bufferProducers;
+            for (int t = 0; t < kBufferThreads; ++t) {
+                bufferProducers.emplace_back([&logger, t] {
+                    for (int i = 0; i < kPerBufferThread; ++i) {
+                        logger.Log(LogLevel::Info, kBufferCategory, "Buffered " + std::to_string(t) + " " + std::to_string(i));
+                    }
+                });
+            }
+            for (std::thread& producer : bufferProducers) {
+                producer.join();
+            }
+
+            logger.CollectThreadBuffers();
+            const std::vector<LogMessage> merged = capture.GetSink().TakeMessages();
+            logger.DisableThreadBuffers();
+
+            bool timeOrdered = true;
+            std::chrono::system_clock::time_point previous{};
+            for (const LogMessage& record : merged) {
+                if (record.category == kBufferCategory) {
+                    timeOrdered = timeOrdered && record.timestamp >= previous;
+                    previous = record.timestamp;
+                }
+            }
+            const SequenceCheck sequences = CheckSequences(merged, kBufferCategory, kBufferThreads);
+            std::cout << "  - Merged " << sequences.count << " records from " << kBufferThreads << " threads" << std::endl;
+            mergeMatch = timeOrdered && sequences.ordered && sequences.count == static_cast<size_t>(kBufferThreads * kPerBufferThread);
+        }
+
+        // 上限10レコード分のバッファに1スレッドから50件積む
+        constexpr int kBudgetRecords = 10;
+        constexpr int kBudgetSent = 50;
+        struct BudgetCase {
+            LogOverflowPolicy policy;
+            const char* name;
+            int firstIndex;             // 配信される最初の連番
+            uint64_t dropped;           // 破棄される件数
+        };
+        const BudgetCase budgetCases[] = {
+            { LogOverflowPolicy::Block, "Block", 0, 0 },
+            { LogOverflowPolicy::DropNewest, "DropNewest", 0, kBudgetSent - kBudgetRecords },
+            { LogOverflowPolicy::DropOldest, "DropOldest", kBudgetSent - kBudgetRecords, kBudgetSent - kBudgetRecords } };
+
+        bool budgetMatch = true;
+        for (const BudgetCase& budgetCase : budgetCases) {
+            ScopedLogCapture capture(LogLevel::Trace, kBudgetSent + 16);
+            const uint64_t droppedBefore = logger.GetDroppedCount();
+            logger.EnableThreadBuffers(kBudgetRecords * sizeof(LogMessage), budgetCase.policy);
+            for (int i = 0; i < kBudgetSent; ++i) {
+                logger.Log(LogLevel::Info, kBufferCategory, "Budget 0 " + std::to_string(i));
+            }
+            logger.DisableThreadBuffers();
+            const uint64_t dropped = logger.GetDroppedCount() - droppedBefore;
+
+            std::vector<int> indices;
+            for (const LogMessage& record : capture.GetSink().TakeMessages()) {
+                if (record.category == kBufferCategory) {
+                    int thread = -1;
+                    int index = -1;
+                    if (std::sscanf(std::string(record.GetText()).c_str(), "%*s %d %d", &thread, &index) == 2) {
+                        indices.push_back(index);
+                    }
+                }
+            }
+            bool contiguous = indices.size() == static_cast<size_t>(kBudgetSent) - budgetCase.dropped;
+            for (size_t i = 0; contiguous && i < indices.size(); ++i) {
+                contiguous = indices[i] == budgetCase.firstIndex + static_cast<int>(i);
+            }
+            std::cout << "  - " << budgetCase.name << ": delivered " << indices.size() << ", dropped " << dropped << std::endl;
+            budgetMatch = budgetMatch && contiguous && dropped == budgetCase.dropped;
+        }
+
+        // 配信中のSinkがログを出す（Blockポリシーで上限を超えても回収を再入せず、次の回収で配信される）
+        size_t echoed = 0;
+        size_t echoSources = 0;
+        {
+            ScopedLogCapture capture(LogLevel::Trace, kBudgetSent * 3 + 16);
+            const LogSinkHandle echoHandle = logger.AddSink(std::make_shared<EchoSink>());
+            logger.EnableThreadBuffers(kBudgetRecords * sizeof(LogMessage), LogOverflowPolicy::Block);
+            for (int i = 0; i < kBudgetSent; ++i) {
+                logger.Log(LogLevel::Info, kBufferCategory, "Echo source " + std::to_string(i));
+            }
+            logger.DisableThreadBuffers();
+            logger.RemoveSink(echoHandle);
+            for (const LogMessage& record : capture.GetSink().TakeMessages()) {
+                echoed += record.category == "LoggerThreadBufferEcho" ? 1 : 0;
+                echoSources += record.category == kBufferCategory ? 1 : 0;
+            }
+        }
+        std::cout << "  - Logging sink: delivered " << echoSources << ", echoed " << echoed << std::endl;
+
+        std::cout << (mergeMatch ? "  SUCCESS: merged in timestamp order, per-thread order kept"
+                                 : "  FAILED: merge order") << std::endl;
+        std::cout << (budgetMatch ? "  SUCCESS: budget policies keep the expected records"
+                                  : "  FAILED: budget policies") << std::endl;
+        std::cout << (echoSources == static_cast<size_t>(kBudgetSent) && echoed == echoSources * 2
+            ? "  SUCCESS: sinks can log while thread buffers are delivered"
+            : "  FAILED: logging from a sink during delivery") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト16: Sinkの中からのSink付け替え（自身の配信の終了を待つデッドロックにならず拒否される）
+    std::cout << "[Logger Test 16] Sink changes from inside a sink" << std::endl;
+
+    {
+        auto reentrant = std::make_shared<ReentrantSink>();
+        reentrant->handle = logger.AddSink(reentrant);
+        logger.Log(LogLevel::Info, "LoggerReentrantTest", "Reentrant write");
+        logger.Flush();
+        const bool stillRegistered = logger.RemoveSink(reentrant->handle) == reentrant;
+        std::cout << (reentrant->rejected && reentrant->writes == 1 && stillRegistered
+            ? "  SUCCESS: AddSink/RemoveSink/ClearSinks rejected inside Write"
+            : "  FAILED: sink changes inside Write") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト17: 遅延フォーマット（配信前に破棄される一時文字列の引数、Sinkへの配信前に一度だけ本文を生成）
+    std::cout << "[Logger Test 17] Deferred format argument lifetime" << std::endl;
+
+    {
+        constexpr int kDeferredRecords = 32;
+        auto deferredSink = std::make_shared<PreformattedCheckSink>();
+        const LogSinkHandle deferredHandle = logger.AddSink(deferredSink);
+        const LogCategoryId deferredCategory = logger.RegisterCategory("LoggerDeferredTest");
+
+        // 一時文字列（SSOに収まらない長さ）は文の終わりで破棄され、レコードはドレインスレッドで整形される
+        logger.EnableAsync(16, LogOverflowPolicy::Block);
+        for (int i = 0; i < kDeferredRecords; ++i) {
+            logger.LogFormat(LogLevel::Info, deferredCategory, "TestLogger.cpp", __LINE__,
+                "Deferred {} {} {:.1f}", "temporary-" + std::to_string(i) + std::string(40, 'x'), i, i * 0.5);
+        }
+        logger.DisableAsync();
+        logger.RemoveSink(deferredHandle);
+
+        bool lifetimeMatch = deferredSink->texts.size() == kDeferredRecords;
+        for (size_t i = 0; lifetimeMatch && i < deferredSink->texts.size(); ++i) {
+            lifetimeMatch = deferredSink->texts[i] == std::format("Deferred temporary-{}{} {} {:.1f}",
+                i, std::string(40, 'x'), i, static_cast<double>(i) * 0.5);
+        }
+        std::cout << "  - Sample: " << (deferredSink->texts.empty() ? std::string() : deferredSink->texts.back()) << std::endl;
+        std::cout << (lifetimeMatch ? "  SUCCESS: arguments copied before the temporaries were destroyed"
+                                    : "  FAILED: deferred arguments") << std::endl;
+        std::cout << (deferredSink->preformatted ? "  SUCCESS: text formatted once before the first sink"
+                                                 : "  FAILED: text formatted inside a sink") << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "### Logger Test Completed ###" << std::endl;
+    std::cout << std::endl;
+}
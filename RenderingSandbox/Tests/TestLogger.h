@@ -0,0 +1,4 @@
+#pragma once
+
+// Loggerのテスト関数
+void RunLoggerTest();
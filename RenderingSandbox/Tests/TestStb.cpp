@@ -2,10 +2,8 @@
 
 #include "TestStb.h"
 
-#define STB_IMAGE_IMPLEMENTATION
+// 実装部はCommon/Src/Texture/StbImplementation.cppに置く
 #include "stb/stb_image.h"
-
-#define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include "stb/stb_image_resize2.h"
 
 #include <iostream>
@@ -0,0 +1,1101 @@
+// テクスチャ読み込み・加工の動作確認・性能測定テスト
+
+#include "TestTexture.h"
+#include "Texture/BlockCompressor.h"
+#include "Texture/BptcCodec.h"
+#include "Texture/MipChainBuilder.h"
+#include "Texture/TextureFileSource.h"
+#include "Texture/TextureLoader.h"
+#include "stb/stb_image.h"
+#include "stb/stb_image_resize2.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace RenderingSandbox;
+
+/// <summary>
+/// 非圧縮24bit TGA（左上原点）を作成
+/// 画素は (x * 16, y * 16, x + y) のグラデーション
+/// </summary>
+std::vector<uint8_t> MakeTestTga(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> tga = {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        static_cast<uint8_t>(width), static_cast<uint8_t>(width >> 8),
+        static_cast<uint8_t>(height), static_cast<uint8_t>(height >> 8),
+        24, 0x20 };
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            // TGAはBGRの順
+            tga.push_back(static_cast<uint8_t>(x + y));
+            tga.push_back(static_cast<uint8_t>(y * 16));
+            tga.push_back(static_cast<uint8_t>(x * 16));
+        }
+    }
+    return tga;
+}
+
+/// <summary>
+/// MakeTestTgaの画素をRGBAとして比較
+/// </summary>
+bool MatchesTestPattern(const TextureImage& image, bool flipped) {
+    if (!image.IsValid() || image.channels != 4 || image.sourceChannels != 3 || image.componentType != TextureComponentType::UInt8) {
+        return false;
+    }
+    const uint8_t* pixels = image.pixels.get();
+    for (uint32_t row = 0; row < image.height; ++row) {
+        const uint32_t y = flipped ? image.height - 1 - row : row;
+        for (uint32_t x = 0; x < image.width; ++x) {
+            const uint8_t* p = pixels + row * image.GetRowPitch() + x * 4;
+            if (p[0] != static_cast<uint8_t>(x * 16) || p[1] != static_cast<uint8_t>(y * 16)
+                || p[2] != static_cast<uint8_t>(x + y) || p[3] != 255) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// PNGのチャンク（長さ・種類・データ・CRC）を追加
+/// </summary>
+void AppendPngChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data) {
+    static const std::array<uint32_t, 256> crcTable = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return table;
+    }();
+    auto appendU32 = [&png](uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            png.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    };
+
+    appendU32(static_cast<uint32_t>(data.size()));
+    const size_t typeOffset = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = typeOffset; i < png.size(); ++i) {
+        crc = crcTable[(crc ^ png[i]) & 0xFF] ^ (crc >> 8);
+    }
+    appendU32(crc ^ 0xFFFFFFFFu);
+}
+
+/// <summary>
+/// 無圧縮（deflateのstoredブロック）のRGBA PNGを作成
+/// 展開がほぼコピーだけになるため、ファイル入出力の差が測りやすい
+/// </summary>
+std::vector<uint8_t> MakeStoredPng(uint32_t width, uint32_t height, uint32_t seed) {
+    // フィルタ種別（0）＋RGBAの行
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(width * 4 + 1) * height);
+    uint32_t state = seed * 2654435761u + 1;
+    for (uint32_t y = 0; y < height; ++y) {
+        raw.push_back(0);
+        for (uint32_t x = 0; x < width * 4; ++x) {
+            state = state * 1664525u + 1013904223u;
+            raw.push_back(static_cast<uint8_t>(state >> 24));
+        }
+    }
+
+    std::vector<uint8_t> idat = { 0x78, 0x01 };
+    for (size_t offset = 0; offset < raw.size(); offset += 65535) {
+        const size_t length = std::min<size_t>(65535, raw.size() - offset);
+        idat.push_back(offset + length == raw.size() ? 1 : 0);
+        idat.push_back(static_cast<uint8_t>(length));
+        idat.push_back(static_cast<uint8_t>(length >> 8));
+        idat.push_back(static_cast<uint8_t>(~length));
+        idat.push_back(static_cast<uint8_t>(~length >> 8));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (uint8_t value : raw) {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    const uint32_t adler = (b << 16) | a;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        idat.push_back(static_cast<uint8_t>(adler >> shift));
+    }
+
+    std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const std::vector<uint8_t> header = {
+        static_cast<uint8_t>(width >> 24), static_cast<uint8_t>(width >> 16), static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width),
+        static_cast<uint8_t>(height >> 24), static_cast<uint8_t>(height >> 16), static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+        8, 6, 0, 0, 0 };
+    AppendPngChunk(png, "IHDR", header);
+    AppendPngChunk(png, "IDAT", idat);
+    AppendPngChunk(png, "IEND", {});
+    return png;
+}
+
+/// <summary>
+/// 画素データのハッシュ（FNV-1a）
+/// </summary>
+uint64_t HashPixels(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/// <summary>
+/// 1スレッドで画像群を読み込んでデコードし、所要時間と画素のハッシュを返す
+/// readModeを指定しない場合はstbi_load（stdio経由）を使う
+/// </summary>
+double MeasureDecode(const std::vector<std::filesystem::path>& paths, const TextureFileReadMode* readMode, uint64_t& hash) {
+    std::vector<uint8_t> scratch;
+    std::vector<TextureImage> images;
+    images.reserve(paths.size());
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (const std::filesystem::path& path : paths) {
+        if (readMode) {
+            TextureLoadOptions options;
+            options.readMode = *readMode;
+            images.push_back(TextureLoader::LoadFile(path, options, scratch));
+        }
+        else {
+            TextureImage image;
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            image.pixels.reset(stbi_load(path.string().c_str(), &width, &height, &channels, 4));
+            image.width = static_cast<uint32_t>(width);
+            image.height = static_cast<uint32_t>(height);
+            image.channels = 4;
+            images.push_back(std::move(image));
+        }
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    hash = 0;
+    for (const TextureImage& image : images) {
+        hash = hash * 31 + (image.IsValid() ? HashPixels(image.pixels.get(), image.GetSizeInBytes()) : 0);
+    }
+    return elapsed.count();
+}
+
+/// <summary>
+/// stdio・一括読み込み・メモリマップの3通りで画像群の読み込み＋デコード時間を比較
+/// </summary>
+bool CompareReadModes(const char* label, const std::vector<std::filesystem::path>& paths) {
+    uintmax_t totalBytes = 0;
+    for (const std::filesystem::path& path : paths) {
+        totalBytes += std::filesystem::file_size(path);
+    }
+    const double megabytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+
+    const TextureFileReadMode readMode = TextureFileReadMode::Read;
+    const TextureFileReadMode mapMode = TextureFileReadMode::Map;
+    uint64_t stdioHash = 0;
+    uint64_t readHash = 0;
+    uint64_t mapHash = 0;
+    // 1回目はページキャッシュを温めるため計測に使わない
+    MeasureDecode(paths, nullptr, stdioHash);
+    const double stdioTime = MeasureDecode(paths, nullptr, stdioHash);
+    const double readTime = MeasureDecode(paths, &readMode, readHash);
+    const double mapTime = MeasureDecode(paths, &mapMode, mapHash);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  - " << label << ": " << paths.size() << " files, " << megabytes << " MB" << std::endl;
+    std::cout << "    stbi_load (stdio): " << std::setw(8) << stdioTime << " ms (" << megabytes * 1000.0 / stdioTime << " MB/s)" << std::endl;
+    std::cout << "    pread + memory:    " << std::setw(8) << readTime << " ms (" << megabytes * 1000.0 / readTime << " MB/s)" << std::endl;
+    std::cout << "    mmap + memory:     " << std::setw(8) << mapTime << " ms (" << megabytes * 1000.0 / mapTime << " MB/s)" << std::endl;
+    std::cout << std::defaultfloat;
+    return stdioHash != 0 && stdioHash == readHash && stdioHash == mapHash;
+}
+
+/// <summary>
+/// stbir_resize_uint8_srgbをレベルごとに呼んでミップチェーンを作る（比較用の素朴な実装）
+/// 呼び出しごとにサンプラーの構築と出力の確保が行われる
+/// </summary>
+std::vector<std::vector<uint8_t>> BuildNaiveMips(const std::vector<uint8_t>& base, uint32_t width, uint32_t height) {
+    std::vector<std::vector<uint8_t>> levels;
+    levels.push_back(base);
+    while (width > 1 || height > 1) {
+        const uint32_t nextWidth = std::max(1u, width / 2);
+        const uint32_t nextHeight = std::max(1u, height / 2);
+        unsigned char* resized = stbir_resize_uint8_srgb(levels.back().data(), static_cast<int>(width), static_cast<int>(height), 0,
+            nullptr, static_cast<int>(nextWidth), static_cast<int>(nextHeight), 0, STBIR_RGBA);
+        levels.emplace_back(resized, resized + static_cast<size_t>(nextWidth) * nextHeight * 4);
+        free(resized);
+        width = nextWidth;
+        height = nextHeight;
+    }
+    return levels;
+}
+
+/// <summary>
+/// 写真に近い圧縮テスト用のRGBA8画像を作成（なめらかなグラデーション＋細かい模様＋ノイズ、アルファは斜めのグラデーション）
+/// </summary>
+std::vector<uint8_t> MakeCompressionTestImage(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    uint32_t state = 24680;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            state = state * 1664525u + 1013904223u;
+            const int noise = static_cast<int>(state >> 29) - 4;
+            const double wave = std::sin(x * 0.05) * std::cos(y * 0.03);
+            uint8_t* p = pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+            p[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(128 + 100 * wave) + noise, 0, 255));
+            p[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(x * 255 / width) + noise, 0, 255));
+            p[2] = static_cast<uint8_t>(std::clamp(static_cast<int>(y * 255 / height + ((x / 8 + y / 8) % 2) * 32) + noise, 0, 255));
+            p[3] = static_cast<uint8_t>((x + y) * 255 / (width + height));
+        }
+    }
+    return pixels;
+}
+
+/// <summary>
+/// 2枚のRGBA8画像のPSNRを計算（channelsは比較するチャンネル数。先頭から数える）
+/// </summary>
+double ComputePsnr(const std::vector<uint8_t>& expected, const std::vector<uint8_t>& actual, int channels) {
+    double squaredError = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < expected.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            const double d = static_cast<double>(expected[i + c]) - actual[i + c];
+            squaredError += d * d;
+            ++count;
+        }
+    }
+    if (squaredError == 0.0) {
+        return 99.0;
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / (squaredError / static_cast<double>(count)));
+}
+
+/// <summary>
+/// 半精度浮動小数点のビット列をfloatに変換
+/// </summary>
+float HalfToFloat(uint16_t half) {
+    const int exponent = (half >> 10) & 31;
+    const int mantissa = half & 1023;
+    const float sign = (half & 0x8000) != 0 ? -1.0f : 1.0f;
+    if (exponent == 0) {
+        return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    if (exponent == 31) {
+        return mantissa == 0 ? sign * INFINITY : NAN;
+    }
+    return sign * std::ldexp(static_cast<float>(mantissa + 1024), exponent - 25);
+}
+
+/// <summary>
+/// floatを半精度浮動小数点のビット列に変換（0〜65504の正の正規化数のみ。仮数は切り捨て）
+/// </summary>
+uint16_t FloatToHalf(float value) {
+    int exponent = 0;
+    const float mantissa = std::frexp(std::clamp(value, 0.0f, 65504.0f), &exponent);
+    if (value <= 0.0f || exponent < -13) {
+        return 0;
+    }
+    return static_cast<uint16_t>(((exponent + 14) << 10) | (static_cast<int>(mantissa * 2048.0f) & 1023));
+}
+
+/// <summary>
+/// 正距円筒図法のHDRの空をRadiance HDR（.hdr、非圧縮のRGBE）として作成
+/// 地平線から天頂へのグラデーション＋縞状の雲＋暗い地面＋非常に明るい太陽（約20000）とその周りの光芒
+/// </summary>
+std::vector<uint8_t> MakeHdrSky(uint32_t width, uint32_t height) {
+    const std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " + std::to_string(height) + " +X " + std::to_string(width) + "\n";
+    std::vector<uint8_t> file(header.begin(), header.end());
+    file.resize(header.size() + static_cast<size_t>(width) * height * 4);
+    uint8_t* rgbe = file.data() + header.size();
+
+    constexpr double kPi = 3.14159265358979323846;
+    const double sunElevation = 0.5;
+    const double sunAzimuth = 1.0;
+    const double sun[3] = { std::cos(sunElevation) * std::cos(sunAzimuth), std::sin(sunElevation), std::cos(sunElevation) * std::sin(sunAzimuth) };
+    for (uint32_t y = 0; y < height; ++y) {
+        const double elevation = kPi * 0.5 - (y + 0.5) * kPi / height;
+        for (uint32_t x = 0; x < width; ++x) {
+            const double azimuth = (x + 0.5) * 2.0 * kPi / width;
+            const double direction[3] = { std::cos(elevation) * std::cos(azimuth), std::sin(elevation), std::cos(elevation) * std::sin(azimuth) };
+            double color[3];
+            if (elevation > 0.0) {
+                const double t = std::pow(std::sin(elevation), 0.5);
+                const double horizon[3] = { 1.6, 1.4, 1.2 };
+                const double zenith[3] = { 0.15, 0.35, 0.9 };
+                const double cloud = std::max(0.0, std::sin(azimuth * 12.0 + std::sin(elevation * 20.0) * 2.0) * std::cos(elevation * 9.0)) * (1.0 - t);
+                for (int c = 0; c < 3; ++c) {
+                    color[c] = horizon[c] + (zenith[c] - horizon[c]) * t + cloud * 2.5;
+                }
+            }
+            else {
+                const double ground[3] = { 0.08, 0.06, 0.04 };
+                const double stripes = 1.0 + 0.3 * std::sin(azimuth * 200.0) * std::sin(elevation * 150.0);
+                for (int c = 0; c < 3; ++c) {
+                    color[c] = ground[c] * stripes;
+                }
+            }
+            const double cosine = direction[0] * sun[0] + direction[1] * sun[1] + direction[2] * sun[2];
+            const double glow = 8.0 * std::pow(std::max(cosine, 0.0), 400.0);
+            const double disk = cosine > std::cos(0.01) ? 20000.0 : 0.0;
+            for (int c = 0; c < 3; ++c) {
+                color[c] += glow + disk;
+            }
+
+            // RGBE: 共通の指数と、最大の成分が128〜255になる仮数
+            uint8_t* pixel = rgbe + (static_cast<size_t>(y) * width + x) * 4;
+            const double maxComponent = std::max({ color[0], color[1], color[2] });
+            int exponent = 0;
+            const double scale = std::frexp(maxComponent, &exponent) * 256.0 / maxComponent;
+            for (int c = 0; c < 3; ++c) {
+                pixel[c] = static_cast<uint8_t>(color[c] * scale);
+            }
+            pixel[3] = static_cast<uint8_t>(exponent + 128);
+        }
+    }
+    return file;
+}
+
+/// <summary>
+/// HDR画像の誤差（floatのRGBA画像の矩形と、展開した半精度のRGBA画像を比べる）
+/// </summary>
+struct HdrError {
+    double meanRelative = 0.0;      // 相対誤差 |展開 - 元| / max(元, 1/1024) の平均
+    double log2Rmse = 0.0;          // log2(1 + 値) の二乗平均平方根誤差
+};
+
+HdrError ComputeHdrError(const float* expected, size_t expectedRowPitch, const uint16_t* actual, uint32_t width, uint32_t height) {
+    double relative = 0.0;
+    double log2Squared = 0.0;
+    for (uint32_t y = 0; y < height; ++y) {
+        const float* expectedRow = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(expected) + y * expectedRowPitch);
+        for (uint32_t x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                const double original = expectedRow[x * 4 + c];
+                const double decoded = HalfToFloat(actual[(static_cast<size_t>(y) * width + x) * 4 + c]);
+                relative += std::abs(decoded - original) / std::max(original, 1.0 / 1024.0);
+                const double d = std::log2(1.0 + decoded) - std::log2(1.0 + original);
+                log2Squared += d * d;
+            }
+        }
+    }
+    const double count = static_cast<double>(width) * height * 3;
+    return { relative / count, std::sqrt(log2Squared / count) };
+}
+
+/// <summary>
+/// 16進文字列をバイト列に変換
+/// </summary>
+std::vector<uint8_t> ParseHexBytes(std::string_view hex) {
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(std::stoi(std::string(hex.substr(i * 2, 2)), nullptr, 16));
+    }
+    return bytes;
+}
+
+/// <summary>
+/// BC6H/BC7の既知解（ブロックと展開結果の16進文字列）
+/// 展開結果は独立した参照デコーダ（Pillow 12.3のBcnDecode）の出力で、ブロックは各モードの乱数ビット列
+/// </summary>
+struct BptcKnownAnswer {
+    int mode;                       // モード番号（BptcCodec::GetBC7Mode・GetBC6HModeの値）
+    const char* block;              // ブロック（16バイト）
+    const char* expected;           // 展開結果（BC7はRGBA8の64バイト、BC6HはToReferenceUnorm8で変換したRGB8の48バイト）
+};
+
+const BptcKnownAnswer kBc7KnownAnswers[] = {
+    { 0, "c1ad13c68d0dbb67f30084faaa33fe32",
+        "e7e7d6ff9b9b77ffc3aaacffba9ca7ff636331ffc2c2a8ffa77f9dff9d7199ffd4d4bfff18aa46ff21b835ff946394ff39de08ff109d55ff31d117ff008473ff" },
+    { 1, "86885d9bf844f1f45220a5e3c45cae11",
+        "3ccebcff56b9a5ffdb4e2eff22e3d3ff99f120ffb2ad1bffd55014ffbc9419ffc16345ffa7785cff8d8d74ff70a48dffaac41dffcd6716ffc47d17ffd55014ff" },
+    { 2, "4c6af523084e1944d04ddba1c9525a72",
+        "add180ffade773ffada59cffadbb8ffff763b5ffae6ec8ffae6ec8ff6179dcfff763b5ff1884efff6179dcfff763b5ff0b5869ff0d6e4cff108431ff084284ff" },
+    { 3, "382e96947d59190e22020d4b5efa34a5",
+        "41b90cff969402ffb39827ff28c21aff41b90cff969402fff7832dff6cad20ff28c21aff6cad20ff969402ff17cb11ff6cad20ff6cad20ff6ca607ff6ca607ff" },
+    { 4, "50e52ecc67771d71ef52c2efd5c32941",
+        "5a72ce7dbd759cc6295de75a8c5db5a32960e75a8c6bb5a3bd649cc68c60b5a3bd6b9cc65a75ce7dbd5d9cc65a67ce7d5a6ece7d8c6eb5a38c75b5a3296ee75a" },
+    { 5, "a04753d866617230dd413e115e81fe1b",
+        "792c50a64c4c996c622c75894c2c996c8f2c2cc38f1c2cc3621c75898f3c2cc34c3c996c4c4c996c794c50a6624c75898f4c2cc3623c75898f2c2cc38f1c2cc3" },
+    { 6, "c06770627d96967faa2bc9f5d1638430",
+        "955282b88b8066dc898860e29a3992a58d766cd488915be9955282b882ac4afe9c2e999d869956ef98418dab935c7cc0974a88b28f6d71cd9e269e9698418dab" },
+    { 7, "80061fed8898e0e9de641d81467d018e",
+        "a23974cfe31038cb5d65b3d34b7273305d65b3d31c8eefd73c8634044b727330e31038cb6949f38a6949f38a6949f38a3c8634045a5db45e6949f38a5a5db45e" },
+};
+
+const BptcKnownAnswer kBc6hKnownAnswers[] = {
+    { 1, "ec37f01843c5f4944d996865cd4f950d",
+        "66cb226fd92766cb2264c82169ce236dd52664c82147bd2e72dc286bd22466cb2252b0296bd2246dd52668951f6e8f1d" },
+    { 2, "e5951a4bd43900fd595dc3ade7279118",
+        "173e0403313f022c3d094a01114103083e4c012338084c01084c0103313f03313f173e04143f03012338063a48173e04" },
+    { 3, "426c95894f08b1b16c57f961999e16a0",
+        "4927cd4f24d14a26ce4728cb4a26ce4827cc4a26ce432ad14f24d1402ad34e2bcb4e2bcb3e2ad53e2ad54a2acd432ad1" },
+    { 4, "26eca29177f140f2b226c05c51b2f03c",
+        "4635d34537d84535d44331d94536d54535d44536d53f38df4535d44536d64535d44134dc4438db4537d84438db3f39e1" },
+    { 5, "4a6cba932f9c31a17295272e29bb3543",
+        "4757d64857d64956d74059e64757d64057e1415ceb405be94057e1415ef0415dee4857d64059e64b55d84758d54857d6" },
+    { 6, "4ed765b75169a7eb3915ced79b8c64a8",
+        "1826431a243e1e20371b233c1c196f1826431826431727481c196f10194e12195315284d16195e10194e1a196a141959" },
+    { 7, "3289b8c4c4281eeb7682bf260bc51599",
+        "083f16083f160f2d10029a2e055e1b03961d029a2e039318039825029c38058d0c064e19029a2e064e1916250f0c3513" },
+    { 8, "964c26b3cca359c4ced547beb8829bd4",
+        "21050f5220084015065f300a1c071321050f160c1a572609491a0725050e160c1a180b18451706451706572609160c1a" },
+    { 9, "1a4c3398164e80456be13b1a5641bcc6",
+        "1b2f061c30070a502d1734040c481c1d31081d32090e41110c481c1a2d051b2e051b3002103c0b1734041b2e051e330b" },
+    { 10, "3ea328a5b05c2b2d2bd0f605970adf8a",
+        "2404050f3a3a1b0a0c2404052b02030f3a3a1e06081e060812ff00240405180f130f3a3a9eff009eff001e0608180f13" },
+    { 11, "e332e244eb4ab5b3d6c430a3e8b5d89e",
+        "1f62290e41121d5e260f44132a6c351f62291f6229124a1716511b0d3e0f1c5b2210471516511b0e41120d3e0f144e19" },
+    { 12, "67f47721c78caf1a8862830cf649be69",
+        "6b0e82500a9d77117a5d0c91710f7d500a9d3a07b98c15735d0c913005cd4a09a46b0e823305c73d07b24a09a45d0c91" },
+    { 13, "abb668e5ac91c922f9e7449d70028a17",
+        "125633177140135e37166f3f125633125633166c3d146239104d2f135e37115231104d2f15653a146038135e37114f30" },
+    { 14, "ef9d71313ce10db610a4a4def0f32de2",
+        "011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a011f3a" },
+};
+
+/// <summary>
+/// BC6Hの展開結果を参照デコーダと同じ規則で8bitに変換（[0, 1]に収めて255倍し、切り捨て）
+/// 参照デコーダはBC6Hの補間で仕様の丸め（+32）をしないため、BC6Hの既知解はその差が8bitに現れないブロックを選んでいる
+/// </summary>
+uint8_t ToReferenceUnorm8(uint16_t half) {
+    const float value = HalfToFloat(half);
+    return value <= 0.0f ? 0 : value >= 1.0f ? 255 : static_cast<uint8_t>(value * 255.0f);
+}
+
+} // namespace
+
+void RunTextureTest()
+{
+    std::cout << "### Texture Test ###" << std::endl;
+    std::cout << std::endl;
+
+    // テスト1: メモリ上の画像のデコード（チャンネルの拡張と上下反転）
+    std::cout << "[Texture Test 1] Decode from memory" << std::endl;
+
+    const std::vector<uint8_t> tga = MakeTestTga(16, 8);
+    const TextureImage decoded = TextureLoader::Decode(tga);
+    TextureLoadOptions flipOptions;
+    flipOptions.flipVertically = true;
+    const TextureImage flipped = TextureLoader::Decode(tga, flipOptions);
+    std::cout << "  - Size: " << decoded.width << " x " << decoded.height << ", channels " << decoded.sourceChannels
+        << " -> " << decoded.channels << std::endl;
+    std::cout << (MatchesTestPattern(decoded, false) && MatchesTestPattern(flipped, true)
+        ? "  SUCCESS: pixels match (RGB -> RGBA, flipped)" : "  FAILED: pixels differ") << std::endl;
+    std::cout << std::endl;
+
+    // テスト2: ワーカースレッドでの読み込みと失敗の通知
+    std::cout << "[Texture Test 2] Worker pool loading" << std::endl;
+
+    const std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "RenderingSandbox_texture_test";
+    std::filesystem::create_directories(tempDir);
+    std::vector<std::filesystem::path> tgaPaths;
+    for (uint32_t i = 0; i < 8; ++i) {
+        const std::filesystem::path path = tempDir / ("pattern" + std::to_string(i) + ".tga");
+        const std::vector<uint8_t> file = MakeTestTga(16, 8 + i);
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        tgaPaths.push_back(path);
+    }
+    tgaPaths.push_back(tempDir / "missing.png");
+
+    bool poolMatch = true;
+    {
+        TextureLoader loader(4);
+        std::vector<std::future<TextureImage>> futures = loader.LoadBatch(tgaPaths);
+        for (size_t i = 0; i < futures.size(); ++i) {
+            const TextureImage image = futures[i].get();
+            if (i + 1 < futures.size()) {
+                // 結果は投入した順に並ぶ
+                poolMatch = poolMatch && image.path == tgaPaths[i] && image.height == 8 + i && MatchesTestPattern(image, false);
+            }
+            else {
+                std::cout << "  - Missing file: " << image.error << std::endl;
+                poolMatch = poolMatch && !image.IsValid() && !image.error.empty();
+            }
+        }
+    }
+    std::filesystem::remove_all(tempDir);
+    std::cout << (poolMatch ? "  SUCCESS: results in submission order, missing file reported" : "  FAILED: unexpected results") << std::endl;
+    std::cout << std::endl;
+
+    // テスト3: 逐次デコードとの速度比較（test.jpgを繰り返し読み込む）
+    std::cout << "[Texture Test 3] Parallel decode throughput" << std::endl;
+
+    const std::filesystem::path jpegPath = std::filesystem::current_path() / "test.jpg";
+    if (!std::filesystem::exists(jpegPath)) {
+        std::cout << "  SKIPPED: place 'test.jpg' in " << std::filesystem::current_path().string() << std::endl;
+    }
+    else {
+        constexpr size_t kImageCount = 64;
+        const std::vector<std::filesystem::path> jpegPaths(kImageCount, jpegPath);
+
+        // 逐次（1スレッドで読み込みバッファを再利用）
+        std::vector<uint8_t> scratch;
+        size_t serialBytes = 0;
+        const auto serialStart = std::chrono::high_resolution_clock::now();
+        for (const std::filesystem::path& path : jpegPaths) {
+            serialBytes += TextureLoader::LoadFile(path, {}, scratch).GetSizeInBytes();
+        }
+        const std::chrono::duration<double, std::milli> serialTime = std::chrono::high_resolution_clock::now() - serialStart;
+
+        // ワーカースレッド
+        TextureLoader loader;
+        size_t parallelBytes = 0;
+        const auto parallelStart = std::chrono::high_resolution_clock::now();
+        for (std::future<TextureImage>& future : loader.LoadBatch(jpegPaths)) {
+            parallelBytes += future.get().GetSizeInBytes();
+        }
+        const std::chrono::duration<double, std::milli> parallelTime = std::chrono::high_resolution_clock::now() - parallelStart;
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  - Serial:   " << kImageCount << " images in " << serialTime.count() << " ms" << std::endl;
+        std::cout << "  - Parallel: " << kImageCount << " images in " << parallelTime.count() << " ms ("
+            << loader.GetThreadCount() << " threads, " << serialTime.count() / parallelTime.count() << "x)" << std::endl;
+        std::cout << std::defaultfloat;
+        std::cout << (serialBytes > 0 && serialBytes == parallelBytes
+            ? "  SUCCESS: parallel results match serial decode" : "  FAILED: decode results differ") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト4: ファイルの読み込み方法（stdio・一括読み込み・メモリマップ）の比較
+    std::cout << "[Texture Test 4] File source read modes" << std::endl;
+
+    const std::filesystem::path sourceDir = std::filesystem::temp_directory_path() / "RenderingSandbox_texture_source";
+    std::filesystem::create_directories(sourceDir);
+    std::vector<std::filesystem::path> pngPaths;
+    for (uint32_t i = 0; i < 8; ++i) {
+        const std::filesystem::path path = sourceDir / ("large" + std::to_string(i) + ".png");
+        const std::vector<uint8_t> file = MakeStoredPng(2048, 1024, i);
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        pngPaths.push_back(path);
+    }
+
+    // Autoではしきい値以上のファイルだけがマップされ、小さいファイルは渡したバッファへ読み込まれる
+    const std::filesystem::path smallPath = sourceDir / "small.tga";
+    const std::vector<uint8_t> smallFile = MakeTestTga(16, 8);
+    std::ofstream(smallPath, std::ios::binary).write(reinterpret_cast<const char*>(smallFile.data()), static_cast<std::streamsize>(smallFile.size()));
+
+    std::vector<uint8_t> sourceScratch;
+    std::string sourceError;
+    TextureFileSource source;
+    const bool largeMapped = source.Open(pngPaths.front(), sourceScratch, TextureFileReadMode::Auto, sourceError) && source.IsMapped()
+        && source.GetData().size() == std::filesystem::file_size(pngPaths.front());
+    const bool smallRead = source.Open(smallPath, sourceScratch, TextureFileReadMode::Auto, sourceError) && !source.IsMapped()
+        && source.GetData().data() == sourceScratch.data() && source.GetData().size() == smallFile.size();
+    source.Close();
+    std::cout << (largeMapped && smallRead
+        ? "  SUCCESS: large files mapped, small files read into the reused buffer" : "  FAILED: unexpected read mode") << std::endl;
+
+    bool modesMatch = CompareReadModes("Stored PNG 2048x1024", pngPaths);
+    if (std::filesystem::exists(jpegPath)) {
+        std::vector<std::filesystem::path> jpegCopies;
+        for (uint32_t i = 0; i < 32; ++i) {
+            const std::filesystem::path path = sourceDir / ("photo" + std::to_string(i) + ".jpg");
+            std::filesystem::copy_file(jpegPath, path, std::filesystem::copy_options::overwrite_existing);
+            jpegCopies.push_back(path);
+        }
+        modesMatch = CompareReadModes("test.jpg copies", jpegCopies) && modesMatch;
+    }
+    std::filesystem::remove_all(sourceDir);
+    std::cout << (modesMatch ? "  SUCCESS: all read modes decode identical pixels" : "  FAILED: read modes decode different pixels") << std::endl;
+    std::cout << std::endl;
+
+    // テスト5: ミップチェーンの生成（sRGBの線形空間での縮小、浮動小数点フォーマット、逐次版との速度比較）
+    std::cout << "[Texture Test 5] Mip chain builder" << std::endl;
+
+    {
+        MipChainBuilder builder;
+        MipChain chain;
+
+        // 白黒の市松模様（2x2）を縮小すると、sRGBでは線形空間の50%（約188）、線形では128前後になる
+        const std::vector<uint8_t> checker = { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 };
+        builder.Build(checker.data(), 2, 2, 0, MipPixelFormat::RGBA8UnormSrgb, chain);
+        const uint8_t srgbValue = chain.GetLevelData(1)[0];
+        builder.Build(checker.data(), 2, 2, 0, MipPixelFormat::RGBA8Unorm, chain);
+        const uint8_t linearValue = chain.GetLevelData(1)[0];
+        std::cout << "  - 2x2 checker -> 1x1: sRGB " << static_cast<int>(srgbValue) << ", linear " << static_cast<int>(linearValue) << std::endl;
+        std::cout << (srgbValue >= 186 && srgbValue <= 190 && linearValue >= 127 && linearValue <= 128
+            ? "  SUCCESS: sRGB levels filtered in linear space" : "  FAILED: unexpected sRGB filtering") << std::endl;
+
+        // 一定値の画像は全レベルで同じ値のまま（半端なサイズでも1x1まで）
+        const std::vector<uint16_t> halfOnes(300 * 20 * 4, 0x3C00);
+        const bool halfBuilt = builder.Build(halfOnes.data(), 300, 20, 0, MipPixelFormat::RGBA16Float, chain);
+        bool floatMatch = halfBuilt && chain.levels.size() == 9 && chain.levels.back().width == 1 && chain.levels.back().height == 1;
+        for (size_t level = 0; floatMatch && level < chain.levels.size(); ++level) {
+            const std::span<const uint8_t> data = chain.GetLevelData(level);
+            for (size_t i = 0; i < data.size(); i += 2) {
+                uint16_t value = 0;
+                std::memcpy(&value, data.data() + i, 2);
+                floatMatch = floatMatch && value == 0x3C00;
+            }
+        }
+        const std::vector<float> depth(256 * 128, 0.25f);
+        floatMatch = floatMatch && builder.Build(depth.data(), 256, 128, 0, MipPixelFormat::R32Float, chain) && chain.levels.size() == 9;
+        for (size_t level = 0; floatMatch && level < chain.levels.size(); ++level) {
+            const std::span<const uint8_t> data = chain.GetLevelData(level);
+            for (size_t i = 0; i < data.size(); i += 4) {
+                float value = 0.0f;
+                std::memcpy(&value, data.data() + i, 4);
+                floatMatch = floatMatch && value == 0.25f;
+            }
+        }
+        std::cout << (floatMatch ? "  SUCCESS: RGBA16F and R32F chains down to 1x1" : "  FAILED: unexpected float chains") << std::endl;
+    }
+
+    {
+        // 2048x2048 sRGBのアルベドを想定した速度比較（フィルタはstbir_resize_uint8_srgbの既定に合わせてMitchell）
+        constexpr uint32_t kSize = 2048;
+        std::vector<uint8_t> albedo(static_cast<size_t>(kSize) * kSize * 4);
+        uint32_t state = 12345;
+        for (size_t i = 0; i < albedo.size(); ++i) {
+            state = state * 1664525u + 1013904223u;
+            albedo[i] = (i % 4 == 3) ? 255 : static_cast<uint8_t>((state >> 24) / 2 + ((i / 4) % kSize) / 16);
+        }
+        MipChainOptions mitchell;
+        mitchell.filter = MipFilter::Mitchell;
+
+        const auto naiveStart = std::chrono::high_resolution_clock::now();
+        const std::vector<std::vector<uint8_t>> naive = BuildNaiveMips(albedo, kSize, kSize);
+        const std::chrono::duration<double, std::milli> naiveTime = std::chrono::high_resolution_clock::now() - naiveStart;
+
+        MipChainBuilder singleBuilder(1);
+        MipChain singleChain;
+        const auto firstStart = std::chrono::high_resolution_clock::now();
+        singleBuilder.Build(albedo.data(), kSize, kSize, 0, MipPixelFormat::RGBA8UnormSrgb, singleChain, mitchell);
+        const std::chrono::duration<double, std::milli> firstTime = std::chrono::high_resolution_clock::now() - firstStart;
+        const auto reuseStart = std::chrono::high_resolution_clock::now();
+        singleBuilder.Build(albedo.data(), kSize, kSize, 0, MipPixelFormat::RGBA8UnormSrgb, singleChain, mitchell);
+        const std::chrono::duration<double, std::milli> reuseTime = std::chrono::high_resolution_clock::now() - reuseStart;
+
+        MipChainBuilder parallelBuilder;
+        MipChain parallelChain;
+        parallelBuilder.Build(albedo.data(), kSize, kSize, 0, MipPixelFormat::RGBA8UnormSrgb, parallelChain, mitchell);
+        const auto parallelStart = std::chrono::high_resolution_clock::now();
+        parallelBuilder.Build(albedo.data(), kSize, kSize, 0, MipPixelFormat::RGBA8UnormSrgb, parallelChain, mitchell);
+        const std::chrono::duration<double, std::milli> parallelTime = std::chrono::high_resolution_clock::now() - parallelStart;
+
+        bool chainMatch = naive.size() == singleChain.levels.size() && singleChain.data == parallelChain.data;
+        for (size_t level = 0; chainMatch && level < naive.size(); ++level) {
+            const std::span<const uint8_t> data = singleChain.GetLevelData(level);
+            chainMatch = data.size() == naive[level].size() && std::equal(data.begin(), data.end(), naive[level].begin());
+        }
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  - " << kSize << "x" << kSize << " RGBA8 sRGB, " << naive.size() << " levels" << std::endl;
+        std::cout << "    per-level stbir_resize_uint8_srgb: " << std::setw(8) << naiveTime.count() << " ms" << std::endl;
+        std::cout << "    builder, 1 thread (first build):  " << std::setw(8) << firstTime.count() << " ms" << std::endl;
+        std::cout << "    builder, 1 thread (reused):       " << std::setw(8) << reuseTime.count() << " ms" << std::endl;
+        std::cout << "    builder, " << std::setw(2) << parallelBuilder.GetThreadCount() << " threads (reused):     "
+            << std::setw(8) << parallelTime.count() << " ms (" << naiveTime.count() / parallelTime.count() << "x)" << std::endl;
+        std::cout << std::defaultfloat;
+        std::cout << (chainMatch ? "  SUCCESS: builder output matches per-level stbir calls" : "  FAILED: builder output differs") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト6: ブロック圧縮（展開してPSNRを確認し、SIMDの有無・品質ごとの速度を比較）
+    std::cout << "[Texture Test 6] Block compression" << std::endl;
+
+    {
+        BlockCompressor compressor;
+        const std::string simdNames[] = { "Scalar", "SSE2", "AVX2" };
+        const BlockSimdLevel supportedSimd = BlockCompressor::GetSupportedSimdLevel();
+        std::cout << "  - Supported SIMD: " << simdNames[static_cast<int>(supportedSimd)] << ", threads: " << compressor.GetThreadCount() << std::endl;
+
+        constexpr uint32_t kSize = 512;
+        const std::vector<uint8_t> image = MakeCompressionTestImage(kSize, kSize);
+        // BC1はアルファ128未満を透明として扱うため、不透明にした画像で測る
+        std::vector<uint8_t> opaqueImage = image;
+        for (size_t i = 3; i < opaqueImage.size(); i += 4) {
+            opaqueImage[i] = 255;
+        }
+        const double megabytes = static_cast<double>(image.size()) / (1024.0 * 1024.0);
+
+        struct FormatCase {
+            BlockFormat format;
+            const char* name;
+            const std::vector<uint8_t>& source;
+            int channels;       // PSNRを測るチャンネル数（BC1はRGB）
+            double minPsnr;     // Fastで期待する最低PSNR
+        };
+        const FormatCase formatCases[] = {
+            { BlockFormat::BC1, "BC1", opaqueImage, 3, 32.0 },
+            { BlockFormat::BC3, "BC3", image, 4, 33.0 },
+            { BlockFormat::BC4, "BC4", image, 1, 40.0 },
+            { BlockFormat::BC5, "BC5", image, 2, 40.0 },
+        };
+
+        bool qualityMatch = true;
+        bool simdMatch = true;
+        std::vector<uint8_t> blocks(BlockCompressor::GetCompressedSize(BlockFormat::BC3, kSize, kSize));
+        std::vector<uint8_t> decoded(image.size());
+        std::cout << std::fixed << std::setprecision(2);
+        for (const FormatCase& formatCase : formatCases) {
+            const size_t compressedSize = BlockCompressor::GetCompressedSize(formatCase.format, kSize, kSize);
+
+            // Fast: 使える命令セットごとに速度を測り、結果が同じことを確認
+            std::vector<uint8_t> referenceBlocks;
+            for (int simd = static_cast<int>(supportedSimd); simd >= 0; --simd) {
+                BlockCompressOptions options;
+                options.maxSimdLevel = static_cast<BlockSimdLevel>(simd);
+                constexpr int kRepeat = 4;
+                const auto start = std::chrono::high_resolution_clock::now();
+                for (int repeat = 0; repeat < kRepeat; ++repeat) {
+                    compressor.CompressImage(formatCase.source.data(), kSize, kSize, 0, formatCase.format, blocks.data(), options);
+                }
+                const std::chrono::duration<double, std::milli> time = (std::chrono::high_resolution_clock::now() - start) / kRepeat;
+                if (referenceBlocks.empty()) {
+                    referenceBlocks.assign(blocks.begin(), blocks.begin() + compressedSize);
+                    BlockCompressor::DecompressImage(blocks.data(), kSize, kSize, formatCase.format, decoded.data());
+                    const double psnr = ComputePsnr(formatCase.source, decoded, formatCase.channels);
+                    qualityMatch = qualityMatch && psnr >= formatCase.minPsnr;
+                    std::cout << "  - " << formatCase.name << " Fast: PSNR " << psnr << " dB" << std::endl;
+                }
+                else {
+                    simdMatch = simdMatch && std::equal(referenceBlocks.begin(), referenceBlocks.end(), blocks.begin());
+                }
+                std::cout << "    " << std::left << std::setw(6) << simdNames[simd] << std::right << std::setw(8) << time.count() << " ms ("
+                    << std::setw(8) << megabytes * 1000.0 / time.count() << " MB/s)" << std::endl;
+            }
+
+            // High: 誤差はFast以下になる
+            BlockCompressOptions highOptions;
+            highOptions.quality = BlockQuality::High;
+            const double fastPsnr = ComputePsnr(formatCase.source, decoded, formatCase.channels);
+            const auto highStart = std::chrono::high_resolution_clock::now();
+            compressor.CompressImage(formatCase.source.data(), kSize, kSize, 0, formatCase.format, blocks.data(), highOptions);
+            const std::chrono::duration<double, std::milli> highTime = std::chrono::high_resolution_clock::now() - highStart;
+            BlockCompressor::DecompressImage(blocks.data(), kSize, kSize, formatCase.format, decoded.data());
+            const double highPsnr = ComputePsnr(formatCase.source, decoded, formatCase.channels);
+            qualityMatch = qualityMatch && highPsnr >= fastPsnr;
+            std::cout << "  - " << formatCase.name << " High: PSNR " << highPsnr << " dB, " << highTime.count() << " ms ("
+                << megabytes * 1000.0 / highTime.count() << " MB/s)" << std::endl;
+        }
+        std::cout << std::defaultfloat;
+        std::cout << (simdMatch ? "  SUCCESS: SIMD and scalar paths produce identical blocks" : "  FAILED: SIMD output differs from scalar") << std::endl;
+        std::cout << (qualityMatch ? "  SUCCESS: PSNR above thresholds, High not worse than Fast" : "  FAILED: unexpected PSNR") << std::endl;
+
+        // BC1の1bitアルファ: 半透明未満のピクセルは透明な黒、それ以外は不透明になる
+        // 単色のブロックは565の量子化より細かく（各チャンネル±2以内で）表せる
+        std::vector<uint8_t> cutout(16 * 16 * 4);
+        for (size_t i = 0; i < cutout.size(); i += 4) {
+            const size_t pixel = i / 4;
+            cutout[i + 0] = 200;
+            cutout[i + 1] = 100;
+            cutout[i + 2] = 37;
+            cutout[i + 3] = (pixel % 16 < 8) ? 255 : ((pixel / 16) % 2 == 0 ? 0 : 255);
+        }
+        std::vector<uint8_t> cutoutBlocks(BlockCompressor::GetCompressedSize(BlockFormat::BC1, 16, 16));
+        std::vector<uint8_t> cutoutDecoded(cutout.size());
+        compressor.CompressImage(cutout.data(), 16, 16, 0, BlockFormat::BC1, cutoutBlocks.data());
+        BlockCompressor::DecompressImage(cutoutBlocks.data(), 16, 16, BlockFormat::BC1, cutoutDecoded.data());
+        bool cutoutMatch = true;
+        for (size_t i = 0; i < cutout.size(); i += 4) {
+            if (cutout[i + 3] == 0) {
+                cutoutMatch = cutoutMatch && cutoutDecoded[i + 3] == 0 && cutoutDecoded[i] == 0;
+            }
+            else {
+                cutoutMatch = cutoutMatch && cutoutDecoded[i + 3] == 255;
+                for (int c = 0; c < 3; ++c) {
+                    cutoutMatch = cutoutMatch && std::abs(cutoutDecoded[i + c] - cutout[i + c]) <= 2;
+                }
+            }
+        }
+        std::cout << (cutoutMatch ? "  SUCCESS: BC1 punch-through alpha and solid colors" : "  FAILED: unexpected BC1 alpha or solid color") << std::endl;
+
+        // ミップチェーンの全レベル（4未満のレベルも含む）を圧縮
+        MipChainBuilder builder;
+        MipChain chain;
+        builder.Build(opaqueImage.data(), kSize, 300, 0, MipPixelFormat::RGBA8UnormSrgb, chain);
+        CompressedTexture texture;
+        bool chainMatch = compressor.Compress(chain, BlockFormat::BC1, texture) && texture.srgb && texture.levels.size() == chain.levels.size();
+        size_t rawBytes = 0;
+        double lowestPsnr = 99.0;
+        for (size_t level = 0; chainMatch && level < texture.levels.size(); ++level) {
+            const CompressedLevel& compressed = texture.levels[level];
+            chainMatch = compressed.width == chain.levels[level].width && compressed.height == chain.levels[level].height
+                && compressed.size == BlockCompressor::GetCompressedSize(BlockFormat::BC1, compressed.width, compressed.height);
+            std::vector<uint8_t> levelPixels(chain.GetLevelData(level).begin(), chain.GetLevelData(level).end());
+            std::vector<uint8_t> levelDecoded(levelPixels.size());
+            BlockCompressor::DecompressImage(texture.GetLevelData(level).data(), compressed.width, compressed.height, BlockFormat::BC1, levelDecoded.data());
+            // 小さいレベルは画像全体の色が数ブロックに詰まるため、PSNRの下限はレベル0だけで確認する
+            const double psnr = ComputePsnr(levelPixels, levelDecoded, 3);
+            chainMatch = chainMatch && (level != 0 || psnr >= 32.0);
+            lowestPsnr = std::min(lowestPsnr, psnr);
+            rawBytes += levelPixels.size();
+        }
+        MipChain floatChain;
+        floatChain.format = MipPixelFormat::RGBA16Float;
+        floatChain.levels.resize(1);
+        chainMatch = chainMatch && !compressor.Compress(floatChain, BlockFormat::BC1, texture);
+        std::cout << "  - Mip chain " << kSize << "x300: " << chain.levels.size() << " levels, " << rawBytes << " -> " << texture.data.size() << " bytes, lowest level PSNR "
+            << std::fixed << std::setprecision(2) << lowestPsnr << std::defaultfloat << " dB" << std::endl;
+        std::cout << (chainMatch ? "  SUCCESS: all mip levels compressed" : "  FAILED: unexpected compressed chain") << std::endl;
+    }
+    std::cout << std::endl;
+
+    // テスト7: BC6H/BC7（参照デコーダで展開して誤差の上限を確認し、4KのHDRの空の圧縮時間を測る）
+    std::cout << "[Texture Test 7] BC6H/BC7 compression" << std::endl;
+
+    {
+        BlockCompressor compressor;
+        BlockCompressOptions highOptions;
+        highOptions.quality = BlockQuality::High;
+        std::cout << "  - Threads: " << compressor.GetThreadCount() << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+
+        // BC7: 同じ16バイト/ブロックのBC3より誤差が小さく、HighはFast以下の誤差になる
+        constexpr uint32_t kSize = 512;
+        const std::vector<uint8_t> image = MakeCompressionTestImage(kSize, kSize);
+        const double megabytes = static_cast<double>(image.size()) / (1024.0 * 1024.0);
+        std::vector<uint8_t> blocks(BlockCompressor::GetCompressedSize(BlockFormat::BC7, kSize, kSize));
+        std::vector<uint8_t> decoded(image.size());
+        compressor.CompressImage(image.data(), kSize, kSize, 0, BlockFormat::BC3, blocks.data());
+        BlockCompressor::DecompressImage(blocks.data(), kSize, kSize, BlockFormat::BC3, decoded.data());
+        const double bc3Psnr = ComputePsnr(image, decoded, 4);
+
+        const auto bc7Start = std::chrono::high_resolution_clock::now();
+        compressor.CompressImage(image.data(), kSize, kSize, 0, BlockFormat::BC7, blocks.data());
+        const std::chrono::duration<double, std::milli> bc7Time = std::chrono::high_resolution_clock::now() - bc7Start;
+        BlockCompressor::DecompressImage(blocks.data(), kSize, kSize, BlockFormat::BC7, decoded.data());
+        const double bc7Psnr = ComputePsnr(image, decoded, 4);
+        int modeCounts[8] = {};
+        for (size_t i = 0; i < blocks.size(); i += 16) {
+            ++modeCounts[BptcCodec::GetBC7Mode(blocks.data() + i)];
+        }
+        std::cout << "  - BC7 Fast: PSNR " << bc7Psnr << " dB (BC3 " << bc3Psnr << " dB), " << bc7Time.count() << " ms ("
+            << megabytes * 1000.0 / bc7Time.count() << " MB/s), modes";
+        for (int mode = 0; mode < 8; ++mode) {
+            std::cout << " " << mode << ":" << modeCounts[mode];
+        }
+        std::cout << std::endl;
+
+        // Highは全パーティションを試すため、中央の128x128の範囲で比べる
+        constexpr uint32_t kCrop = 128;
+        const uint8_t* cropPixels = image.data() + (static_cast<size_t>(kSize / 2) * kSize + kSize / 2) * 4;
+        std::vector<uint8_t> cropImage(kCrop * kCrop * 4);
+        for (uint32_t y = 0; y < kCrop; ++y) {
+            std::copy(cropPixels + y * kSize * 4, cropPixels + y * kSize * 4 + kCrop * 4, cropImage.begin() + y * kCrop * 4);
+        }
+        std::vector<uint8_t> cropBlocks(BlockCompressor::GetCompressedSize(BlockFormat::BC7, kCrop, kCrop));
+        std::vector<uint8_t> cropDecoded(cropImage.size());
+        compressor.CompressImage(cropPixels, kCrop, kCrop, kSize * 4, BlockFormat::BC7, cropBlocks.data());
+        BlockCompressor::DecompressImage(cropBlocks.data(), kCrop, kCrop, BlockFormat::BC7, cropDecoded.data());
+        const double cropFastPsnr = ComputePsnr(cropImage, cropDecoded, 4);
+        const auto bc7HighStart = std::chrono::high_resolution_clock::now();
+        compressor.CompressImage(cropPixels, kCrop, kCrop, kSize * 4, BlockFormat::BC7, cropBlocks.data(), highOptions);
+        const std::chrono::duration<double, std::milli> bc7HighTime = std::chrono::high_resolution_clock::now() - bc7HighStart;
+        BlockCompressor::DecompressImage(cropBlocks.data(), kCrop, kCrop, BlockFormat::BC7, cropDecoded.data());
+        const double cropHighPsnr = ComputePsnr(cropImage, cropDecoded, 4);
+        std::cout << "  - BC7 " << kCrop << "x" << kCrop << ": Fast " << cropFastPsnr << " dB, High " << cropHighPsnr << " dB ("
+            << bc7HighTime.count() << " ms)" << std::endl;
+
+        // 単色のブロックは各チャンネル±1以内（p-bitを共有するため完全には一致しない場合がある）
+        bool solidMatch = true;
+        const uint8_t solidColors[][4] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, { 200, 100, 37, 255 }, { 13, 250, 128, 77 }, { 1, 2, 3, 0 } };
+        for (const auto& color : solidColors) {
+            uint8_t solid[16][4];
+            for (auto& pixel : solid) {
+                std::copy(color, color + 4, pixel);
+            }
+            uint8_t block[16];
+            uint8_t solidDecoded[16][4];
+            BptcCodec::EncodeBC7Block(solid[0], BlockQuality::Fast, block);
+            BptcCodec::DecodeBC7Block(block, solidDecoded[0]);
+            for (const auto& pixel : solidDecoded) {
+                for (int c = 0; c < 4; ++c) {
+                    solidMatch = solidMatch && std::abs(pixel[c] - color[c]) <= 1;
+                }
+            }
+        }
+
+        const bool bc7Match = bc7Psnr >= 45.0 && bc7Psnr > bc3Psnr && cropHighPsnr >= cropFastPsnr && solidMatch;
+        std::cout << (bc7Match ? "  SUCCESS: BC7 beats BC3, High not worse than Fast, solid blocks within 1"
+                               : "  FAILED: unexpected BC7 error") << std::endl;
+
+        // BC6H: .hdrをTextureLoaderでFloat32のRGBAに読み込み、4K（4096x2048）の空をそのまま圧縮する
+        constexpr uint32_t kSkyWidth = 4096;
+        constexpr uint32_t kSkyHeight = 2048;
+        const std::vector<uint8_t> hdrFile = MakeHdrSky(kSkyWidth, kSkyHeight);
+        const TextureImage sky = TextureLoader::Decode(hdrFile);
+        bool hdrMatch = sky.IsValid() && sky.componentType == TextureComponentType::Float32 && sky.channels == 4
+            && sky.width == kSkyWidth && sky.height == kSkyHeight;
+        const float* skyPixels = reinterpret_cast<const float*>(sky.pixels.get());
+        const size_t skyRowPitch = sky.GetRowPitch();
+        std::vector<uint8_t> skyBlocks(BlockCompressor::GetCompressedSize(BlockFormat::BC6H, kSkyWidth, kSkyHeight));
+        HdrError skyError;
+        if (hdrMatch) {
+            const auto start = std::chrono::high_resolution_clock::now();
+            hdrMatch = compressor.CompressHdrImage(skyPixels, kSkyWidth, kSkyHeight, 0, MipPixelFormat::RGBA32Float, skyBlocks.data());
+            const std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+
+            // 64行ずつ展開して比べる
+            constexpr uint32_t kRows = 64;
+            std::vector<uint16_t> rows(static_cast<size_t>(kSkyWidth) * kRows * 4);
+            for (uint32_t y = 0; y < kSkyHeight; y += kRows) {
+                BlockCompressor::DecompressHdrImage(skyBlocks.data() + (y / 4) * (kSkyWidth / 4) * 16, kSkyWidth, kRows, rows.data());
+                const HdrError error = ComputeHdrError(skyPixels + y * kSkyWidth * 4, skyRowPitch, rows.data(), kSkyWidth, kRows);
+                skyError.meanRelative += error.meanRelative / (kSkyHeight / kRows);
+                skyError.log2Rmse += error.log2Rmse * error.log2Rmse / (kSkyHeight / kRows);
+            }
+            skyError.log2Rmse = std::sqrt(skyError.log2Rmse);
+            int modeCounts[15] = {};
+            for (size_t i = 0; i < skyBlocks.size(); i += 16) {
+                ++modeCounts[std::max(BptcCodec::GetBC6HMode(skyBlocks.data() + i), 0)];
+            }
+            std::cout << "  - BC6H Fast " << kSkyWidth << "x" << kSkyHeight << " sky: " << time.count() << " ms ("
+                << static_cast<double>(kSkyWidth) * kSkyHeight / 1000.0 / time.count() << " Mpixel/s), mean relative error "
+                << skyError.meanRelative * 100.0 << "%, log2 RMSE " << std::setprecision(4) << skyError.log2Rmse << std::setprecision(2) << ", modes";
+            for (int mode = 1; mode <= 14; ++mode) {
+                std::cout << " " << mode << ":" << modeCounts[mode];
+            }
+            std::cout << std::endl;
+            hdrMatch = hdrMatch && skyError.meanRelative < 0.01 && skyError.log2Rmse < 0.005;
+        }
+
+        // 太陽の周りでFastとHighを比べる（誤差は半精度のビット列の差の二乗和。エンコーダが最小化する値）
+        if (hdrMatch) {
+            constexpr uint32_t kSunX = 608;
+            constexpr uint32_t kSunY = 640;
+            const float* sunPixels = skyPixels + (static_cast<size_t>(kSunY) * kSkyWidth + kSunX) * 4;
+            std::vector<uint16_t> sunHalves(kCrop * kCrop * 4);
+            for (uint32_t y = 0; y < kCrop; ++y) {
+                for (uint32_t x = 0; x < kCrop * 4; ++x) {
+                    sunHalves[y * kCrop * 4 + x] = FloatToHalf(sunPixels[static_cast<size_t>(y) * kSkyWidth * 4 + x]);
+                }
+            }
+            std::vector<uint8_t> sunBlocks(BlockCompressor::GetCompressedSize(BlockFormat::BC6H, kCrop, kCrop));
+            std::vector<uint16_t> sunDecoded(kCrop * kCrop * 4);
+            double squaredErrors[2] = {};
+            double relativeErrors[2] = {};
+            for (int quality = 0; quality < 2; ++quality) {
+                compressor.CompressHdrImage(sunHalves.data(), kCrop, kCrop, 0, MipPixelFormat::RGBA16Float, sunBlocks.data(),
+                                            quality == 0 ? BlockCompressOptions{} : highOptions);
+                BlockCompressor::DecompressHdrImage(sunBlocks.data(), kCrop, kCrop, sunDecoded.data());
+                for (uint32_t y = 0; y < kCrop; ++y) {
+                    for (uint32_t x = 0; x < kCrop; ++x) {
+                        for (int c = 0; c < 3; ++c) {
+                            const size_t index = (y * kCrop + x) * 4 + c;
+                            const double d = static_cast<double>(sunDecoded[index]) - sunHalves[index];
+                            squaredErrors[quality] += d * d;
+                        }
+                    }
+                }
+                relativeErrors[quality] = ComputeHdrError(sunPixels, skyRowPitch, sunDecoded.data(), kCrop, kCrop).meanRelative;
+            }
+            std::cout << "  - BC6H " << kCrop << "x" << kCrop << " around the sun: mean relative error Fast " << relativeErrors[0] * 100.0
+                << "%, High " << relativeErrors[1] * 100.0 << "%" << std::endl;
+            hdrMatch = squaredErrors[1] <= squaredErrors[0];
+        }
+
+        // 単色は1領域のモード（端点16bit）で正確に表せる。予約されたモードは0に展開される
+        const uint16_t solidHalves[] = { 0x0000, 0x0001, 0x3555, 0x3C00, 0x5640, 0x7BFF };
+        for (const uint16_t half : solidHalves) {
+            uint16_t solid[16][3];
+            for (auto& pixel : solid) {
+                pixel[0] = half;
+                pixel[1] = static_cast<uint16_t>(half / 2);
+                pixel[2] = static_cast<uint16_t>(0x7BFF - half);
+            }
+            uint8_t block[16];
+            uint16_t solidDecoded[16][3];
+            BptcCodec::EncodeBC6HBlock(solid[0], BlockQuality::Fast, block);
+            hdrMatch = hdrMatch && BptcCodec::DecodeBC6HBlock(block, solidDecoded[0])
+                && std::equal(solidDecoded[0], solidDecoded[0] + 48, solid[0]);
+        }
+        uint8_t reserved[16] = { 0x13 };
+        uint16_t reservedDecoded[16][3];
+        hdrMatch = hdrMatch && !BptcCodec::DecodeBC6HBlock(reserved, reservedDecoded[0]) && reservedDecoded[15][2] == 0;
+        std::cout << (hdrMatch ? "  SUCCESS: BC6H error within bounds, High not worse than Fast, solid colors exact"
+                               : "  FAILED: unexpected BC6H error") << std::endl;
+
+        // ミップチェーン: HDRはRGBA32FloatのままBC6Hへ、LDRはsRGBのBC7へ。形式が合わない組み合わせは失敗する
+        // 並列数によらず同じブロックになる
+        MipChainBuilder builder;
+        MipChain hdrChain;
+        MipChain ldrChain;
+        CompressedTexture hdrTexture;
+        CompressedTexture ldrTexture;
+        CompressedTexture singleThreadTexture;
+        BlockCompressor singleThreadCompressor(1);
+        BlockCompressor multiThreadCompressor(4);
+        bool chainMatch = sky.IsValid()
+            && builder.Build(skyPixels, 512, 256, skyRowPitch, MipPixelFormat::RGBA32Float, hdrChain)
+            && builder.Build(image.data(), kSize, kSize, 0, MipPixelFormat::RGBA8UnormSrgb, ldrChain)
+            && multiThreadCompressor.Compress(hdrChain, BlockFormat::BC6H, hdrTexture)
+            && singleThreadCompressor.Compress(hdrChain, BlockFormat::BC6H, singleThreadTexture)
+            && hdrTexture.data == singleThreadTexture.data && !hdrTexture.srgb && hdrTexture.levels.size() == 10
+            && multiThreadCompressor.Compress(ldrChain, BlockFormat::BC7, ldrTexture)
+            && singleThreadCompressor.Compress(ldrChain, BlockFormat::BC7, singleThreadTexture)
+            && ldrTexture.data == singleThreadTexture.data && ldrTexture.srgb
+            && !compressor.Compress(ldrChain, BlockFormat::BC6H, singleThreadTexture)
+            && !compressor.Compress(hdrChain, BlockFormat::BC7, singleThreadTexture)
+            && !compressor.CompressImage(image.data(), kSize, kSize, 0, BlockFormat::BC6H, blocks.data())
+            && !BlockCompressor::DecompressImage(blocks.data(), kSize, kSize, BlockFormat::BC6H, decoded.data());
+        std::cout << "  - Mip chains: BC6H " << hdrTexture.data.size() << " bytes, BC7 " << ldrTexture.data.size() << " bytes" << std::endl;
+        std::cout << (chainMatch ? "  SUCCESS: mip chains compressed identically with 1 and 4 threads"
+                                 : "  FAILED: unexpected mip chain compression") << std::endl;
+        std::cout << std::defaultfloat;
+    }
+    std::cout << std::endl;
+
+    // テスト8: BC6H/BC7の既知解（独立した参照デコーダの展開結果と一致するか。全モードを1つずつ）
+    std::cout << "[Texture Test 8] BC6H/BC7 known-answer vectors" << std::endl;
+    {
+        int bc7Matched = 0;
+        for (const BptcKnownAnswer& answer : kBc7KnownAnswers) {
+            const std::vector<uint8_t> block = ParseHexBytes(answer.block);
+            const std::vector<uint8_t> expected = ParseHexBytes(answer.expected);
+            uint8_t decoded[64];
+            if (BptcCodec::GetBC7Mode(block.data()) == answer.mode && BptcCodec::DecodeBC7Block(block.data(), decoded)
+                && std::equal(decoded, decoded + 64, expected.begin())) {
+                ++bc7Matched;
+            } else {
+                std::cout << "  - BC7 mode " << answer.mode << " does not match the reference" << std::endl;
+            }
+        }
+
+        int bc6hMatched = 0;
+        for (const BptcKnownAnswer& answer : kBc6hKnownAnswers) {
+            const std::vector<uint8_t> block = ParseHexBytes(answer.block);
+            const std::vector<uint8_t> expected = ParseHexBytes(answer.expected);
+            uint16_t decoded[48];
+            bool match = BptcCodec::GetBC6HMode(block.data()) == answer.mode && BptcCodec::DecodeBC6HBlock(block.data(), decoded);
+            for (int i = 0; match && i < 48; ++i) {
+                match = ToReferenceUnorm8(decoded[i]) == expected[i];
+            }
+            if (match) {
+                ++bc6hMatched;
+            } else {
+                std::cout << "  - BC6H mode " << answer.mode << " does not match the reference" << std::endl;
+            }
+        }
+        std::cout << "  - BC7 " << bc7Matched << "/" << std::size(kBc7KnownAnswers) << " modes, BC6H "
+                  << bc6hMatched << "/" << std::size(kBc6hKnownAnswers) << " modes" << std::endl;
+        const bool allMatched = bc7Matched == static_cast<int>(std::size(kBc7KnownAnswers))
+            && bc6hMatched == static_cast<int>(std::size(kBc6hKnownAnswers));
+        std::cout << (allMatched ? "  SUCCESS: all modes decode to the reference output"
+                                 : "  FAILED: decoded blocks differ from the reference") << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "### Texture Test Completed ###" << std::endl;
+    std::cout << std::endl;
+}
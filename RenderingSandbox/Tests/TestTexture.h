@@ -0,0 +1,4 @@
+#pragma once
+
+// テクスチャ読み込み・加工のテスト関数
+void RunTextureTest();
@@ -4,17 +4,21 @@
 #include "Tests/TestImGui.h"
 #include "Tests/TestStb.h"
 #include "Tests/TestAssimp.h"
+#include "Tests/TestLogger.h"
+#include "Tests/TestTexture.h"
 
 // Logger
 #include "Logger/Logger.h"
 #include "Logger/ConsoleSink.h"
 #include "Logger/DebugOutputSink.h"
 #include "Logger/FileSink.h"
+#include "Logger/LogCrashHandler.h"
 #include "Logger/LogMacros.h"
 
 #include <iostream>
 #include <wrl.h>
 #include <format>
+#include <string_view>
 
 #define WIN32_LEAN_AND_MEAN //不要な機能をWindows.hから除外するための定義
 #include <Windows.h>
@@ -31,6 +35,28 @@ extern "C" {
 
 using namespace Microsoft::WRL;
 
+// 起動時引数に指定したオプションが含まれているか（空白区切りの引数と完全一致で判定）
+static bool HasCommandLineOption(PCWSTR cmdLine, std::wstring_view option)
+{
+	std::wstring_view rest = cmdLine ? cmdLine : L"";
+	while (!rest.empty())
+	{
+		const size_t begin = rest.find_first_not_of(L" \t");
+		if (begin == std::wstring_view::npos)
+		{
+			break;
+		}
+		rest.remove_prefix(begin);
+		const size_t end = rest.find_first_of(L" \t");
+		if (rest.substr(0, end) == option)
+		{
+			return true;
+		}
+		rest.remove_prefix(end == std::wstring_view::npos ? rest.size() : end);
+	}
+	return false;
+}
+
 int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _In_ PWSTR pCmdLine, _In_ int nCmdShow)
 {
 	// コンソールウィンドウを割り当て（Windows Subsystemでもコンソール表示可能にする）
@@ -48,6 +74,9 @@ int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _
 	logger.AddSink(std::make_unique<RenderingSandbox::DebugOutputSink>());
 	logger.AddSink(std::make_unique<RenderingSandbox::FileSink>("RenderingSandbox.log"));
 
+	// クラッシュ時に配信前のログとバックトレースを書き出す
+	RenderingSandbox::LogCrashHandler::Install();
+
 #ifdef _DEBUG
 	logger.SetGlobalMinLevel(RenderingSandbox::LogLevel::Trace);
 #else
@@ -57,6 +86,9 @@ int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _
 	LOG_INFO("System", "=== RenderingSandbox Started ===");
 	LOG_INFO("System", "");
 
+	// 時間のかかるテスト（ベンチマークを含み、グローバルのLoggerの設定も変更する）は起動時引数 --run-tests を指定した場合のみ実行
+	const bool runTests = HasCommandLineOption(pCmdLine, L"--run-tests");
+
 	std::cout << "=== Library Test ===" << std::endl;
 	std::cout << std::endl;
 
@@ -69,6 +101,18 @@ int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _
 	// Assimpテスト実行
 	RunAssimpTest();
 
+	// Loggerテスト実行
+	if (runTests)
+	{
+		RunLoggerTest();
+	}
+
+	// テクスチャテスト実行
+	if (runTests)
+	{
+		RunTextureTest();
+	}
+
 	std::cout << "=== All Library Tests Completed ===" << std::endl;
 	std::cout << std::endl;
 
@@ -145,12 +189,12 @@ int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _
 			std::wstring wDescription(desc1.Description);
 			std::string description(wDescription.begin(), wDescription.end());
 
-			LOG_INFO("DeviceInfo", std::format("Description: {}\nVendorID: {:#x}, DeviceID: {:#x}",
-				description, desc1.VendorId, desc1.DeviceId));
+			LOG_INFOF("DeviceInfo", "Description: {}\nVendorID: {:#x}, DeviceID: {:#x}",
+				description, desc1.VendorId, desc1.DeviceId);
 
 			LARGE_INTEGER umdVersion;
 			adapter->CheckInterfaceSupport(__uuidof(ID3D12Device), &umdVersion);
-			LOG_INFO("DeviceInfo", std::format("UMD Version: {}.{}", umdVersion.HighPart, umdVersion.LowPart));
+			LOG_INFOF("DeviceInfo", "UMD Version: {}.{}", umdVersion.HighPart, umdVersion.LowPart);
 
 			// CheckInterfaceSupportはDirectX 12では使用不可（Direct3D 10.x専用）
 			// DirectX 12の機能チェックはdevice->CheckFeatureSupport()を使用
@@ -184,6 +228,7 @@ int __stdcall wWinMain(_In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _
 	// Logger終了処理
 	LOG_INFO("System", "=== RenderingSandbox Terminated ===");
 	logger.Flush();
+	RenderingSandbox::LogCrashHandler::Uninstall();
 
 	// コンソールウィンドウを解放
 	FreeConsole();
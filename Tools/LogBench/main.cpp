@@ -0,0 +1,326 @@
+// LogBench - Loggerのスループット・レイテンシ測定ツール
+//
+// Logger::Log（本文指定）とLogger::LogFormat（遅延フォーマット）を、Sinkとスレッド数の組み合わせごとに呼び出して
+// スループット、1呼び出しあたりのレイテンシ（p50/p99/p999）、1レコードあたりのヒープ確保回数を表示する
+// ロガーの最適化を行う際の基準値として使う（ウィンドウを開かないのでヘッドレス環境でも実行できる）
+//
+// 使い方:
+//   LogBench [--records N] [--threads N] [--sink null|file|console|all] [--async]
+//     --records  1スレッドあたりのレコード数（既定: 200000）
+//     --threads  最大スレッド数（1から2倍ずつ増やして測定、既定: ハードウェアスレッド数）
+//     --sink     測定するSink（既定: all）。consoleは標準出力をヌルデバイスへ向けて測定する
+//     --async    非同期モード（EnableAsync）で測定する
+//
+// Linuxでのビルド例:
+//   g++ -std=c++20 -O2 -pthread -ICommon/Include Tools/LogBench/main.cpp Common/Src/Logger/*.cpp -o LogBench
+
+#include "Logger/ConsoleSink.h"
+#include "Logger/FileSink.h"
+#include "Logger/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ==================================================
+// ヒープ確保回数の計測（グローバルのoperator newを置き換える）
+// ==================================================
+
+namespace {
+    std::atomic<uint64_t> g_allocationCount{ 0 };
+
+    void* CountedAllocate(size_t size) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        if (void* pointer = std::malloc(size > 0 ? size : 1)) {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* CountedAllocateAligned(size_t size, std::align_val_t alignment) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        const size_t align = static_cast<size_t>(alignment);
+        const size_t rounded = (std::max<size_t>(size, 1) + align - 1) / align * align;
+#ifdef _WIN32
+        void* pointer = _aligned_malloc(rounded, align);
+#else
+        void* pointer = std::aligned_alloc(align, rounded);
+#endif
+        if (pointer) {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    void AlignedFree(void* pointer) {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+} // namespace
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { AlignedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { AlignedFree(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { AlignedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { AlignedFree(pointer); }
+
+using namespace RenderingSandbox;
+
+namespace {
+
+    // 何も出力しないSink（Logger本体のコストだけを測る）
+    class NullSink : public ILogSink {
+    public:
+        void Write(const LogMessage&) override {}
+    };
+
+    enum class SinkKind { Null, File, Console };
+    enum class CallKind { Text, Format };
+
+    struct Options {
+        size_t records = 200000;
+        size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<SinkKind> sinks = { SinkKind::Null, SinkKind::File, SinkKind::Console };
+        bool async = false;
+    };
+
+    struct Result {
+        double recordsPerSecond = 0.0;
+        double p50 = 0.0;               // ナノ秒
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double allocationsPerRecord = 0.0;
+    };
+
+    const char* GetSinkName(SinkKind kind) {
+        switch (kind) {
+            case SinkKind::Null:    return "null";
+            case SinkKind::File:    return "file";
+            case SinkKind::Console: return "console";
+        }
+        return "";
+    }
+
+    // 標準出力をヌルデバイスへ向ける（スコープを抜けると元に戻す）
+    class StdoutToNull {
+    public:
+        StdoutToNull() {
+            std::fflush(stdout);
+#ifdef _WIN32
+            m_saved = _dup(1);
+            int null = -1;
+            _sopen_s(&null, "NUL", _O_WRONLY, _SH_DENYNO, 0);
+            _dup2(null, 1);
+            _close(null);
+#else
+            m_saved = ::dup(1);
+            int null = ::open("/dev/null", O_WRONLY);
+            ::dup2(null, 1);
+            ::close(null);
+#endif
+        }
+
+        ~StdoutToNull() {
+            std::fflush(stdout);
+#ifdef _WIN32
+            _dup2(m_saved, 1);
+            _close(m_saved);
+#else
+            ::dup2(m_saved, 1);
+            ::close(m_saved);
+#endif
+        }
+
+    private:
+        int m_saved = -1;
+    };
+
+    double Percentile(const std::vector<uint32_t>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+        return sorted[index];
+    }
+
+    Result Run(const Options& options, SinkKind sinkKind, CallKind callKind, size_t threadCount, const std::filesystem::path& directory) {
+        Logger& logger = Logger::GetInstance();
+        logger.ClearSinks();
+
+        std::unique_ptr<StdoutToNull> redirect;
+        switch (sinkKind) {
+            case SinkKind::Null:
+                logger.AddSink(std::make_unique<NullSink>());
+                break;
+            case SinkKind::File: {
+                auto sink = std::make_unique<FileSink>(directory / "LogBench.log", false);
+                sink->SetMaxFileSize(SIZE_MAX);
+                logger.AddSink(std::move(sink));
+                break;
+            }
+            case SinkKind::Console:
+                redirect = std::make_unique<StdoutToNull>();
+                logger.AddSink(std::make_unique<ConsoleSink>());
+                break;
+        }
+        if (options.async) {
+            logger.EnableAsync(65536, LogOverflowPolicy::Block);
+        }
+
+        const LogCategoryId category = logger.RegisterCategory("Bench");
+        std::vector<std::vector<uint32_t>> latencies(threadCount);
+        for (auto& samples : latencies) {
+            samples.resize(options.records);
+        }
+
+        // 全スレッドの準備ができてから一斉に開始する
+        std::atomic<size_t> ready{ 0 };
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                uint32_t* samples = latencies[t].data();
+                ready.fetch_add(1);
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < options.records; ++i) {
+                    const auto callStart = std::chrono::steady_clock::now();
+                    if (callKind == CallKind::Text) {
+                        logger.Log(LogLevel::Info, category, "Frame rendered: draw calls 1234, triangles 567890", "main.cpp", 42);
+                    } else {
+                        logger.LogFormat(LogLevel::Info, category, "main.cpp", 42,
+                            "Frame {} rendered: draw calls {}, triangles {}, {:.2f} ms", i, 1234, 567890, 16.67);
+                    }
+                    const auto callEnd = std::chrono::steady_clock::now();
+                    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(callEnd - callStart).count();
+                    samples[i] = static_cast<uint32_t>(std::min<int64_t>(nanoseconds, UINT32_MAX));
+                }
+            });
+        }
+        while (ready.load() < threadCount) {
+            std::this_thread::yield();
+        }
+
+        const uint64_t allocationsBefore = g_allocationCount.load();
+        const auto runStart = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        // 非同期モード・バッファ付きSinkでは配信完了までを含める
+        logger.Flush();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - runStart;
+        const uint64_t allocations = g_allocationCount.load() - allocationsBefore;
+
+        if (options.async) {
+            logger.DisableAsync();
+        }
+        logger.ClearSinks();
+        redirect.reset();
+
+        std::vector<uint32_t> merged;
+        merged.reserve(threadCount * options.records);
+        for (const auto& samples : latencies) {
+            merged.insert(merged.end(), samples.begin(), samples.end());
+        }
+        std::sort(merged.begin(), merged.end());
+
+        const double totalRecords = static_cast<double>(threadCount * options.records);
+        Result result;
+        result.recordsPerSecond = totalRecords / elapsed.count();
+        result.p50 = Percentile(merged, 0.50);
+        result.p99 = Percentile(merged, 0.99);
+        result.p999 = Percentile(merged, 0.999);
+        result.allocationsPerRecord = static_cast<double>(allocations) / totalRecords;
+        return result;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (argument == "--records" && hasValue) {
+                options.records = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+            } else if (argument == "--threads" && hasValue) {
+                options.maxThreads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+            } else if (argument == "--sink" && hasValue) {
+                const std::string_view name = argv[++i];
+                if (name == "null") {
+                    options.sinks = { SinkKind::Null };
+                } else if (name == "file") {
+                    options.sinks = { SinkKind::File };
+                } else if (name == "console") {
+                    options.sinks = { SinkKind::Console };
+                } else if (name != "all") {
+                    return false;
+                }
+            } else if (argument == "--async") {
+                options.async = true;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: LogBench [--records N] [--threads N] [--sink null|file|console|all] [--async]\n");
+        return 2;
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RenderingSandbox_LogBench";
+    std::filesystem::create_directories(directory);
+
+    std::printf("LogBench: %zu records/thread, %s mode\n", options.records, options.async ? "async" : "sync");
+    std::printf("%-8s %-7s %7s %14s %10s %10s %10s %12s\n",
+        "sink", "call", "threads", "records/sec", "p50(ns)", "p99(ns)", "p999(ns)", "allocs/rec");
+
+    for (SinkKind sinkKind : options.sinks) {
+        for (CallKind callKind : { CallKind::Text, CallKind::Format }) {
+            for (size_t threadCount = 1; threadCount <= options.maxThreads; threadCount *= 2) {
+                const Result result = Run(options, sinkKind, callKind, threadCount, directory);
+                std::printf("%-8s %-7s %7zu %14.0f %10.0f %10.0f %10.0f %12.3f\n",
+                    GetSinkName(sinkKind), callKind == CallKind::Text ? "text" : "format", threadCount,
+                    result.recordsPerSecond, result.p50, result.p99, result.p999, result.allocationsPerRecord);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
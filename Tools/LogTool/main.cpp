@@ -0,0 +1,81 @@
+// LogTool - ログファイル用のコマンドラインツール
+//
+// 使い方:
+//   LogTool ring <file>           MappedFileSinkのリングファイルを古い順にテキストへ展開して標準出力へ書き出す
+//   LogTool bin <file> [--json]   BinaryFileSinkのファイルをデコードしてテキスト（またはJSON Lines）で書き出す
+//
+// Linuxでのビルド例:
+//   g++ -std=c++20 -O2 -pthread -ICommon/Include Tools/LogTool/main.cpp Common/Src/Logger/*.cpp -o LogTool
+
+#include "Logger/BinaryFileSink.h"
+#include "Logger/JsonLinesSink.h"
+#include "Logger/MappedFileSink.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+using namespace RenderingSandbox;
+
+namespace {
+
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "Usage:\n"
+            "  LogTool ring <file>           Dump a MappedFileSink ring file as text (oldest first)\n"
+            "  LogTool bin <file> [--json]   Decode a BinaryFileSink file as text or JSON Lines\n");
+    }
+
+    int DumpRing(const char* path) {
+        std::string line;
+        const bool valid = MappedFileSink::ReadFile(path, [&](const LogMessage& message) {
+            message.FormatTo(line);
+            line.push_back('\n');
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        });
+
+        if (!valid) {
+            std::fprintf(stderr, "LogTool: not a ring log file: %s\n", path);
+            return 1;
+        }
+        return 0;
+    }
+
+    int DecodeBinary(const char* path, bool json) {
+        std::string line;
+        const bool valid = BinaryFileSink::ReadFile(path, [&](const LogMessage& message) {
+            if (json) {
+                JsonLinesSink::FormatJson(message, line);
+            } else {
+                message.FormatTo(line);
+            }
+            line.push_back('\n');
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        });
+
+        if (!valid) {
+            std::fprintf(stderr, "LogTool: not a binary log file: %s\n", path);
+            return 1;
+        }
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 2;
+    }
+
+    const std::string_view command = argv[1];
+    if (command == "ring") {
+        return DumpRing(argv[2]);
+    }
+    if (command == "bin") {
+        const bool json = argc >= 4 && std::string_view(argv[3]) == "--json";
+        return DecodeBinary(argv[2], json);
+    }
+
+    PrintUsage();
+    return 2;
+}